@@ -0,0 +1,180 @@
+/**
+ * =============================================================================
+ * AllocationTracker.h - Heap Allocation Counting per Subsystem and Frame
+ * =============================================================================
+ * An instrumented build (CMake option CARSHOWROOM_TRACK_ALLOCATIONS) replaces
+ * the global operator new/delete with versions that count every allocation.
+ * Each count goes to the subsystem whose zone is active on the calling
+ * thread, so a frame's allocations can be split into Renderer, Shader,
+ * Input, Animation and Collision (everything else is Other).
+ * 
+ * Zones are marked with a scope at the subsystem's entry points:
+ * 
+ *   void Application::processInput() {
+ *       ALLOCATION_ZONE(AllocSubsystem::INPUT);
+ *       ...
+ *   }
+ * 
+ * Frames that should not allocate at all are marked the same way with
+ * ALLOCATION_FREE_SCOPE(condition). An allocation inside one is a
+ * violation: it is counted and reported (with the subsystem and size), or,
+ * with CARSHOWROOM_BREAK_ON_FRAME_ALLOCATION, stops in the debugger.
+ * 
+ * In a normal build both macros compile to nothing, operator new is the
+ * standard one and isEnabled() returns false.
+ * 
+ * Counters live in one slot per thread, so threads never share a counter.
+ * Per-frame numbers are the difference between two snapshots taken by the
+ * main thread and include the render and loader threads' work in between.
+ * 
+ * Not counted: aligned operator new (over-aligned types, not used here)
+ * and memory the C library or GL driver allocates with malloc.
+ * =============================================================================
+ */
+
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * AllocSubsystem - Zone an allocation is charged to.
+ */
+enum class AllocSubsystem {
+    OTHER,
+    RENDERER,
+    SHADER,
+    INPUT,
+    ANIMATION,
+    COLLISION,
+    COUNT
+};
+
+/**
+ * AllocationCounts - Allocations and requested bytes.
+ */
+struct AllocationCounts {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * AllocationReport - Allocations over a number of frames.
+ */
+struct AllocationReport {
+    size_t frameCount = 0;
+    std::array<AllocationCounts, static_cast<size_t>(AllocSubsystem::COUNT)> subsystems;
+    AllocationCounts total;
+    uint64_t worstFrameCount = 0;       // Most allocations in a single frame
+    uint64_t frees = 0;
+    uint64_t violations = 0;            // Allocations in allocation-free scopes
+};
+
+namespace AllocationTracker {
+    /**
+     * Frames before allocation-free scopes take effect. Containers that keep
+     * their capacity (frame packets, queues) reach their final size here.
+     */
+    constexpr uint64_t WARMUP_FRAMES = 120;
+    
+    /**
+     * Check whether this is an instrumented build.
+     */
+    constexpr bool isEnabled() {
+#ifdef CARSHOWROOM_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    /**
+     * Get the display name of a subsystem (e.g., "Renderer").
+     */
+    const char* getSubsystemName(AllocSubsystem subsystem);
+    
+    /**
+     * Close the current frame: add the allocations since the previous call
+     * to the running report. Call once per frame from the main thread.
+     */
+    void endFrame();
+    
+    /**
+     * Get the report for the frames since the last call and start a new one.
+     */
+    AllocationReport takeReport();
+    
+    /**
+     * Print a report as per-frame averages, one line per subsystem that
+     * allocated.
+     */
+    void printReport(std::ostream& out, const AllocationReport& report);
+    
+    /**
+     * Choose between reporting a violation and trapping into the debugger.
+     * Defaults to CARSHOWROOM_BREAK_ON_FRAME_ALLOCATION.
+     */
+    void setBreakOnViolation(bool enabled);
+    
+    /**
+     * Called by the instrumented operator new/delete.
+     */
+    void recordAllocation(size_t bytes);
+    void recordFree();
+}
+
+/**
+ * AllocationZone - Charges allocations on this thread to a subsystem until
+ * the scope ends. Zones nest; the innermost one wins.
+ */
+class AllocationZone {
+public:
+    explicit AllocationZone(AllocSubsystem subsystem);
+    ~AllocationZone();
+    
+    AllocationZone(const AllocationZone&) = delete;
+    AllocationZone& operator=(const AllocationZone&) = delete;
+
+private:
+    AllocSubsystem m_previous;
+};
+
+/**
+ * AllocationFreeScope - Marks code on this thread that must not allocate.
+ */
+class AllocationFreeScope {
+public:
+    /**
+     * @param active False makes the scope do nothing (e.g., during warm-up)
+     */
+    explicit AllocationFreeScope(bool active = true);
+    ~AllocationFreeScope();
+    
+    AllocationFreeScope(const AllocationFreeScope&) = delete;
+    AllocationFreeScope& operator=(const AllocationFreeScope&) = delete;
+
+private:
+    bool m_active;
+};
+
+// =============================================================================
+// Scope Macros
+// =============================================================================
+
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+
+#ifdef CARSHOWROOM_TRACK_ALLOCATIONS
+#define ALLOCATION_ZONE(subsystem) \
+    AllocationZone ALLOCATION_CONCAT(allocationZone_, __LINE__)(subsystem)
+#define ALLOCATION_FREE_SCOPE(active) \
+    AllocationFreeScope ALLOCATION_CONCAT(allocationFree_, __LINE__)(active)
+#else
+#define ALLOCATION_ZONE(subsystem) ((void)0)
+#define ALLOCATION_FREE_SCOPE(active) ((void)0)
+#endif
+
+#endif // ALLOCATION_TRACKER_H
@@ -0,0 +1,150 @@
+/**
+ * =============================================================================
+ * AmbientOcclusion.h - Half-Resolution Screen-Space Ambient Occlusion
+ * =============================================================================
+ * Ambient light reaches every surface equally, so without occlusion a car
+ * seems to float a little above the floor. This stage darkens ambient
+ * light in creases and under the cars from the depth of the current view.
+ * 
+ * Passes (all at half resolution, about a quarter of the pixels):
+ * 1. Depth: the packet's opaque items are drawn depth-only into a depth
+ *    texture.
+ * 2. Occlusion: each pixel reconstructs its view-space position and normal
+ *    from that depth and tests a small hemisphere kernel of points against
+ *    it. The kernel is rotated per pixel with interleaved gradient noise,
+ *    shifted every frame, so few samples still cover all directions.
+ * 3. Blur: a 4x4 depth-aware (bilateral) blur removes the rotation noise
+ *    without bleeding across silhouettes.
+ * 
+ * The main shader then reads the result at full resolution with a
+ * depth-aware bilateral upsample: of the four nearest half-resolution
+ * texels, those at the fragment's own depth count most, so edges stay
+ * sharp. Occlusion scales the ambient term of dynamic lighting and the
+ * whole lightmap of static surfaces (the lightmaps do not contain cars).
+ * 
+ * Quality tiers: OFF skips every pass, LOW and HIGH differ in kernel size.
+ * =============================================================================
+ */
+
+#ifndef AMBIENT_OCCLUSION_H
+#define AMBIENT_OCCLUSION_H
+
+#include <memory>
+
+#include "FullscreenPass.h"
+
+class Shader;
+struct FramePacket;
+
+/**
+ * AmbientOcclusionQuality - Ambient occlusion tier, chosen per frame.
+ */
+enum class AmbientOcclusionQuality {
+    OFF,                // No passes; ambient light is unoccluded
+    LOW,                // 8 kernel samples
+    HIGH                // 16 kernel samples
+};
+
+/**
+ * AmbientOcclusion class - Computes an occlusion texture for the current view.
+ * 
+ * Usage (render thread, before the main pass):
+ *   occlusion.render(packet, width, height);
+ *   renderer.setAmbientOcclusion(occlusion.getTexture(), occlusion.getDepthTexture());
+ */
+class AmbientOcclusion {
+public:
+    static constexpr int MAX_SAMPLES = 16;      // Kernel size at HIGH
+    
+    /**
+     * Create the targets for a framebuffer size. Requires a current GL context.
+     */
+    AmbientOcclusion(int width, int height);
+    
+    /**
+     * Destructor - Deletes the textures and framebuffers (call with the context current).
+     */
+    ~AmbientOcclusion();
+    
+    // Disable copying
+    AmbientOcclusion(const AmbientOcclusion&) = delete;
+    AmbientOcclusion& operator=(const AmbientOcclusion&) = delete;
+    
+    /**
+     * Follow a framebuffer resize (targets are half this size).
+     */
+    void resize(int width, int height);
+    
+    /**
+     * Run the passes for the packet's camera and opaque items at the
+     * packet's quality, then restore the default framebuffer and viewport.
+     * @param width Default framebuffer width (for the viewport)
+     * @param height Default framebuffer height
+     */
+    void render(const FramePacket& packet, int width, int height);
+    
+    /**
+     * Get the blurred occlusion (1 = open, 0 = fully occluded), or 0 when
+     * the last render() was OFF or the targets are incomplete.
+     */
+    unsigned int getTexture() const { return isActive() ? m_blurredTexture : 0; }
+    
+    /**
+     * Get the half-resolution depth the occlusion was computed from
+     * (for the bilateral upsample).
+     */
+    unsigned int getDepthTexture() const { return isActive() ? m_depthTexture : 0; }
+    
+    /**
+     * Get the kernel size of a tier (0 for OFF).
+     */
+    static int getSampleCount(AmbientOcclusionQuality quality);
+    
+    /**
+     * Get a tier's display name.
+     */
+    static const char* getQualityName(AmbientOcclusionQuality quality);
+    
+    /**
+     * Get the tier after a given one (cycles OFF -> LOW -> HIGH -> OFF).
+     */
+    static AmbientOcclusionQuality getNextQuality(AmbientOcclusionQuality quality);
+
+private:
+    bool m_valid;
+    AmbientOcclusionQuality m_quality;      // Tier of the last render()
+    
+    // Target size (half the framebuffer, rounded up)
+    int m_width;
+    int m_height;
+    
+    // Pass 1: depth only
+    unsigned int m_depthTexture;
+    unsigned int m_depthFramebuffer;
+    
+    // Pass 2: noisy occlusion; pass 3: blurred occlusion
+    unsigned int m_rawTexture;
+    unsigned int m_rawFramebuffer;
+    unsigned int m_blurredTexture;
+    unsigned int m_blurredFramebuffer;
+    
+    // Fullscreen triangle of the screen-space passes
+    FullscreenPass m_fullscreen;
+    std::unique_ptr<Shader> m_depthShader;
+    std::unique_ptr<Shader> m_occlusionShader;
+    std::unique_ptr<Shader> m_blurShader;
+    
+    bool isActive() const { return m_valid && m_quality != AmbientOcclusionQuality::OFF; }
+    
+    /**
+     * Create the textures and framebuffers for the current size.
+     */
+    void createTargets();
+    
+    /**
+     * Delete the textures and framebuffers.
+     */
+    void destroyTargets();
+};
+
+#endif // AMBIENT_OCCLUSION_H
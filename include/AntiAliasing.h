@@ -0,0 +1,176 @@
+/**
+ * =============================================================================
+ * AntiAliasing.h - Temporal, FXAA and Optional Multisample Anti-Aliasing
+ * =============================================================================
+ * The window used to ask for a 4x multisampled default framebuffer. That
+ * stores and resolves four color and depth samples per pixel for every
+ * pass, and a multisampled default framebuffer cannot be read by
+ * post-processing. The default framebuffer is now single-sampled, and
+ * this stage smooths edges in one of several ways:
+ * 
+ * - TAA (default): the projection is shifted by a different subpixel
+ *   offset every frame (a Halton(2,3) sequence, see getJitter), so over
+ *   a few frames each pixel sees several positions of every edge. The
+ *   main pass also writes a motion vector per pixel, from each item's
+ *   current and previous model matrix and the current and previous
+ *   camera. The resolve pass follows that vector back into the history
+ *   (the previous result) and blends a little of the new frame in.
+ *   Before blending, the history color is clamped to the range of the
+ *   new frame's 3x3 neighbourhood, which rejects history that was
+ *   disoccluded or belongs to something else and so prevents ghosting.
+ *   The motion vector is taken from the closest of those nine pixels, so
+ *   a moving silhouette drags its edge pixels along with it.
+ * - FXAA: one fullscreen pass that finds luminance edges in the finished
+ *   image and blurs along them. Cheapest, but softer and unaware of
+ *   subpixel detail.
+ * - MSAA: the old 4x multisampling, now into an offscreen target that is
+ *   resolved with a blit. Its targets are only created once it is used.
+ * - OFF: the main pass draws straight into the default framebuffer.
+ * 
+ * Per frame (render thread):
+ *   antiAliasing.beginScene(packet, renderer);   // bind and clear the target
+ *   renderer.drawItems(...);
+ *   antiAliasing.resolve();                       // into the default framebuffer
+ * =============================================================================
+ */
+
+#ifndef ANTI_ALIASING_H
+#define ANTI_ALIASING_H
+
+#include <cstdint>
+#include <memory>
+#include <glm/glm.hpp>
+
+#include "FullscreenPass.h"
+
+class Shader;
+class Renderer;
+struct FramePacket;
+
+/**
+ * AntiAliasingMode - Edge smoothing technique, chosen per frame.
+ */
+enum class AntiAliasingMode {
+    OFF,                // Draw directly to the default framebuffer
+    FXAA,               // Post-process edge blur
+    TAA,                // Jittered frames accumulated with reprojection
+    MSAA                // 4x multisampling, offscreen and resolved
+};
+
+/**
+ * AntiAliasing class - Offscreen scene targets and the resolve to the screen.
+ */
+class AntiAliasing {
+public:
+    static constexpr int MSAA_SAMPLES = 4;
+    static constexpr int JITTER_PHASES = 8;     // Halton points before the jitter repeats
+    
+    /**
+     * Create the targets for a framebuffer size. Requires a current GL context.
+     */
+    AntiAliasing(int width, int height);
+    
+    /**
+     * Destructor - Deletes the textures and framebuffers (call with the context current).
+     */
+    ~AntiAliasing();
+    
+    // Disable copying
+    AntiAliasing(const AntiAliasing&) = delete;
+    AntiAliasing& operator=(const AntiAliasing&) = delete;
+    
+    /**
+     * Follow a framebuffer resize. Drops the TAA history.
+     */
+    void resize(int width, int height);
+    
+    /**
+     * Bind and clear the target the main pass draws into for the packet's
+     * mode, and give the renderer the previous camera for motion vectors.
+     * Call after the passes that use other framebuffers (reflection
+     * probe, ambient occlusion) and before Renderer::drawItems().
+     */
+    void beginScene(const FramePacket& packet, Renderer& renderer);
+    
+    /**
+     * Resolve the scene target into the default framebuffer and leave it
+     * bound. Does nothing when the scene was drawn there directly.
+     */
+    void resolve();
+    
+    /**
+     * Get the projection jitter of a frame for Camera::setProjectionJitter.
+     * @return NDC offset within half a pixel of the center
+     */
+    static glm::vec2 getJitter(uint64_t frameNumber, int width, int height);
+    
+    /**
+     * Get a mode's display name.
+     */
+    static const char* getModeName(AntiAliasingMode mode);
+    
+    /**
+     * Get the mode after a given one (cycles OFF -> FXAA -> TAA -> MSAA -> OFF).
+     */
+    static AntiAliasingMode getNextMode(AntiAliasingMode mode);
+
+private:
+    int m_width;
+    int m_height;
+    AntiAliasingMode m_mode;        // Mode of the frame in progress
+    
+    // Single-sampled scene target (TAA and FXAA): color, motion, depth
+    bool m_valid;
+    unsigned int m_colorTexture;
+    unsigned int m_velocityTexture;
+    unsigned int m_depthTexture;
+    unsigned int m_sceneFramebuffer;
+    
+    // TAA history, ping-ponged: one is read while the other is written
+    unsigned int m_historyTextures[2];
+    unsigned int m_historyFramebuffers[2];
+    int m_historyIndex;             // The one holding the last result
+    bool m_hasHistory;
+    
+    // Camera the history was drawn with
+    glm::mat4 m_previousViewProjection;
+    glm::vec2 m_previousJitter;
+    
+    // Multisampled scene target, created the first time MSAA is used
+    bool m_msaaValid;
+    unsigned int m_msaaColorBuffer;
+    unsigned int m_msaaDepthBuffer;
+    unsigned int m_msaaFramebuffer;
+    
+    // Fullscreen triangle of the screen-space passes
+    FullscreenPass m_fullscreen;
+    std::unique_ptr<Shader> m_taaShader;
+    std::unique_ptr<Shader> m_fxaaShader;
+    
+    /**
+     * Get the framebuffer the main pass draws into this frame (0 = default).
+     */
+    unsigned int getSceneFramebuffer() const;
+    
+    /**
+     * Blend the scene into the history and copy the result to the screen.
+     */
+    void resolveTemporal();
+    
+    /**
+     * Create the single-sampled scene and history targets for the current size.
+     */
+    void createTargets();
+    
+    /**
+     * Create the multisampled scene target for the current size.
+     */
+    void createMultisampleTargets();
+    
+    /**
+     * Delete every target (multisampled ones included).
+     */
+    void destroyTargets();
+};
+
+#endif // ANTI_ALIASING_H
@@ -21,22 +21,37 @@
  * 1. Calculate delta time
  * 2. Process input
  * 3. Update scene (with fixed timestep if needed)
- * 4. Render
- * 5. Swap buffers and poll events
+ * 4. Build a FramePacket and hand it to the render thread
+ * 5. Poll events
+ * 
+ * All OpenGL work (drawing, picking, swapping, pacing) happens on the
+ * RenderThread, which draws frame N while this loop simulates frame N+1.
  * =============================================================================
  */
 
 #ifndef APPLICATION_H
 #define APPLICATION_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
+#include "SceneGenerator.h"
+
 class Window;
 class Renderer;
 class Camera;
 class ShowroomScene;
 class Input;
+class ObjectPicker;
+class FramePacer;
+class RenderThread;
+class AssetLoader;
+struct FramePacket;
+enum class PacingMode;
+enum class AmbientOcclusionQuality;
+enum class AntiAliasingMode;
+class CarModel;
 
 /**
  * Application class - Main application controller.
@@ -49,12 +64,15 @@ public:
      * @param width Window width
      * @param height Window height
      * @param title Window title
+     * @param sceneConfig Standard showroom (default) or a generated car lot
      */
     Application(int width = 1280, int height = 720, 
-                const std::string& title = "3D Car Showroom");
+                const std::string& title = "3D Car Showroom",
+                const SceneConfig& sceneConfig = SceneConfig());
     
     /**
-     * Destructor - Cleans up all resources.
+     * Destructor - Stops the render and loader threads, then cleans up
+     * all resources.
      */
     ~Application();
     
@@ -94,6 +112,9 @@ public:
     Input& getInput() { return *m_input; }
     const Input& getInput() const { return *m_input; }
     
+    FramePacer& getFramePacer() { return *m_pacer; }
+    const FramePacer& getFramePacer() const { return *m_pacer; }
+    
     // =========================================================================
     // Timing
     // =========================================================================
@@ -113,6 +134,14 @@ public:
      */
     float getFPS() const { return m_fps; }
     
+    /**
+     * Set the physics (fixed update) step length in seconds.
+     * Rendering interpolates between steps, so lower rates such as 1/30
+     * save CPU on busy scenes without making motion stutter.
+     */
+    void setFixedTimestep(float seconds);
+    float getFixedTimestep() const { return m_fixedTimestep; }
+    
 private:
     // Core components
     std::unique_ptr<Window> m_window;
@@ -120,10 +149,20 @@ private:
     std::unique_ptr<Camera> m_camera;
     std::unique_ptr<ShowroomScene> m_scene;
     std::unique_ptr<Input> m_input;
+    std::unique_ptr<ObjectPicker> m_picker;
+    std::unique_ptr<FramePacer> m_pacer;
+    std::unique_ptr<AssetLoader> m_loader;          // nullptr = scene loaded up front
+    std::unique_ptr<RenderThread> m_renderThread;   // Last: stops before the rest is freed
     
     // Application state
     bool m_running;
     
+    // Draw on a dedicated render thread (false = same thread, for debugging)
+    static constexpr bool USE_RENDER_THREAD = true;
+    
+    // Pacing mode requested from the render thread (which owns the swap interval)
+    PacingMode m_pacingMode;
+    
     // Timing
     float m_deltaTime;
     float m_elapsedTime;
@@ -131,11 +170,42 @@ private:
     float m_fps;
     float m_fpsAccumulator;
     int m_frameCount;
+    double m_frameStartTime;        // Window::getTime() at the top of this frame
+    double m_mainCpuMs;             // Main thread work of the last frame (see RenderStats)
+    
+    // Frame statistics overlay (F3)
+    bool m_showStats;
+    
+    // Ambient occlusion tier (Q)
+    AmbientOcclusionQuality m_ambientOcclusion;
+    
+    // Anti-aliasing mode (M)
+    AntiAliasingMode m_antiAliasing;
+    
+    // Price tags above the cars (T)
+    bool m_showPriceTags;
+    
+    // Main car in four views at once (4)
+    bool m_kioskMode;
     
     // Fixed timestep for physics
-    static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+    static constexpr float DEFAULT_FIXED_TIMESTEP = 1.0f / 60.0f;
+    float m_fixedTimestep;
     float m_physicsAccumulator;
     
+    // Picking state (only active while the cursor is released)
+    uint32_t m_hoveredObject;       // Pick object ID under the cursor, 0 = none
+    uint32_t m_hoveredPart;         // Mesh index of the hovered part
+    
+    // Car the orbit camera circles (nullptr = main car)
+    CarModel* m_focusCar;
+    
+    // Frames left before render() is checked for allocations (AllocationTracker)
+    int m_allocationWarmupFrames;
+    
+    // Time the scene started streaming in (see ShowroomScene::updateStreaming)
+    double m_streamStartTime;
+    
     /**
      * Initialize all subsystems.
      */
@@ -159,14 +229,21 @@ private:
     void fixedUpdate(float fixedDeltaTime);
     
     /**
-     * Render the current frame.
+     * Build this frame's packet and submit it to the render thread.
      */
     void render();
     
     /**
-     * Handle window resize.
+     * Request an ID pass for the pixel under the cursor in the packet and
+     * collect finished results from earlier frames.
+     */
+    void updatePicking(FramePacket& packet);
+    
+    /**
+     * Fill the packet's views with the kiosk's 2x2 layout of the main car:
+     * front, side, top and from the driver's seat.
      */
-    void onResize(int width, int height);
+    void collectKioskViews(FramePacket& packet) const;
     
     /**
      * Handle key press.
@@ -0,0 +1,175 @@
+/**
+ * =============================================================================
+ * AssetLoader.h - Background Asset Loading with a Shared GL Context
+ * =============================================================================
+ * Builds assets (meshes, models, textures) on a background thread so the
+ * showroom can render while the rest of the scene streams in.
+ * 
+ * The loader thread owns a hidden window whose GL context shares objects
+ * with the main one. Jobs run there with that context current, so they can
+ * create and fill buffers and textures directly (Mesh does so in its
+ * constructor).
+ * 
+ * Publishing: a buffer filled in one context is only safe to use in
+ * another once the GPU has finished the upload. After each batch of jobs
+ * the loader inserts a fence and waits for it on its own thread. Only then
+ * are the batch's futures fulfilled, so whatever a ready future returns can
+ * be drawn right away.
+ * 
+ * VAOs and FBOs are not shared between contexts. Mesh creates its VAO on
+ * the first draw, and all GL objects are freed via GpuDeletionQueue.
+ * =============================================================================
+ */
+
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+class Window;
+struct GLFWwindow;
+
+/**
+ * AssetLoader class - Runs asset jobs on a thread with a shared GL context.
+ * 
+ * Usage:
+ *   AssetLoader loader(window);
+ *   std::future<std::unique_ptr<Model>> pending = loader.load([] {
+ *       return buildModel();       // Runs on the loader thread
+ *   });
+ *   ...
+ *   if (AssetLoader::isReady(pending)) { model = pending.get(); }
+ */
+class AssetLoader {
+public:
+    /**
+     * Create the shared context and start the loader thread.
+     * Call on the main thread while it holds the window's context.
+     * @throws std::runtime_error if the shared context can't be created
+     */
+    explicit AssetLoader(Window& window);
+    
+    /**
+     * Destructor - Finishes the current batch, drops queued jobs (their
+     * futures report broken_promise) and destroys the shared context.
+     * Call on the main thread.
+     */
+    ~AssetLoader();
+    
+    // Disable copying
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    
+    /**
+     * Queue a job. It runs on the loader thread with the shared context
+     * current; jobs run one at a time, in the order they were queued.
+     * @param job Callable returning the asset (not void). Exceptions are
+     *            passed on through the future.
+     * @return Future that becomes ready once the job's GPU uploads are done
+     */
+    template <typename Job>
+    auto load(Job job) -> std::future<std::invoke_result_t<Job&>>;
+    
+    /**
+     * Check without blocking whether a future is ready.
+     */
+    template <typename T>
+    static bool isReady(const std::future<T>& future) {
+        return future.valid() &&
+               future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    
+    /**
+     * Get the number of jobs queued or running.
+     */
+    size_t getPendingCount() const;
+
+private:
+    /**
+     * LoadJob - One queued job, split so results are published after the fence.
+     */
+    struct LoadJob {
+        std::function<void()> run;      // Runs the job and stores its result
+        std::function<void()> publish;  // Fulfills the promise
+    };
+    
+    GLFWwindow* m_context;              // Hidden window sharing the main context
+    std::thread m_thread;
+    
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<LoadJob> m_jobs;         // Guarded by m_mutex
+    size_t m_runningCount;              // Jobs in the current batch
+    bool m_stop;
+    
+    /**
+     * Add a job to the queue and wake the thread.
+     */
+    void enqueue(LoadJob job);
+    
+    /**
+     * Loader thread main loop.
+     */
+    void threadLoop();
+    
+    /**
+     * Most jobs published behind one fence. Small batches let results
+     * appear one by one instead of all at the end.
+     */
+    static constexpr size_t MAX_BATCH_SIZE = 4;
+    
+    /**
+     * Wait until the GPU has finished everything issued on the loader context.
+     */
+    static void waitForUploads();
+};
+
+// =============================================================================
+// Template Implementation
+// =============================================================================
+
+template <typename Job>
+auto AssetLoader::load(Job job) -> std::future<std::invoke_result_t<Job&>> {
+    using Result = std::invoke_result_t<Job&>;
+    static_assert(!std::is_void_v<Result>, "AssetLoader jobs must return the loaded asset");
+    
+    // Shared between the run and publish halves
+    struct State {
+        std::promise<Result> promise;
+        std::optional<Result> result;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    std::future<Result> future = state->promise.get_future();
+    
+    LoadJob entry;
+    entry.run = [state, job]() mutable {
+        try {
+            state->result.emplace(job());
+        } catch (...) {
+            state->error = std::current_exception();
+        }
+    };
+    entry.publish = [state]() {
+        if (state->error) {
+            state->promise.set_exception(state->error);
+        } else {
+            state->promise.set_value(std::move(*state->result));
+        }
+    };
+    
+    enqueue(std::move(entry));
+    return future;
+}
+
+#endif // ASSET_LOADER_H
@@ -80,10 +80,20 @@ public:
      * Get the projection matrix.
      * Transforms camera coordinates to clip coordinates (NDC after division).
      * 
+     * Includes the projection jitter, if one is set.
+     * 
      * @param aspectRatio Width/Height of the viewport
      */
     glm::mat4 getProjectionMatrix(float aspectRatio) const;
     
+    /**
+     * Shift the projection by a subpixel offset (temporal anti-aliasing
+     * jitters it every frame). The offset is in NDC, so one pixel is
+     * 2 / width horizontally. Zero turns jitter off.
+     */
+    void setProjectionJitter(const glm::vec2& offset) { m_projectionJitter = offset; }
+    const glm::vec2& getProjectionJitter() const { return m_projectionJitter; }
+    
     // =========================================================================
     // Camera Mode
     // =========================================================================
@@ -146,6 +156,11 @@ public:
     void setYaw(float yaw);
     void setPitch(float pitch);
     
+    /**
+     * Turn to face a point (sets yaw and pitch, pitch limited to +-89 degrees).
+     */
+    void lookAt(const glm::vec3& target);
+    
     float getFOV() const { return m_fov; }
     void setFOV(float fov);
     
@@ -181,6 +196,7 @@ private:
     float m_fov;                // Field of view in degrees
     float m_nearPlane;
     float m_farPlane;
+    glm::vec2 m_projectionJitter;   // NDC offset added after projection
     
     // Camera mode
     CameraMode m_mode;
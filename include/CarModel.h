@@ -12,6 +12,11 @@
  * - Y axis: Down to up (positive up)
  * - Z axis: Back to front (positive forward)
  * - Origin: Center of the car at ground level
+ * 
+ * Construction is split in two: generateGeometry() builds the generated
+ * meshes on the CPU (any thread), and the constructor uploads them along
+ * with the compile-time body and wheel tables. The scene generates many
+ * cars at once on the thread pool and then uploads them one after another.
  * =============================================================================
  */
 
@@ -19,7 +24,9 @@
 #define CAR_MODEL_H
 
 #include "Model.h"
+#include "Collision.h"
 #include <array>
+#include <cstdint>
 
 class Shader;
 
@@ -43,6 +50,17 @@ enum class DoorPosition {
     REAR_RIGHT = 3
 };
 
+/**
+ * CarGeometry - A car's generated meshes, not yet uploaded.
+ * The body and wheels are fixed shapes built at compile time (see
+ * StaticMesh.h), so only the glass and interior are generated.
+ */
+struct CarGeometry {
+    bool simplified = false;
+    MeshData window;                // Empty for simplified cars
+    MeshData interior;              // Empty for simplified cars
+};
+
 /**
  * CarModel class - Represents a detailed car with animations.
  */
@@ -59,6 +77,19 @@ public:
      */
     explicit CarModel(bool simplified);
     
+    /**
+     * Create a car from geometry generated earlier, uploading it now.
+     * Requires a current GL context.
+     */
+    explicit CarModel(CarGeometry&& geometry);
+    
+    /**
+     * Build a car's meshes on the CPU. Touches no GL state, so it is
+     * safe to call on worker threads.
+     * @param simplified If true, builds the low-detail version
+     */
+    static CarGeometry generateGeometry(bool simplified);
+    
     /**
      * Destructor.
      */
@@ -145,6 +176,21 @@ public:
      */
     float getOrbitDistance() const { return 5.0f; }
     
+    /**
+     * Get the point above the roof where the car's price tag sits.
+     */
+    glm::vec3 getLabelPosition() const;
+    
+    // =========================================================================
+    // Showroom Info
+    // =========================================================================
+    
+    /**
+     * Set the sticker price in dollars (0 = no price tag).
+     */
+    void setPrice(uint32_t dollars) { m_price = dollars; }
+    uint32_t getPrice() const { return m_price; }
+    
     // =========================================================================
     // Rendering
     // =========================================================================
@@ -164,17 +210,35 @@ public:
      */
     void drawTransparent(Shader& shader) const;
     
+    /**
+     * Get the world matrix of a mesh (wheels spin and sit at the corners).
+     */
+    glm::mat4 getMeshMatrix(size_t meshIndex) const override;
+    
+    /**
+     * Get a readable name for a mesh, e.g. for a picked part.
+     */
+    const char* getPartName(size_t meshIndex) const;
+    
     // =========================================================================
     // Collision
     // =========================================================================
     
     /**
      * Get bounding box for collision detection.
+     * This is the world-axis box around the oriented box, so it grows
+     * as the car turns away from the X axis.
      * @param min Output: minimum corner
      * @param max Output: maximum corner
      */
     void getBoundingBox(glm::vec3& min, glm::vec3& max) const;
     
+    /**
+     * Get the oriented bounding box of the body.
+     * Built from the model matrix, so it follows position, heading and scale.
+     */
+    OBB getOrientedBoundingBox() const;
+    
 private:
     // Sub-meshes (owned by parent Model::m_meshes)
     // We store indices into the meshes vector for identification
@@ -197,6 +261,7 @@ private:
     
     // Features
     bool m_headlightsOn;
+    uint32_t m_price;               // Sticker price in dollars
     bool m_hasInterior;             // False for simplified cars
     
     // Car dimensions (for bounding box and camera positioning)
@@ -206,14 +271,15 @@ private:
     float m_wheelRadius;
     
     /**
-     * Create the detailed car geometry.
+     * Build a wheel's world matrix from the car's model matrix.
+     * @param wheel Wheel index (see WheelPosition)
      */
-    void createDetailedCar();
+    glm::mat4 getWheelMatrix(size_t wheel, const glm::mat4& modelMatrix) const;
     
     /**
-     * Create simplified car geometry.
+     * Upload generated geometry as this car's meshes.
      */
-    void createSimplifiedCar();
+    void createMeshes(CarGeometry&& geometry);
     
     /**
      * Create a wheel mesh at the given position.
@@ -4,8 +4,13 @@
  * =============================================================================
  * Implements simple collision detection for the car showroom:
  * - AABB (Axis-Aligned Bounding Box) collision
+ * - OBB (Oriented Bounding Box) collision using the separating axis test
  * - Sphere collision
+ * - Frustum planes for view culling
  * - Ray casting for picking
+ * - Sort-and-sweep broadphase for moving bodies (car vs car)
+ * - Bounding volume hierarchy for batched raycasts against static boxes
+ * - Uniform spatial hash grid for proximity queries over many moving entries
  * 
  * Design Decision: Using simple collision primitives rather than mesh-based
  * collision. This is sufficient for keeping the car within showroom walls
@@ -14,7 +19,8 @@
  * AABB vs OBB:
  * - AABB: Faster but less accurate for rotated objects
  * - OBB (Oriented Bounding Box): More accurate but slower
- * We use AABB for walls and simplified car bounds.
+ * We use AABB for walls and the broadphase, and OBB for cars: a car turned
+ * 45 degrees would otherwise get a box almost 1.5x too wide.
  * =============================================================================
  */
 
@@ -22,6 +28,8 @@
 #define COLLISION_H
 
 #include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -73,6 +81,47 @@ struct AABB {
     AABB transformed(const glm::mat4& transform) const;
 };
 
+/**
+ * OBB - Oriented Bounding Box
+ * 
+ * A box with its own rotation: a center, three perpendicular unit axes,
+ * and the half-size along each axis. A point p is inside when, for every
+ * axis i, |dot(p - center, axes[i])| <= halfExtents[i].
+ */
+struct OBB {
+    glm::vec3 center;
+    glm::vec3 axes[3];      // Box local X, Y, Z in world space (unit length)
+    glm::vec3 halfExtents;  // Half-size along each local axis
+    
+    OBB();
+    
+    /**
+     * Create an OBB that matches an axis-aligned box.
+     */
+    static OBB fromAABB(const AABB& box);
+    
+    /**
+     * Create an OBB from a box in model space and a model matrix.
+     * Rotation and scale come from the matrix columns (no shear allowed).
+     */
+    static OBB fromTransform(const glm::mat4& transform, const AABB& localBox);
+    
+    /**
+     * Get the smallest AABB that contains this box.
+     */
+    AABB getEnclosingAABB() const;
+    
+    /**
+     * Get the farthest point of the box in a direction.
+     */
+    glm::vec3 getSupportPoint(const glm::vec3& direction) const;
+    
+    /**
+     * Check if a point is inside the box.
+     */
+    bool containsPoint(const glm::vec3& point) const;
+};
+
 /**
  * BoundingSphere - Spherical bounding volume.
  */
@@ -90,6 +139,26 @@ struct BoundingSphere {
     bool containsPoint(const glm::vec3& point) const;
 };
 
+/**
+ * Frustum - The six planes of a camera's view volume, for culling.
+ * Planes face inwards: a point p is inside when
+ * dot(plane.xyz, p) + plane.w >= 0 for all six.
+ */
+struct Frustum {
+    glm::vec4 planes[6];    // Left, right, bottom, top, near, far
+    
+    /**
+     * Extract the planes from a projection * view matrix, in world space.
+     */
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+    
+    /**
+     * Check if a sphere is at least partly inside (conservative near the
+     * corners, where a sphere outside two planes may still pass).
+     */
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+};
+
 /**
  * Ray - For ray casting and picking.
  */
@@ -133,6 +202,22 @@ namespace Collision {
      */
     CollisionResult testAABBvsAABBResponse(const AABB& a, const AABB& b);
     
+    /**
+     * Test OBB vs OBB intersection (separating axis test).
+     */
+    bool testOBBvsOBB(const OBB& a, const OBB& b);
+    
+    /**
+     * Test OBB vs OBB with collision response info.
+     * The normal points from 'b' towards 'a' (the direction to push 'a').
+     */
+    CollisionResult testOBBvsOBBResponse(const OBB& a, const OBB& b);
+    
+    /**
+     * Test OBB vs AABB with collision response info.
+     */
+    CollisionResult testOBBvsAABBResponse(const OBB& a, const AABB& b);
+    
     /**
      * Test sphere vs sphere intersection.
      */
@@ -176,6 +261,311 @@ namespace Collision {
     glm::vec3 resolveAABBCollision(const AABB& a, const AABB& b);
 }
 
+/**
+ * BroadPhasePair - Two dynamic bodies whose AABBs overlap.
+ * 
+ * The broadphase only says "these two might be touching"; a narrowphase
+ * test decides whether they really collide and how to separate them.
+ */
+struct BroadPhasePair {
+    size_t a;   // Proxy ID of the first body (always the smaller ID)
+    size_t b;   // Proxy ID of the second body
+};
+
+/**
+ * SweepAndPrune - Sort-and-sweep broadphase for moving bodies.
+ * 
+ * Each body's AABB contributes two endpoints (min and max) on one axis.
+ * The endpoints are kept in a sorted list; sweeping that list from left to
+ * right with an "active" set yields every pair whose intervals overlap on
+ * that axis, and a cheap test on the other two axes filters the rest.
+ * 
+ * Frame-to-frame coherence: bodies move only a little between physics
+ * steps, so last step's order is almost sorted. Insertion sort on an almost
+ * sorted list runs in close to O(n), which keeps pair finding near linear
+ * even with hundreds of moving cars.
+ * 
+ * The sweep axis is chosen as the one along which body centers are spread
+ * out the most (fewest overlapping intervals). Changing axis needs a full
+ * re-sort, so it only happens when another axis is clearly better.
+ */
+class SweepAndPrune {
+public:
+    SweepAndPrune();
+    
+    /**
+     * Add a body to the broadphase.
+     * @return Proxy ID used to update or remove the body
+     */
+    size_t addProxy(const AABB& box);
+    
+    /**
+     * Update a body's bounds after it moved.
+     */
+    void updateProxy(size_t proxyId, const AABB& box);
+    
+    /**
+     * Remove a body. Its proxy ID may be reused by a later addProxy().
+     */
+    void removeProxy(size_t proxyId);
+    
+    /**
+     * Get the current bounds of a body.
+     */
+    const AABB& getProxyBounds(size_t proxyId) const { return m_boxes[proxyId]; }
+    
+    /**
+     * Get the number of live bodies.
+     */
+    size_t getProxyCount() const { return m_endpoints.size() / 2; }
+    
+    /**
+     * Re-sort the endpoints and collect all overlapping pairs.
+     * The returned reference stays valid until the next call.
+     */
+    const std::vector<BroadPhasePair>& findOverlappingPairs();
+    
+    /**
+     * Get the axis currently used for sorting (0 = X, 1 = Y, 2 = Z).
+     */
+    int getSortAxis() const { return m_sortAxis; }
+    
+    /**
+     * Remove all bodies.
+     */
+    void clear();
+    
+private:
+    /**
+     * Endpoint - One end of a body's interval on the sort axis.
+     */
+    struct Endpoint {
+        float value;        // Cached coordinate on the sort axis
+        uint32_t proxy;     // Owning proxy ID
+        uint32_t isMax;     // 0 = interval start, 1 = interval end
+    };
+    
+    std::vector<AABB> m_boxes;              // Bounds, indexed by proxy ID
+    std::vector<uint8_t> m_alive;           // Whether a proxy ID is in use
+    std::vector<size_t> m_freeIds;          // Recycled proxy IDs
+    std::vector<Endpoint> m_endpoints;      // Sorted along m_sortAxis
+    std::vector<BroadPhasePair> m_pairs;    // Output of the last sweep
+    std::vector<uint32_t> m_active;         // Sweep scratch: open intervals
+    std::vector<uint32_t> m_activeSlot;     // Position of a proxy in m_active
+    int m_sortAxis;
+    
+    /**
+     * Pick the axis with the largest spread of body centers.
+     * Re-sorts from scratch if the axis changes.
+     */
+    void chooseSortAxis();
+    
+    /**
+     * Refresh cached endpoint values and restore sorted order.
+     */
+    void sortEndpoints();
+};
+
+/**
+ * StaticAABBTree - Bounding volume hierarchy (BVH) over static boxes.
+ * 
+ * Built once after the static colliders are added. Every node stores a box
+ * around everything below it, so a ray that misses a node skips its whole
+ * subtree; a cast visits roughly log2(N) nodes instead of all N boxes.
+ * 
+ * Rays are traced in packets of RAY_PACKET_SIZE. The rays of a packet walk
+ * the tree together, and each node or box test is a small loop over the
+ * packet's lanes that the compiler turns into SIMD slab tests. This works
+ * best when the rays of a packet point the same way, so batches are first
+ * grouped by direction before being cut into packets.
+ * 
+ * Coherent short rays (picking, camera-grid probes) are the fast case. Random
+ * rays that cross the whole scene gain little from packets: each needs a long
+ * chain of dependent node and box loads, so they run far slower.
+ */
+class StaticAABBTree {
+public:
+    static constexpr int RAY_PACKET_SIZE = 4;   // Rays traced together
+    static constexpr int MAX_LEAF_SIZE = 4;     // Boxes per leaf node
+    
+    StaticAABBTree() = default;
+    
+    /**
+     * Build the tree. The boxes are copied; indices reported by raycasts
+     * are positions in this vector.
+     */
+    void build(const std::vector<AABB>& boxes);
+    
+    /**
+     * Cast many rays and find the first hit of each.
+     * Results are written in the same order as the input rays.
+     * @param rays Input rays
+     * @param count Number of rays
+     * @param maxDistance Rays stop at this distance
+     * @param outHitT Output: distance to the hit, or maxDistance on a miss
+     * @param outHitIndex Output: index of the hit box, or -1 on a miss
+     * @return Number of rays that hit something
+     */
+    size_t raycastBatch(const Ray* rays, size_t count, float maxDistance,
+                        float* outHitT, int32_t* outHitIndex) const;
+    
+    /**
+     * Get the number of tree nodes (0 if not built).
+     */
+    size_t getNodeCount() const { return m_nodes.size(); }
+    
+    /**
+     * Remove the tree.
+     */
+    void clear();
+    
+private:
+    /**
+     * Node - 32 bytes, two nodes per cache line.
+     * Leaf (count > 0): boxes [leftOrFirst, leftOrFirst + count).
+     * Inner (count == 0): children at leftOrFirst and leftOrFirst + 1.
+     */
+    struct Node {
+        glm::vec3 boundsMin;
+        uint32_t leftOrFirst;
+        glm::vec3 boundsMax;
+        uint32_t count;
+    };
+    
+    struct RayPacket;
+    
+    std::vector<Node> m_nodes;
+    std::vector<AABB> m_boxes;              // Boxes reordered to leaf order
+    std::vector<int32_t> m_boxIndices;      // Leaf order -> original index
+    
+    /**
+     * Split boxes [first, first + count) and create their subtree.
+     * @param depth Depth of the node (the root is 0)
+     */
+    void buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, uint32_t depth,
+                   std::vector<glm::vec3>& centers);
+    
+    /**
+     * Walk the tree once for all rays in a packet.
+     */
+    void tracePacket(RayPacket& packet) const;
+};
+
+/**
+ * SpatialHashGrid - Uniform grid for proximity queries over many entries.
+ * 
+ * The ground plane (X/Z) is divided into square cells of getCellSize().
+ * Cells are hashed into a fixed-size bucket table, so the grid covers an
+ * unbounded area (a parking lot hundreds of meters across) with memory
+ * proportional to the number of entries, not the area.
+ * 
+ * When to use it instead of a tree: entries that are roughly evenly spread
+ * and all move every step. Rebuilding the grid from scratch is a linear
+ * counting sort, cheaper than keeping a tree balanced.
+ * 
+ * Layout: after rebuild() the entries of each bucket are contiguous, and
+ * positions and radii are stored as separate arrays ("structure of
+ * arrays"), so a query scans tightly packed floats. Large rebuilds run
+ * the counting sort in parallel: each thread counts and then scatters
+ * its own slice of the entries.
+ * 
+ * Unrelated cells can share a bucket; every query checks real distances,
+ * so this only costs a few extra tests.
+ */
+class SpatialHashGrid {
+public:
+    static constexpr uint32_t DEFAULT_BUCKET_COUNT = 4096;     // Power of two
+    static constexpr size_t PARALLEL_REBUILD_THRESHOLD = 8192;  // Entries before threads help
+    
+    /**
+     * Create an empty grid.
+     * @param cellSize Cell edge length; about the diameter of a typical entry works well
+     * @param bucketCount Hash table size, rounded up to a power of two
+     */
+    explicit SpatialHashGrid(float cellSize = 4.0f, uint32_t bucketCount = DEFAULT_BUCKET_COUNT);
+    
+    /**
+     * Replace all entries. Entry IDs are the array indices.
+     * @param positions Entry centers
+     * @param radii Entry radii, or nullptr for points
+     * @param count Number of entries
+     */
+    void rebuild(const glm::vec3* positions, const float* radii, size_t count);
+    
+    /**
+     * Find entries whose sphere overlaps a query sphere.
+     * @param outIds Output: IDs of overlapping entries (appended, any order)
+     * @return Number of IDs appended
+     */
+    size_t queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& outIds) const;
+    
+    /**
+     * Find the entry whose center is closest to a point.
+     * @param maxDistance Ignore entries further than this (infinity = no limit)
+     * @param outDistance Output (optional): distance to the entry
+     * @return Entry ID, or -1 if none is within maxDistance
+     */
+    int32_t findNearest(const glm::vec3& point, float maxDistance,
+                        float* outDistance = nullptr) const;
+    
+    /**
+     * Find all pairs of entries whose spheres overlap (collision candidates).
+     * @param outPairs Output: pairs of entry IDs (cleared first)
+     */
+    void findPairs(std::vector<BroadPhasePair>& outPairs) const;
+    
+    /**
+     * Get properties.
+     */
+    size_t getCount() const { return m_ids.size(); }
+    float getCellSize() const { return m_cellSize; }
+    
+    /**
+     * Remove all entries.
+     */
+    void clear();
+    
+private:
+    float m_cellSize;
+    float m_inverseCellSize;
+    uint32_t m_bucketMask;                  // Bucket count - 1
+    float m_maxRadius;                      // Largest entry radius
+    
+    // Entries sorted by bucket (structure of arrays)
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<float> m_radius;
+    std::vector<uint32_t> m_ids;            // Sorted position -> entry ID
+    std::vector<uint32_t> m_bucketStart;    // Bucket b holds [start[b], start[b + 1])
+    
+    // Rebuild scratch, kept to avoid reallocating every step
+    std::vector<uint32_t> m_keys;           // Bucket of each input entry
+    std::vector<uint32_t> m_sliceCounts;    // Per-slice bucket histograms
+    
+    /**
+     * Get the cell coordinate containing a world coordinate.
+     */
+    int32_t cellOf(float coordinate) const {
+        return static_cast<int32_t>(std::floor(coordinate * m_inverseCellSize));
+    }
+    
+    /**
+     * Hash a cell into a bucket index.
+     */
+    uint32_t bucketOf(int32_t cellX, int32_t cellZ) const {
+        return ((static_cast<uint32_t>(cellX) * 73856093u) ^
+                (static_cast<uint32_t>(cellZ) * 19349663u)) & m_bucketMask;
+    }
+    
+    /**
+     * Collect the distinct buckets of a rectangle of cells.
+     * @return False if the rectangle touches every bucket anyway
+     */
+    bool gatherBuckets(int32_t minX, int32_t minZ, int32_t maxX, int32_t maxZ,
+                       std::vector<uint32_t>& outBuckets) const;
+};
+
 /**
  * CollisionWorld - Manages all collision objects in the scene.
  */
@@ -195,10 +585,17 @@ public:
      */
     CollisionResult testAgainstStatic(const AABB& movingBox) const;
     
+    /**
+     * Test a moving OBB against all static colliders.
+     * @return Collision result with deepest penetration
+     */
+    CollisionResult testAgainstStatic(const OBB& movingBox) const;
+    
     /**
      * Resolve collisions and return corrected position.
      */
     glm::vec3 resolveCollisions(const AABB& movingBox, const glm::vec3& currentPos) const;
+    glm::vec3 resolveCollisions(const OBB& movingBox, const glm::vec3& currentPos) const;
     
     /**
      * Cast a ray and find the first hit.
@@ -206,6 +603,50 @@ public:
      */
     bool raycast(const Ray& ray, float maxDistance, float& hitT, size_t& hitIndex) const;
     
+    /**
+     * Cast many rays against the static colliders in one call.
+     * Use this for anything that casts more than a handful of rays per
+     * frame (hover tests, camera occlusion, sensors, baking).
+     * @param outHitT Output: distance to the hit, or maxDistance on a miss
+     * @param outHitIndex Output: index of the hit collider, or -1 on a miss
+     * @return Number of rays that hit something
+     */
+    size_t raycastBatch(const Ray* rays, size_t count, float maxDistance,
+                        float* outHitT, int32_t* outHitIndex) const;
+    
+    /**
+     * Rebuild the static tree used by raycastBatch().
+     * Call after adding static colliders; until then batches build a
+     * temporary tree on every call.
+     */
+    void buildStaticTree();
+    
+    // =========================================================================
+    // Dynamic Bodies
+    // =========================================================================
+    
+    /**
+     * Add a moving AABB collider (e.g., a car).
+     * @return Proxy ID of the added body
+     */
+    size_t addDynamicAABB(const AABB& box);
+    
+    /**
+     * Update a moving collider's bounds.
+     */
+    void updateDynamicAABB(size_t proxyId, const AABB& box);
+    
+    /**
+     * Remove a moving collider.
+     */
+    void removeDynamicAABB(size_t proxyId);
+    
+    /**
+     * Find all pairs of moving colliders whose AABBs overlap.
+     * Results are candidates for a narrowphase test.
+     */
+    const std::vector<BroadPhasePair>& findDynamicPairs();
+    
     /**
      * Clear all colliders.
      */
@@ -213,6 +654,9 @@ public:
     
 private:
     std::vector<AABB> m_staticBoxes;
+    StaticAABBTree m_staticTree;
+    bool m_staticTreeDirty = true;      // Static boxes changed since last build
+    SweepAndPrune m_broadPhase;
 };
 
 #endif // COLLISION_H
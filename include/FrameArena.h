@@ -0,0 +1,90 @@
+/**
+ * =============================================================================
+ * FrameArena.h - Per-Frame Linear (Bump) Allocator
+ * =============================================================================
+ * Memory for data that only lives for one frame. Allocating is a pointer
+ * bump inside one preallocated block, freeing does nothing, and reset()
+ * rewinds the whole block at the start of the next frame.
+ * 
+ * It is a std::pmr::memory_resource, so standard containers can use it:
+ * 
+ *   std::pmr::vector<DrawItem> items(&arena);
+ * 
+ * Rules:
+ * - Everything allocated from the arena must be destroyed (or dropped)
+ *   before reset(). The Renderer rebuilds its frame containers first.
+ * - Single-threaded: use it only from the thread that resets it.
+ * - If a frame needs more than the block holds, the rest comes from the
+ *   upstream resource (the heap) and is counted in getOverflowCount(), so
+ *   an undersized arena shows up instead of silently falling back.
+ * =============================================================================
+ */
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * FrameArena class - Bump allocator rewound once per frame.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+    
+    /**
+     * Allocate the block.
+     * @param capacity Block size in bytes
+     * @param upstream Used when the block is full
+     */
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    
+    ~FrameArena() override = default;
+    
+    // Disable copying
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    /**
+     * Rewind to the start of the block. Nothing allocated from the arena
+     * may be used afterwards.
+     */
+    void reset();
+    
+    /**
+     * Get the block size, the bytes used this frame, and the most ever
+     * used in one frame (for sizing the block).
+     */
+    size_t getCapacity() const { return m_capacity; }
+    size_t getUsed() const { return m_offset; }
+    size_t getPeakUsed() const { return m_peak; }
+    
+    /**
+     * Get how many allocations did not fit and went to the upstream
+     * resource, over the arena's lifetime.
+     */
+    size_t getOverflowCount() const { return m_overflowCount; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    std::unique_ptr<std::byte[]> m_buffer;
+    size_t m_capacity;
+    size_t m_offset;                        // Next free byte
+    size_t m_peak;
+    size_t m_overflowCount;
+    std::pmr::memory_resource* m_upstream;
+    
+    /**
+     * Check whether a pointer came from the block (not from upstream).
+     */
+    bool owns(const void* pointer) const;
+};
+
+#endif // FRAME_ARENA_H
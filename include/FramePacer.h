@@ -0,0 +1,170 @@
+/**
+ * =============================================================================
+ * FramePacer.h - Frame Pacing and Frame-Time Statistics
+ * =============================================================================
+ * Decides when the next frame may start. Four modes:
+ * - VSYNC: swap interval 1. The swap blocks until the display refresh.
+ *   No tearing, but a 144 Hz monitor means 144 frames of work a second.
+ * - ADAPTIVE_VSYNC: swap interval -1 (swap control tear). Like vsync,
+ *   except a late frame is shown right away (with a tear) instead of
+ *   waiting a whole extra refresh. Falls back to VSYNC when the driver
+ *   lacks the extension.
+ * - UNCAPPED: swap interval 0 and no waiting. For benchmarks only.
+ * - LIMITED: swap interval 0 and a CPU frame limiter at a target rate.
+ * 
+ * The limiter keeps a deadline that advances by one period per frame, so
+ * small oversleeps don't add up into a lower rate. It sleeps while the
+ * deadline is far away and spins (yielding) for the last couple of
+ * milliseconds, because OS sleeps can overshoot by a millisecond or more.
+ * 
+ * GPU queue throttling: the driver may let the CPU run several frames
+ * ahead of the GPU, and each queued frame adds a frame of latency. With
+ * setMaxQueuedFrames(n) a fence is inserted after every swap, and the
+ * CPU waits for the fence from n frames ago before starting a new frame.
+ * =============================================================================
+ */
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <array>
+#include <cstddef>
+
+class Window;
+
+/**
+ * PacingMode - How frames are paced (see file header).
+ */
+enum class PacingMode {
+    VSYNC,
+    ADAPTIVE_VSYNC,
+    UNCAPPED,
+    LIMITED
+};
+
+/**
+ * FrameTimeStats - Frame times over the recent history, in milliseconds.
+ */
+struct FrameTimeStats {
+    double average = 0.0;
+    double standardDeviation = 0.0;   // Jitter: 0 means perfectly even frames
+    double minimum = 0.0;
+    double maximum = 0.0;
+    size_t frameCount = 0;            // Frames the numbers are based on
+};
+
+/**
+ * FramePacer class - Applies a pacing mode and measures frame times.
+ * 
+ * Usage (once per frame):
+ *   render();
+ *   window.swapBuffers();
+ *   pacer.endFrame();     // Throttle and limit here
+ *   window.pollEvents();  // Then sample input as late as possible
+ */
+class FramePacer {
+public:
+    static constexpr double DEFAULT_TARGET_RATE = 60.0;
+    static constexpr size_t HISTORY_SIZE = 240;          // Frames kept for statistics
+    static constexpr size_t MAX_QUEUED_FRAMES = 4;       // Fence ring size
+    
+    /**
+     * Create the pacer and apply VSYNC.
+     * @param window Window whose swap interval is controlled (must outlive the pacer)
+     */
+    explicit FramePacer(Window& window);
+    
+    /**
+     * Destructor - Deletes pending fences.
+     */
+    ~FramePacer();
+    
+    // Disable copying
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+    
+    /**
+     * Select a pacing mode.
+     * ADAPTIVE_VSYNC becomes VSYNC if the driver doesn't support it.
+     */
+    void setMode(PacingMode mode);
+    PacingMode getMode() const { return m_mode; }
+    
+    /**
+     * Switch to the next mode (VSYNC -> ADAPTIVE -> UNCAPPED -> LIMITED).
+     */
+    void cycleMode();
+    
+    /**
+     * Get the mode cycleMode() would switch to from the given one,
+     * skipping ADAPTIVE_VSYNC when it isn't supported.
+     */
+    PacingMode getNextMode(PacingMode mode) const;
+    
+    /**
+     * Set the frame rate used by LIMITED mode.
+     */
+    void setTargetFrameRate(double framesPerSecond);
+    double getTargetFrameRate() const { return 1.0 / m_targetPeriod; }
+    
+    /**
+     * Limit how many frames the GPU may lag behind the CPU.
+     * @param frames 1..MAX_QUEUED_FRAMES, or 0 to let the driver decide
+     */
+    void setMaxQueuedFrames(size_t frames);
+    size_t getMaxQueuedFrames() const { return m_maxQueuedFrames; }
+    
+    /**
+     * Call right after swapping buffers. Waits as the mode requires and
+     * records the frame time.
+     */
+    void endFrame();
+    
+    /**
+     * Get frame-time statistics over the last HISTORY_SIZE frames.
+     */
+    FrameTimeStats getStats() const;
+    
+    /**
+     * Get a mode's display name.
+     */
+    static const char* getModeName(PacingMode mode);
+
+private:
+    Window& m_window;
+    PacingMode m_mode;
+    bool m_adaptiveSupported;
+    
+    // Limiter
+    double m_targetPeriod;          // Seconds per frame in LIMITED mode
+    double m_nextDeadline;          // Earliest start of the next frame
+    
+    // GPU queue throttling (fences are GLsync, kept opaque)
+    size_t m_maxQueuedFrames;
+    std::array<void*, MAX_QUEUED_FRAMES> m_fences;
+    size_t m_fenceIndex;
+    
+    // Frame-time history (ring buffer, seconds)
+    std::array<double, HISTORY_SIZE> m_frameTimes;
+    size_t m_frameTimeCount;
+    size_t m_frameTimeIndex;
+    double m_lastFrameEnd;
+    
+    /**
+     * Wait for the fence from m_maxQueuedFrames frames ago, then insert
+     * this frame's fence.
+     */
+    void throttleGpuQueue();
+    
+    /**
+     * Sleep, then spin, until the limiter deadline.
+     */
+    void waitForDeadline();
+    
+    /**
+     * Delete all pending fences.
+     */
+    void clearFences();
+};
+
+#endif // FRAME_PACER_H
@@ -0,0 +1,257 @@
+/**
+ * =============================================================================
+ * FramePacket.h - Self-Contained Frame Description for the Render Thread
+ * =============================================================================
+ * A FramePacket holds everything needed to draw one frame: camera
+ * matrices, lights, a flat list of draw items and text labels. Every
+ * draw item holds a copy of its matrix and material. Once the main
+ * thread has published a packet, the render thread never looks at scene
+ * objects again, so the simulation can move cars while the previous
+ * frame is still being drawn.
+ * 
+ * Only the Mesh pointers are shared. Meshes are immutable GPU resources
+ * that outlive the render thread.
+ * 
+ * A packet can describe several views of the scene (e.g. the kiosk's
+ * 2x2 layout). The draw lists are built and culled once for all of
+ * them: each item carries a bit per view it is visible in, and the
+ * render thread draws the same lists into each view's viewport.
+ * 
+ * FrameQueue - Triple-buffered handoff between the two threads:
+ * 
+ *   slot 0: being rendered      (render thread)
+ *   slot 1: published, waiting  (queued)
+ *   slot 2: being filled        (main thread)
+ * 
+ * The threads share two atomic counters (published / released), so
+ * neither side takes a lock on the normal path. A side only blocks when
+ * it has to: the render thread when no packet is ready, and the main
+ * thread when it is more than maxQueuedFrames packets ahead of the GPU
+ * side (this limit is the latency bound).
+ * =============================================================================
+ */
+
+#ifndef FRAME_PACKET_H
+#define FRAME_PACKET_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Light.h"
+#include "Material.h"
+#include "FramePacer.h"
+#include "AmbientOcclusion.h"
+#include "AntiAliasing.h"
+
+class Mesh;
+
+/**
+ * DrawItem - One mesh to draw, with its own copy of per-draw data.
+ */
+struct DrawItem {
+    const Mesh* mesh;
+    glm::mat4 model;        // World matrix (normal matrix is derived on the render thread)
+    glm::mat4 previousModel;    // World matrix of the previous frame (for motion vectors)
+    Material material;
+    uint32_t pickId;        // ObjectPicker::encodeId(object, part); object 0 = not pickable
+    float sortDepth;        // Squared distance to the camera (for transparent sorting)
+    glm::vec4 bounds;       // World bounding sphere: center in xyz, radius in w
+    uint32_t viewMask;      // Bit i: inside view i's frustum (see FramePacket::cullItems)
+    uint8_t pointLightMask; // Bit i: pointLights[i] reaches the bounds (see FramePacket::assignLights)
+    uint8_t spotLightMask;  // Bit i: spotLights[i] reaches the bounds
+};
+
+/**
+ * RenderView - One camera drawn into a rectangle of the framebuffer.
+ */
+struct RenderView {
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);     // For the viewport's aspect ratio
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    
+    // Viewport, in pixels from the bottom-left
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    
+    /**
+     * Get a projection that puts this view's image into its viewport
+     * while the viewport covers the whole framebuffer (labels, picking).
+     */
+    glm::mat4 getScreenProjection(int framebufferWidth, int framebufferHeight) const;
+};
+
+/**
+ * TextLabel - Text drawn over a point in the world (e.g. a price tag).
+ * The text is stored inline so filling labels never allocates.
+ */
+struct TextLabel {
+    static constexpr size_t MAX_LENGTH = 32;
+    
+    glm::vec3 position;     // World point the label sits on
+    glm::vec4 color;
+    char text[MAX_LENGTH];  // Null-terminated
+};
+
+/**
+ * FramePacket - Everything the render thread needs for one frame.
+ */
+struct FramePacket {
+    uint64_t frameNumber = 0;
+    
+    // Framebuffer size this frame was built for
+    int width = 0;
+    int height = 0;
+    
+    // Camera
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);   // Jitter included
+    glm::vec2 jitter = glm::vec2(0.0f);         // NDC offset in projection (see AntiAliasing)
+    glm::vec3 cameraPosition = glm::vec3(0.0f);
+    
+    // Several cameras at once, each into its own viewport from the same
+    // draw lists (at most MAX_VIEWS). Empty: one full-screen view from
+    // the camera above.
+    static constexpr size_t MAX_VIEWS = 4;
+    std::vector<RenderView> views;
+    
+    // Lights
+    DirectionalLight sunLight;
+    std::vector<PointLight> pointLights;
+    std::vector<SpotLight> spotLights;
+    
+    // Reflection probe (see ReflectionProbe): captured from pick object 0
+    // items, again whenever staticVersion changes
+    glm::vec3 probePosition = glm::vec3(0.0f);
+    uint32_t staticVersion = 0;     // Changes with static geometry or lighting
+    
+    // Geometry (transparent items sorted back-to-front)
+    std::vector<DrawItem> opaqueItems;
+    std::vector<DrawItem> transparentItems;
+    
+    // Screen-space labels (drawn by TextRenderer, in one batch)
+    std::vector<TextLabel> labels;
+    
+    // Statistics from the main thread (see RenderStats)
+    uint32_t objectsTotal = 0;      // Models considered for this frame
+    uint32_t objectsHidden = 0;     // Skipped as invisible
+    uint32_t itemsCulled = 0;       // Draw items outside every view (see cullItems)
+    double cpuMainMs = 0.0;         // Main thread time of the previous frame
+    
+    // GPU pick under the cursor (see ObjectPicker)
+    bool pickRequested = false;
+    int pickX = 0;              // Pixel, bottom-left origin
+    int pickY = 0;
+    
+    // Presentation
+    PacingMode pacingMode = PacingMode::VSYNC;
+    AmbientOcclusionQuality ambientOcclusion = AmbientOcclusionQuality::HIGH;
+    AntiAliasingMode antiAliasing = AntiAliasingMode::TAA;
+    bool showStats = false;         // Draw the StatsOverlay
+    
+    /**
+     * Set every draw item's viewMask from the views' frusta (or the
+     * camera's, without views), once for all views. Call after the
+     * items and views are filled. Items outside every view keep a zero
+     * mask and are skipped by all passes but the reflection probe.
+     */
+    void cullItems();
+    
+    /**
+     * Set every draw item's light masks to the point and spot lights
+     * that reach its bounds, so the main shader only loops over those.
+     * Call after the items and lights are filled. Lightmapped items get
+     * none, since their dynamic lighting is never computed.
+     */
+    void assignLights();
+    
+    /**
+     * Reset for reuse. Vectors keep their capacity, so a packet stops
+     * allocating after the first few frames.
+     */
+    void clear();
+};
+
+/**
+ * FrameQueue class - Lock-free single-producer/single-consumer packet handoff.
+ * 
+ * Producer (main thread):        Consumer (render thread):
+ *   FramePacket* p = q.beginWrite();   FramePacket* p = q.beginRead();
+ *   ...fill p...                       ...draw p...
+ *   q.publish();                       q.endRead();
+ */
+class FrameQueue {
+public:
+    static constexpr size_t SLOT_COUNT = 3;
+    
+    FrameQueue() = default;
+    
+    // Disable copying
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator=(const FrameQueue&) = delete;
+    
+    /**
+     * Limit how many published packets may be unfinished while the main
+     * thread fills the next one (the one being drawn included).
+     * @param frames 1 = double buffering (lowest latency),
+     *               SLOT_COUNT - 1 = triple buffering (default)
+     */
+    void setMaxQueuedFrames(size_t frames);
+    size_t getMaxQueuedFrames() const { return m_maxQueued.load(); }
+    
+    /**
+     * Get the packet to fill next. Blocks only while the queue is at
+     * its depth limit.
+     * @return The packet, or nullptr once the queue is closed
+     */
+    FramePacket* beginWrite();
+    
+    /**
+     * Hand the packet from beginWrite() to the consumer.
+     */
+    void publish();
+    
+    /**
+     * Get the oldest published packet, waiting if there is none.
+     * @return The packet, or nullptr once the queue is closed
+     */
+    FramePacket* beginRead();
+    
+    /**
+     * Return the packet from beginRead() to the producer.
+     */
+    void endRead();
+    
+    /**
+     * Wake and release both sides for shutdown.
+     */
+    void close();
+    bool isClosed() const { return m_closed.load(); }
+
+private:
+    std::array<FramePacket, SLOT_COUNT> m_slots;
+    
+    alignas(64) std::atomic<uint64_t> m_published{0};   // Written by the producer
+    alignas(64) std::atomic<uint64_t> m_released{0};    // Written by the consumer
+    std::atomic<size_t> m_maxQueued{SLOT_COUNT - 1};
+    std::atomic<bool> m_closed{false};
+    
+    // Slow path only: a side that must block sets its flag and sleeps here
+    std::mutex m_waitMutex;
+    std::condition_variable m_producerCondition;
+    std::condition_variable m_consumerCondition;
+    std::atomic<bool> m_producerWaiting{false};
+    std::atomic<bool> m_consumerWaiting{false};
+    
+    bool canWrite() const;
+    bool canRead() const;
+};
+
+#endif // FRAME_PACKET_H
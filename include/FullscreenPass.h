@@ -0,0 +1,65 @@
+/**
+ * =============================================================================
+ * FullscreenPass.h - Shared Fullscreen Triangle for Screen-Space Passes
+ * =============================================================================
+ * Screen-space passes (ambient occlusion, anti-aliasing resolves, reflection
+ * prefiltering) run a fragment shader once per pixel of the viewport. They
+ * all draw the same geometry: one triangle with corners (-1,-1), (3,-1) and
+ * (-1,3), which covers the viewport without the diagonal seam of a quad.
+ * 
+ * The vertex shader builds the corners from gl_VertexID, so the triangle
+ * needs no vertex buffer. Core profile draws still need a bound vertex
+ * array object, so each pass owns an empty one.
+ * 
+ * Usage:
+ *   Shader shader(FullscreenPass::VERTEX_SHADER_SOURCE, fragmentSource, false);
+ *   ...
+ *   m_fullscreen.bind();
+ *   shader.use();
+ *   FullscreenPass::draw();
+ *   glBindVertexArray(0);
+ * =============================================================================
+ */
+
+#ifndef FULLSCREEN_PASS_H
+#define FULLSCREEN_PASS_H
+
+/**
+ * FullscreenPass class - Empty vertex array for the fullscreen triangle.
+ */
+class FullscreenPass {
+public:
+    /**
+     * Vertex shader for fullscreen fragment shaders (no inputs or outputs).
+     */
+    static const char* const VERTEX_SHADER_SOURCE;
+    
+    /**
+     * Create the empty vertex array. Requires a current GL context.
+     */
+    FullscreenPass();
+    
+    /**
+     * Destructor - Frees the vertex array (call with the context current).
+     */
+    ~FullscreenPass();
+    
+    // Disable copying
+    FullscreenPass(const FullscreenPass&) = delete;
+    FullscreenPass& operator=(const FullscreenPass&) = delete;
+    
+    /**
+     * Bind the empty vertex array for draw().
+     */
+    void bind() const;
+    
+    /**
+     * Draw the triangle with the current program and framebuffer.
+     */
+    static void draw();
+
+private:
+    unsigned int m_emptyVAO;
+};
+
+#endif // FULLSCREEN_PASS_H
@@ -0,0 +1,55 @@
+/**
+ * =============================================================================
+ * GpuDeletionQueue.h - Deferred Deletion of OpenGL Objects
+ * =============================================================================
+ * A GL object may only be deleted on a thread with a GL context current, and
+ * vertex array objects only in the context that created them. Meshes are
+ * built on the asset loader thread, drawn on the render thread and destroyed
+ * wherever their owner lets go of them (usually the main thread, which holds
+ * no context while the render thread runs).
+ * 
+ * So destructors never call glDelete* directly. They queue the names here,
+ * and the render thread deletes them at the start of each frame.
+ * 
+ * Usage:
+ *   GpuDeletionQueue::deleteBuffer(m_VBO);     // From any thread
+ *   GpuDeletionQueue::flush();                 // Render context current
+ * =============================================================================
+ */
+
+#ifndef GPU_DELETION_QUEUE_H
+#define GPU_DELETION_QUEUE_H
+
+#include <cstddef>
+
+namespace GpuDeletionQueue {
+    /**
+     * Queue a vertex array object for deletion. VAOs are not shared
+     * between contexts, so these must be flushed in the drawing context.
+     */
+    void deleteVertexArray(unsigned int id);
+    
+    /**
+     * Queue a buffer object for deletion (shared between contexts).
+     */
+    void deleteBuffer(unsigned int id);
+    
+    /**
+     * Queue a texture for deletion (shared between contexts).
+     */
+    void deleteTexture(unsigned int id);
+    
+    /**
+     * Delete everything queued so far.
+     * Call with the render context current (RenderThread does every frame,
+     * Application once more during shutdown).
+     */
+    void flush();
+    
+    /**
+     * Get the number of objects waiting for deletion.
+     */
+    size_t getPendingCount();
+}
+
+#endif // GPU_DELETION_QUEUE_H
@@ -0,0 +1,79 @@
+/**
+ * =============================================================================
+ * GpuTimer.h - Non-Blocking GPU Frame Timing
+ * =============================================================================
+ * Measures how long the GPU spends on a frame with a pair of GL_TIMESTAMP
+ * queries written at the start and end of the frame's commands.
+ * 
+ * The GPU runs a few frames behind the CPU, so results are read back
+ * several frames later. Each frame uses its own pair from a small ring,
+ * and a pair is only read once GL reports its result available: reading
+ * a query early would make the CPU wait for the GPU. If every pair is
+ * still in flight, that frame is simply not measured.
+ * =============================================================================
+ */
+
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <array>
+#include <cstddef>
+
+/**
+ * GpuTimer class - Times frames on the GPU without stalling.
+ * 
+ * Usage (render thread, once per frame):
+ *   timer.beginFrame();
+ *   ...draw...
+ *   timer.endFrame();
+ *   double ms = timer.getLastTimeMs();    // Some earlier frame
+ */
+class GpuTimer {
+public:
+    static constexpr size_t SLOT_COUNT = 4;     // Frames that may be in flight
+    
+    /**
+     * Create the queries. Requires a current GL context.
+     */
+    GpuTimer();
+    
+    /**
+     * Destructor - Deletes the queries (call with the context current).
+     */
+    ~GpuTimer();
+    
+    // Disable copying
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+    
+    /**
+     * Collect finished results and write this frame's start timestamp.
+     */
+    void beginFrame();
+    
+    /**
+     * Write this frame's end timestamp.
+     */
+    void endFrame();
+    
+    /**
+     * Get the GPU time of the most recently finished frame, in milliseconds
+     * (0 until the first result arrives).
+     */
+    double getLastTimeMs() const { return m_lastTimeMs; }
+
+private:
+    std::array<unsigned int, SLOT_COUNT> m_beginQueries;
+    std::array<unsigned int, SLOT_COUNT> m_endQueries;
+    std::array<bool, SLOT_COUNT> m_pending;     // Written, result not read yet
+    size_t m_index;                             // Slot of the current frame
+    bool m_measuring;                           // This frame got a slot
+    double m_lastTimeMs;
+    
+    /**
+     * Read every pending slot whose result is available, oldest first.
+     */
+    void collectResults();
+};
+
+#endif // GPU_TIMER_H
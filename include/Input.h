@@ -21,14 +21,32 @@
  * Design Decision: Polling-based input with event callbacks. Polling is used
  * for continuous input (movement), while callbacks handle discrete events
  * (key press, mode switch).
+ * 
+ * Event Flow:
+ * - GLFW callbacks only push a timestamped InputEvent into a lock-free
+ *   ring; nothing else happens inside glfwPollEvents.
+ * - update() drains the ring once per frame: it applies key/button changes
+ *   to fixed-size state arrays (after saving last frame's state, so
+ *   "pressed this frame" works) and fires the registered callbacks.
+ * - lateLatch() runs in the render path just before the view matrix is
+ *   uploaded. It pumps events again and turns any mouse motion that
+ *   arrived since update() into camera rotation, so the frame shows the
+ *   newest look direction instead of one sampled a frame earlier.
  * =============================================================================
  */
 
 #ifndef INPUT_H
 #define INPUT_H
 
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
 class Window;
@@ -55,6 +73,81 @@ struct ActionBinding {
     bool requiresAlt;           // Requires Alt modifier
 };
 
+/**
+ * InputEvent - One raw GLFW event, stamped with the time it was received.
+ */
+struct InputEvent {
+    enum class Type : uint8_t {
+        KEY,            // code = key, action = GLFW_PRESS/RELEASE/REPEAT
+        MOUSE_BUTTON,   // code = button, action = GLFW_PRESS/RELEASE
+        CURSOR,         // x, y = cursor position
+        SCROLL          // x, y = scroll offset
+    };
+    
+    Type type;
+    int code;
+    int action;
+    int mods;
+    double x;
+    double y;
+    double time;        // Window::getTime() when GLFW delivered the event
+};
+
+/**
+ * InputEventQueue - Fixed-size single-producer/single-consumer ring.
+ * 
+ * The producer (GLFW callbacks) and the consumer (Input::update) only
+ * share two atomic indices, so pushing never blocks or allocates.
+ * Only cursor motion comes in fast enough to fill the ring (a high-rate
+ * mouse during a frame hitch), so cursor events are dropped once fewer
+ * than RESERVED_SLOTS slots are left; the cursor position is read from
+ * the window each frame anyway. Those last slots stay free for keys,
+ * buttons and scrolling, so a release is not lost and a key never
+ * sticks down. If the reserve fills up as well, those are dropped too.
+ */
+class InputEventQueue {
+public:
+    static constexpr size_t CAPACITY = 256;         // Must be a power of two
+    static constexpr size_t RESERVED_SLOTS = 64;    // Kept free of cursor events
+    
+    /**
+     * Add an event (producer side).
+     * @return False if the ring was too full and the event was dropped
+     */
+    bool push(const InputEvent& event) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t limit = (event.type == InputEvent::Type::CURSOR) ? CAPACITY - RESERVED_SLOTS : CAPACITY;
+        if (head - m_tail.load(std::memory_order_acquire) >= limit) {
+            return false;
+        }
+        m_events[head & (CAPACITY - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Take the oldest event (consumer side).
+     * @return False if the ring is empty
+     */
+    bool pop(InputEvent& event) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        event = m_events[tail & (CAPACITY - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    static_assert(RESERVED_SLOTS < CAPACITY, "Cursor events need some of the ring");
+    
+    std::array<InputEvent, CAPACITY> m_events;
+    alignas(64) std::atomic<size_t> m_head{0};  // Next slot to write
+    alignas(64) std::atomic<size_t> m_tail{0};  // Next slot to read
+};
+
 /**
  * Input class - Handles all input for the application.
  */
@@ -65,6 +158,10 @@ public:
     using MouseMoveCallback = std::function<void(double xpos, double ypos)>;
     using ScrollCallback = std::function<void(double offset)>;
     
+    // Sizes of the key and mouse button state arrays (all GLFW codes fit)
+    static constexpr int MAX_KEYS = 512;
+    static constexpr int MAX_MOUSE_BUTTONS = 8;
+    
     /**
      * Initialize input system for a window.
      */
@@ -72,9 +169,15 @@ public:
     
     /**
      * Update input state. Call once per frame before processing input.
+     * Drains the event ring and fires the registered callbacks.
      */
     void update();
     
+    /**
+     * Events drained by the last update(), oldest first.
+     */
+    const std::vector<InputEvent>& getFrameEvents() const { return m_frameEvents; }
+    
     // =========================================================================
     // Keyboard Input
     // =========================================================================
@@ -198,6 +301,14 @@ public:
      */
     void processCamera(Camera& camera, float deltaTime);
     
+    /**
+     * Apply mouse motion that arrived after update() to the camera.
+     * Call in the render path right before the view matrix is taken from
+     * the camera. Pumps window events, so key presses received here are
+     * queued for the next update().
+     */
+    void lateLatch(Camera& camera);
+    
     /**
      * Process input for car control.
      * @param car The car to control
@@ -208,19 +319,23 @@ public:
 private:
     Window& m_window;
     
-    // Keyboard state
-    std::unordered_map<int, KeyState> m_keyStates;
-    std::unordered_map<int, KeyState> m_previousKeyStates;
+    // Raw events from the GLFW callbacks, and the ones drained this frame
+    InputEventQueue m_events;
+    std::vector<InputEvent> m_frameEvents;
+    
+    // Keyboard state (bit set = key down), indexed by GLFW key code
+    std::bitset<MAX_KEYS> m_keysDown;
+    std::bitset<MAX_KEYS> m_previousKeysDown;
     
     // Mouse state
     glm::vec2 m_mousePosition;
-    glm::vec2 m_lastMousePosition;
+    glm::vec2 m_lastMousePosition;  // Position already applied to the camera
     glm::vec2 m_mouseDelta;
     bool m_firstMouse;
     
-    // Mouse buttons
-    std::unordered_map<int, KeyState> m_mouseButtonStates;
-    std::unordered_map<int, KeyState> m_previousMouseButtonStates;
+    // Mouse buttons, indexed by GLFW button code
+    std::bitset<MAX_MOUSE_BUTTONS> m_buttonsDown;
+    std::bitset<MAX_MOUSE_BUTTONS> m_previousButtonsDown;
     
     // Scroll
     float m_scrollOffset;
@@ -242,6 +357,11 @@ private:
      */
     void setupDefaultBindings();
     
+    /**
+     * Apply one drained event to the state and fire its callbacks.
+     */
+    void applyEvent(const InputEvent& event);
+    
     /**
      * Handle GLFW key callback.
      */
@@ -42,6 +42,33 @@
 
 class Shader;
 
+/**
+ * LightUniformNames - Full uniform names for one light struct in the
+ * shader (e.g., "pointLights[2].position").
+ * 
+ * Lights are applied every frame. Concatenating these names on each call
+ * cost a dozen heap allocations per light, so the renderer builds them
+ * once per light slot.
+ */
+struct LightUniformNames {
+    std::string enabled;
+    std::string position;
+    std::string direction;
+    std::string ambient;
+    std::string diffuse;
+    std::string specular;
+    std::string cutOff;
+    std::string outerCutOff;
+    std::string constant;
+    std::string linear;
+    std::string quadratic;
+    
+    /**
+     * @param prefix Base name (e.g., "dirLight" or "pointLights[0]")
+     */
+    explicit LightUniformNames(const std::string& prefix);
+};
+
 /**
  * Base Light class - Common properties for all light types.
  */
@@ -58,12 +85,23 @@ public:
     // Light state
     bool enabled;
     
+    // Attenuation at getRange() of point and spot lights: past it a light
+    // adds under 1% of its color, and objects beyond it don't get the light
+    static constexpr float RANGE_ATTENUATION = 0.01f;
+    
     /**
      * Apply this light's properties to a shader.
+     * Builds the uniform names on each call; per-frame code should keep a
+     * LightUniformNames and use the overload below.
      * @param shader The shader program
      * @param uniformName Base name for the uniform (e.g., "dirLight" or "pointLights[0]")
      */
-    virtual void applyToShader(Shader& shader, const std::string& uniformName) const = 0;
+    void applyToShader(Shader& shader, const std::string& uniformName) const;
+    
+    /**
+     * Apply this light's properties using precomputed uniform names.
+     */
+    virtual void applyToShader(Shader& shader, const LightUniformNames& names) const = 0;
 };
 
 /**
@@ -82,7 +120,8 @@ public:
     
     glm::vec3 direction;    // Direction the light is shining
     
-    void applyToShader(Shader& shader, const std::string& uniformName) const override;
+    using Light::applyToShader;
+    void applyToShader(Shader& shader, const LightUniformNames& names) const override;
 };
 
 /**
@@ -119,13 +158,25 @@ public:
     float linear;           // Linear falloff
     float quadratic;        // Quadratic falloff
     
-    void applyToShader(Shader& shader, const std::string& uniformName) const override;
+    using Light::applyToShader;
+    void applyToShader(Shader& shader, const LightUniformNames& names) const override;
     
     /**
      * Set attenuation for a specific range.
      * @param range Approximate distance where light intensity becomes negligible
      */
     void setRange(float range);
+    
+    /**
+     * Get the distance where attenuation falls to RANGE_ATTENUATION
+     * (about 1.1x the setRange() value).
+     */
+    float getRange() const;
+    
+    /**
+     * Check if the light reaches a bounding sphere (enabled and in range).
+     */
+    bool reaches(const glm::vec3& center, float radius) const;
 };
 
 /**
@@ -162,12 +213,25 @@ public:
     float linear;
     float quadratic;
     
-    void applyToShader(Shader& shader, const std::string& uniformName) const override;
+    using Light::applyToShader;
+    void applyToShader(Shader& shader, const LightUniformNames& names) const override;
     
     /**
      * Set cutoff angles in degrees.
      */
     void setCutoff(float innerDegrees, float outerDegrees);
+    
+    /**
+     * Get the distance where attenuation falls to RANGE_ATTENUATION.
+     */
+    float getRange() const;
+    
+    /**
+     * Check if the light reaches a bounding sphere: enabled, in range and,
+     * unless it has an ambient term (which shines all around), inside
+     * the outer cone.
+     */
+    bool reaches(const glm::vec3& center, float radius) const;
 };
 
 #endif // LIGHT_H
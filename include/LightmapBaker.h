@@ -0,0 +1,200 @@
+/**
+ * =============================================================================
+ * LightmapBaker.h - CPU Lightmap Baking for Static Geometry
+ * =============================================================================
+ * The showroom's floor, walls, ceiling, platform and pillars never move,
+ * and neither do the lights shining on them. Instead of evaluating every
+ * light per pixel each frame, their lighting is computed once on the CPU
+ * and stored in textures. At runtime a static surface costs one texture
+ * fetch.
+ * 
+ * Steps:
+ * 1. UVs: each surface is cut into charts (a quad, i.e. two coplanar
+ *    triangles sharing an edge, or a single triangle). Every chart is laid
+ *    flat at a fixed number of texels per meter and shelf-packed into the
+ *    surface's own lightmap, with a border of padding texels so bilinear
+ *    filtering never reads a neighbouring chart.
+ * 2. Direct light: every texel's world position is lit by the sun, point
+ *    and spot lights with the main shader's diffuse and ambient terms, and
+ *    a shadow ray per light against the combined static triangles.
+ * 3. Bounces and occlusion: cosine-distributed rays over the hemisphere
+ *    gather the previous pass's light from whatever they hit. The first
+ *    gather also measures how open the texel is (ambient occlusion).
+ * 
+ * Rays are traced with one TriangleBVH over all surfaces in world space,
+ * and texels are shared out over the ThreadPool. Sample patterns are
+ * fixed, so the same scene always bakes to the same result; a cache file
+ * keyed by a hash of every input skips the bake on later runs.
+ * 
+ * Specular highlights depend on the viewer and are not baked.
+ * =============================================================================
+ */
+
+#ifndef LIGHTMAP_BAKER_H
+#define LIGHTMAP_BAKER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Light.h"
+#include "Material.h"
+#include "Mesh.h"
+#include "MeshBVH.h"
+
+/**
+ * Lightmap - Baked RGB light of one surface.
+ */
+struct Lightmap {
+    int width = 0;
+    int height = 0;
+    std::vector<glm::vec3> texels;      // Rows bottom to top, as GL uploads them
+};
+
+/**
+ * LightmapBaker class - Bakes lighting of static surfaces into textures.
+ * 
+ * Usage:
+ *   LightmapBaker baker;
+ *   baker.addSurface(floorData, floorModel.getModelMatrix(), Material::Tile());
+ *   ...more surfaces...
+ *   baker.setLights(sun, pointLights, spotLights);
+ *   if (!baker.loadCache(path)) {
+ *       baker.bake();
+ *       baker.saveCache(path);
+ *   }
+ *   unsigned int texture = baker.createTexture(0);
+ */
+class LightmapBaker {
+public:
+    static constexpr float TEXELS_PER_METER = 4.0f;
+    static constexpr int MAX_SIZE = 512;            // Largest lightmap side; density drops to fit
+    static constexpr int CHART_PADDING = 2;         // Texels around each chart
+    static constexpr int SAMPLES_PER_TEXEL = 64;    // Hemisphere rays per texel and bounce
+    static constexpr int BOUNCES = 2;
+    static constexpr float OCCLUSION_DISTANCE = 2.0f;   // Hits closer than this darken ambient light
+    
+    LightmapBaker() = default;
+    
+    // Disable copying
+    LightmapBaker(const LightmapBaker&) = delete;
+    LightmapBaker& operator=(const LightmapBaker&) = delete;
+    
+    /**
+     * Add a static surface and give it lightmap UVs.
+     * The mesh's texture coordinates are replaced with lightmap UVs, and
+     * vertices are split where charts meet. The surface must not use its
+     * texture coordinates for anything else.
+     * @param mesh Geometry, changed in place (upload it afterwards)
+     * @param model World transform of the surface
+     * @param material Ambient and diffuse colors the light is baked with
+     * @return Surface index (lightmaps are returned in this order)
+     */
+    size_t addSurface(MeshData& mesh, const glm::mat4& model, const Material& material);
+    
+    /**
+     * Set the lights to bake. Disabled lights are skipped.
+     */
+    void setLights(const DirectionalLight& sun, const std::vector<PointLight>& pointLights,
+                   const std::vector<SpotLight>& spotLights);
+    
+    /**
+     * Compute every lightmap. Runs on all cores and returns when done.
+     */
+    void bake();
+    
+    /**
+     * Load lightmaps baked earlier from exactly the same surfaces, lights
+     * and settings.
+     * @return False if the file is missing or was baked from other inputs
+     */
+    bool loadCache(const std::string& path);
+    
+    /**
+     * Save the lightmaps for loadCache().
+     * @return False if the file could not be written
+     */
+    bool saveCache(const std::string& path) const;
+    
+    /**
+     * Get a surface's lightmap (black until baked or loaded).
+     */
+    const Lightmap& getLightmap(size_t surface) const { return m_surfaces[surface].lightmap; }
+    size_t getSurfaceCount() const { return m_surfaces.size(); }
+    
+    /**
+     * Upload a surface's lightmap as a half-float RGB texture.
+     * Requires a current GL context.
+     * @return Texture ID (owned by the caller)
+     */
+    unsigned int createTexture(size_t surface) const;
+    
+    /**
+     * Get the number of texels that were (or would be) baked.
+     */
+    size_t getTexelCount() const;
+
+private:
+    /**
+     * TexelSample - Where on the surface a lightmap texel sits.
+     */
+    struct TexelSample {
+        glm::vec3 position{0.0f};
+        glm::vec3 normal{0.0f};
+        bool used = false;              // False in gaps between charts
+    };
+    
+    /**
+     * Surface - One static mesh, in world space.
+     */
+    struct Surface {
+        glm::vec3 ambient;
+        glm::vec3 diffuse;
+        std::vector<glm::vec3> positions;   // Per vertex, world space
+        std::vector<glm::vec2> uvs;         // Per vertex, lightmap UV
+        std::vector<unsigned int> indices;
+        uint32_t firstTriangle = 0;         // Index of triangle 0 in the scene BVH
+        std::vector<TexelSample> samples;   // width * height, same layout as lightmap
+        Lightmap lightmap;
+    };
+    
+    std::vector<Surface> m_surfaces;
+    
+    // Lights (point and spot lights: enabled ones only)
+    DirectionalLight m_sun;
+    std::vector<PointLight> m_pointLights;
+    std::vector<SpotLight> m_spotLights;
+    
+    // Static triangles of every surface, built by bake()
+    TriangleBVH m_bvh;
+    std::vector<uint32_t> m_triangleSurfaces;   // Scene triangle -> surface
+    
+    /**
+     * Hash every input that changes the result (geometry, materials,
+     * lights and the settings above).
+     */
+    uint64_t computeKey() const;
+    
+    /**
+     * Direct light (diffuse only, shadowed) and ambient light at a point.
+     */
+    void computeDirect(const glm::vec3& position, const glm::vec3& normal,
+                       const Surface& surface, glm::vec3& direct, glm::vec3& ambient) const;
+    
+    /**
+     * Check if anything static lies between a point and a target.
+     */
+    bool isOccluded(const glm::vec3& origin, const glm::vec3& target) const;
+    
+    /**
+     * Trace a ray into the scene and look up a per-texel value where it lands.
+     * @param source One value per texel of every surface
+     * @param hitDistance Output: distance to the hit, or -1 for none
+     * @return The value at the hit texel, or black for a miss or a back face
+     */
+    glm::vec3 gather(const Ray& ray, const std::vector<std::vector<glm::vec3>>& source,
+                     float& hitDistance) const;
+};
+
+#endif // LIGHTMAP_BAKER_H
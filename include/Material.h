@@ -11,6 +11,15 @@
  * - Specular: Highlight color (shiny reflection)
  * - Shininess: How focused the specular highlight is (higher = smaller, sharper)
  * 
+ * Reflections: reflectivity and roughness control how much of the
+ * showroom's reflection probe (see ReflectionProbe.h) shows on the
+ * surface. Reflectivity is the head-on strength; it rises towards 1 at
+ * grazing angles (Fresnel). Roughness picks a blurrier probe mip.
+ * 
+ * Lightmaps: a static surface with a baked lightmap (see LightmapBaker.h)
+ * takes its ambient and diffuse light from that texture instead of the
+ * scene's lights. Its texture coordinates are the lightmap UVs.
+ * 
  * Common Shininess Values:
  * - 2-10: Very rough surfaces (rubber, chalk)
  * - 10-50: Moderately shiny (plastic, wood)
@@ -54,10 +63,15 @@ public:
     // Transparency
     float opacity;          // 1.0 = fully opaque, 0.0 = fully transparent
     
+    // Environment reflections (0 = none, the default)
+    float reflectivity;     // Reflection strength when viewed head-on
+    float roughness;        // 0 = mirror, 1 = fully blurred
+    
     // Texture IDs (0 = no texture)
     unsigned int diffuseMap;
     unsigned int specularMap;
     unsigned int normalMap;
+    unsigned int lightMap;      // Baked lighting, bound by the Renderer
     
     /**
      * Apply material properties to a shader.
@@ -17,6 +17,22 @@
  * 
  * Design Decision: Using indexed rendering with Element Buffer Objects (EBO)
  * to reduce vertex duplication. Shared vertices only need to be stored once.
+ * 
+ * Memory: once uploaded, drawing only needs the GPU copy. The vertex and
+ * index vectors are moved in (never copied), and a MeshRetention policy
+ * decides what stays in RAM afterwards: everything, only what ray queries
+ * need, or nothing.
+ * 
+ * Generation vs upload: the MeshGenerator functions come in two halves.
+ * generateX() only builds a MeshData on the CPU and touches no GL state,
+ * so many meshes can be generated at once on worker threads. createX()
+ * generates and uploads in one call, for code that needs just one mesh.
+ * 
+ * Threading: the constructor uploads the VBO/EBO in whatever context is
+ * current, which may be the AssetLoader's shared context. VAOs are not
+ * shared between contexts, so the VAO is created on the first draw() in
+ * the drawing context. GPU objects are released through GpuDeletionQueue,
+ * so a mesh may be destroyed on any thread.
  * =============================================================================
  */
 
@@ -25,9 +41,15 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <glm/glm.hpp>
 
+#include "StaticMesh.h"
+
 class Shader;
+class TriangleBVH;
+struct TriangleHit;
+struct Ray;
 
 /**
  * Vertex structure - Holds all per-vertex data.
@@ -51,6 +73,24 @@ struct Vertex {
         : Position(pos), Normal(norm), TexCoords(tex) {}
 };
 
+/**
+ * MeshRetention - What a mesh keeps in RAM after its GPU upload.
+ */
+enum class MeshRetention {
+    KEEP_ALL,           // Full vertices and indices
+    COLLISION_ONLY,     // Positions (12 of 32 bytes per vertex) and indices, for buildBVH()/raycast()
+    DROP                // Nothing: the GPU buffers are the only copy
+};
+
+/**
+ * MeshData - Geometry built on the CPU and not yet uploaded.
+ * Plain vectors, so it can be built on any thread and moved into a Mesh.
+ */
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
 /**
  * Texture structure - References a loaded texture.
  */
@@ -66,26 +106,56 @@ struct Texture {
  * Usage:
  *   std::vector<Vertex> vertices = {...};
  *   std::vector<unsigned int> indices = {...};
- *   Mesh mesh(vertices, indices);
+ *   Mesh mesh(std::move(vertices), std::move(indices), MeshRetention::DROP);
  *   mesh.draw(shader);
  */
 class Mesh {
 public:
-    // Mesh data (public for easy access)
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    // Textures bound, one unit each, when drawing
     std::vector<Texture> textures;
     
     /**
-     * Construct a mesh from vertex and index data.
+     * Construct a mesh, taking over the vertex and index data.
      * 
-     * @param vertices Vector of vertex data
-     * @param indices Vector of indices for indexed rendering
+     * @param vertices Vertex data (moved from, never copied)
+     * @param indices Indices for indexed rendering (moved from)
+     * @param retention What to keep in RAM after the upload
      * @param textures Vector of textures (optional)
      */
-    Mesh(const std::vector<Vertex>& vertices,
-         const std::vector<unsigned int>& indices,
-         const std::vector<Texture>& textures = {});
+    Mesh(std::vector<Vertex>&& vertices,
+         std::vector<unsigned int>&& indices,
+         MeshRetention retention = MeshRetention::KEEP_ALL,
+         std::vector<Texture> textures = {});
+    
+    /**
+     * Construct a mesh from generated geometry, taking over its vectors.
+     */
+    explicit Mesh(MeshData&& data, MeshRetention retention = MeshRetention::KEEP_ALL);
+    
+    /**
+     * Construct a mesh from data owned elsewhere (e.g. static tables).
+     * The arrays are uploaded directly; only what the retention policy
+     * asks for is copied.
+     */
+    Mesh(const Vertex* vertices, size_t vertexCount,
+         const unsigned int* indices, size_t indexCount,
+         MeshRetention retention = MeshRetention::DROP);
+    
+    /**
+     * Construct a mesh from a compile-time table (see StaticMesh.h). The
+     * table is uploaded in place, so by default nothing is generated or
+     * allocated at runtime.
+     */
+    Mesh(const StaticVertex* vertices, size_t vertexCount,
+         const unsigned int* indices, size_t indexCount,
+         MeshRetention retention = MeshRetention::DROP);
+    
+    template <size_t VERTEX_COUNT, size_t INDEX_COUNT>
+    explicit Mesh(const StaticMeshData<VERTEX_COUNT, INDEX_COUNT>& table,
+                  MeshRetention retention = MeshRetention::DROP)
+        : Mesh(table.vertices.data(), VERTEX_COUNT, table.indices.data(), INDEX_COUNT, retention)
+    {
+    }
     
     /**
      * Destructor - Releases GPU resources.
@@ -108,21 +178,115 @@ public:
     void draw(const Shader& shader) const;
     
     /**
-     * Get the VAO ID for external use.
+     * Get the VAO ID for external use (0 until the first draw).
      */
     unsigned int getVAO() const { return m_VAO; }
     
+    // =========================================================================
+    // CPU-Side Data
+    // =========================================================================
+    
+    /**
+     * Get the retained data. Vertices are empty unless KEEP_ALL, positions
+     * are filled only under COLLISION_ONLY, indices are empty under DROP.
+     */
+    const std::vector<Vertex>& getVertices() const { return m_vertices; }
+    const std::vector<glm::vec3>& getPositions() const { return m_positions; }
+    const std::vector<unsigned int>& getIndices() const { return m_indices; }
+    
+    /**
+     * Get the size of the uploaded geometry (valid whatever is retained).
+     */
+    size_t getVertexCount() const { return m_vertexCount; }
+    size_t getIndexCount() const { return m_indexCount; }
+    
+    /**
+     * Get a sphere around every vertex in model space (for culling),
+     * valid whatever is retained.
+     */
+    const glm::vec3& getBoundsCenter() const { return m_boundsCenter; }
+    float getBoundsRadius() const { return m_boundsRadius; }
+    
+    /**
+     * Get the current retention policy.
+     */
+    MeshRetention getRetention() const { return m_retention; }
+    
+    /**
+     * Free CPU data down to a lower retention level, e.g. DROP once the
+     * BVH is built. Data that is already gone can't come back, so asking
+     * for more than is kept does nothing.
+     */
+    void releaseCpuData(MeshRetention retention);
+    
+    /**
+     * Get the bytes of geometry held in RAM (not counting the BVH).
+     */
+    size_t getCpuMemoryUsage() const;
+    
+    // =========================================================================
+    // Ray Queries
+    // =========================================================================
+    
+    /**
+     * Build the triangle BVH used by raycast().
+     * Optional: only meshes that need exact ray hits pay for it. Needs
+     * positions and indices, so DROP meshes can't build one (reported
+     * as an error).
+     */
+    void buildBVH();
+    
+    /**
+     * Check if a triangle BVH has been built.
+     */
+    bool hasBVH() const { return m_bvh != nullptr; }
+    
+    /**
+     * Find the closest triangle along a ray in model space.
+     * Fills in the triangle, barycentrics, UV, point and normal. Without
+     * full vertices (COLLISION_ONLY) the UV is 0 and the normal is the
+     * triangle's face normal.
+     * @return False if no BVH is built or nothing was hit
+     */
+    bool raycast(const Ray& ray, float maxDistance, TriangleHit& hit) const;
+    
 private:
     // OpenGL buffer objects
-    unsigned int m_VAO;     // Vertex Array Object - stores vertex attribute configuration
-    unsigned int m_VBO;     // Vertex Buffer Object - stores vertex data
-    unsigned int m_EBO;     // Element Buffer Object - stores indices
+    mutable unsigned int m_VAO;     // Vertex Array Object - stores vertex attribute configuration
+    unsigned int m_VBO;             // Vertex Buffer Object - stores vertex data
+    unsigned int m_EBO;             // Element Buffer Object - stores indices
+    
+    // CPU-side copies, as far as m_retention keeps them
+    MeshRetention m_retention;
+    std::vector<Vertex> m_vertices;
+    std::vector<glm::vec3> m_positions;
+    std::vector<unsigned int> m_indices;
+    size_t m_vertexCount;
+    size_t m_indexCount;
+    
+    // Bounding sphere in model space (center of the box, farthest vertex)
+    glm::vec3 m_boundsCenter;
+    float m_boundsRadius;
+    
+    std::unique_ptr<TriangleBVH> m_bvh;     // Optional, see buildBVH()
     
     /**
      * Set up the mesh GPU resources.
-     * Creates VAO, VBO, EBO and configures vertex attributes.
+     * Creates and fills the VBO and EBO (works in any context).
+     * @param vertices m_vertexCount vertices in the Vertex layout
+     */
+    void setupMesh(const void* vertices, const unsigned int* indices);
+    
+    /**
+     * Create the VAO and configure vertex attributes.
+     * Must run in the context that draws the mesh.
      */
-    void setupMesh();
+    void createVertexArray() const;
+    
+    /**
+     * Queue the GPU objects for deletion and forget them.
+     */
+    void releaseGpuResources();
 };
 
 // =============================================================================
@@ -131,12 +295,19 @@ private:
 // These functions create common shapes for building scenes
 
 namespace MeshGenerator {
+    // The generate functions fill a MeshData with exactly sized vectors and
+    // are safe to call from any thread. The create functions upload the
+    // result, passing the retention argument on to the Mesh constructor.
+    // For fixed sizes and tessellations, a StaticMesh table built at
+    // compile time avoids both steps.
+    
     /**
      * Create a cube mesh.
      * @param size Side length of the cube
      * @return Mesh object representing a cube
      */
-    Mesh createCube(float size = 1.0f);
+    MeshData generateCube(float size = 1.0f);
+    Mesh createCube(float size = 1.0f, MeshRetention retention = MeshRetention::KEEP_ALL);
     
     /**
      * Create a plane/quad mesh.
@@ -146,8 +317,11 @@ namespace MeshGenerator {
      * @param vScale Texture V coordinate scale
      * @return Mesh object representing a horizontal plane
      */
+    MeshData generatePlane(float width = 10.0f, float depth = 10.0f,
+                           float uScale = 1.0f, float vScale = 1.0f);
     Mesh createPlane(float width = 10.0f, float depth = 10.0f, 
-                     float uScale = 1.0f, float vScale = 1.0f);
+                     float uScale = 1.0f, float vScale = 1.0f,
+                     MeshRetention retention = MeshRetention::KEEP_ALL);
     
     /**
      * Create a sphere mesh.
@@ -156,7 +330,9 @@ namespace MeshGenerator {
      * @param stacks Number of vertical divisions (latitude)
      * @return Mesh object representing a sphere
      */
-    Mesh createSphere(float radius = 1.0f, int sectors = 36, int stacks = 18);
+    MeshData generateSphere(float radius = 1.0f, int sectors = 36, int stacks = 18);
+    Mesh createSphere(float radius = 1.0f, int sectors = 36, int stacks = 18,
+                      MeshRetention retention = MeshRetention::KEEP_ALL);
     
     /**
      * Create a cylinder mesh.
@@ -165,13 +341,16 @@ namespace MeshGenerator {
      * @param sectors Number of divisions around the circumference
      * @return Mesh object representing a cylinder
      */
-    Mesh createCylinder(float radius = 0.5f, float height = 1.0f, int sectors = 36);
+    MeshData generateCylinder(float radius = 0.5f, float height = 1.0f, int sectors = 36);
+    Mesh createCylinder(float radius = 0.5f, float height = 1.0f, int sectors = 36,
+                        MeshRetention retention = MeshRetention::KEEP_ALL);
     
     /**
      * Create a simple car body mesh.
      * @return Mesh object representing a simplified car body
      */
-    Mesh createCarBody();
+    MeshData generateCarBody();
+    Mesh createCarBody(MeshRetention retention = MeshRetention::KEEP_ALL);
     
     /**
      * Create a wheel mesh.
@@ -179,7 +358,21 @@ namespace MeshGenerator {
      * @param width Wheel width
      * @return Mesh object representing a wheel
      */
-    Mesh createWheel(float radius = 0.4f, float width = 0.2f);
+    MeshData generateWheel(float radius = 0.4f, float width = 0.2f);
+    Mesh createWheel(float radius = 0.4f, float width = 0.2f,
+                     MeshRetention retention = MeshRetention::KEEP_ALL);
+    
+    /**
+     * Copy a compile-time table (see StaticMesh.h) into a MeshData, for
+     * shapes that are edited before upload (e.g. given lightmap UVs).
+     */
+    MeshData copyTable(const StaticVertex* vertices, size_t vertexCount,
+                       const unsigned int* indices, size_t indexCount);
+    
+    template <size_t VERTEX_COUNT, size_t INDEX_COUNT>
+    MeshData copyTable(const StaticMeshData<VERTEX_COUNT, INDEX_COUNT>& table) {
+        return copyTable(table.vertices.data(), VERTEX_COUNT, table.indices.data(), INDEX_COUNT);
+    }
 }
 
 #endif // MESH_H
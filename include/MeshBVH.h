@@ -0,0 +1,181 @@
+/**
+ * =============================================================================
+ * MeshBVH.h - Triangle Bounding Volume Hierarchy
+ * =============================================================================
+ * Exact ray queries against the triangles of a mesh. The Collision module
+ * only knows boxes, spheres and planes, so a ray aimed at a car would stop
+ * at its bounding box; this finds the actual triangle, together with the
+ * barycentric coordinates needed to interpolate UVs and normals.
+ * 
+ * Layout:
+ * - Nodes are 32 bytes (two per cache line), as in StaticAABBTree.
+ * - Each leaf holds up to 4 triangles in one TriangleBlock, stored
+ *   "structure of arrays" style: all 4 vertex-0 X values together, then
+ *   all Y values, and so on. The ray-triangle test runs over the 4 lanes
+ *   in one loop, which the compiler turns into SIMD instructions.
+ * - Triangles are stored pre-processed for the Moller-Trumbore test
+ *   (one corner plus two edge vectors), so no vertex lookups happen
+ *   while tracing.
+ * 
+ * Large meshes (imported models) are built on all CPU cores: the top of
+ * the tree is split on one thread, then the subtrees below it are built
+ * in parallel and joined into one node array.
+ * =============================================================================
+ */
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Collision.h"
+#include "Mesh.h"
+
+/**
+ * TriangleHit - Result of a ray-triangle query.
+ */
+struct TriangleHit {
+    bool hit = false;
+    float distance = 0.0f;              // Ray parameter t (world units for normalized rays)
+    uint32_t triangle = 0;              // Triangle index: corners are indices[3 * triangle + 0..2]
+    glm::vec3 barycentric{0.0f};        // Weights of corners 0, 1 and 2 (sum to 1)
+    glm::vec2 uv{0.0f};                 // Interpolated texture coordinates
+    glm::vec3 point{0.0f};              // Hit position
+    glm::vec3 normal{0.0f};             // Interpolated vertex normal
+    size_t meshIndex = 0;               // Mesh within its model (Model::raycast only)
+};
+
+/**
+ * TriangleBVH class - Static triangle hierarchy for one mesh.
+ * 
+ * Usage:
+ *   TriangleBVH bvh;
+ *   bvh.build(mesh.getVertices(), mesh.getIndices());
+ *   TriangleHit hit;
+ *   if (bvh.raycast(ray, 100.0f, hit)) { ... hit.triangle, hit.barycentric ... }
+ */
+class TriangleBVH {
+public:
+    static constexpr int LEAF_WIDTH = 4;                        // Triangles per leaf block
+    static constexpr uint32_t PARALLEL_BUILD_THRESHOLD = 16384; // Triangles before threads help
+    
+    TriangleBVH() = default;
+    
+    /**
+     * Build the hierarchy from indexed triangles.
+     * Only positions are copied; the vertex data can change or be freed
+     * afterwards (re-build if the shape changes).
+     */
+    void build(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+    
+    /**
+     * Build from bare positions (meshes that keep only collision data).
+     */
+    void build(const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& indices);
+    
+    /**
+     * Find the closest triangle along a ray.
+     * The direction does not need to be normalized: distance is measured
+     * in multiples of its length, which lets callers pass rays transformed
+     * into model space (scaled or not) without correcting the result.
+     * Only hit, distance, triangle and barycentric are filled in.
+     * @param ray Ray in the same space as the vertices
+     * @param maxDistance Ignore hits further than this
+     * @param hit Output: closest hit
+     * @return True if a triangle was hit
+     */
+    bool raycast(const Ray& ray, float maxDistance, TriangleHit& hit) const;
+    
+    /**
+     * Check if the hierarchy has been built.
+     */
+    bool isBuilt() const { return !m_nodes.empty(); }
+    
+    /**
+     * Get statistics.
+     */
+    size_t getTriangleCount() const { return m_triangleCount; }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    size_t getMemoryUsage() const;
+    
+    /**
+     * Remove the hierarchy.
+     */
+    void clear();
+
+private:
+    /**
+     * Node - 32 bytes.
+     * Leaf (count > 0): triangle block leftOrFirst, with count lanes used.
+     * Inner (count == 0): children at leftOrFirst and leftOrFirst + 1.
+     */
+    struct Node {
+        glm::vec3 boundsMin;
+        uint32_t leftOrFirst;
+        glm::vec3 boundsMax;
+        uint32_t count;
+    };
+    
+    /**
+     * TriangleBlock - Up to 4 triangles, one SIMD lane each (144 bytes).
+     * Unused lanes have zero edges, which the test always rejects.
+     */
+    struct alignas(16) TriangleBlock {
+        float v0[3][LEAF_WIDTH];    // Corner 0, per axis
+        float e1[3][LEAF_WIDTH];    // Corner 1 - corner 0
+        float e2[3][LEAF_WIDTH];    // Corner 2 - corner 0
+    };
+    
+    /**
+     * Per-triangle data used only while building.
+     */
+    struct BuildInput;
+    
+    /**
+     * A subtree whose construction was handed to a worker thread.
+     */
+    struct DeferredSubtree {
+        uint32_t nodeIndex;
+        uint32_t first;
+        uint32_t count;
+        uint32_t depth;
+    };
+    
+    std::vector<Node> m_nodes;
+    std::vector<TriangleBlock> m_blocks;
+    std::vector<uint32_t> m_blockTriangles;     // LEAF_WIDTH per block: original triangle index
+    size_t m_triangleCount = 0;
+    
+    /**
+     * Shared build: vertex i's position is at positions + i * stride bytes.
+     */
+    void buildFromPositions(const unsigned char* positions, size_t stride,
+                            const std::vector<unsigned int>& indices);
+    
+    /**
+     * Build the subtree of triangles [first, first + count) into nodes.
+     * When deferred is set, ranges of at most deferBelow triangles are
+     * recorded there instead of being built.
+     */
+    static void buildNode(std::vector<Node>& nodes, uint32_t nodeIndex,
+                          uint32_t first, uint32_t count, uint32_t depth,
+                          BuildInput& input, uint32_t deferBelow,
+                          std::vector<DeferredSubtree>* deferred);
+    
+    /**
+     * Pick a split for triangles [first, first + count) and partition them.
+     * @return Index of the first triangle of the right half
+     */
+    static uint32_t partition(uint32_t first, uint32_t count,
+                              const glm::vec3& centerMin, const glm::vec3& centerMax,
+                              BuildInput& input);
+    
+    /**
+     * Copy leaf triangles into blocks, in node order.
+     */
+    void fillBlocks(const BuildInput& input);
+};
+
+#endif // MESH_BVH_H
@@ -23,6 +23,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -30,6 +31,9 @@
 #include "Material.h"
 
 class Shader;
+struct TriangleHit;
+struct Ray;
+struct DrawItem;
 
 /**
  * Model class - Container for multiple meshes with transform.
@@ -88,6 +92,12 @@ public:
     Mesh* getMesh(size_t index);
     const Mesh* getMesh(size_t index) const;
     
+    /**
+     * Get the material a mesh is drawn with.
+     */
+    Material* getMeshMaterial(size_t index);
+    const Material* getMeshMaterial(size_t index) const;
+    
     // =========================================================================
     // Transform Operations
     // =========================================================================
@@ -120,6 +130,36 @@ public:
      */
     glm::mat4 getModelMatrix() const;
     
+    // =========================================================================
+    // Render Interpolation
+    // =========================================================================
+    // Physics moves objects in fixed steps (see Application::fixedUpdate),
+    // which rarely line up with rendered frames. The transform before the
+    // latest step is kept, and rendering blends between the two so motion
+    // stays smooth even when physics runs at 30 Hz and the display at 144.
+    // Physics and collision always use the current transform.
+    
+    /**
+     * Remember the current transform as the previous step.
+     * Call at the start of every fixed step, and after teleporting an
+     * object so it doesn't visibly slide to its new place.
+     */
+    void storePreviousTransform();
+    
+    /**
+     * Set how far rendering is between the previous and current step.
+     * @param alpha 0 = previous step, 1 = current step
+     */
+    void setRenderAlpha(float alpha);
+    
+    /**
+     * Get the blended transform used for drawing.
+     * Same as getModelMatrix() until storePreviousTransform() is called.
+     */
+    glm::mat4 getRenderMatrix() const;
+    glm::vec3 getRenderPosition() const;
+    glm::vec3 getRenderRotation() const;
+    
     // =========================================================================
     // Rendering
     // =========================================================================
@@ -135,6 +175,53 @@ public:
      */
     virtual void draw(Shader& shader, const glm::mat4& parentTransform) const;
     
+    /**
+     * Get the world matrix of one mesh, as drawn.
+     * Defaults to the render matrix; subclasses override it for parts
+     * that move on their own (e.g., car wheels).
+     */
+    virtual glm::mat4 getMeshMatrix(size_t meshIndex) const;
+    
+    /**
+     * Draw every mesh with the ID shader for GPU picking.
+     * Each mesh writes ObjectPicker::encodeId(objectId, meshIndex).
+     */
+    void drawIds(Shader& idShader, uint32_t objectId) const;
+    
+    /**
+     * Append one draw item per mesh, with the matrix and material it
+     * would be drawn with, for a FramePacket. Transparent meshes go to
+     * the transparent list. Nothing is added while invisible.
+     * Each item's previous matrix is the one the last call produced, so
+     * call this once per frame.
+     * @param objectId Pick ID of this model (see drawIds)
+     * @param cameraPosition Used for the items' sort depth
+     * @return False if the model was skipped as invisible
+     */
+    bool collectDrawItems(std::vector<DrawItem>& opaque, std::vector<DrawItem>& transparent,
+                          uint32_t objectId, const glm::vec3& cameraPosition) const;
+    
+    // =========================================================================
+    // Ray Queries
+    // =========================================================================
+    
+    /**
+     * Build the triangle BVH of every mesh, enabling raycast().
+     */
+    void buildBVHs();
+    
+    /**
+     * Find the closest triangle of any mesh along a world-space ray.
+     * The ray is moved into each mesh's space with getMeshMatrix(), so
+     * animated parts (wheels) are hit where they are drawn.
+     * Meshes without a BVH are skipped.
+     * @param ray World-space ray (normalized direction)
+     * @param maxDistance Ignore hits further than this
+     * @param hit Output: closest hit, with point and normal in world space
+     * @return True if a triangle was hit
+     */
+    bool raycast(const Ray& ray, float maxDistance, TriangleHit& hit) const;
+    
     // =========================================================================
     // Properties
     // =========================================================================
@@ -169,10 +256,27 @@ protected:
     mutable glm::mat4 m_modelMatrix;
     mutable bool m_modelMatrixDirty;
     
+    // Transform at the previous fixed step (see storePreviousTransform)
+    glm::vec3 m_previousPosition;
+    glm::vec3 m_previousRotation;
+    glm::vec3 m_previousScale;
+    bool m_hasPreviousTransform;
+    float m_renderAlpha;
+    
+    // Mesh matrices of the last collectDrawItems(), the previous matrices
+    // of the next one (empty while hidden)
+    mutable std::vector<glm::mat4> m_drawnMatrices;
+    
     /**
      * Update the cached model matrix.
      */
     void updateModelMatrix() const;
+    
+    /**
+     * Build a Translation * RotationZ * RotationY * RotationX * Scale matrix.
+     */
+    static glm::mat4 composeMatrix(const glm::vec3& position, const glm::vec3& rotation,
+                                   const glm::vec3& scale);
 };
 
 #endif // MODEL_H
@@ -0,0 +1,164 @@
+/**
+ * =============================================================================
+ * ObjectPicker.h - GPU Object-ID Picking
+ * =============================================================================
+ * Finds out exactly which object (and which part of it) is under the mouse
+ * cursor, at triangle precision.
+ * 
+ * How it works:
+ * 1. Every object is drawn again with a tiny shader that writes an integer
+ *    ID instead of a color, into an offscreen R32UI texture.
+ * 2. A scissor rectangle limits that pass to the pixel under the cursor,
+ *    so almost no fragments are shaded.
+ * 3. The ID pixel is copied into a pixel buffer object (PBO). The copy runs
+ *    on the GPU; the CPU only reads the PBO once a fence says it's done,
+ *    usually one or two frames later.
+ * 
+ * Why not just read the pixel right away?
+ * glReadPixels into client memory makes the CPU wait until the GPU has
+ * finished every queued command. That stall can cost several milliseconds
+ * per frame. With the PBO and fence the readback never waits.
+ * 
+ * ID encoding: (objectId << 8) | partId. Object 0 means "nothing"; the
+ * part is the mesh index inside the object (up to 256 meshes).
+ * =============================================================================
+ */
+
+#ifndef OBJECT_PICKER_H
+#define OBJECT_PICKER_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <glm/glm.hpp>
+
+class Shader;
+
+/**
+ * PickResult - What was under the cursor when the pick was requested.
+ */
+struct PickResult {
+    uint32_t objectId = 0;  // 0 = nothing pickable
+    uint32_t partId = 0;    // Mesh index within the object
+    int x = 0;              // Sampled pixel (bottom-left origin)
+    int y = 0;
+};
+
+/**
+ * ObjectPicker class - Renders object IDs and reads them back asynchronously.
+ * 
+ * Usage (once per frame, after the normal scene render):
+ *   if (picker.beginPick(x, y, view, projection)) {
+ *       scene.drawIds(picker.getShader());
+ *       picker.endPick();
+ *   }
+ *   PickResult result;
+ *   if (picker.pollResult(result)) { ... }
+ */
+class ObjectPicker {
+public:
+    /**
+     * Number of readbacks that can be in flight at once.
+     * Three covers the usual two frames of GPU latency plus one spare.
+     */
+    static constexpr int READBACK_SLOTS = 3;
+    
+    /**
+     * Create the ID render target.
+     * @param width Framebuffer width
+     * @param height Framebuffer height
+     */
+    ObjectPicker(int width, int height);
+    
+    /**
+     * Destructor - Frees the framebuffer, PBOs and pending fences.
+     */
+    ~ObjectPicker();
+    
+    // Disable copying
+    ObjectPicker(const ObjectPicker&) = delete;
+    ObjectPicker& operator=(const ObjectPicker&) = delete;
+    
+    /**
+     * Resize the ID target to match the window.
+     */
+    void resize(int width, int height);
+    
+    /**
+     * Start an ID pass for one pixel.
+     * Binds the ID target and shader. Returns false (and binds nothing)
+     * if the pixel is off-screen or all readback slots are still busy.
+     * @param x Pixel X (bottom-left origin)
+     * @param y Pixel Y (bottom-left origin)
+     */
+    bool beginPick(int x, int y, const glm::mat4& view, const glm::mat4& projection);
+    
+    /**
+     * Finish the ID pass: queue the readback and restore the default framebuffer.
+     */
+    void endPick();
+    
+    /**
+     * Collect finished readbacks without waiting.
+     * @param result Output: the newest finished pick
+     * @return True if at least one pick finished since the last call
+     */
+    bool pollResult(PickResult& result);
+    
+    /**
+     * Get the ID shader. Objects set "model" and "objectId" per mesh.
+     */
+    Shader& getShader() { return *m_shader; }
+    
+    /**
+     * Check if the ID target was created successfully.
+     */
+    bool isValid() const { return m_valid; }
+    
+    /**
+     * Pack an object and part into one ID value.
+     */
+    static uint32_t encodeId(uint32_t objectId, uint32_t partId) {
+        return (objectId << 8) | (partId & 0xFFu);
+    }
+
+private:
+    /**
+     * ReadbackSlot - One in-flight copy of an ID pixel.
+     */
+    struct ReadbackSlot {
+        unsigned int pbo = 0;
+        void* fence = nullptr;  // GLsync, kept opaque to avoid including GL here
+        int x = 0;
+        int y = 0;
+        bool pending = false;
+    };
+    
+    int m_width;
+    int m_height;
+    bool m_valid;
+    
+    // ID render target
+    unsigned int m_framebuffer;
+    unsigned int m_idTexture;
+    unsigned int m_depthBuffer;
+    
+    std::unique_ptr<Shader> m_shader;
+    
+    // Ring of readbacks: written at m_writeSlot, read at m_readSlot
+    std::array<ReadbackSlot, READBACK_SLOTS> m_slots;
+    int m_writeSlot;
+    int m_readSlot;
+    
+    /**
+     * Create (or re-create) the texture and depth buffer at the current size.
+     */
+    void createTargets();
+    
+    /**
+     * Delete the texture, depth buffer and framebuffer.
+     */
+    void destroyTargets();
+};
+
+#endif // OBJECT_PICKER_H
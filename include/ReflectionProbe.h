@@ -0,0 +1,141 @@
+/**
+ * =============================================================================
+ * ReflectionProbe.h - Cached Environment Cubemap for Reflections
+ * =============================================================================
+ * Gives car paint, chrome and glass something to reflect without drawing
+ * the scene again every frame.
+ * 
+ * How it works:
+ * 1. Capture: the static showroom (every item with pick object 0: floor,
+ *    walls, platform, pillars) is drawn six times with a 90 degree camera
+ *    at the probe position, once into each face of a small cubemap.
+ * 2. Prefilter: a fullscreen pass per face and mip convolves the capture
+ *    with the GGX lobe for that mip's roughness (mip 0 = mirror, last
+ *    mip = fully rough). Samples read a lower capture mip where they are
+ *    sparse, so 32 of them are enough without sparkles.
+ * 3. Use: the main shader reads the filtered cubemap in the reflection
+ *    direction at mip roughness * maxLod. That is one texture fetch per
+ *    fragment, whatever the scene contains.
+ * 
+ * Cost: the first capture happens in one frame. After that nothing is
+ * drawn until the packet's staticVersion changes (lights toggled,
+ * geometry replaced). A recapture then redraws one face per frame and
+ * filters after the sixth, so no single frame pays for all six views.
+ * The previous result stays in use until the new one is complete.
+ * 
+ * Cars are left out on purpose: they move, and the main car sits right
+ * on the probe.
+ * =============================================================================
+ */
+
+#ifndef REFLECTION_PROBE_H
+#define REFLECTION_PROBE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "FramePacket.h"
+#include "FullscreenPass.h"
+
+class Renderer;
+class Shader;
+
+/**
+ * ReflectionProbe class - Captures and prefilters a cubemap of the static scene.
+ * 
+ * Usage (render thread, once per frame, after the lights are set):
+ *   renderer.setEnvironmentMap(0, 0.0f);   // The capture must not reflect itself
+ *   probe.update(renderer, packet, width, height);
+ *   renderer.setEnvironmentMap(probe.getTexture(), probe.getMaxLod());
+ */
+class ReflectionProbe {
+public:
+    static constexpr int FACE_SIZE = 128;       // Pixels per face at mip 0
+    static constexpr int MIP_COUNT = 6;         // Roughness levels (128 down to 4 pixels)
+    static constexpr int FACE_COUNT = 6;
+    
+    /**
+     * Create the cubemaps and framebuffers. Requires a current GL context.
+     */
+    ReflectionProbe();
+    
+    /**
+     * Destructor - Deletes the textures and framebuffers (call with the context current).
+     */
+    ~ReflectionProbe();
+    
+    // Disable copying
+    ReflectionProbe(const ReflectionProbe&) = delete;
+    ReflectionProbe& operator=(const ReflectionProbe&) = delete;
+    
+    /**
+     * Capture or continue capturing if the packet's static version is new.
+     * Draws with the renderer's lights, then restores the default
+     * framebuffer, the viewport and the packet's camera.
+     * @param width Default framebuffer width (for the viewport)
+     * @param height Default framebuffer height
+     */
+    void update(Renderer& renderer, const FramePacket& packet, int width, int height);
+    
+    /**
+     * Get the filtered cubemap, or 0 before the first capture has finished.
+     */
+    unsigned int getTexture() const { return m_ready ? m_filteredMap : 0; }
+    
+    /**
+     * Get the mip that holds roughness 1.
+     */
+    float getMaxLod() const { return static_cast<float>(MIP_COUNT - 1); }
+    
+    /**
+     * Check if the probe's GL objects were created successfully.
+     */
+    bool isValid() const { return m_valid; }
+
+private:
+    bool m_valid;
+    bool m_ready;                   // m_filteredMap holds a complete result
+    
+    // Capture target: color cubemap (mipmapped for filtering) and depth
+    unsigned int m_captureMap;
+    unsigned int m_captureFramebuffer;
+    unsigned int m_depthBuffer;
+    
+    // Result: one roughness level per mip
+    unsigned int m_filteredMap;
+    unsigned int m_filterFramebuffer;
+    
+    // Fullscreen triangle of the screen-space passes
+    FullscreenPass m_fullscreen;
+    std::unique_ptr<Shader> m_filterShader;
+    
+    // Capture progress
+    bool m_hasVersion;              // m_version is meaningful
+    uint32_t m_version;             // staticVersion being (or last) captured
+    int m_nextFace;                 // FACE_COUNT = nothing left to capture
+    glm::vec3 m_position;
+    
+    // Static items of the capture, kept so recaptures don't allocate
+    std::vector<DrawItem> m_opaqueItems;
+    std::vector<DrawItem> m_transparentItems;
+    
+    /**
+     * Copy the packet's static items (pick object 0).
+     */
+    void collectStaticItems(const FramePacket& packet);
+    
+    /**
+     * Draw the static items into one face of the capture cubemap.
+     */
+    void captureFace(Renderer& renderer, int face);
+    
+    /**
+     * Build the capture's mip chain, then fill every face and mip of the
+     * filtered cubemap.
+     */
+    void prefilter();
+};
+
+#endif // REFLECTION_PROBE_H
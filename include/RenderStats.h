@@ -0,0 +1,79 @@
+/**
+ * =============================================================================
+ * RenderStats.h - Per-Frame Rendering Counters
+ * =============================================================================
+ * What one frame cost: how much was submitted, how often GL state changed,
+ * how much data went to the GPU, what was culled and how long the CPU and
+ * GPU took.
+ * 
+ * Counting happens where the work happens, not in the Renderer: every
+ * draw goes through Mesh::draw and every program bind through Shader::use,
+ * whichever path issued them (draw items, the pick pass, the old
+ * Model::draw path). They add to RenderStats::current(), the counters of
+ * the calling thread, which the Renderer resets in beginFrame(). Each GL
+ * context lives on one thread, so these are exactly one context's counts.
+ * 
+ * Uploads can happen on any thread (the asset loader fills meshes on its
+ * own), so uploaded bytes go through a shared atomic total instead, which
+ * the render thread drains once per frame.
+ * 
+ * RenderThread fills in the culling and timing fields and publishes the
+ * finished frame through RenderThread::getStats().
+ * =============================================================================
+ */
+
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * RenderStats - Counters for one frame.
+ */
+struct RenderStats {
+    uint64_t frameNumber = 0;
+    
+    // Submission
+    uint32_t drawCalls = 0;
+    uint32_t instances = 0;             // Equals drawCalls until instancing exists
+    uint64_t triangles = 0;
+    uint64_t vertices = 0;              // Indices submitted (vertex shader runs, before caching)
+    
+    // State changes
+    uint32_t programChanges = 0;        // glUseProgram calls that changed the program
+    uint32_t vertexArrayChanges = 0;
+    uint32_t textureChanges = 0;
+    uint32_t uniformChanges = 0;
+    
+    // Data sent to the GPU since the previous frame (any thread)
+    uint64_t bytesUploaded = 0;
+    
+    // Culling: hidden models, then draw items against the view frusta
+    uint32_t objectsTotal = 0;          // Models the scene considered
+    uint32_t objectsHidden = 0;         // Rejected by Model::isVisible()
+    uint32_t itemsTotal = 0;            // Draw items of the visible models
+    uint32_t itemsCulled = 0;           // Outside every view (FramePacket::cullItems)
+    
+    // Timing in milliseconds (0 = not measured yet)
+    double cpuMainMs = 0.0;             // Main thread: input, simulation, packet
+    double cpuRenderMs = 0.0;           // Render thread: GL calls up to the swap
+    double gpuMs = 0.0;                 // GPU time of the frame (a few frames late)
+    
+    /**
+     * Get the counters of the calling thread's current frame.
+     */
+    static RenderStats& current();
+    
+    /**
+     * Count bytes sent to the GPU. Safe from any thread.
+     */
+    static void addUploadedBytes(size_t bytes);
+    
+    /**
+     * Get the bytes uploaded since the last call and reset the total.
+     */
+    static uint64_t takeUploadedBytes();
+};
+
+#endif // RENDER_STATS_H
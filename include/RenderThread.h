@@ -0,0 +1,206 @@
+/**
+ * =============================================================================
+ * RenderThread.h - Dedicated OpenGL Render Thread
+ * =============================================================================
+ * Moves all OpenGL work off the main thread. Before this, event polling,
+ * input, simulation and GL calls all ran on the main thread. A long
+ * glfwSwapBuffers then held up input handling, and a slow simulation
+ * step left the GPU idle.
+ * 
+ * Thread roles:
+ * - Main thread: GLFW window and events (GLFW requires this), input,
+ *   simulation. Each frame it fills a FramePacket and publishes it.
+ * - Render thread: owns the GL context. It takes packets from the
+ *   FrameQueue, draws them, runs the pick pass, swaps and paces frames.
+ * 
+ * GL objects (meshes, shaders, the picker) are created on the main thread
+ * during startup while it still holds the context. start() then hands the
+ * context to the render thread, and stop() hands it back so destructors
+ * can free GL objects.
+ * 
+ * The class can also run without a thread: submitFrame() then draws the
+ * packet immediately on the calling thread through the same code path.
+ * 
+ * Reflective materials sample a ReflectionProbe that is captured here
+ * from the packet's static items and only redrawn when they change.
+ * Ambient occlusion is computed here too, at the packet's quality tier,
+ * just before the main pass. The main pass draws into an AntiAliasing
+ * target that is resolved to the screen before picking and the HUD.
+ * 
+ * Each frame's RenderStats are completed here (CPU and GPU times, culling
+ * counts from the packet) and can be read back with getStats().
+ * =============================================================================
+ */
+
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FramePacket.h"
+#include "ObjectPicker.h"
+#include "RenderStats.h"
+#include "GpuTimer.h"
+#include "ReflectionProbe.h"
+#include "AmbientOcclusion.h"
+#include "AntiAliasing.h"
+#include "StatsOverlay.h"
+#include "TextRenderer.h"
+
+class Window;
+class Renderer;
+class FramePacer;
+
+/**
+ * RenderThread class - Draws published frame packets on its own thread.
+ * 
+ * Usage (main thread, once per frame):
+ *   FramePacket* packet = renderThread.beginFrame();
+ *   if (!packet) { ...render thread stopped... }
+ *   ...fill packet...
+ *   renderThread.submitFrame();
+ */
+class RenderThread {
+public:
+    /**
+     * Set up the renderer. Does not start the thread yet.
+     * All references must outlive this object.
+     * @param threaded False to draw packets on the submitting thread
+     */
+    RenderThread(Window& window, Renderer& renderer, ObjectPicker& picker,
+                 FramePacer& pacer, bool threaded);
+    
+    /**
+     * Destructor - Stops the thread if it is running.
+     */
+    ~RenderThread();
+    
+    // Disable copying
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+    
+    /**
+     * Start drawing. Call on the thread that holds the GL context; in
+     * threaded mode that thread loses the context until stop().
+     */
+    void start();
+    
+    /**
+     * Finish the queued frames, join the thread and make the GL context
+     * current on the calling thread again.
+     */
+    void stop();
+    
+    /**
+     * Get the packet to fill for the next frame (cleared).
+     * May block while the queue is at its depth limit.
+     * @return The packet, or nullptr if the render thread has stopped
+     */
+    FramePacket* beginFrame();
+    
+    /**
+     * Publish the packet from beginFrame().
+     */
+    void submitFrame();
+    
+    /**
+     * Set the queue depth limit (see FrameQueue::setMaxQueuedFrames).
+     */
+    void setMaxQueuedFrames(size_t frames) { m_queue.setMaxQueuedFrames(frames); }
+    size_t getMaxQueuedFrames() const { return m_queue.getMaxQueuedFrames(); }
+    
+    /**
+     * Get the newest pick result delivered since the last call.
+     * @return True if there was a new result
+     */
+    bool pollPickResult(PickResult& result);
+    
+    /**
+     * Get the statistics of the last frame drawn. Safe from any thread.
+     */
+    RenderStats getStats() const;
+    
+    /**
+     * Check whether packets are drawn on a separate thread.
+     */
+    bool isThreaded() const { return m_threaded; }
+
+private:
+    Window& m_window;
+    Renderer& m_renderer;
+    ObjectPicker& m_picker;
+    FramePacer& m_pacer;
+    bool m_threaded;
+    bool m_running;
+    
+    FrameQueue m_queue;
+    std::thread m_thread;
+    uint64_t m_frameNumber;
+    
+    // Framebuffer size the renderer and picker are set up for (render side)
+    int m_width;
+    int m_height;
+    
+    // Pick results travel back to the main thread through here
+    std::mutex m_pickMutex;
+    PickResult m_pickResult;
+    bool m_hasPickResult;
+    
+    // Statistics (render side), published to the main thread under m_statsMutex
+    GpuTimer m_gpuTimer;
+    StatsOverlay m_overlay;
+    mutable std::mutex m_statsMutex;
+    RenderStats m_stats;
+    
+    // Labels and the statistics overlay, drawn together at the end of the frame
+    TextRenderer m_text;
+    
+    // Environment cubemap of the static showroom, recaptured on changes
+    ReflectionProbe m_probe;
+    
+    // Screen-space ambient occlusion of each frame's view
+    AmbientOcclusion m_occlusion;
+    
+    // Offscreen scene target and its resolve (TAA, FXAA or MSAA)
+    AntiAliasing m_antiAliasing;
+    
+    /**
+     * Render thread main loop.
+     */
+    void threadLoop();
+    
+    /**
+     * Draw one packet, then swap and pace.
+     */
+    void renderPacket(const FramePacket& packet);
+    
+    /**
+     * Draw the packet's items once per view, each into its viewport
+     * (packets with views only).
+     */
+    void renderViews(const FramePacket& packet);
+    
+    /**
+     * Draw the packet's labels and, if enabled, the statistics overlay,
+     * with all text in one batch.
+     */
+    void renderHud(const FramePacket& packet);
+    
+    /**
+     * Draw the packet's items into the pick buffer if it asked for a pick,
+     * and collect finished readbacks.
+     */
+    void renderPicking(const FramePacket& packet);
+    
+    /**
+     * Complete this frame's RenderStats (culling, timing, uploads) and
+     * publish them.
+     * @param frameStart Time renderPacket() started, in seconds
+     */
+    void publishStats(const FramePacket& packet, double frameStart);
+};
+
+#endif // RENDER_THREAD_H
@@ -17,17 +17,22 @@
  * 5. Post-processing (if any)
  * 6. Swap buffers
  * 
- * Design Decision: Using a deferred-style approach for collecting render
- * commands, then executing them in the correct order. This allows proper
- * handling of transparency without requiring the scene to be structured
- * in any particular way.
+ * Design Decision: The scene is drawn from prepared draw items (see
+ * FramePacket) with transparent items already sorted back-to-front, so
+ * the renderer never touches scene objects and can run on its own thread.
  * =============================================================================
  */
 
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include "FrameArena.h"
+#include "RenderStats.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -38,16 +43,9 @@ class Light;
 class DirectionalLight;
 class PointLight;
 class SpotLight;
-
-/**
- * RenderCommand - Stores information needed to render an object.
- */
-struct RenderCommand {
-    const Model* model;
-    glm::mat4 transform;
-    bool transparent;
-    float distanceToCamera;  // For sorting transparent objects
-};
+struct LightUniformNames;
+struct DrawItem;
+struct RenderView;
 
 /**
  * Renderer class - Handles all OpenGL rendering operations.
@@ -75,15 +73,11 @@ public:
     // =========================================================================
     
     /**
-     * Begin a new frame. Clears buffers and resets state.
+     * Begin a new frame. Clears buffers, resets state and zeroes this
+     * thread's RenderStats.
      */
     void beginFrame();
     
-    /**
-     * End the frame. Executes all queued render commands.
-     */
-    void endFrame();
-    
     /**
      * Handle viewport resize.
      */
@@ -98,6 +92,27 @@ public:
      */
     void setCamera(const Camera& camera);
     
+    /**
+     * Set the camera for this frame from precomputed matrices
+     * (e.g., from a FramePacket on the render thread).
+     */
+    void setCamera(const glm::mat4& view, const glm::mat4& projection,
+                   const glm::vec3& position);
+    
+    /**
+     * Get the camera matrices set for this frame.
+     */
+    const glm::mat4& getViewMatrix() const { return m_viewMatrix; }
+    const glm::mat4& getProjectionMatrix() const { return m_projectionMatrix; }
+    
+    /**
+     * Upload the cameras of several views at once, one slot each, for
+     * drawItems() with a view index. Slot 0 is overwritten too; the
+     * next setCamera() or setPreviousCamera() takes it back.
+     * @param views Up to FramePacket::MAX_VIEWS views
+     */
+    void setViews(const RenderView* views, size_t count);
+    
     // =========================================================================
     // Lighting Setup
     // =========================================================================
@@ -127,16 +142,35 @@ public:
     // =========================================================================
     
     /**
-     * Submit a model for rendering.
-     * The model will be rendered during endFrame() in the correct order.
+     * Draw a model immediately with its own shader.
+     * Use for debugging or UI elements.
      */
-    void submit(const Model& model, const glm::mat4& transform = glm::mat4(1.0f));
+    void drawImmediate(const Model& model, Shader& shader);
     
     /**
-     * Draw a model immediately (bypasses the command queue).
-     * Use for debugging or UI elements.
+     * Draw prepared draw items with the current camera and lights.
+     * Items carry their own matrices and materials, so no scene object
+     * is touched.
+     * @param opaque Drawn first, in any order
+     * @param transparent Drawn last with blending, in the given order
+     *                    (expected back-to-front)
+     * @param viewIndex Camera slot: 0 is the setCamera() camera, others
+     *                  come from setViews()
+     * @param viewMask Only items with one of these DrawItem::viewMask bits are drawn
      */
-    void drawImmediate(const Model& model, Shader& shader);
+    void drawItems(const std::vector<DrawItem>& opaque,
+                   const std::vector<DrawItem>& transparent,
+                   size_t viewIndex = 0, uint32_t viewMask = ~0u) {
+        drawItems(opaque.data(), opaque.size(), transparent.data(), transparent.size(),
+                  viewIndex, viewMask);
+    }
+    
+    /**
+     * Draw item arrays, e.g. lists built in the frame arena.
+     */
+    void drawItems(const DrawItem* opaque, size_t opaqueCount,
+                   const DrawItem* transparent, size_t transparentCount,
+                   size_t viewIndex = 0, uint32_t viewMask = ~0u);
     
     // =========================================================================
     // Render Settings
@@ -146,6 +180,32 @@ public:
      * Set the clear color.
      */
     void setClearColor(const glm::vec3& color);
+    const glm::vec3& getClearColor() const { return m_clearColor; }
+    
+    /**
+     * Set the prefiltered cubemap reflective materials sample in drawItems()
+     * (see ReflectionProbe). 0 turns reflections off.
+     * @param cubemap Cubemap texture with one roughness level per mip
+     * @param maxLod Mip used for roughness 1
+     */
+    void setEnvironmentMap(unsigned int cubemap, float maxLod);
+    
+    /**
+     * Set the ambient occlusion drawItems() applies (see AmbientOcclusion).
+     * Both textures must match the current camera. 0 turns it off.
+     * @param occlusionMap Half-resolution occlusion
+     * @param depthMap Half-resolution depth it was computed from
+     */
+    void setAmbientOcclusion(unsigned int occlusionMap, unsigned int depthMap);
+    
+    /**
+     * Set the previous frame's camera for the motion vectors drawItems()
+     * writes to the second color output (see AntiAliasing). Targets
+     * without a second attachment simply drop them.
+     * @param viewProjection Previous projection * view, jitter included
+     * @param jitterDelta This frame's projection jitter minus the previous one (NDC)
+     */
+    void setPreviousCamera(const glm::mat4& viewProjection, const glm::vec2& jitterDelta);
     
     /**
      * Enable/disable wireframe mode.
@@ -167,15 +227,28 @@ public:
     // Statistics
     // =========================================================================
     
+    /**
+     * Get the counters of the frame in progress (see RenderStats).
+     * Only meaningful on the thread that draws.
+     */
+    const RenderStats& getStats() const { return RenderStats::current(); }
+    
     /**
      * Get number of draw calls this frame.
      */
-    int getDrawCallCount() const { return m_drawCallCount; }
+    int getDrawCallCount() const { return static_cast<int>(getStats().drawCalls); }
     
     /**
      * Get number of triangles rendered this frame.
      */
-    int getTriangleCount() const { return m_triangleCount; }
+    int getTriangleCount() const { return static_cast<int>(getStats().triangles); }
+    
+    /**
+     * Get the arena holding this frame's lights and other render-thread
+     * scratch lists. Memory from it is valid until the next beginFrame().
+     */
+    FrameArena& getFrameArena() { return m_frameArena; }
+    const FrameArena& getFrameArena() const { return m_frameArena; }
     
     // =========================================================================
     // Constants
@@ -184,6 +257,16 @@ public:
     static constexpr int MAX_POINT_LIGHTS = 4;
     static constexpr int MAX_SPOT_LIGHTS = 2;
     
+    // Texture units of the environment map, lightmaps and ambient
+    // occlusion, clear of the units meshes bind
+    static constexpr int ENVIRONMENT_TEXTURE_UNIT = 7;
+    static constexpr int LIGHTMAP_TEXTURE_UNIT = 6;
+    static constexpr int OCCLUSION_TEXTURE_UNIT = 5;
+    static constexpr int OCCLUSION_DEPTH_TEXTURE_UNIT = 4;
+    
+    // Binding point of the main shader's Frame uniform block
+    static constexpr unsigned int FRAME_UNIFORM_BINDING = 0;
+    
 private:
     // Viewport dimensions
     int m_width;
@@ -197,24 +280,49 @@ private:
     glm::mat4 m_projectionMatrix;
     glm::vec3 m_cameraPosition;
     
-    // Render queue
-    std::vector<RenderCommand> m_opaqueCommands;
-    std::vector<RenderCommand> m_transparentCommands;
+    // Per-frame memory (declared before the containers that use it)
+    FrameArena m_frameArena;
     
-    // Lights
+    // Lights (arena-backed, re-added every frame)
     DirectionalLight* m_directionalLight;
-    std::vector<PointLight> m_pointLights;
-    std::vector<SpotLight> m_spotLights;
+    std::pmr::vector<PointLight> m_pointLights;
+    std::pmr::vector<SpotLight> m_spotLights;
+    
+    // Light uniform names, built once instead of every frame
+    std::unique_ptr<LightUniformNames> m_dirLightNames;
+    std::vector<LightUniformNames> m_pointLightNames;
+    std::vector<LightUniformNames> m_spotLightNames;
+    
+    // Reflection probe cubemap (0 = no reflections)
+    unsigned int m_environmentMap;
+    float m_environmentMaxLod;
+    
+    // Screen-space ambient occlusion (0 = off)
+    unsigned int m_occlusionMap;
+    unsigned int m_occlusionDepthMap;
+    
+    // Previous frame's camera (motion vectors)
+    glm::mat4 m_previousViewProjection;
+    glm::vec2 m_jitterDelta;
+    
+    // Frame uniform block: camera matrices per view, one aligned slot each
+    unsigned int m_frameUniformBuffer;
+    size_t m_frameUniformStride;
+    bool m_frameUniformsDirty;                  // Slot 0 behind the camera above
+    
+    // Lightmap on LIGHTMAP_TEXTURE_UNIT during drawItems() (0 = none yet)
+    unsigned int m_boundLightMap;
+    
+    // Light masks the shader's light lists were built from during
+    // drawItems(): point lights in the low byte, spot lights in the high one
+    static constexpr uint16_t ALL_LIGHTS = 0xFFFF;
+    uint16_t m_boundLightMasks;
     
     // Settings
     glm::vec3 m_clearColor;
     bool m_wireframeMode;
     bool m_cullingEnabled;
     
-    // Statistics
-    int m_drawCallCount;
-    int m_triangleCount;
-    
     /**
      * Set up OpenGL state for rendering.
      */
@@ -226,14 +334,21 @@ private:
     void applyLighting();
     
     /**
-     * Sort transparent objects back-to-front.
+     * Bind a view's Frame uniform slot, uploading slot 0 first if the
+     * camera changed since.
+     */
+    void bindView(size_t viewIndex);
+    
+    /**
+     * Set the shader's point and spot light index lists from masks of
+     * the uploaded lights (bit i = light i).
      */
-    void sortTransparentCommands();
+    void applyLightLists(uint8_t pointMask, uint8_t spotMask);
     
     /**
-     * Execute a render command.
+     * Draw one draw item (matrix, material, mesh).
      */
-    void executeCommand(const RenderCommand& cmd);
+    void executeItem(const DrawItem& item);
     
     /**
      * Create and compile shaders.
@@ -0,0 +1,127 @@
+/**
+ * =============================================================================
+ * SceneGenerator.h - Procedural Scene Layouts
+ * =============================================================================
+ * Describes where cars, lights and pillars go, without creating any of
+ * them. ShowroomScene turns a layout into models, lights and colliders.
+ * 
+ * Two kinds of layout:
+ * - The standard showroom: one hero car, four background cars, four
+ *   ceiling lights in a 30 x 20 m room.
+ * - A generated "car lot" for scaling tests: N cars in a parking grid
+ *   with a mix of detailed and simplified models, M point lights and a
+ *   grid of pillars with collision boxes. The lot grows with N, so the
+ *   density stays the same from 10 cars to 100,000.
+ * 
+ * Generated layouts are driven by a seed. The same seed and settings
+ * always produce the same scene, so frame time and memory can be compared
+ * between runs and builds.
+ * 
+ * Layouts only use plain data (no OpenGL), so tools and benchmarks can
+ * generate them without a window.
+ * =============================================================================
+ */
+
+#ifndef SCENE_GENERATOR_H
+#define SCENE_GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Collision.h"
+
+/**
+ * SceneConfig - Settings for the scene to build.
+ */
+struct SceneConfig {
+    uint32_t seed = 1;              // Random seed for generated layouts
+    size_t carCount = 0;            // Total cars including the hero car; 0 = standard showroom
+    float detailedFraction = 0.1f;  // Share of generated cars using the detailed model
+    size_t lightCount = 16;         // Point lights in a generated lot
+    float pillarSpacing = 24.0f;    // Distance between pillars; 0 = no pillars
+    
+    /**
+     * Check if this asks for a generated lot instead of the showroom.
+     */
+    bool isGenerated() const { return carCount > 0; }
+};
+
+/**
+ * CarPlacement - One car of a layout (the hero car is not included).
+ */
+struct CarPlacement {
+    glm::vec3 position;
+    float heading;          // Degrees around Y
+    bool detailed;          // Full model (true) or simplified placeholder
+    uint32_t paint;         // Index into the car paint presets
+    uint32_t price;         // Sticker price in dollars
+};
+
+/**
+ * LightPlacement - One point light of a layout.
+ */
+struct LightPlacement {
+    glm::vec3 position;
+    glm::vec3 color;
+    float range;            // Distance at which the light fades out
+};
+
+/**
+ * SceneLayout - Everything needed to populate a scene.
+ */
+struct SceneLayout {
+    glm::vec3 size;                         // Room/lot size (X width, Y height, Z depth)
+    std::vector<CarPlacement> cars;         // Cars besides the hero car
+    std::vector<LightPlacement> lights;
+    std::vector<AABB> pillars;              // Pillar boxes (drawn and collided)
+};
+
+namespace SceneGenerator {
+    /**
+     * What the program should do after reading the command line.
+     */
+    enum class CommandLineResult {
+        RUN,            // Options read, start the program
+        EXIT_OK,        // Help shown; exit with status 0
+        EXIT_ERROR      // Bad option (already reported); exit with status 1
+    };
+    
+    /**
+     * Number of car paint presets a placement's paint index can refer to.
+     */
+    constexpr uint32_t PAINT_COUNT = 5;
+    
+    /**
+     * Build the layout for a configuration.
+     * Returns the standard showroom unless config.isGenerated().
+     */
+    SceneLayout createLayout(const SceneConfig& config);
+    
+    /**
+     * The hand-placed standard showroom.
+     */
+    SceneLayout createShowroomLayout();
+    
+    /**
+     * A seeded car lot with config.carCount cars.
+     */
+    SceneLayout createLotLayout(const SceneConfig& config);
+    
+    /**
+     * Read scene options from the command line.
+     * Options: --cars N, --detailed F, --lights M, --pillars SPACING,
+     * --seed S, --help.
+     * Values above an option's maximum (e.g. 1,000,000 cars) are rejected.
+     * @param config Output: updated with the options found
+     */
+    CommandLineResult parseCommandLine(int argc, char* argv[], SceneConfig& config);
+    
+    /**
+     * Print the command-line options.
+     */
+    void printUsage(const char* programName);
+}
+
+#endif // SCENE_GENERATOR_H
@@ -21,6 +21,7 @@
 #define SHADER_H
 
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 /**
@@ -63,7 +64,8 @@ public:
     
     /**
      * Activate this shader program for subsequent draw calls.
-     * Only one shader can be active at a time.
+     * Only one shader can be active at a time. Does nothing if this
+     * program is already active; don't mix with direct glUseProgram calls.
      */
     void use() const;
     
@@ -94,6 +96,11 @@ public:
      */
     void setInt(const std::string& name, int value) const;
     
+    /**
+     * Set an unsigned integer uniform (e.g. object IDs).
+     */
+    void setUInt(const std::string& name, unsigned int value) const;
+    
     /**
      * Set a float uniform.
      */
@@ -119,6 +126,12 @@ public:
     void setVec4(const std::string& name, const glm::vec4& value) const;
     void setVec4(const std::string& name, float x, float y, float z, float w) const;
     
+    /**
+     * Set an ivec2 or ivec4 uniform (e.g. index lists).
+     */
+    void setIVec2(const std::string& name, const glm::ivec2& value) const;
+    void setIVec4(const std::string& name, const glm::ivec4& value) const;
+    
     /**
      * Set a 3x3 matrix uniform.
      * Common uses: normal matrix (inverse transpose of model matrix)
@@ -134,6 +147,9 @@ public:
 private:
     unsigned int m_programID;
     
+    // Uniform name -> location, filled on first use of each name
+    mutable std::unordered_map<std::string, int> m_uniformLocations;
+    
     /**
      * Read shader source code from a file.
      */
@@ -153,8 +169,8 @@ private:
     
     /**
      * Get uniform location with caching.
-     * Note: In a production implementation, locations would be cached
-     * in a std::unordered_map for performance.
+     * Only the first lookup of a name queries OpenGL (and allocates); later
+     * ones are a hash lookup. Missing uniforms are cached as -1 too.
      */
     int getUniformLocation(const std::string& name) const;
 };
@@ -15,6 +15,26 @@
  * - Glass walls with exterior view (simulated)
  * - Multiple light sources for dramatic effect
  * 
+ * The placement of cars, lights and pillars comes from a SceneLayout
+ * (see SceneGenerator.h): the standard showroom by default, or a
+ * generated car lot of any size for scaling tests.
+ * 
+ * Streaming: given an AssetLoader, the scene only builds the environment
+ * and the main car up front. Background cars are built on the loader
+ * thread and join the scene through updateStreaming() while it is
+ * already being drawn.
+ * 
+ * Startup: fixed shapes (platform, pillars, car bodies and wheels) are
+ * tables built at compile time. Everything that depends on the layout is
+ * generated on the CPU first, fanned out over the shared ThreadPool
+ * (room planes, main car and every background car at once). The
+ * constructor then uploads everything in one pass on the calling thread
+ * and builds the cars' BVHs in parallel again.
+ * 
+ * Lighting of the static environment is baked into lightmaps at startup
+ * (see LightmapBaker.h) and cached on disk, so the floor, walls and
+ * pillars cost one texture fetch per pixel instead of every light.
+ * 
  * Design Decision: The scene owns all models and manages their lifetimes.
  * It provides access to objects for the renderer and input system without
  * exposing internal implementation details.
@@ -24,19 +44,27 @@
 #ifndef SHOWROOM_SCENE_H
 #define SHOWROOM_SCENE_H
 
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include "Light.h"
 #include "Collision.h"
+#include "SceneGenerator.h"
 
 class Model;
 class CarModel;
+class Material;
 class Mesh;
 class Shader;
 class Camera;
-class Renderer;
+class AssetLoader;
+struct CarGeometry;
+struct MeshData;
+struct FramePacket;
+struct TriangleHit;
 
 /**
  * ShowroomScene class - Contains and manages all scene objects.
@@ -44,9 +72,13 @@ class Renderer;
 class ShowroomScene {
 public:
     /**
-     * Create and initialize the showroom scene.
+     * Create and initialize the scene.
+     * @param config Standard showroom (default) or a generated car lot
+     * @param loader Streams background cars in if given (must outlive
+     *               the scene's pending loads); nullptr builds everything now
      */
-    ShowroomScene();
+    explicit ShowroomScene(const SceneConfig& config = SceneConfig(),
+                           AssetLoader* loader = nullptr);
     
     /**
      * Destructor.
@@ -67,14 +99,33 @@ public:
      */
     void update(float deltaTime);
     
-    // =========================================================================
-    // Rendering
-    // =========================================================================
+    /**
+     * Snapshot car transforms before a fixed (physics) step.
+     * See Model::storePreviousTransform.
+     */
+    void storePreviousTransforms();
     
     /**
-     * Submit all scene objects to the renderer.
+     * Set the blend between the previous and current physics step used
+     * for drawing (the fixed-step accumulator's leftover fraction).
      */
-    void render(Renderer& renderer) const;
+    void setRenderAlpha(float alpha);
+    
+    /**
+     * Add streamed background cars that have finished loading.
+     * Cars join in placement order, so pick IDs don't depend on timing.
+     * @return Number of cars added
+     */
+    size_t updateStreaming();
+    
+    /**
+     * Get the number of background cars still loading.
+     */
+    size_t getPendingCarCount() const { return m_pendingCars.size() - m_nextPendingCar; }
+    
+    // =========================================================================
+    // Rendering
+    // =========================================================================
     
     /**
      * Draw all scene objects with a specific shader.
@@ -82,6 +133,24 @@ public:
      */
     void draw(Shader& shader) const;
     
+    /**
+     * Draw all scene objects with their pick IDs (see ObjectPicker).
+     * The environment writes ID 0 so it still hides cars behind it.
+     */
+    void drawIds(Shader& idShader) const;
+    
+    /**
+     * Add draw items for every object to a frame packet, with the same
+     * pick IDs as drawIds(). Transparent items are sorted back to front
+     * from the packet's camera position.
+     */
+    void collectDrawItems(FramePacket& packet) const;
+    
+    /**
+     * Add a price tag label above every visible car with a price.
+     */
+    void collectPriceTags(FramePacket& packet) const;
+    
     // =========================================================================
     // Object Access
     // =========================================================================
@@ -99,6 +168,24 @@ public:
         return m_backgroundCars;
     }
     
+    /**
+     * Find the car with a pick object ID.
+     * ID 1 is the main car, 2 and up are the background cars.
+     * @return The car, or nullptr for 0 / unknown IDs
+     */
+    CarModel* getCarByPickId(uint32_t objectId);
+    
+    /**
+     * Find the car whose actual triangles a ray hits first.
+     * Unlike a bounding-box test, rays through gaps or past the
+     * rounded body miss correctly.
+     * @param ray World-space ray
+     * @param maxDistance Ignore hits further than this
+     * @param hit Output: triangle, UV, point and normal of the hit
+     * @return The car that was hit, or nullptr
+     */
+    CarModel* raycastCars(const Ray& ray, float maxDistance, TriangleHit& hit) const;
+    
     /**
      * Get environment models.
      */
@@ -131,6 +218,17 @@ public:
      */
     void applyLighting(Shader& shader) const;
     
+    /**
+     * Copy all lights into a frame packet.
+     */
+    void collectLights(FramePacket& packet) const;
+    
+    /**
+     * Set the packet's reflection probe: the platform center, and a
+     * version that changes whenever static geometry or lighting does.
+     */
+    void collectReflectionProbe(FramePacket& packet) const;
+    
     // =========================================================================
     // Collision
     // =========================================================================
@@ -151,6 +249,38 @@ public:
      */
     glm::vec3 constrainPosition(const glm::vec3& position, const glm::vec3& size) const;
     
+    /**
+     * Constrain a position using an oriented box (e.g. a turned car).
+     * The box must already be placed at 'position'.
+     */
+    glm::vec3 constrainPosition(const glm::vec3& position, const OBB& box) const;
+    
+    /**
+     * Separate cars that overlap each other.
+     * Uses the sort-and-sweep broadphase to find candidate pairs, then
+     * pushes each overlapping pair apart. Call once per physics step.
+     */
+    void resolveCarCollisions();
+    
+    /**
+     * Rebuild the car proximity grid from the cars' current positions.
+     * Call once per physics step, after collisions are resolved.
+     */
+    void updateSpatialGrid();
+    
+    /**
+     * Find the car whose center is closest to a point (e.g. the camera).
+     * @return The car, or nullptr if none is within maxDistance
+     */
+    CarModel* findNearestCar(const glm::vec3& point, float maxDistance) const;
+    
+    /**
+     * Find cars whose bounding circle overlaps a sphere (e.g. a light's range).
+     * @param outCars Output: matching cars (cleared first)
+     */
+    void findCarsInRadius(const glm::vec3& center, float radius,
+                          std::vector<CarModel*>& outCars) const;
+    
     // =========================================================================
     // Scene Configuration
     // =========================================================================
@@ -169,6 +299,7 @@ public:
      * Toggle showroom lights on/off.
      */
     void setLightsEnabled(bool enabled);
+    bool areLightsEnabled() const { return m_sunLight.enabled; }
     
 private:
     // Main featured car
@@ -177,44 +308,111 @@ private:
     // Background/placeholder cars
     std::vector<std::unique_ptr<CarModel>> m_backgroundCars;
     
+    // Background cars still on the asset loader, in placement order
+    std::vector<std::future<std::unique_ptr<CarModel>>> m_pendingCars;
+    size_t m_nextPendingCar = 0;            // First entry not yet added
+    
     // Environment (floor, walls, ceiling, decorations)
     std::vector<std::unique_ptr<Model>> m_environment;
+    std::vector<unsigned int> m_environmentLightmaps;   // Texture per environment model
     
     // Lighting
     DirectionalLight m_sunLight;
     std::vector<PointLight> m_pointLights;
     std::vector<SpotLight> m_spotLights;
     
+    // Bumped when anything the reflection probe captures changes
+    uint32_t m_staticVersion = 0;
+    
     // Collision
     CollisionWorld m_collisionWorld;
+    std::vector<CarModel*> m_dynamicCars;   // Indexed by broadphase proxy ID
+    SpatialHashGrid m_carGrid;              // Proximity queries over all cars
+    std::vector<CarModel*> m_gridCars;      // Indexed by grid entry ID
+    std::vector<glm::vec3> m_gridPositions; // Rebuild input, kept between steps
+    std::vector<float> m_gridRadii;
     
     // Scene dimensions
     glm::vec3 m_showroomSize;
+    std::vector<AABB> m_pillars;            // Free-standing pillars (drawn and collided)
+    
+    /**
+     * SceneGeometry - Generated startup meshes, built before any upload
+     * (defined in ShowroomScene.cpp).
+     */
+    struct SceneGeometry;
+    
+    /**
+     * Generate the startup geometry on the thread pool.
+     * @param withBackgroundCars False when the cars are streamed instead
+     */
+    SceneGeometry generateGeometry(const std::vector<CarPlacement>& placements,
+                                   bool withBackgroundCars) const;
+    
+    /**
+     * Create the showroom environment (floor, walls, pillars, etc.)
+     */
+    void createEnvironment(SceneGeometry& geometry);
     
     /**
-     * Create the showroom environment (floor, walls, etc.)
+     * Bake (or load from the cache file) a lightmap for every environment
+     * model, with the current lights.
+     * @param meshes One per m_environment entry; given lightmap UVs
+     * @param materials One per entry; lightMap is set to the new texture
      */
-    void createEnvironment();
+    void bakeLightmaps(std::vector<MeshData>& meshes, std::vector<Material>& materials);
     
     /**
      * Create the main featured car.
      */
-    void createMainCar();
+    void createMainCar(CarGeometry&& geometry);
+    
+    /**
+     * Create background cars from their placements and generated geometry
+     * (one entry per placement).
+     */
+    void createBackgroundCars(const std::vector<CarPlacement>& placements,
+                              std::vector<CarGeometry>&& geometry);
+    
+    /**
+     * Build the BVHs of every car in the scene, one car per task.
+     */
+    void buildCarBVHs();
     
     /**
-     * Create background cars.
+     * Queue background cars on the asset loader (see updateStreaming).
      */
-    void createBackgroundCars();
+    void streamBackgroundCars(const std::vector<CarPlacement>& placements,
+                              AssetLoader& loader);
     
     /**
-     * Set up the lighting.
+     * Upload one background car (without BVHs). Safe to call on the
+     * loader thread.
+     * @param number Used for the name ("Car <number>")
      */
-    void setupLighting();
+    static std::unique_ptr<CarModel> createBackgroundCar(const CarPlacement& placement,
+                                                         size_t number,
+                                                         CarGeometry&& geometry);
+    
+    /**
+     * Set up the lighting (point lights from their placements).
+     */
+    void setupLighting(const std::vector<LightPlacement>& lights);
     
     /**
      * Set up collision boundaries.
      */
     void setupCollision();
+    
+    /**
+     * Register a car as a moving body in the collision world.
+     */
+    void addDynamicCar(CarModel* car);
+    
+    /**
+     * Get a car's world-space bounds for the broadphase.
+     */
+    static AABB getCarBounds(const CarModel& car);
 };
 
 #endif // SHOWROOM_SCENE_H
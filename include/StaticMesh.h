@@ -0,0 +1,387 @@
+/**
+ * =============================================================================
+ * StaticMesh.h - Primitive Meshes Built at Compile Time
+ * =============================================================================
+ * constexpr versions of the fixed-shape MeshGenerator primitives. A table
+ * declared as
+ * 
+ *   constexpr auto WHEEL = StaticMesh::makeCylinder<24>(0.4f, 0.2f);
+ * 
+ * is computed by the compiler and stored in the executable's read-only
+ * data. Creating a Mesh from it uploads the array as it is: no vertex is
+ * generated, nothing is allocated, and the result is the same bytes on
+ * every run.
+ * 
+ * Tessellation is a template argument, because the array sizes must be
+ * known at compile time. Shapes whose size only comes from data at runtime
+ * (e.g. the floor of a generated lot) still use the MeshGenerator
+ * functions, which share the cube, plane and car body builders below.
+ * 
+ * Trigonometry: std::sin/std::cos are not constexpr, so rings use
+ * StaticMesh::sin/cos, evaluated in double precision with a Taylor
+ * series after range reduction. They are accurate to well below float
+ * precision over the angles used here.
+ * =============================================================================
+ */
+
+#ifndef STATIC_MESH_H
+#define STATIC_MESH_H
+
+#include <array>
+#include <cstddef>
+
+/**
+ * StaticVertex - A Vertex without constructors, so it can be built in
+ * constexpr code. Same 32-byte layout as Vertex (checked in Mesh.cpp).
+ */
+struct StaticVertex {
+    float position[3];
+    float normal[3];
+    float texCoords[2];
+};
+
+/**
+ * StaticMeshData - Vertex and index arrays of a compile-time mesh.
+ */
+template <size_t VERTEX_COUNT, size_t INDEX_COUNT>
+struct StaticMeshData {
+    std::array<StaticVertex, VERTEX_COUNT> vertices;
+    std::array<unsigned int, INDEX_COUNT> indices;
+};
+
+namespace StaticMesh {
+
+    constexpr double PI = 3.14159265358979323846;
+    
+    // =========================================================================
+    // constexpr Trigonometry
+    // =========================================================================
+    
+    /**
+     * Sine of an angle in radians (any angle).
+     */
+    constexpr double sin(double x) {
+        // Reduce to [-pi, pi], then to [-pi/2, pi/2] where the series
+        // converges fastest: sin(x) = sin(pi - x)
+        while (x > PI) x -= 2.0 * PI;
+        while (x < -PI) x += 2.0 * PI;
+        if (x > PI / 2.0) x = PI - x;
+        if (x < -PI / 2.0) x = -PI - x;
+        
+        // x - x^3/3! + x^5/5! - ...; 12 terms reach double precision here
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 12; n++) {
+            term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+            sum += term;
+        }
+        return sum;
+    }
+    
+    /**
+     * Cosine of an angle in radians (any angle).
+     */
+    constexpr double cos(double x) {
+        return sin(x + PI / 2.0);
+    }
+    
+    // =========================================================================
+    // Fixed Shapes
+    // =========================================================================
+    
+    /**
+     * Write one vertex.
+     */
+    constexpr StaticVertex vertex(float px, float py, float pz,
+                                  float nx, float ny, float nz,
+                                  float u, float v) {
+        return {{px, py, pz}, {nx, ny, nz}, {u, v}};
+    }
+    
+    /**
+     * Cube centered on the origin (same layout as MeshGenerator::createCube).
+     * @param size Side length of the cube
+     */
+    constexpr StaticMeshData<24, 36> makeCube(float size) {
+        float h = size / 2.0f;
+        return {{{
+            // Front face
+            vertex(-h, -h,  h,   0,  0,  1,  0, 0),
+            vertex( h, -h,  h,   0,  0,  1,  1, 0),
+            vertex( h,  h,  h,   0,  0,  1,  1, 1),
+            vertex(-h,  h,  h,   0,  0,  1,  0, 1),
+            // Back face
+            vertex( h, -h, -h,   0,  0, -1,  0, 0),
+            vertex(-h, -h, -h,   0,  0, -1,  1, 0),
+            vertex(-h,  h, -h,   0,  0, -1,  1, 1),
+            vertex( h,  h, -h,   0,  0, -1,  0, 1),
+            // Top face
+            vertex(-h,  h,  h,   0,  1,  0,  0, 0),
+            vertex( h,  h,  h,   0,  1,  0,  1, 0),
+            vertex( h,  h, -h,   0,  1,  0,  1, 1),
+            vertex(-h,  h, -h,   0,  1,  0,  0, 1),
+            // Bottom face
+            vertex(-h, -h, -h,   0, -1,  0,  0, 0),
+            vertex( h, -h, -h,   0, -1,  0,  1, 0),
+            vertex( h, -h,  h,   0, -1,  0,  1, 1),
+            vertex(-h, -h,  h,   0, -1,  0,  0, 1),
+            // Right face
+            vertex( h, -h,  h,   1,  0,  0,  0, 0),
+            vertex( h, -h, -h,   1,  0,  0,  1, 0),
+            vertex( h,  h, -h,   1,  0,  0,  1, 1),
+            vertex( h,  h,  h,   1,  0,  0,  0, 1),
+            // Left face
+            vertex(-h, -h, -h,  -1,  0,  0,  0, 0),
+            vertex(-h, -h,  h,  -1,  0,  0,  1, 0),
+            vertex(-h,  h,  h,  -1,  0,  0,  1, 1),
+            vertex(-h,  h, -h,  -1,  0,  0,  0, 1),
+        }}, {{
+            0, 1, 2, 2, 3, 0,       // Front
+            4, 5, 6, 6, 7, 4,       // Back
+            8, 9, 10, 10, 11, 8,    // Top
+            12, 13, 14, 14, 15, 12, // Bottom
+            16, 17, 18, 18, 19, 16, // Right
+            20, 21, 22, 22, 23, 20  // Left
+        }}};
+    }
+    
+    /**
+     * Horizontal plane facing +Y (same layout as MeshGenerator::createPlane).
+     */
+    constexpr StaticMeshData<4, 6> makePlane(float width, float depth,
+                                             float uScale, float vScale) {
+        float hw = width / 2.0f;
+        float hd = depth / 2.0f;
+        return {{{
+            vertex(-hw, 0, -hd,  0, 1, 0,  0, 0),
+            vertex( hw, 0, -hd,  0, 1, 0,  uScale, 0),
+            vertex( hw, 0,  hd,  0, 1, 0,  uScale, vScale),
+            vertex(-hw, 0,  hd,  0, 1, 0,  0, vScale),
+        }}, {{0, 1, 2, 2, 3, 0}}};
+    }
+    
+    /**
+     * Simplified car body: 10 quads (see MeshGenerator::createCarBody).
+     */
+    constexpr StaticMeshData<40, 60> makeCarBody() {
+        // Car dimensions
+        float length = 4.0f;
+        float width = 1.8f;
+        float bodyHeight = 0.8f;
+        float cabinHeight = 0.7f;
+        float hoodLength = 1.2f;
+        float trunkLength = 0.8f;
+        
+        float hl = length / 2.0f;
+        float hw = width / 2.0f;
+        float hoodStart = hl - hoodLength;
+        float trunkEnd = -hl + trunkLength;
+        
+        // Cabin (raised middle section)
+        float cabinFront = hoodStart;
+        float cabinBack = trunkEnd;
+        float cabinTop = bodyHeight + cabinHeight;
+        float cabinWidth = hw * 0.9f;
+        
+        StaticMeshData<40, 60> mesh{{{
+            // Lower body: front
+            vertex(-hl, 0, -hw,  0, 0, -1,  0, 0),
+            vertex( hl, 0, -hw,  0, 0, -1,  1, 0),
+            vertex( hl, bodyHeight, -hw,  0, 0, -1,  1, 1),
+            vertex(-hl, bodyHeight, -hw,  0, 0, -1,  0, 1),
+            // Back
+            vertex( hl, 0, hw,  0, 0, 1,  0, 0),
+            vertex(-hl, 0, hw,  0, 0, 1,  1, 0),
+            vertex(-hl, bodyHeight, hw,  0, 0, 1,  1, 1),
+            vertex( hl, bodyHeight, hw,  0, 0, 1,  0, 1),
+            // Left side
+            vertex(-hl, 0, hw,  -1, 0, 0,  0, 0),
+            vertex(-hl, 0, -hw,  -1, 0, 0,  1, 0),
+            vertex(-hl, bodyHeight, -hw,  -1, 0, 0,  1, 1),
+            vertex(-hl, bodyHeight, hw,  -1, 0, 0,  0, 1),
+            // Right side
+            vertex( hl, 0, -hw,  1, 0, 0,  0, 0),
+            vertex( hl, 0, hw,  1, 0, 0,  1, 0),
+            vertex( hl, bodyHeight, hw,  1, 0, 0,  1, 1),
+            vertex( hl, bodyHeight, -hw,  1, 0, 0,  0, 1),
+            // Bottom
+            vertex(-hl, 0, hw,  0, -1, 0,  0, 0),
+            vertex( hl, 0, hw,  0, -1, 0,  1, 0),
+            vertex( hl, 0, -hw,  0, -1, 0,  1, 1),
+            vertex(-hl, 0, -hw,  0, -1, 0,  0, 1),
+            // Hood (top of front section)
+            vertex(hoodStart, bodyHeight, -hw,  0, 1, 0,  0, 0),
+            vertex(hl, bodyHeight, -hw,  0, 1, 0,  1, 0),
+            vertex(hl, bodyHeight, hw,  0, 1, 0,  1, 1),
+            vertex(hoodStart, bodyHeight, hw,  0, 1, 0,  0, 1),
+            // Trunk (top of rear section)
+            vertex(-hl, bodyHeight, -hw,  0, 1, 0,  0, 0),
+            vertex(trunkEnd, bodyHeight, -hw,  0, 1, 0,  1, 0),
+            vertex(trunkEnd, bodyHeight, hw,  0, 1, 0,  1, 1),
+            vertex(-hl, bodyHeight, hw,  0, 1, 0,  0, 1),
+            // Cabin front (windshield area)
+            vertex(cabinFront, bodyHeight, -cabinWidth,  0.7f, 0.7f, 0,  0, 0),
+            vertex(cabinFront + 0.3f, cabinTop, -cabinWidth,  0.7f, 0.7f, 0,  1, 0),
+            vertex(cabinFront + 0.3f, cabinTop, cabinWidth,  0.7f, 0.7f, 0,  1, 1),
+            vertex(cabinFront, bodyHeight, cabinWidth,  0.7f, 0.7f, 0,  0, 1),
+            // Cabin back (rear window area)
+            vertex(cabinBack, bodyHeight, cabinWidth,  -0.7f, 0.7f, 0,  0, 0),
+            vertex(cabinBack - 0.3f, cabinTop, cabinWidth,  -0.7f, 0.7f, 0,  1, 0),
+            vertex(cabinBack - 0.3f, cabinTop, -cabinWidth,  -0.7f, 0.7f, 0,  1, 1),
+            vertex(cabinBack, bodyHeight, -cabinWidth,  -0.7f, 0.7f, 0,  0, 1),
+            // Cabin roof
+            vertex(cabinFront + 0.3f, cabinTop, -cabinWidth,  0, 1, 0,  0, 0),
+            vertex(cabinBack - 0.3f, cabinTop, -cabinWidth,  0, 1, 0,  1, 0),
+            vertex(cabinBack - 0.3f, cabinTop, cabinWidth,  0, 1, 0,  1, 1),
+            vertex(cabinFront + 0.3f, cabinTop, cabinWidth,  0, 1, 0,  0, 1),
+        }}, {}};
+        
+        // Two triangles per quad
+        for (unsigned int quad = 0; quad < 10; quad++) {
+            unsigned int i = 4 * quad;
+            unsigned int* out = &mesh.indices[6 * quad];
+            out[0] = i;
+            out[1] = i + 1;
+            out[2] = i + 2;
+            out[3] = i + 2;
+            out[4] = i + 3;
+            out[5] = i;
+        }
+        return mesh;
+    }
+    
+    // =========================================================================
+    // Tessellated Shapes
+    // =========================================================================
+    
+    /**
+     * Cylinder along Y, centered on the origin, with both caps (same
+     * layout as MeshGenerator::createCylinder).
+     */
+    template <int SECTORS>
+    constexpr StaticMeshData<2 * (SECTORS + 1) + 2 * (SECTORS + 2), 12 * SECTORS>
+    makeCylinder(float radius, float height) {
+        static_assert(SECTORS >= 3, "A cylinder needs at least 3 sectors");
+        
+        StaticMeshData<2 * (SECTORS + 1) + 2 * (SECTORS + 2), 12 * SECTORS> mesh{};
+        
+        // One ring, shared by the side and both caps
+        float cosines[SECTORS + 1] = {};
+        float sines[SECTORS + 1] = {};
+        for (int j = 0; j <= SECTORS; j++) {
+            double angle = 2.0 * PI * j / SECTORS;
+            cosines[j] = static_cast<float>(cos(angle));
+            sines[j] = static_cast<float>(sin(angle));
+        }
+        
+        float halfHeight = height / 2.0f;
+        size_t v = 0;
+        size_t i = 0;
+        
+        // Side vertices: bottom ring, then top ring
+        for (int ring = 0; ring <= 1; ring++) {
+            float y = (ring == 0) ? -halfHeight : halfHeight;
+            for (int j = 0; j <= SECTORS; j++) {
+                mesh.vertices[v++] = vertex(radius * cosines[j], y, radius * sines[j],
+                                            cosines[j], 0.0f, sines[j],
+                                            static_cast<float>(j) / SECTORS,
+                                            static_cast<float>(ring));
+            }
+        }
+        
+        // Side indices
+        for (unsigned int j = 0; j < SECTORS; j++) {
+            unsigned int k1 = j;
+            unsigned int k2 = j + SECTORS + 1;
+            mesh.indices[i++] = k1;
+            mesh.indices[i++] = k2;
+            mesh.indices[i++] = k1 + 1;
+            mesh.indices[i++] = k1 + 1;
+            mesh.indices[i++] = k2;
+            mesh.indices[i++] = k2 + 1;
+        }
+        
+        // Caps: a center vertex and a ring each, wound to face outwards
+        for (int cap = 0; cap <= 1; cap++) {
+            float y = (cap == 0) ? halfHeight : -halfHeight;
+            float ny = (cap == 0) ? 1.0f : -1.0f;
+            unsigned int base = static_cast<unsigned int>(v);
+            
+            mesh.vertices[v++] = vertex(0.0f, y, 0.0f, 0.0f, ny, 0.0f, 0.5f, 0.5f);
+            for (int j = 0; j <= SECTORS; j++) {
+                mesh.vertices[v++] = vertex(radius * cosines[j], y, radius * sines[j],
+                                            0.0f, ny, 0.0f,
+                                            0.5f + 0.5f * cosines[j],
+                                            0.5f + 0.5f * sines[j]);
+            }
+            
+            for (unsigned int j = 0; j < SECTORS; j++) {
+                mesh.indices[i++] = base;
+                mesh.indices[i++] = (cap == 0) ? base + j + 2 : base + j + 1;
+                mesh.indices[i++] = (cap == 0) ? base + j + 1 : base + j + 2;
+            }
+        }
+        return mesh;
+    }
+    
+    /**
+     * UV sphere centered on the origin (same layout as
+     * MeshGenerator::createSphere).
+     */
+    template <int SECTORS, int STACKS>
+    constexpr StaticMeshData<(STACKS + 1) * (SECTORS + 1), 6 * SECTORS * (STACKS - 1)>
+    makeSphere(float radius) {
+        static_assert(SECTORS >= 3 && STACKS >= 2, "A sphere needs at least 3 sectors and 2 stacks");
+        
+        StaticMeshData<(STACKS + 1) * (SECTORS + 1), 6 * SECTORS * (STACKS - 1)> mesh{};
+        
+        float cosines[SECTORS + 1] = {};
+        float sines[SECTORS + 1] = {};
+        for (int j = 0; j <= SECTORS; j++) {
+            double angle = 2.0 * PI * j / SECTORS;
+            cosines[j] = static_cast<float>(cos(angle));
+            sines[j] = static_cast<float>(sin(angle));
+        }
+        
+        // Vertices, from the north pole down; the normal is the position
+        // over the radius
+        size_t v = 0;
+        for (int stack = 0; stack <= STACKS; stack++) {
+            double stackAngle = PI / 2.0 - PI * stack / STACKS;
+            float ringScale = static_cast<float>(cos(stackAngle));
+            float height = static_cast<float>(sin(stackAngle));
+            
+            for (int j = 0; j <= SECTORS; j++) {
+                float nx = ringScale * cosines[j];
+                float nz = ringScale * sines[j];
+                mesh.vertices[v++] = vertex(radius * nx, radius * height, radius * nz,
+                                            nx, height, nz,
+                                            static_cast<float>(j) / SECTORS,
+                                            static_cast<float>(stack) / STACKS);
+            }
+        }
+        
+        // Indices: one triangle per sector in the pole stacks, two elsewhere
+        size_t i = 0;
+        for (int stack = 0; stack < STACKS; stack++) {
+            unsigned int k1 = static_cast<unsigned int>(stack * (SECTORS + 1));
+            unsigned int k2 = k1 + SECTORS + 1;
+            
+            for (int j = 0; j < SECTORS; j++, k1++, k2++) {
+                if (stack != 0) {
+                    mesh.indices[i++] = k1;
+                    mesh.indices[i++] = k2;
+                    mesh.indices[i++] = k1 + 1;
+                }
+                if (stack != STACKS - 1) {
+                    mesh.indices[i++] = k1 + 1;
+                    mesh.indices[i++] = k2;
+                    mesh.indices[i++] = k2 + 1;
+                }
+            }
+        }
+        return mesh;
+    }
+}
+
+#endif // STATIC_MESH_H
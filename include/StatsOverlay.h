@@ -0,0 +1,94 @@
+/**
+ * =============================================================================
+ * StatsOverlay.h - On-Screen Frame Statistics Graphs
+ * =============================================================================
+ * Draws history graphs of the last HISTORY_SIZE frames in the top-left
+ * corner, one strip per metric:
+ * - CPU main thread time (blue)
+ * - CPU render thread time (green)
+ * - GPU time (orange)
+ * - Draw calls (purple)
+ * Time strips span 0..33 ms with a white line at 16.7 ms (60 FPS). The
+ * draw call strip scales to the largest value in its history. Each strip
+ * is labelled with its latest value, and a line below adds triangles,
+ * state changes and uploads of the last frame.
+ * 
+ * Cost: every bar, background and line is a solid rectangle, and the
+ * numbers are text, all added to the caller's TextRenderer batch. The
+ * overlay has no buffers or draw of its own; it is drawn with the rest of
+ * the frame's text in one call, and adding it does not allocate.
+ * =============================================================================
+ */
+
+#ifndef STATS_OVERLAY_H
+#define STATS_OVERLAY_H
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+#include "RenderStats.h"
+
+class TextRenderer;
+
+/**
+ * StatsOverlay class - History graphs of RenderStats, drawn as text-batch quads.
+ * 
+ * Usage (render thread, once per frame):
+ *   overlay.draw(text);                   // Graphs up to the last frame
+ *   text.flush();                         // Draws them with the other text
+ *   overlay.addFrame(stats);              // Then record this frame
+ */
+class StatsOverlay {
+public:
+    static constexpr size_t HISTORY_SIZE = 120;
+    
+    /**
+     * Start with an empty history.
+     */
+    StatsOverlay();
+    
+    /**
+     * Record one finished frame.
+     */
+    void addFrame(const RenderStats& stats);
+    
+    /**
+     * Add the graphs and their numbers to a text batch, drawn by its
+     * next flush().
+     */
+    void draw(TextRenderer& text) const;
+
+private:
+    /**
+     * Metrics with a strip each, top to bottom.
+     */
+    enum Metric {
+        CPU_MAIN,
+        CPU_RENDER,
+        GPU,
+        DRAW_CALLS,
+        METRIC_COUNT
+    };
+    
+    // Ring buffer of past frames, one array per metric
+    std::array<std::array<float, HISTORY_SIZE>, METRIC_COUNT> m_history;
+    size_t m_historyCount;
+    size_t m_historyIndex;          // Slot of the next frame
+    RenderStats m_lastFrame;        // Counters of the newest frame
+    
+    /**
+     * Add one metric's strip: background, bars and an optional line.
+     * @param scale Value at the top of the strip
+     * @param line Value to mark with a line (0 = none)
+     */
+    void addStrip(TextRenderer& text, Metric metric, float top, float scale, float line,
+                  const glm::vec4& color) const;
+    
+    /**
+     * Add the text beside the strips and the summary line below them.
+     */
+    void addNumbers(TextRenderer& text, float top) const;
+};
+
+#endif // STATS_OVERLAY_H
@@ -0,0 +1,144 @@
+/**
+ * =============================================================================
+ * TextRenderer.h - Batched Screen-Space Text
+ * =============================================================================
+ * Draws 2D text over the frame: price tags above the cars, the numbers
+ * next to the statistics graphs, and any other HUD text.
+ * 
+ * Glyphs come from an 8x8 bitmap font built into the program (printable
+ * ASCII). At startup every glyph is copied once into a single-channel
+ * atlas texture; after that no glyph is ever rasterized again.
+ * 
+ * Text is not drawn when it is added. Each character becomes one quad in
+ * a CPU vertex array, and flush() uploads the whole array into one
+ * streaming buffer and draws every quad with a single glDrawElements.
+ * Hundreds of labels therefore cost one draw call and one upload, and
+ * the per-character work is a handful of float writes.
+ * 
+ * Quads share a static index buffer (0-1-2, 0-2-3 per quad) built once
+ * for MAX_GLYPHS, so each character uploads 4 vertices instead of 6.
+ * The vertex array is reserved up front, so adding text does not allocate.
+ * =============================================================================
+ */
+
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Shader;
+
+/**
+ * TextRenderer class - Collects text quads and draws them in one call.
+ * 
+ * Usage (render thread, once per frame):
+ *   text.begin(width, height);
+ *   text.addText("Hello", 10.0f, 10.0f, 2.0f, white);
+ *   text.addLabel("$24,900", carTop, viewProjection, 2.0f, white, black);
+ *   text.flush();                      // One draw for everything above
+ */
+class TextRenderer {
+public:
+    static constexpr int GLYPH_SIZE = 8;            // Glyph cell in font pixels
+    static constexpr size_t MAX_GLYPHS = 16384;     // Quads per frame (extra ones are dropped)
+    
+    /**
+     * Build the glyph atlas, shader and buffers. Requires a current GL context.
+     */
+    TextRenderer();
+    
+    /**
+     * Destructor - Frees the GL objects (call with the context current).
+     */
+    ~TextRenderer();
+    
+    // Disable copying
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+    
+    /**
+     * Start a new batch.
+     * @param width Framebuffer width in pixels
+     * @param height Framebuffer height in pixels
+     */
+    void begin(int width, int height);
+    
+    /**
+     * Add a line of text. Characters outside printable ASCII draw as '?'.
+     * @param x Left edge in pixels from the left of the screen
+     * @param y Top edge in pixels from the top of the screen
+     * @param scale Screen pixels per font pixel (1 = 8 pixel glyphs)
+     */
+    void addText(std::string_view text, float x, float y, float scale, const glm::vec4& color);
+    
+    /**
+     * Add a solid rectangle (text backgrounds, panels), in pixels from the
+     * top-left corner. Drawn in the same batch as the text.
+     */
+    void addRect(float x, float y, float width, float height, const glm::vec4& color);
+    
+    /**
+     * Add text centered above a point in the world, on a background box.
+     * @param viewProjection Projection * view of the camera
+     * @return false if the point is behind the camera or off screen
+     */
+    bool addLabel(std::string_view text, const glm::vec3& worldPosition,
+                  const glm::mat4& viewProjection, float scale,
+                  const glm::vec4& textColor, const glm::vec4& backgroundColor);
+    
+    /**
+     * Upload the batch and draw it over the current framebuffer.
+     * Does nothing if the batch is empty.
+     */
+    void flush();
+    
+    /**
+     * Get the width of a line of text in pixels.
+     */
+    static float measure(std::string_view text, float scale);
+    
+    /**
+     * Get the number of quads (characters and rectangles) in the batch.
+     */
+    size_t getQuadCount() const { return m_vertices.size() / 4; }
+
+private:
+    /**
+     * TextVertex - Corner of a glyph quad, 20 bytes.
+     */
+    struct TextVertex {
+        glm::vec2 position;         // Pixels from the top-left corner
+        glm::vec2 texCoord;         // Into the glyph atlas
+        uint32_t color;             // RGBA8, normalized by the vertex fetch
+    };
+    
+    std::unique_ptr<Shader> m_shader;
+    unsigned int m_atlas;
+    unsigned int m_VAO;
+    unsigned int m_VBO;
+    unsigned int m_EBO;
+    
+    std::vector<TextVertex> m_vertices;
+    
+    // Size the batch is laid out for
+    float m_pixelWidth;
+    float m_pixelHeight;
+    
+    /**
+     * Create the atlas texture from the built-in font.
+     */
+    void createAtlas();
+    
+    /**
+     * Add one textured quad. Dropped once MAX_GLYPHS is reached.
+     */
+    void addQuad(float x, float y, float width, float height,
+                 const glm::vec2& uvMin, const glm::vec2& uvMax, uint32_t color);
+};
+
+#endif // TEXT_RENDERER_H
@@ -0,0 +1,122 @@
+/**
+ * =============================================================================
+ * ThreadPool.h - Worker Threads for Data-Parallel Loops
+ * =============================================================================
+ * A small pool of persistent worker threads that split a loop into chunks.
+ * Used for CPU-heavy, embarrassingly parallel work such as building
+ * acceleration structures for large meshes.
+ * 
+ * How parallelFor works:
+ * - The range [0, count) is cut into chunks of grainSize items.
+ * - Workers and the calling thread take chunks from a shared atomic counter
+ *   until none are left, so fast threads simply take more chunks.
+ * - The call returns once every chunk has finished.
+ * 
+ * Design Decision: The caller always helps with its own loop. A
+ * parallelFor issued from inside a loop body (on any thread), or while
+ * another thread's loop is running, runs on the calling thread alone, so
+ * nesting can never deadlock waiting for busy workers.
+ * =============================================================================
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * ThreadPool class - Runs loop chunks on worker threads.
+ * 
+ * Usage:
+ *   ThreadPool::getShared().parallelFor(count, 1024, [&](size_t begin, size_t end) {
+ *       for (size_t i = begin; i < end; i++) { ... }
+ *   });
+ */
+class ThreadPool {
+public:
+    /**
+     * Loop body: processes items [begin, end).
+     */
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+    
+    /**
+     * Create the pool.
+     * @param workerCount Worker threads to start; 0 = one per extra hardware thread
+     */
+    explicit ThreadPool(unsigned int workerCount = 0);
+    
+    /**
+     * Destructor - Stops and joins all workers.
+     */
+    ~ThreadPool();
+    
+    // Disable copying
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * Get the process-wide pool (created on first use).
+     */
+    static ThreadPool& getShared();
+    
+    /**
+     * Run body over [0, count) in chunks and wait for all of them.
+     * @param count Number of items
+     * @param grainSize Items per chunk (at least 1)
+     * @param body Called once per chunk, possibly on several threads at once.
+     *             If it throws, the remaining chunks are skipped and the
+     *             first exception is rethrown here.
+     */
+    void parallelFor(size_t count, size_t grainSize, const RangeFunction& body);
+    
+    /**
+     * Get the number of worker threads (not counting the caller).
+     */
+    size_t getWorkerCount() const { return m_workers.size(); }
+
+private:
+    /**
+     * Job - One parallelFor call being processed.
+     */
+    struct Job {
+        const RangeFunction* body = nullptr;
+        size_t count = 0;
+        size_t grainSize = 1;
+        size_t chunkCount = 0;
+        std::atomic<size_t> nextChunk{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;       // First exception a chunk threw
+    };
+    
+    std::vector<std::thread> m_workers;
+    
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;    // Workers wait here for jobs
+    std::condition_variable m_doneCondition;    // Caller waits here for workers
+    Job* m_job = nullptr;                       // Current job (guarded by m_mutex)
+    unsigned int m_jobGeneration = 0;           // Bumped for every new job
+    unsigned int m_busyWorkers = 0;             // Workers still inside m_job
+    bool m_stop = false;
+    
+    std::mutex m_jobMutex;                      // Held by the running top-level parallelFor
+    
+    /**
+     * Worker thread main loop.
+     */
+    void workerLoop();
+    
+    /**
+     * Take and run chunks of a job until none are left. An exception from
+     * the body is stored in the job instead of propagating.
+     */
+    static void runChunks(Job& job);
+};
+
+#endif // THREAD_POOL_H
@@ -84,6 +84,25 @@ public:
      */
     void pollEvents();
     
+    /**
+     * Make this window's OpenGL context current on the calling thread.
+     * A context is current on at most one thread at a time; see RenderThread.
+     */
+    void makeContextCurrent();
+    
+    /**
+     * Release whatever context is current on the calling thread.
+     */
+    static void detachContext();
+    
+    /**
+     * Create a hidden window whose context shares objects (buffers,
+     * textures, shaders, syncs, but not VAOs or FBOs) with this one.
+     * Call on the main thread; the caller destroys it with glfwDestroyWindow.
+     * @return The hidden window, or nullptr if it could not be created
+     */
+    GLFWwindow* createSharedContext() const;
+    
     /**
      * Get current window dimensions.
      */
@@ -97,6 +116,12 @@ public:
      */
     GLFWwindow* getHandle() const { return m_window; }
     
+    /**
+     * Show status text after the title (e.g., frame statistics).
+     * Call on the main thread. An empty string shows just the title.
+     */
+    void setTitleStatus(const std::string& status);
+    
     /**
      * Set cursor mode.
      * @param captured true to hide and capture cursor (FPS-style), false for normal
@@ -113,6 +138,13 @@ public:
      */
     void getMousePosition(double& x, double& y) const;
     
+    /**
+     * Set how many display refreshes a swap waits for.
+     * 1 = vsync, 0 = no wait, -1 = adaptive vsync (needs swap control tear).
+     * See FramePacer for choosing between them.
+     */
+    void setSwapInterval(int interval);
+    
     // Event callback setters
     void setFramebufferSizeCallback(FramebufferSizeCallback callback);
     void setKeyCallback(KeyCallback callback);
@@ -69,6 +69,7 @@ typedef khronos_intptr_t GLintptr;
 typedef khronos_ssize_t GLsizeiptr;
 typedef khronos_int64_t GLint64;
 typedef khronos_uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
 
 // =============================================================================
 // OpenGL Constants
@@ -87,6 +88,7 @@ typedef khronos_uint64_t GLuint64;
 #define GL_INT 0x1404
 #define GL_UNSIGNED_INT 0x1405
 #define GL_FLOAT 0x1406
+#define GL_HALF_FLOAT 0x140B
 
 // Primitive types (how vertices are interpreted)
 #define GL_POINTS 0x0000
@@ -107,6 +109,7 @@ typedef khronos_uint64_t GLuint64;
 #define GL_BLEND 0x0BE2
 #define GL_CULL_FACE 0x0B44
 #define GL_SCISSOR_TEST 0x0C11
+#define GL_TEXTURE_CUBE_MAP_SEAMLESS 0x884F
 
 // Blend functions
 #define GL_SRC_ALPHA 0x0302
@@ -141,6 +144,9 @@ typedef khronos_uint64_t GLuint64;
 // Buffer types
 #define GL_ARRAY_BUFFER 0x8892
 #define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_INVALID_INDEX 0xFFFFFFFFu
 
 // Buffer usage hints
 #define GL_STREAM_DRAW 0x88E0
@@ -150,12 +156,16 @@ typedef khronos_uint64_t GLuint64;
 // Texture targets
 #define GL_TEXTURE_2D 0x0DE1
 #define GL_TEXTURE_CUBE_MAP 0x8513
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_X 0x8515
 
 // Texture parameters
 #define GL_TEXTURE_MIN_FILTER 0x2801
 #define GL_TEXTURE_MAG_FILTER 0x2800
 #define GL_TEXTURE_WRAP_S 0x2802
 #define GL_TEXTURE_WRAP_T 0x2803
+#define GL_TEXTURE_WRAP_R 0x8072
+#define GL_TEXTURE_BASE_LEVEL 0x813C
+#define GL_TEXTURE_MAX_LEVEL 0x813D
 #define GL_NEAREST 0x2600
 #define GL_LINEAR 0x2601
 #define GL_NEAREST_MIPMAP_NEAREST 0x2700
@@ -174,12 +184,57 @@ typedef khronos_uint64_t GLuint64;
 #define GL_TEXTURE3 0x84C3
 
 // Pixel formats
+#define GL_DEPTH_COMPONENT 0x1902
 #define GL_RED 0x1903
 #define GL_RGB 0x1907
 #define GL_RGBA 0x1908
 #define GL_BGR 0x80E0
 #define GL_BGRA 0x80E1
 
+// Framebuffer objects (render to texture)
+#define GL_FRAMEBUFFER 0x8D40
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#define GL_DRAW_FRAMEBUFFER 0x8CA9
+#define GL_RENDERBUFFER 0x8D41
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#define GL_COLOR_ATTACHMENT1 0x8CE1
+#define GL_DEPTH_ATTACHMENT 0x8D00
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#define GL_COLOR 0x1800
+#define GL_NONE 0
+
+// Sized internal formats
+#define GL_DEPTH_COMPONENT24 0x81A6
+#define GL_R32UI 0x8236
+#define GL_RED_INTEGER 0x8D94
+#define GL_R8 0x8229
+#define GL_RG 0x8227
+#define GL_RG16F 0x822F
+#define GL_RGBA8 0x8058
+#define GL_RGBA16F 0x881A
+#define GL_RGB16F 0x881B
+
+// Pixel storage
+#define GL_UNPACK_ALIGNMENT 0x0CF5
+
+// Pixel buffer objects and mapping (asynchronous readback)
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#define GL_STREAM_READ 0x88E1
+#define GL_MAP_READ_BIT 0x0001
+
+// Sync objects (fences)
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+
+// Query objects (GPU timer queries)
+#define GL_TIMESTAMP 0x8E28
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+
 // Error codes
 #define GL_NO_ERROR 0
 #define GL_INVALID_ENUM 0x0500
@@ -227,6 +282,13 @@ typedef void (APIENTRYP PFNGLFRONTFACEPROC)(GLenum mode);
 typedef void (APIENTRYP PFNGLDEPTHMASKPROC)(GLboolean flag);
 typedef GLenum (APIENTRYP PFNGLGETERRORPROC)(void);
 typedef const GLubyte* (APIENTRYP PFNGLGETSTRINGPROC)(GLenum name);
+typedef void (APIENTRYP PFNGLGETINTEGERVPROC)(GLenum pname, GLint* data);
+typedef void (APIENTRYP PFNGLSCISSORPROC)(GLint x, GLint y, GLsizei width, GLsizei height);
+typedef void (APIENTRYP PFNGLREADPIXELSPROC)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels);
+typedef void (APIENTRYP PFNGLREADBUFFERPROC)(GLenum src);
+typedef void (APIENTRYP PFNGLDRAWBUFFERPROC)(GLenum buf);
+typedef void (APIENTRYP PFNGLDRAWBUFFERSPROC)(GLsizei n, const GLenum* bufs);
+typedef void (APIENTRYP PFNGLCOLORMASKIPROC)(GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a);
 
 GLAPI PFNGLCLEARCOLORPROC glClearColor;
 GLAPI PFNGLCLEARPROC glClear;
@@ -240,6 +302,13 @@ GLAPI PFNGLFRONTFACEPROC glFrontFace;
 GLAPI PFNGLDEPTHMASKPROC glDepthMask;
 GLAPI PFNGLGETERRORPROC glGetError;
 GLAPI PFNGLGETSTRINGPROC glGetString;
+GLAPI PFNGLGETINTEGERVPROC glGetIntegerv;
+GLAPI PFNGLSCISSORPROC glScissor;
+GLAPI PFNGLREADPIXELSPROC glReadPixels;
+GLAPI PFNGLREADBUFFERPROC glReadBuffer;
+GLAPI PFNGLDRAWBUFFERPROC glDrawBuffer;
+GLAPI PFNGLDRAWBUFFERSPROC glDrawBuffers;
+GLAPI PFNGLCOLORMASKIPROC glColorMaski;
 
 // Shader functions
 typedef GLuint (APIENTRYP PFNGLCREATESHADERPROC)(GLenum type);
@@ -256,6 +325,8 @@ typedef void (APIENTRYP PFNGLGETPROGRAMINFOLOGPROC)(GLuint program, GLsizei bufS
 typedef void (APIENTRYP PFNGLUSEPROGRAMPROC)(GLuint program);
 typedef void (APIENTRYP PFNGLDELETEPROGRAMPROC)(GLuint program);
 typedef GLint (APIENTRYP PFNGLGETUNIFORMLOCATIONPROC)(GLuint program, const GLchar* name);
+typedef GLuint (APIENTRYP PFNGLGETUNIFORMBLOCKINDEXPROC)(GLuint program, const GLchar* uniformBlockName);
+typedef void (APIENTRYP PFNGLUNIFORMBLOCKBINDINGPROC)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
 
 GLAPI PFNGLCREATESHADERPROC glCreateShader;
 GLAPI PFNGLSHADERSOURCEPROC glShaderSource;
@@ -271,9 +342,14 @@ GLAPI PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
 GLAPI PFNGLUSEPROGRAMPROC glUseProgram;
 GLAPI PFNGLDELETEPROGRAMPROC glDeleteProgram;
 GLAPI PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
+GLAPI PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
+GLAPI PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
 
 // Uniform functions (for passing data to shaders)
 typedef void (APIENTRYP PFNGLUNIFORM1IPROC)(GLint location, GLint v0);
+typedef void (APIENTRYP PFNGLUNIFORM2IPROC)(GLint location, GLint v0, GLint v1);
+typedef void (APIENTRYP PFNGLUNIFORM4IPROC)(GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
+typedef void (APIENTRYP PFNGLUNIFORM1UIPROC)(GLint location, GLuint v0);
 typedef void (APIENTRYP PFNGLUNIFORM1FPROC)(GLint location, GLfloat v0);
 typedef void (APIENTRYP PFNGLUNIFORM2FPROC)(GLint location, GLfloat v0, GLfloat v1);
 typedef void (APIENTRYP PFNGLUNIFORM3FPROC)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
@@ -284,6 +360,9 @@ typedef void (APIENTRYP PFNGLUNIFORMMATRIX3FVPROC)(GLint location, GLsizei count
 typedef void (APIENTRYP PFNGLUNIFORMMATRIX4FVPROC)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
 
 GLAPI PFNGLUNIFORM1IPROC glUniform1i;
+GLAPI PFNGLUNIFORM2IPROC glUniform2i;
+GLAPI PFNGLUNIFORM4IPROC glUniform4i;
+GLAPI PFNGLUNIFORM1UIPROC glUniform1ui;
 GLAPI PFNGLUNIFORM1FPROC glUniform1f;
 GLAPI PFNGLUNIFORM2FPROC glUniform2f;
 GLAPI PFNGLUNIFORM3FPROC glUniform3f;
@@ -305,16 +384,78 @@ GLAPI PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
 // Buffer Object functions
 typedef void (APIENTRYP PFNGLGENBUFFERSPROC)(GLsizei n, GLuint* buffers);
 typedef void (APIENTRYP PFNGLBINDBUFFERPROC)(GLenum target, GLuint buffer);
+typedef void (APIENTRYP PFNGLBINDBUFFERRANGEPROC)(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
 typedef void (APIENTRYP PFNGLBUFFERDATAPROC)(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
 typedef void (APIENTRYP PFNGLBUFFERSUBDATAPROC)(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
 typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC)(GLsizei n, const GLuint* buffers);
 
 GLAPI PFNGLGENBUFFERSPROC glGenBuffers;
 GLAPI PFNGLBINDBUFFERPROC glBindBuffer;
+GLAPI PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
 GLAPI PFNGLBUFFERDATAPROC glBufferData;
 GLAPI PFNGLBUFFERSUBDATAPROC glBufferSubData;
 GLAPI PFNGLDELETEBUFFERSPROC glDeleteBuffers;
 
+// Buffer mapping
+typedef void* (APIENTRYP PFNGLMAPBUFFERRANGEPROC)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRYP PFNGLUNMAPBUFFERPROC)(GLenum target);
+
+GLAPI PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+GLAPI PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+
+// Framebuffer Object (FBO) functions
+typedef void (APIENTRYP PFNGLGENFRAMEBUFFERSPROC)(GLsizei n, GLuint* framebuffers);
+typedef void (APIENTRYP PFNGLBINDFRAMEBUFFERPROC)(GLenum target, GLuint framebuffer);
+typedef void (APIENTRYP PFNGLFRAMEBUFFERTEXTURE2DPROC)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+typedef void (APIENTRYP PFNGLFRAMEBUFFERRENDERBUFFERPROC)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
+typedef GLenum (APIENTRYP PFNGLCHECKFRAMEBUFFERSTATUSPROC)(GLenum target);
+typedef void (APIENTRYP PFNGLDELETEFRAMEBUFFERSPROC)(GLsizei n, const GLuint* framebuffers);
+typedef void (APIENTRYP PFNGLGENRENDERBUFFERSPROC)(GLsizei n, GLuint* renderbuffers);
+typedef void (APIENTRYP PFNGLBINDRENDERBUFFERPROC)(GLenum target, GLuint renderbuffer);
+typedef void (APIENTRYP PFNGLRENDERBUFFERSTORAGEPROC)(GLenum target, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRYP PFNGLDELETERENDERBUFFERSPROC)(GLsizei n, const GLuint* renderbuffers);
+typedef void (APIENTRYP PFNGLCLEARBUFFERUIVPROC)(GLenum buffer, GLint drawbuffer, const GLuint* value);
+typedef void (APIENTRYP PFNGLCLEARBUFFERFVPROC)(GLenum buffer, GLint drawbuffer, const GLfloat* value);
+typedef void (APIENTRYP PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC)(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height);
+typedef void (APIENTRYP PFNGLBLITFRAMEBUFFERPROC)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
+
+GLAPI PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+GLAPI PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+GLAPI PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D;
+GLAPI PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
+GLAPI PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
+GLAPI PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
+GLAPI PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers;
+GLAPI PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer;
+GLAPI PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage;
+GLAPI PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers;
+GLAPI PFNGLCLEARBUFFERUIVPROC glClearBufferuiv;
+GLAPI PFNGLCLEARBUFFERFVPROC glClearBufferfv;
+GLAPI PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample;
+GLAPI PFNGLBLITFRAMEBUFFERPROC glBlitFramebuffer;
+
+// Sync object (fence) functions
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRYP PFNGLDELETESYNCPROC)(GLsync sync);
+
+GLAPI PFNGLFENCESYNCPROC glFenceSync;
+GLAPI PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+GLAPI PFNGLDELETESYNCPROC glDeleteSync;
+
+// Query object functions
+typedef void (APIENTRYP PFNGLGENQUERIESPROC)(GLsizei n, GLuint* ids);
+typedef void (APIENTRYP PFNGLDELETEQUERIESPROC)(GLsizei n, const GLuint* ids);
+typedef void (APIENTRYP PFNGLQUERYCOUNTERPROC)(GLuint id, GLenum target);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTIVPROC)(GLuint id, GLenum pname, GLint* params);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTUI64VPROC)(GLuint id, GLenum pname, GLuint64* params);
+
+GLAPI PFNGLGENQUERIESPROC glGenQueries;
+GLAPI PFNGLDELETEQUERIESPROC glDeleteQueries;
+GLAPI PFNGLQUERYCOUNTERPROC glQueryCounter;
+GLAPI PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+GLAPI PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+
 // Vertex attribute functions
 typedef void (APIENTRYP PFNGLVERTEXATTRIBPOINTERPROC)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
 typedef void (APIENTRYP PFNGLENABLEVERTEXATTRIBARRAYPROC)(GLuint index);
@@ -339,6 +480,7 @@ typedef void (APIENTRYP PFNGLTEXPARAMETERIPROC)(GLenum target, GLenum pname, GLi
 typedef void (APIENTRYP PFNGLGENERATEMIPMAPPROC)(GLenum target);
 typedef void (APIENTRYP PFNGLACTIVETEXTUREPROC)(GLenum texture);
 typedef void (APIENTRYP PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint* textures);
+typedef void (APIENTRYP PFNGLPIXELSTOREIPROC)(GLenum pname, GLint param);
 
 GLAPI PFNGLGENTEXTURESPROC glGenTextures;
 GLAPI PFNGLBINDTEXTUREPROC glBindTexture;
@@ -347,6 +489,7 @@ GLAPI PFNGLTEXPARAMETERIPROC glTexParameteri;
 GLAPI PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
 GLAPI PFNGLACTIVETEXTUREPROC glActiveTexture;
 GLAPI PFNGLDELETETEXTURESPROC glDeleteTextures;
+GLAPI PFNGLPIXELSTOREIPROC glPixelStorei;
 
 // Polygon mode (for wireframe rendering)
 typedef void (APIENTRYP PFNGLPOLYGONMODEPROC)(GLenum face, GLenum mode);
@@ -0,0 +1,294 @@
+/**
+ * =============================================================================
+ * AllocationTracker.cpp - Allocation Counting Implementation
+ * =============================================================================
+ * Everything the operator new hook touches is constant-initialized (plain
+ * thread_locals and zero-initialized atomics), so counting works during
+ * static initialization and never allocates by itself.
+ * =============================================================================
+ */
+
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef CARSHOWROOM_TRACK_ALLOCATIONS
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <csignal>
+#endif
+#endif
+
+namespace {
+
+constexpr size_t SUBSYSTEM_COUNT = static_cast<size_t>(AllocSubsystem::COUNT);
+constexpr size_t MAX_THREAD_SLOTS = 64;        // Later threads share the last slot
+constexpr uint64_t MAX_REPORTED_VIOLATIONS = 20;
+
+/**
+ * ThreadCounters - One thread's totals since startup. Only the owning
+ * thread writes them; atomics make the main thread's reads safe.
+ */
+struct ThreadCounters {
+    std::atomic<uint64_t> counts[SUBSYSTEM_COUNT];
+    std::atomic<uint64_t> bytes[SUBSYSTEM_COUNT];
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> violations;
+};
+
+/**
+ * Totals summed over all threads at one point in time.
+ */
+struct Snapshot {
+    AllocationCounts subsystems[SUBSYSTEM_COUNT];
+    uint64_t frees = 0;
+    uint64_t violations = 0;
+};
+
+ThreadCounters g_slots[MAX_THREAD_SLOTS];
+std::atomic<size_t> g_slotCount{0};
+std::atomic<uint64_t> g_reportedViolations{0};
+
+#ifdef CARSHOWROOM_BREAK_ON_FRAME_ALLOCATION
+std::atomic<bool> g_breakOnViolation{true};
+#else
+std::atomic<bool> g_breakOnViolation{false};
+#endif
+
+thread_local ThreadCounters* t_counters = nullptr;
+thread_local AllocSubsystem t_zone = AllocSubsystem::OTHER;
+thread_local int t_allocationFreeDepth = 0;
+thread_local bool t_inHook = false;
+
+// Main thread only
+Snapshot g_lastSnapshot;
+AllocationReport g_report;
+
+ThreadCounters& getThreadCounters() {
+    if (!t_counters) {
+        size_t slot = g_slotCount.fetch_add(1, std::memory_order_relaxed);
+        t_counters = &g_slots[std::min(slot, MAX_THREAD_SLOTS - 1)];
+    }
+    return *t_counters;
+}
+
+Snapshot takeSnapshot() {
+    Snapshot snapshot;
+    size_t slotCount = std::min(g_slotCount.load(std::memory_order_relaxed), MAX_THREAD_SLOTS);
+    for (size_t s = 0; s < slotCount; s++) {
+        const ThreadCounters& slot = g_slots[s];
+        for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+            snapshot.subsystems[i].count += slot.counts[i].load(std::memory_order_relaxed);
+            snapshot.subsystems[i].bytes += slot.bytes[i].load(std::memory_order_relaxed);
+        }
+        snapshot.frees += slot.frees.load(std::memory_order_relaxed);
+        snapshot.violations += slot.violations.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void reportViolation(size_t bytes) {
+    if (g_breakOnViolation.load(std::memory_order_relaxed)) {
+#if defined(_MSC_VER)
+        __debugbreak();
+#elif defined(SIGTRAP)
+        std::raise(SIGTRAP);
+#else
+        std::abort();
+#endif
+        return;
+    }
+    
+    // stdio, not iostream: this runs inside operator new
+    uint64_t reported = g_reportedViolations.fetch_add(1, std::memory_order_relaxed);
+    if (reported < MAX_REPORTED_VIOLATIONS) {
+        std::fprintf(stderr, "ERROR: %zu-byte allocation in an allocation-free frame (%s)%s\n",
+                     bytes, AllocationTracker::getSubsystemName(t_zone),
+                     reported + 1 == MAX_REPORTED_VIOLATIONS ? "; further violations are only counted" : "");
+    }
+}
+
+} // anonymous namespace
+
+namespace AllocationTracker {
+
+const char* getSubsystemName(AllocSubsystem subsystem) {
+    switch (subsystem) {
+        case AllocSubsystem::RENDERER: return "Renderer";
+        case AllocSubsystem::SHADER: return "Shader";
+        case AllocSubsystem::INPUT: return "Input";
+        case AllocSubsystem::ANIMATION: return "Animation";
+        case AllocSubsystem::COLLISION: return "Collision";
+        default: return "Other";
+    }
+}
+
+void endFrame() {
+    Snapshot snapshot = takeSnapshot();
+    
+    uint64_t frameCount = 0;
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+        AllocationCounts delta;
+        delta.count = snapshot.subsystems[i].count - g_lastSnapshot.subsystems[i].count;
+        delta.bytes = snapshot.subsystems[i].bytes - g_lastSnapshot.subsystems[i].bytes;
+        
+        g_report.subsystems[i].count += delta.count;
+        g_report.subsystems[i].bytes += delta.bytes;
+        g_report.total.count += delta.count;
+        g_report.total.bytes += delta.bytes;
+        frameCount += delta.count;
+    }
+    g_report.frees += snapshot.frees - g_lastSnapshot.frees;
+    g_report.violations += snapshot.violations - g_lastSnapshot.violations;
+    g_report.worstFrameCount = std::max(g_report.worstFrameCount, frameCount);
+    g_report.frameCount++;
+    
+    g_lastSnapshot = snapshot;
+}
+
+AllocationReport takeReport() {
+    AllocationReport report = g_report;
+    g_report = AllocationReport();
+    return report;
+}
+
+void printReport(std::ostream& out, const AllocationReport& report) {
+    if (report.frameCount == 0) {
+        return;
+    }
+    double frames = static_cast<double>(report.frameCount);
+    
+    out << "Allocations per frame (" << report.frameCount << " frames): "
+        << report.total.count / frames << " ("
+        << report.total.bytes / frames << " bytes), worst frame "
+        << report.worstFrameCount << ", violations " << report.violations << "\n";
+    
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+        const AllocationCounts& counts = report.subsystems[i];
+        if (counts.count == 0) {
+            continue;
+        }
+        out << "  " << getSubsystemName(static_cast<AllocSubsystem>(i)) << ": "
+            << counts.count / frames << " (" << counts.bytes / frames << " bytes)\n";
+    }
+    out.flush();
+}
+
+void setBreakOnViolation(bool enabled) {
+    g_breakOnViolation.store(enabled, std::memory_order_relaxed);
+}
+
+void recordAllocation(size_t bytes) {
+    if (t_inHook) {
+        return;  // Allocation made while reporting
+    }
+    t_inHook = true;
+    
+    ThreadCounters& counters = getThreadCounters();
+    size_t zone = static_cast<size_t>(t_zone);
+    counters.counts[zone].fetch_add(1, std::memory_order_relaxed);
+    counters.bytes[zone].fetch_add(bytes, std::memory_order_relaxed);
+    
+    if (t_allocationFreeDepth > 0) {
+        counters.violations.fetch_add(1, std::memory_order_relaxed);
+        reportViolation(bytes);
+    }
+    
+    t_inHook = false;
+}
+
+void recordFree() {
+    getThreadCounters().frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace AllocationTracker
+
+// =============================================================================
+// Scopes
+// =============================================================================
+
+AllocationZone::AllocationZone(AllocSubsystem subsystem)
+    : m_previous(t_zone)
+{
+    t_zone = subsystem;
+}
+
+AllocationZone::~AllocationZone() {
+    t_zone = m_previous;
+}
+
+AllocationFreeScope::AllocationFreeScope(bool active)
+    : m_active(active)
+{
+    if (m_active) {
+        t_allocationFreeDepth++;
+    }
+}
+
+AllocationFreeScope::~AllocationFreeScope() {
+    if (m_active) {
+        t_allocationFreeDepth--;
+    }
+}
+
+// =============================================================================
+// Global operator new/delete (instrumented builds only)
+// =============================================================================
+
+#ifdef CARSHOWROOM_TRACK_ALLOCATIONS
+
+void* operator new(size_t size) {
+    AllocationTracker::recordAllocation(size);
+    void* pointer = std::malloc(size > 0 ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    AllocationTracker::recordAllocation(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer) {
+        AllocationTracker::recordFree();
+        std::free(pointer);
+    }
+}
+
+void operator delete[](void* pointer) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    ::operator delete(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    ::operator delete(pointer);
+}
+
+#endif // CARSHOWROOM_TRACK_ALLOCATIONS
@@ -0,0 +1,385 @@
+/**
+ * =============================================================================
+ * AmbientOcclusion.cpp - Screen-Space Ambient Occlusion Implementation
+ * =============================================================================
+ */
+
+#include "AmbientOcclusion.h"
+#include "FramePacket.h"
+#include "Mesh.h"
+#include "Shader.h"
+
+#include <glad/glad.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Depth pass: positions only, no color
+static const char* DEPTH_VERTEX_SHADER_SOURCE = R"(
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 viewProjection;
+
+void main() {
+    gl_Position = viewProjection * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* DEPTH_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+void main() {
+}
+)";
+
+static const char* OCCLUSION_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+out float FragColor;
+
+#define MAX_SAMPLES 16
+
+uniform sampler2D depthMap;
+uniform mat4 projection;
+uniform mat4 invProjection;
+uniform vec3 kernel[MAX_SAMPLES];   // Hemisphere points, z up, length <= 1
+uniform int sampleCount;
+uniform float noiseOffset;          // Changes every frame
+
+const float RADIUS = 0.5;           // World units (meters)
+const float BIAS = 0.025;
+const float STRENGTH = 1.5;         // Exponent: > 1 darkens creases more
+const float PI = 3.14159265359;
+
+vec3 viewPosition(ivec2 texel) {
+    float depth = texelFetch(depthMap, texel, 0).r;
+    vec2 uv = (vec2(texel) + 0.5) / vec2(textureSize(depthMap, 0));
+    vec4 position = invProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return position.xyz / position.w;
+}
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(depthMap, 0) - 1;
+    
+    // Nothing drawn here: nothing to occlude
+    if (texelFetch(depthMap, texel, 0).r >= 1.0) {
+        FragColor = 1.0;
+        return;
+    }
+    vec3 position = viewPosition(texel);
+    
+    // Normal from the neighbours' positions. On each axis the side at the
+    // closer depth is used, so silhouettes don't bend the normal.
+    vec3 left = viewPosition(max(texel - ivec2(1, 0), ivec2(0)));
+    vec3 right = viewPosition(min(texel + ivec2(1, 0), maxTexel));
+    vec3 down = viewPosition(max(texel - ivec2(0, 1), ivec2(0)));
+    vec3 up = viewPosition(min(texel + ivec2(0, 1), maxTexel));
+    vec3 dx = abs(right.z - position.z) < abs(position.z - left.z) ? right - position : position - left;
+    vec3 dy = abs(up.z - position.z) < abs(position.z - down.z) ? up - position : position - down;
+    vec3 normal = normalize(cross(dx, dy));
+    
+    // Kernel rotation: interleaved gradient noise, shifted every frame
+    float noise = fract(52.9829189 * fract(dot(gl_FragCoord.xy + noiseOffset,
+                                               vec2(0.06711056, 0.00583715))));
+    vec3 rotation = vec3(cos(2.0 * PI * noise), sin(2.0 * PI * noise), 0.0);
+    vec3 tangent = rotation - normal * dot(rotation, normal);
+    tangent = length(tangent) > 0.001 ? normalize(tangent) : vec3(0.0, 0.0, 1.0);
+    mat3 tbn = mat3(tangent, cross(normal, tangent), normal);
+    
+    float occlusion = 0.0;
+    for (int i = 0; i < sampleCount; i++) {
+        vec3 samplePosition = position + tbn * kernel[i] * RADIUS;
+        vec4 clip = projection * vec4(samplePosition, 1.0);
+        vec2 uv = clip.xy / clip.w * 0.5 + 0.5;
+        ivec2 sampleTexel = clamp(ivec2(uv * vec2(textureSize(depthMap, 0))), ivec2(0), maxTexel);
+        float sceneDepth = viewPosition(sampleTexel).z;
+        
+        // Surfaces far in front of the point don't occlude it
+        float range = smoothstep(0.0, 1.0, RADIUS / abs(position.z - sceneDepth));
+        occlusion += (sceneDepth >= samplePosition.z + BIAS ? 1.0 : 0.0) * range;
+    }
+    
+    FragColor = pow(1.0 - occlusion / float(sampleCount), STRENGTH);
+}
+)";
+
+static const char* BLUR_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+out float FragColor;
+
+uniform sampler2D occlusionMap;
+uniform sampler2D depthMap;
+uniform mat4 projection;
+
+// View distance of a depth buffer value
+float linearDepth(float depth) {
+    return projection[3][2] / (depth * 2.0 - 1.0 + projection[2][2]);
+}
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(occlusionMap, 0) - 1;
+    float centerDepth = linearDepth(texelFetch(depthMap, texel, 0).r);
+    
+    // 4x4 texels: 16 different kernel rotations. Neighbours at another
+    // depth (across a silhouette) hardly count.
+    float total = 0.0;
+    float totalWeight = 0.0;
+    for (int y = -2; y < 2; y++) {
+        for (int x = -2; x < 2; x++) {
+            ivec2 sampleTexel = clamp(texel + ivec2(x, y), ivec2(0), maxTexel);
+            float depth = linearDepth(texelFetch(depthMap, sampleTexel, 0).r);
+            float weight = 1.0 / (0.001 + abs(depth - centerDepth) / centerDepth);
+            total += texelFetch(occlusionMap, sampleTexel, 0).r * weight;
+            totalWeight += weight;
+        }
+    }
+    
+    FragColor = total / totalWeight;
+}
+)";
+
+namespace {
+
+// Frames before the noise shift repeats
+constexpr uint64_t NOISE_PERIOD = 64;
+
+/**
+ * Radical inverse of an index in a base (Halton sequence coordinate).
+ */
+float halton(unsigned int index, unsigned int base) {
+    float result = 0.0f;
+    float fraction = 1.0f / static_cast<float>(base);
+    while (index > 0) {
+        result += static_cast<float>(index % base) * fraction;
+        index /= base;
+        fraction /= static_cast<float>(base);
+    }
+    return result;
+}
+
+/**
+ * Create a half-resolution texture with nearest filtering.
+ */
+unsigned int createTarget(int width, int height, int internalFormat, unsigned int format,
+                          unsigned int type) {
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+AmbientOcclusion::AmbientOcclusion(int width, int height)
+    : m_valid(false)
+    , m_quality(AmbientOcclusionQuality::OFF)
+    , m_width((width + 1) / 2)
+    , m_height((height + 1) / 2)
+    , m_depthTexture(0)
+    , m_depthFramebuffer(0)
+    , m_rawTexture(0)
+    , m_rawFramebuffer(0)
+    , m_blurredTexture(0)
+    , m_blurredFramebuffer(0)
+{
+    m_depthShader = std::make_unique<Shader>(DEPTH_VERTEX_SHADER_SOURCE,
+                                             DEPTH_FRAGMENT_SHADER_SOURCE, false);
+    m_occlusionShader = std::make_unique<Shader>(FullscreenPass::VERTEX_SHADER_SOURCE,
+                                                 OCCLUSION_FRAGMENT_SHADER_SOURCE, false);
+    m_blurShader = std::make_unique<Shader>(FullscreenPass::VERTEX_SHADER_SOURCE,
+                                            BLUR_FRAGMENT_SHADER_SOURCE, false);
+    
+    // Kernel: Halton points, so the first 8 (LOW) are as evenly spread as
+    // all 16. More of them lie close to the center, where occluders
+    // matter most.
+    m_occlusionShader->use();
+    m_occlusionShader->setInt("depthMap", 0);
+    for (int i = 0; i < MAX_SAMPLES; i++) {
+        float length = halton(static_cast<unsigned int>(i + 1), 2);
+        float cosTheta = 0.15f + 0.85f * halton(static_cast<unsigned int>(i + 1), 3);
+        float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+        float phi = 2.39996323f * static_cast<float>(i);    // Golden angle
+        float scale = 0.1f + 0.9f * length * length;
+        glm::vec3 point(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+        m_occlusionShader->setVec3("kernel[" + std::to_string(i) + "]", point * scale);
+    }
+    
+    m_blurShader->use();
+    m_blurShader->setInt("occlusionMap", 0);
+    m_blurShader->setInt("depthMap", 1);
+    
+    createTargets();
+}
+
+AmbientOcclusion::~AmbientOcclusion() {
+    destroyTargets();
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void AmbientOcclusion::resize(int width, int height) {
+    int halfWidth = (width + 1) / 2;
+    int halfHeight = (height + 1) / 2;
+    if (halfWidth == m_width && halfHeight == m_height) {
+        return;
+    }
+    m_width = halfWidth;
+    m_height = halfHeight;
+    
+    destroyTargets();
+    createTargets();
+}
+
+void AmbientOcclusion::render(const FramePacket& packet, int width, int height) {
+    m_quality = packet.ambientOcclusion;
+    if (!isActive()) {
+        return;
+    }
+    
+    glViewport(0, 0, m_width, m_height);
+    
+    // 1. Depth of the opaque items (glass doesn't occlude)
+    glBindFramebuffer(GL_FRAMEBUFFER, m_depthFramebuffer);
+    glDepthMask(GL_TRUE);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    
+    m_depthShader->use();
+    m_depthShader->setMat4("viewProjection", packet.projection * packet.view);
+    for (const DrawItem& item : packet.opaqueItems) {
+        if ((item.viewMask & 1u) == 0) {
+            continue;   // Outside the camera's frustum
+        }
+        m_depthShader->setMat4("model", item.model);
+        item.mesh->draw(*m_depthShader);
+    }
+    
+    // 2. Occlusion from that depth
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    m_fullscreen.bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, m_rawFramebuffer);
+    m_occlusionShader->use();
+    m_occlusionShader->setMat4("projection", packet.projection);
+    m_occlusionShader->setMat4("invProjection", glm::inverse(packet.projection));
+    m_occlusionShader->setInt("sampleCount", getSampleCount(m_quality));
+    m_occlusionShader->setFloat("noiseOffset",
+                                5.588238f * static_cast<float>(packet.frameNumber % NOISE_PERIOD));
+    FullscreenPass::draw();
+    
+    // 3. Depth-aware blur
+    glBindFramebuffer(GL_FRAMEBUFFER, m_blurredFramebuffer);
+    m_blurShader->use();
+    m_blurShader->setMat4("projection", packet.projection);
+    glBindTexture(GL_TEXTURE_2D, m_rawTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    FullscreenPass::draw();
+    
+    // Back to the frame being drawn
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+}
+
+int AmbientOcclusion::getSampleCount(AmbientOcclusionQuality quality) {
+    switch (quality) {
+        case AmbientOcclusionQuality::OFF:  return 0;
+        case AmbientOcclusionQuality::LOW:  return MAX_SAMPLES / 2;
+        case AmbientOcclusionQuality::HIGH: return MAX_SAMPLES;
+    }
+    return 0;
+}
+
+const char* AmbientOcclusion::getQualityName(AmbientOcclusionQuality quality) {
+    switch (quality) {
+        case AmbientOcclusionQuality::OFF:  return "Off";
+        case AmbientOcclusionQuality::LOW:  return "Low";
+        case AmbientOcclusionQuality::HIGH: return "High";
+    }
+    return "Unknown";
+}
+
+AmbientOcclusionQuality AmbientOcclusion::getNextQuality(AmbientOcclusionQuality quality) {
+    switch (quality) {
+        case AmbientOcclusionQuality::OFF:  return AmbientOcclusionQuality::LOW;
+        case AmbientOcclusionQuality::LOW:  return AmbientOcclusionQuality::HIGH;
+        case AmbientOcclusionQuality::HIGH: return AmbientOcclusionQuality::OFF;
+    }
+    return AmbientOcclusionQuality::OFF;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void AmbientOcclusion::createTargets() {
+    m_depthTexture = createTarget(m_width, m_height, GL_DEPTH_COMPONENT24,
+                                  GL_DEPTH_COMPONENT, GL_UNSIGNED_INT);
+    m_rawTexture = createTarget(m_width, m_height, GL_R8, GL_RED, GL_UNSIGNED_BYTE);
+    m_blurredTexture = createTarget(m_width, m_height, GL_R8, GL_RED, GL_UNSIGNED_BYTE);
+    
+    // Depth only: no color buffer to draw into or read from
+    glGenFramebuffers(1, &m_depthFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_depthFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    m_valid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    
+    glGenFramebuffers(1, &m_rawFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_rawFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_rawTexture, 0);
+    m_valid = m_valid && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    
+    glGenFramebuffers(1, &m_blurredFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_blurredFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_blurredTexture, 0);
+    m_valid = m_valid && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (!m_valid) {
+        std::cerr << "ERROR: Ambient occlusion framebuffer is incomplete" << std::endl;
+    }
+}
+
+void AmbientOcclusion::destroyTargets() {
+    for (unsigned int* framebuffer : {&m_depthFramebuffer, &m_rawFramebuffer, &m_blurredFramebuffer}) {
+        if (*framebuffer) {
+            glDeleteFramebuffers(1, framebuffer);
+            *framebuffer = 0;
+        }
+    }
+    for (unsigned int* texture : {&m_depthTexture, &m_rawTexture, &m_blurredTexture}) {
+        if (*texture) {
+            glDeleteTextures(1, texture);
+            *texture = 0;
+        }
+    }
+    m_valid = false;
+}
@@ -0,0 +1,441 @@
+/**
+ * =============================================================================
+ * AntiAliasing.cpp - Anti-Aliasing Implementation
+ * =============================================================================
+ */
+
+#include "AntiAliasing.h"
+#include "FramePacket.h"
+#include "Renderer.h"
+#include "Shader.h"
+
+#include <glad/glad.h>
+#include <iostream>
+
+static const char* TAA_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+out vec4 FragColor;
+
+uniform sampler2D sceneColor;
+uniform sampler2D historyColor;
+uniform sampler2D velocityMap;
+uniform sampler2D depthMap;
+uniform bool hasHistory;
+
+// Share of the new frame: lower is smoother but slower to react
+const float CURRENT_WEIGHT = 0.1;
+
+void main() {
+    ivec2 texel = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(sceneColor, 0) - 1;
+    vec3 current = texelFetch(sceneColor, texel, 0).rgb;
+    
+    // Color range of the 3x3 neighbourhood, and its closest pixel
+    vec3 minColor = current;
+    vec3 maxColor = current;
+    float closestDepth = texelFetch(depthMap, texel, 0).r;
+    ivec2 closestTexel = texel;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            ivec2 sampleTexel = clamp(texel + ivec2(x, y), ivec2(0), maxTexel);
+            vec3 color = texelFetch(sceneColor, sampleTexel, 0).rgb;
+            minColor = min(minColor, color);
+            maxColor = max(maxColor, color);
+            float depth = texelFetch(depthMap, sampleTexel, 0).r;
+            if (depth < closestDepth) {
+                closestDepth = depth;
+                closestTexel = sampleTexel;
+            }
+        }
+    }
+    
+    // Where this pixel was last frame
+    vec2 uv = gl_FragCoord.xy / vec2(textureSize(sceneColor, 0));
+    vec2 historyUV = uv - texelFetch(velocityMap, closestTexel, 0).rg;
+    if (!hasHistory || any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0)))) {
+        FragColor = vec4(current, 1.0);
+        return;
+    }
+    
+    // History outside the new neighbourhood's range shows something
+    // that is no longer there
+    vec3 history = clamp(texture(historyColor, historyUV).rgb, minColor, maxColor);
+    FragColor = vec4(mix(history, current, CURRENT_WEIGHT), 1.0);
+}
+)";
+
+static const char* FXAA_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+out vec4 FragColor;
+
+uniform sampler2D sceneColor;
+
+const float SPAN_MAX = 8.0;             // Longest blur, in pixels
+const float REDUCE_MIN = 1.0 / 128.0;
+const float REDUCE_MUL = 1.0 / 8.0;
+const vec3 LUMA = vec3(0.299, 0.587, 0.114);
+
+void main() {
+    vec2 texelSize = 1.0 / vec2(textureSize(sceneColor, 0));
+    vec2 uv = gl_FragCoord.xy * texelSize;
+    
+    // Luminance of the pixel and its diagonal neighbours
+    vec3 colorM = texture(sceneColor, uv).rgb;
+    float lumaM = dot(colorM, LUMA);
+    float lumaNW = dot(textureOffset(sceneColor, uv, ivec2(-1, 1)).rgb, LUMA);
+    float lumaNE = dot(textureOffset(sceneColor, uv, ivec2(1, 1)).rgb, LUMA);
+    float lumaSW = dot(textureOffset(sceneColor, uv, ivec2(-1, -1)).rgb, LUMA);
+    float lumaSE = dot(textureOffset(sceneColor, uv, ivec2(1, -1)).rgb, LUMA);
+    float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+    
+    // Blur direction: along the edge, across the luminance gradient
+    vec2 direction = vec2(-((lumaNW + lumaNE) - (lumaSW + lumaSE)),
+                          (lumaNW + lumaSW) - (lumaNE + lumaSE));
+    float reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25 * REDUCE_MUL, REDUCE_MIN);
+    float scale = 1.0 / (min(abs(direction.x), abs(direction.y)) + reduce);
+    direction = clamp(direction * scale, vec2(-SPAN_MAX), vec2(SPAN_MAX)) * texelSize;
+    
+    // Two taps close in, and two more further out along the edge
+    vec3 colorA = 0.5 * (texture(sceneColor, uv + direction * (1.0 / 3.0 - 0.5)).rgb +
+                         texture(sceneColor, uv + direction * (2.0 / 3.0 - 0.5)).rgb);
+    vec3 colorB = colorA * 0.5 + 0.25 * (texture(sceneColor, uv - direction * 0.5).rgb +
+                                         texture(sceneColor, uv + direction * 0.5).rgb);
+    
+    // The wide blur crossed another edge if it left the local range
+    float lumaB = dot(colorB, LUMA);
+    FragColor = vec4((lumaB < lumaMin || lumaB > lumaMax) ? colorA : colorB, 1.0);
+}
+)";
+
+namespace {
+
+/**
+ * Radical inverse of an index in a base (Halton sequence coordinate).
+ */
+float halton(unsigned int index, unsigned int base) {
+    float result = 0.0f;
+    float fraction = 1.0f / static_cast<float>(base);
+    while (index > 0) {
+        result += static_cast<float>(index % base) * fraction;
+        index /= base;
+        fraction /= static_cast<float>(base);
+    }
+    return result;
+}
+
+/**
+ * Create a full-resolution texture that clamps at the edges.
+ */
+unsigned int createTarget(int width, int height, int internalFormat, unsigned int format,
+                          unsigned int type, int filter) {
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+AntiAliasing::AntiAliasing(int width, int height)
+    : m_width(width)
+    , m_height(height)
+    , m_mode(AntiAliasingMode::OFF)
+    , m_valid(false)
+    , m_colorTexture(0)
+    , m_velocityTexture(0)
+    , m_depthTexture(0)
+    , m_sceneFramebuffer(0)
+    , m_historyTextures{0, 0}
+    , m_historyFramebuffers{0, 0}
+    , m_historyIndex(0)
+    , m_hasHistory(false)
+    , m_previousViewProjection(1.0f)
+    , m_previousJitter(0.0f)
+    , m_msaaValid(false)
+    , m_msaaColorBuffer(0)
+    , m_msaaDepthBuffer(0)
+    , m_msaaFramebuffer(0)
+{
+    m_taaShader = std::make_unique<Shader>(FullscreenPass::VERTEX_SHADER_SOURCE,
+                                           TAA_FRAGMENT_SHADER_SOURCE, false);
+    m_fxaaShader = std::make_unique<Shader>(FullscreenPass::VERTEX_SHADER_SOURCE,
+                                            FXAA_FRAGMENT_SHADER_SOURCE, false);
+    
+    m_taaShader->use();
+    m_taaShader->setInt("sceneColor", 0);
+    m_taaShader->setInt("historyColor", 1);
+    m_taaShader->setInt("velocityMap", 2);
+    m_taaShader->setInt("depthMap", 3);
+    
+    m_fxaaShader->use();
+    m_fxaaShader->setInt("sceneColor", 0);
+    
+    createTargets();
+}
+
+AntiAliasing::~AntiAliasing() {
+    destroyTargets();
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void AntiAliasing::resize(int width, int height) {
+    if (width == m_width && height == m_height) {
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    
+    destroyTargets();
+    createTargets();
+}
+
+void AntiAliasing::beginScene(const FramePacket& packet, Renderer& renderer) {
+    m_mode = packet.antiAliasing;
+    if (m_mode == AntiAliasingMode::MSAA && !m_msaaFramebuffer) {
+        createMultisampleTargets();
+    }
+    
+    // History only carries over between consecutive TAA frames
+    glm::mat4 viewProjection = packet.projection * packet.view;
+    if (m_mode != AntiAliasingMode::TAA || !m_valid) {
+        m_hasHistory = false;
+    }
+    if (m_hasHistory) {
+        renderer.setPreviousCamera(m_previousViewProjection, packet.jitter - m_previousJitter);
+    } else {
+        renderer.setPreviousCamera(viewProjection, glm::vec2(0.0f));
+    }
+    m_previousViewProjection = viewProjection;
+    m_previousJitter = packet.jitter;
+    
+    unsigned int framebuffer = getSceneFramebuffer();
+    if (framebuffer == 0) {
+        return;     // Renderer::beginFrame() already cleared the screen
+    }
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    const glm::vec3& clearColor = renderer.getClearColor();
+    const float color[4] = {clearColor.r, clearColor.g, clearColor.b, 1.0f};
+    glClearBufferfv(GL_COLOR, 0, color);
+    
+    // Only TAA reads motion vectors; FXAA frames skip writing them
+    if (framebuffer == m_sceneFramebuffer) {
+        bool writeMotion = m_mode == AntiAliasingMode::TAA;
+        unsigned int motionBuffer = writeMotion ? GL_COLOR_ATTACHMENT1 : GL_NONE;
+        const unsigned int drawBuffers[2] = {GL_COLOR_ATTACHMENT0, motionBuffer};
+        glDrawBuffers(2, drawBuffers);
+        if (writeMotion) {
+            const float noMotion[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            glClearBufferfv(GL_COLOR, 1, noMotion);
+        }
+    }
+    glDepthMask(GL_TRUE);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+void AntiAliasing::resolve() {
+    unsigned int framebuffer = getSceneFramebuffer();
+    if (framebuffer == 0) {
+        return;
+    }
+    
+    if (m_mode == AntiAliasingMode::MSAA) {
+        // Averages the samples of each pixel on the way
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_msaaFramebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height,
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return;
+    }
+    
+    glDisable(GL_DEPTH_TEST);
+    m_fullscreen.bind();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+    
+    if (m_mode == AntiAliasingMode::TAA) {
+        resolveTemporal();
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        m_fxaaShader->use();
+        FullscreenPass::draw();
+    }
+    
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    glEnable(GL_DEPTH_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+glm::vec2 AntiAliasing::getJitter(uint64_t frameNumber, int width, int height) {
+    // Halton(2,3) from index 1 (index 0 is the corner), centered on the pixel
+    unsigned int index = static_cast<unsigned int>(frameNumber % JITTER_PHASES) + 1;
+    glm::vec2 offset(halton(index, 2) - 0.5f, halton(index, 3) - 0.5f);
+    return offset * glm::vec2(2.0f / static_cast<float>(width), 2.0f / static_cast<float>(height));
+}
+
+const char* AntiAliasing::getModeName(AntiAliasingMode mode) {
+    switch (mode) {
+        case AntiAliasingMode::OFF:  return "Off";
+        case AntiAliasingMode::FXAA: return "FXAA";
+        case AntiAliasingMode::TAA:  return "TAA";
+        case AntiAliasingMode::MSAA: return "4x MSAA";
+    }
+    return "Unknown";
+}
+
+AntiAliasingMode AntiAliasing::getNextMode(AntiAliasingMode mode) {
+    switch (mode) {
+        case AntiAliasingMode::OFF:  return AntiAliasingMode::FXAA;
+        case AntiAliasingMode::FXAA: return AntiAliasingMode::TAA;
+        case AntiAliasingMode::TAA:  return AntiAliasingMode::MSAA;
+        case AntiAliasingMode::MSAA: return AntiAliasingMode::OFF;
+    }
+    return AntiAliasingMode::OFF;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+unsigned int AntiAliasing::getSceneFramebuffer() const {
+    switch (m_mode) {
+        case AntiAliasingMode::OFF:  return 0;
+        case AntiAliasingMode::FXAA:
+        case AntiAliasingMode::TAA:  return m_valid ? m_sceneFramebuffer : 0;
+        case AntiAliasingMode::MSAA: return m_msaaValid ? m_msaaFramebuffer : 0;
+    }
+    return 0;
+}
+
+void AntiAliasing::resolveTemporal() {
+    int writeIndex = 1 - m_historyIndex;
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, m_historyFramebuffers[writeIndex]);
+    m_taaShader->use();
+    m_taaShader->setBool("hasHistory", m_hasHistory);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_historyTextures[m_historyIndex]);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, m_velocityTexture);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    FullscreenPass::draw();
+    
+    for (unsigned int unit : {GL_TEXTURE3, GL_TEXTURE2, GL_TEXTURE1}) {
+        glActiveTexture(unit);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    
+    // The new history is also this frame's image
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_historyFramebuffers[writeIndex]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    
+    m_historyIndex = writeIndex;
+    m_hasHistory = true;
+}
+
+void AntiAliasing::createTargets() {
+    m_hasHistory = false;
+    
+    // Scene: color is filtered (FXAA reads between pixels), the rest is fetched
+    m_colorTexture = createTarget(m_width, m_height, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, GL_LINEAR);
+    m_velocityTexture = createTarget(m_width, m_height, GL_RG16F, GL_RG, GL_HALF_FLOAT, GL_NEAREST);
+    m_depthTexture = createTarget(m_width, m_height, GL_DEPTH_COMPONENT24,
+                                  GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, GL_NEAREST);
+    
+    glGenFramebuffers(1, &m_sceneFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_velocityTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+    const unsigned int drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+    m_valid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    
+    // History: half floats, so small blends still add up without banding
+    for (int i = 0; i < 2; i++) {
+        m_historyTextures[i] = createTarget(m_width, m_height, GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT,
+                                            GL_LINEAR);
+        glGenFramebuffers(1, &m_historyFramebuffers[i]);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_historyFramebuffers[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               m_historyTextures[i], 0);
+        m_valid = m_valid && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (!m_valid) {
+        std::cerr << "ERROR: Anti-aliasing framebuffer is incomplete" << std::endl;
+    }
+}
+
+void AntiAliasing::createMultisampleTargets() {
+    glGenRenderbuffers(1, &m_msaaColorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_msaaColorBuffer);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_RGBA8, m_width, m_height);
+    
+    glGenRenderbuffers(1, &m_msaaDepthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_msaaDepthBuffer);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_DEPTH_COMPONENT24,
+                                     m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    glGenFramebuffers(1, &m_msaaFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_msaaFramebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_msaaColorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_msaaDepthBuffer);
+    m_msaaValid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (!m_msaaValid) {
+        std::cerr << "ERROR: Multisample framebuffer is incomplete" << std::endl;
+    }
+}
+
+void AntiAliasing::destroyTargets() {
+    for (unsigned int* framebuffer : {&m_sceneFramebuffer, &m_historyFramebuffers[0],
+                                      &m_historyFramebuffers[1], &m_msaaFramebuffer}) {
+        if (*framebuffer) {
+            glDeleteFramebuffers(1, framebuffer);
+            *framebuffer = 0;
+        }
+    }
+    for (unsigned int* texture : {&m_colorTexture, &m_velocityTexture, &m_depthTexture,
+                                  &m_historyTextures[0], &m_historyTextures[1]}) {
+        if (*texture) {
+            glDeleteTextures(1, texture);
+            *texture = 0;
+        }
+    }
+    for (unsigned int* renderbuffer : {&m_msaaColorBuffer, &m_msaaDepthBuffer}) {
+        if (*renderbuffer) {
+            glDeleteRenderbuffers(1, renderbuffer);
+            *renderbuffer = 0;
+        }
+    }
+    m_valid = false;
+    m_msaaValid = false;
+    m_hasHistory = false;
+}
@@ -11,30 +11,64 @@
 #include "ShowroomScene.h"
 #include "Input.h"
 #include "CarModel.h"
+#include "ObjectPicker.h"
+#include "FramePacer.h"
+#include "RenderThread.h"
+#include "FramePacket.h"
+#include "AssetLoader.h"
+#include "GpuDeletionQueue.h"
+#include "AllocationTracker.h"
+#include "RenderStats.h"
 
 #include <GLFW/glfw3.h>
+#include <cmath>
 #include <iostream>
+#include <sstream>
 
 // =============================================================================
 // Constructor / Destructor
 // =============================================================================
 
-Application::Application(int width, int height, const std::string& title)
+Application::Application(int width, int height, const std::string& title,
+                         const SceneConfig& sceneConfig)
     : m_running(false)
+    , m_pacingMode(PacingMode::VSYNC)
     , m_deltaTime(0.0f)
     , m_elapsedTime(0.0f)
     , m_lastFrameTime(0.0f)
     , m_fps(0.0f)
     , m_fpsAccumulator(0.0f)
     , m_frameCount(0)
+    , m_frameStartTime(0.0)
+    , m_mainCpuMs(0.0)
+    , m_showStats(false)
+    , m_ambientOcclusion(AmbientOcclusionQuality::HIGH)
+    , m_antiAliasing(AntiAliasingMode::TAA)
+    , m_showPriceTags(false)
+    , m_kioskMode(false)
+    , m_fixedTimestep(DEFAULT_FIXED_TIMESTEP)
     , m_physicsAccumulator(0.0f)
+    , m_hoveredObject(0)
+    , m_hoveredPart(0)
+    , m_focusCar(nullptr)
+    , m_allocationWarmupFrames(static_cast<int>(AllocationTracker::WARMUP_FRAMES))
+    , m_streamStartTime(0.0)
 {
     // Create window first (initializes OpenGL context)
     m_window = std::make_unique<Window>(width, height, title);
     
+    // Frame pacing: vsync by default, and never let the GPU fall more
+    // than two frames behind (each queued frame is a frame of latency)
+    m_pacer = std::make_unique<FramePacer>(*m_window);
+    m_pacer->setMaxQueuedFrames(2);
+    m_pacingMode = m_pacer->getMode();
+    
     // Create renderer
     m_renderer = std::make_unique<Renderer>(width, height);
     
+    // Create GPU picker (ID buffer for click/hover selection)
+    m_picker = std::make_unique<ObjectPicker>(width, height);
+    
     // Create camera
     m_camera = std::make_unique<Camera>(
         glm::vec3(0.0f, 3.0f, 10.0f),  // Position
@@ -44,8 +78,26 @@ Application::Application(int width, int height, const std::string& title)
     );
     m_camera->setMode(CameraMode::ORBIT);
     
-    // Create scene
-    m_scene = std::make_unique<ShowroomScene>();
+    // Background loader with its own shared GL context
+    try {
+        m_loader = std::make_unique<AssetLoader>(*m_window);
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << " (loading the whole scene up front)" << std::endl;
+    }
+    
+    // Create scene; with the loader, background cars stream in after
+    // the first frames are already on screen
+    double sceneStart = glfwGetTime();
+    m_scene = std::make_unique<ShowroomScene>(sceneConfig, m_loader.get());
+    m_streamStartTime = sceneStart;
+    if (sceneConfig.isGenerated()) {
+        std::cout << "Generated scene (seed " << sceneConfig.seed << "): "
+                  << m_scene->getBackgroundCars().size() + m_scene->getPendingCarCount() + 1
+                  << " cars (" << m_scene->getPendingCarCount() << " streaming), "
+                  << m_scene->getPointLights().size() << " point lights, "
+                  << m_scene->getEnvironment().size() << " environment models in "
+                  << (glfwGetTime() - sceneStart) * 1000.0 << " ms" << std::endl;
+    }
     
     // Set orbit target to main car
     if (m_scene->getMainCar()) {
@@ -55,18 +107,25 @@ Application::Application(int width, int height, const std::string& title)
     // Create input handler
     m_input = std::make_unique<Input>(*m_window);
     
-    // Set up window callbacks
-    m_window->setFramebufferSizeCallback([this](int w, int h) {
-        onResize(w, h);
-    });
-    
-    // Set up input callbacks
+    // Set up input callbacks (resizes reach the renderer through packets)
     m_input->onKeyPress([this](int key) {
         onKeyPress(key);
     });
+    
+    // Render thread last: everything GL was created above, on this thread
+    m_renderThread = std::make_unique<RenderThread>(
+        *m_window, *m_renderer, *m_picker, *m_pacer, USE_RENDER_THREAD);
 }
 
-Application::~Application() = default;
+Application::~Application() {
+    // Nothing may be drawing or loading while the scene goes away
+    m_renderThread.reset();
+    m_loader.reset();
+    m_scene.reset();
+    
+    // The context is back on this thread; free what the meshes released
+    GpuDeletionQueue::flush();
+}
 
 // =============================================================================
 // Main Loop
@@ -86,17 +145,32 @@ int Application::run() {
     std::cout << "1: Free-roam camera" << std::endl;
     std::cout << "2: Orbit camera" << std::endl;
     std::cout << "3: Driver seat camera" << std::endl;
+    std::cout << "4: Toggle kiosk views (front/side/top/interior)" << std::endl;
     std::cout << "I/K: Move car forward/backward" << std::endl;
     std::cout << "J/L: Turn car left/right" << std::endl;
     std::cout << "O: Toggle door" << std::endl;
     std::cout << "H: Toggle headlights" << std::endl;
     std::cout << "R: Reset car position" << std::endl;
+    std::cout << "P: Cycle physics rate (60/30/15 Hz)" << std::endl;
+    std::cout << "F: Orbit the car nearest to the camera" << std::endl;
+    std::cout << "V: Cycle frame pacing (vsync/adaptive/uncapped/limited)" << std::endl;
+    std::cout << "T: Toggle price tags" << std::endl;
+    std::cout << "N: Toggle showroom lights" << std::endl;
+    std::cout << "Q: Cycle ambient occlusion (off/low/high)" << std::endl;
+    std::cout << "M: Cycle anti-aliasing (off/FXAA/TAA/4x MSAA)" << std::endl;
+    std::cout << "F3: Toggle statistics overlay" << std::endl;
     std::cout << "Escape: Release cursor / Exit" << std::endl;
+    std::cout << "Left click (cursor released): Select car part" << std::endl;
+    std::cout << "Right click: Recapture cursor" << std::endl;
     std::cout << "================================\n" << std::endl;
     
+    // Hand the GL context to the render thread
+    m_renderThread->start();
+    
     while (m_running && !m_window->shouldClose()) {
         // Calculate delta time
-        float currentTime = static_cast<float>(Window::getTime());
+        m_frameStartTime = Window::getTime();
+        float currentTime = static_cast<float>(m_frameStartTime);
         m_deltaTime = currentTime - m_lastFrameTime;
         m_lastFrameTime = currentTime;
         m_elapsedTime = currentTime;
@@ -114,22 +188,36 @@ int Application::run() {
         
         // Fixed timestep for physics
         m_physicsAccumulator += m_deltaTime;
-        while (m_physicsAccumulator >= FIXED_TIMESTEP) {
-            fixedUpdate(FIXED_TIMESTEP);
-            m_physicsAccumulator -= FIXED_TIMESTEP;
+        while (m_physicsAccumulator >= m_fixedTimestep) {
+            fixedUpdate(m_fixedTimestep);
+            m_physicsAccumulator -= m_fixedTimestep;
         }
         
+        // The leftover time is how far we are into the next step; draw
+        // that fraction of the way from the previous step to the current
+        m_scene->setRenderAlpha(m_physicsAccumulator / m_fixedTimestep);
+        
         // Variable timestep update
         update(m_deltaTime);
         
-        // Render
+        // Hand the frame to the render thread
         render();
         
-        // Swap buffers and poll events
-        m_window->swapBuffers();
-        m_window->pollEvents();
+        if (AllocationTracker::isEnabled()) {
+            AllocationTracker::endFrame();
+        }
+        
+        // Poll events so the next frame starts with the freshest input
+        // (swapping and pacing happen on the render thread)
+        {
+            ALLOCATION_ZONE(AllocSubsystem::INPUT);
+            m_window->pollEvents();
+        }
     }
     
+    // Finish queued frames and take the GL context back for cleanup
+    m_renderThread->stop();
+    
     return 0;
 }
 
@@ -137,29 +225,49 @@ void Application::quit() {
     m_running = false;
 }
 
+void Application::setFixedTimestep(float seconds) {
+    if (seconds > 0.0f) {
+        m_fixedTimestep = seconds;
+        m_physicsAccumulator = 0.0f;
+    }
+}
+
 // =============================================================================
 // Private Methods
 // =============================================================================
 
 void Application::processInput() {
+    ALLOCATION_ZONE(AllocSubsystem::INPUT);
+    
     m_input->update();
     
     // Camera movement
     m_input->processCamera(*m_camera, m_deltaTime);
     
-    // Car control
-    if (m_scene->getMainCar()) {
-        m_input->processCar(*m_scene->getMainCar(), m_deltaTime);
-    }
+    // Car control runs in fixedUpdate with the physics
 }
 
 void Application::update(float deltaTime) {
+    // Adopt background cars the loader has finished
+    if (m_scene->getPendingCarCount() > 0) {
+        m_scene->updateStreaming();
+        if (m_scene->getPendingCarCount() == 0) {
+            std::cout << "Scene streamed in: " << m_scene->getBackgroundCars().size()
+                      << " background cars after "
+                      << (Window::getTime() - m_streamStartTime) * 1000.0 << " ms" << std::endl;
+            
+            // Packets grow to hold the new cars during the next few frames
+            m_allocationWarmupFrames = static_cast<int>(AllocationTracker::WARMUP_FRAMES);
+        }
+    }
+    
     // Update scene
     m_scene->update(deltaTime);
     
     // Update camera orbit target (in case car moved)
-    if (m_camera->getMode() == CameraMode::ORBIT && m_scene->getMainCar()) {
-        m_camera->setOrbitTarget(m_scene->getMainCar()->getOrbitTarget());
+    CarModel* orbitCar = m_focusCar ? m_focusCar : m_scene->getMainCar();
+    if (m_camera->getMode() == CameraMode::ORBIT && orbitCar) {
+        m_camera->setOrbitTarget(orbitCar->getOrbitTarget());
     }
     
     // Update driver seat camera position
@@ -168,48 +276,196 @@ void Application::update(float deltaTime) {
     }
 }
 
-void Application::fixedUpdate([[maybe_unused]] float fixedDeltaTime) {
-    // Physics updates would go here
-    // For now, we just handle collision
+void Application::fixedUpdate(float fixedDeltaTime) {
+    // Keep the pre-step transforms for render interpolation
+    m_scene->storePreviousTransforms();
+    
+    // Car control
+    if (m_scene->getMainCar()) {
+        ALLOCATION_ZONE(AllocSubsystem::INPUT);
+        m_input->processCar(*m_scene->getMainCar(), fixedDeltaTime);
+    }
     
+    // Everything below is collision handling
+    ALLOCATION_ZONE(AllocSubsystem::COLLISION);
+    
+    // Car vs car (broadphase + narrowphase)
+    m_scene->resolveCarCollisions();
+    
+    // Car vs walls
     if (m_scene->getMainCar()) {
         CarModel* car = m_scene->getMainCar();
         glm::vec3 carPos = car->getPosition();
-        glm::vec3 carSize(4.0f, 1.5f, 1.8f);  // Approximate car dimensions
         
-        // Constrain car to showroom bounds
-        glm::vec3 constrainedPos = m_scene->constrainPosition(carPos, carSize);
+        // Constrain car to showroom bounds using its real, rotated box
+        glm::vec3 constrainedPos = m_scene->constrainPosition(
+            carPos, car->getOrientedBoundingBox());
         if (constrainedPos != carPos) {
             car->setPosition(constrainedPos);
         }
     }
+    
+    // Refresh proximity queries with this step's final positions
+    m_scene->updateSpatialGrid();
 }
 
 void Application::render() {
-    // Begin frame
-    m_renderer->beginFrame();
+    // May wait here while the render thread is a full queue behind
+    double waitStart = Window::getTime();
+    FramePacket* packet = m_renderThread->beginFrame();
+    double waitTime = Window::getTime() - waitStart;
+    if (!packet) {
+        quit();  // Render thread stopped (error already reported)
+        return;
+    }
+    
+    // Once warmed up and fully streamed in, building a packet must not allocate
+    if (m_allocationWarmupFrames > 0) {
+        m_allocationWarmupFrames--;
+    }
+    ALLOCATION_ZONE(AllocSubsystem::RENDERER);
+    ALLOCATION_FREE_SCOPE(m_allocationWarmupFrames == 0 && m_scene->getPendingCarCount() == 0);
+    
+    packet->width = m_window->getWidth();
+    packet->height = m_window->getHeight();
+    
+    // Kiosk views: TAA history and ambient occlusion follow one camera,
+    // so the 2x2 layout uses FXAA and no occlusion instead
+    bool kiosk = m_kioskMode && m_scene->getMainCar();
+    AntiAliasingMode antiAliasing = m_antiAliasing;
+    if (kiosk && antiAliasing == AntiAliasingMode::TAA) {
+        antiAliasing = AntiAliasingMode::FXAA;
+    }
+    
+    // Camera, with mouse look that arrived during this frame's update.
+    // TAA shifts the projection by a different subpixel offset each frame.
+    m_input->lateLatch(*m_camera);
+    glm::vec2 jitter(0.0f);
+    if (antiAliasing == AntiAliasingMode::TAA && packet->width > 0 && packet->height > 0) {
+        jitter = AntiAliasing::getJitter(packet->frameNumber, packet->width, packet->height);
+    }
+    m_camera->setProjectionJitter(jitter);
+    packet->jitter = jitter;
+    packet->view = m_camera->getViewMatrix();
+    if (packet->height > 0) {
+        packet->projection = m_camera->getProjectionMatrix(
+            static_cast<float>(packet->width) / static_cast<float>(packet->height));
+    }
+    packet->cameraPosition = m_camera->getPosition();
     
-    // Set camera
-    m_renderer->setCamera(*m_camera);
+    // Lights and geometry, copied so the simulation can move on
+    m_scene->collectLights(*packet);
+    m_scene->collectReflectionProbe(*packet);
+    m_scene->collectDrawItems(*packet);
+    if (m_showPriceTags) {
+        m_scene->collectPriceTags(*packet);
+    }
     
-    // Set lighting
-    m_renderer->setDirectionalLight(m_scene->getDirectionalLight());
-    for (const auto& light : m_scene->getPointLights()) {
-        m_renderer->addPointLight(light);
+    // Views, then one culling pass over the items for all of them, and
+    // the lights that reach each item
+    if (kiosk) {
+        collectKioskViews(*packet);
     }
-    for (const auto& light : m_scene->getSpotLights()) {
-        m_renderer->addSpotLight(light);
+    packet->cullItems();
+    packet->assignLights();
+    
+    // ID pass under the cursor
+    updatePicking(*packet);
+    
+    packet->pacingMode = m_pacingMode;
+    packet->showStats = m_showStats;
+    packet->ambientOcclusion = kiosk ? AmbientOcclusionQuality::OFF : m_ambientOcclusion;
+    packet->antiAliasing = antiAliasing;
+    
+    // Main thread work for this frame, not counting the wait above; the
+    // packet carries the previous frame's value since this one isn't done
+    packet->cpuMainMs = m_mainCpuMs;
+    m_mainCpuMs = (Window::getTime() - m_frameStartTime - waitTime) * 1000.0;
+    
+    m_renderThread->submitFrame();
+}
+
+void Application::collectKioskViews(FramePacket& packet) const {
+    const CarModel* car = m_scene->getMainCar();
+    if (!car || packet.width < 2 || packet.height < 2) {
+        return;
     }
     
-    // Draw scene
-    m_scene->draw(m_renderer->getShader());
+    glm::vec3 target = car->getOrbitTarget();
+    float headingRad = glm::radians(car->getRenderRotation().y);
+    glm::vec3 forward(std::sin(headingRad), 0.0f, std::cos(headingRad));
+    glm::vec3 right(std::cos(headingRad), 0.0f, -std::sin(headingRad));
+    float distance = car->getOrbitDistance();
+    glm::vec3 seat = car->getDriverSeatPosition();
     
-    // End frame
-    m_renderer->endFrame();
+    // Eye and target per view, in reading order from the top-left
+    struct KioskShot {
+        glm::vec3 position;
+        glm::vec3 target;
+    };
+    const KioskShot shots[] = {
+        {target + forward * distance + glm::vec3(0.0f, 0.5f, 0.0f), target},   // Front
+        {target + right * distance + glm::vec3(0.0f, 0.5f, 0.0f), target},     // Side
+        {target + glm::vec3(0.0f, distance * 1.5f, 0.0f) - forward * 0.5f, target},  // Top
+        {seat, seat + forward}                                                  // Interior
+    };
+    
+    int halfWidth = packet.width / 2;
+    int halfHeight = packet.height / 2;
+    for (int i = 0; i < 4; i++) {
+        Camera camera(shots[i].position);
+        camera.lookAt(shots[i].target);
+        
+        RenderView view;
+        bool rightColumn = (i % 2) == 1;
+        bool topRow = i < 2;
+        view.x = rightColumn ? halfWidth : 0;
+        view.y = topRow ? halfHeight : 0;
+        view.width = rightColumn ? packet.width - halfWidth : halfWidth;
+        view.height = topRow ? packet.height - halfHeight : halfHeight;
+        view.view = camera.getViewMatrix();
+        view.projection = camera.getProjectionMatrix(
+            static_cast<float>(view.width) / static_cast<float>(view.height));
+        view.cameraPosition = camera.getPosition();
+        packet.views.push_back(view);
+    }
 }
 
-void Application::onResize(int width, int height) {
-    m_renderer->resize(width, height);
+void Application::updatePicking(FramePacket& packet) {
+    // Results of picks issued one or two frames ago
+    PickResult result;
+    if (m_renderThread->pollPickResult(result)) {
+        m_hoveredObject = result.objectId;
+        m_hoveredPart = result.partId;
+    }
+    
+    // While the mouse drives the camera there is nothing to point at
+    if (m_input->isCursorCaptured()) {
+        m_hoveredObject = 0;
+        return;
+    }
+    
+    // Mouse coordinates start at the top-left; GL pixels at the bottom-left
+    glm::vec2 mouse = m_input->getMousePosition();
+    packet.pickRequested = true;
+    packet.pickX = static_cast<int>(mouse.x);
+    packet.pickY = packet.height - 1 - static_cast<int>(mouse.y);
+    
+    // Left click selects whatever the latest readback found
+    if (m_input->isMouseButtonPressed(GLFW_MOUSE_BUTTON_LEFT)) {
+        CarModel* car = m_scene->getCarByPickId(m_hoveredObject);
+        if (car) {
+            std::cout << "Selected: " << car->getName() << " - "
+                      << car->getPartName(m_hoveredPart) << std::endl;
+        } else {
+            std::cout << "Selected: nothing" << std::endl;
+        }
+    }
+    
+    // Right click hands the mouse back to the camera
+    if (m_input->isMouseButtonHeld(GLFW_MOUSE_BUTTON_RIGHT)) {
+        m_input->captureCursor();
+    }
 }
 
 void Application::onKeyPress(int key) {
@@ -219,6 +475,7 @@ void Application::onKeyPress(int key) {
         std::cout << "Camera mode: Free-roam" << std::endl;
     } else if (key == GLFW_KEY_2) {
         m_camera->setMode(CameraMode::ORBIT);
+        m_focusCar = nullptr;  // Back to the main car
         if (m_scene->getMainCar()) {
             m_camera->setOrbitTarget(m_scene->getMainCar()->getOrbitTarget());
         }
@@ -229,6 +486,9 @@ void Application::onKeyPress(int key) {
             m_camera->setPosition(m_scene->getMainCar()->getDriverSeatPosition());
         }
         std::cout << "Camera mode: Driver seat" << std::endl;
+    } else if (key == GLFW_KEY_4) {
+        m_kioskMode = !m_kioskMode;
+        std::cout << "Kiosk views: " << (m_kioskMode ? "On" : "Off") << std::endl;
     }
     
     // Car controls
@@ -251,15 +511,69 @@ void Application::onKeyPress(int key) {
         if (key == GLFW_KEY_R) {
             car->setPosition(glm::vec3(0.0f, 0.2f, 0.0f));
             car->setRotation(glm::vec3(0.0f));
+            car->storePreviousTransform();  // Jump there instead of sliding
             std::cout << "Car position reset" << std::endl;
         }
     }
     
+    // Focus the orbit camera on the closest car
+    if (key == GLFW_KEY_F) {
+        m_focusCar = m_scene->findNearestCar(m_camera->getPosition(), 100.0f);
+        if (m_focusCar) {
+            m_camera->setMode(CameraMode::ORBIT);
+            m_camera->setOrbitTarget(m_focusCar->getOrbitTarget());
+            std::cout << "Focus: " << m_focusCar->getName() << std::endl;
+        }
+    }
+    
+    // Physics rate: rendering stays smooth thanks to interpolation
+    if (key == GLFW_KEY_P) {
+        int rate = static_cast<int>(std::lround(1.0f / m_fixedTimestep));
+        int nextRate = (rate > 30) ? 30 : (rate > 15) ? 15 : 60;
+        setFixedTimestep(1.0f / static_cast<float>(nextRate));
+        std::cout << "Physics rate: " << nextRate << " Hz" << std::endl;
+    }
+    
+    // Frame pacing: the render thread switches when the next packet
+    // arrives and reports the frame-time spread of the mode being left
+    if (key == GLFW_KEY_V) {
+        m_pacingMode = m_pacer->getNextMode(m_pacingMode);
+    }
+    
+    // Price tags over every car
+    if (key == GLFW_KEY_T) {
+        m_showPriceTags = !m_showPriceTags;
+    }
+    
+    // Showroom lights (the reflection probe recaptures itself)
+    if (key == GLFW_KEY_N) {
+        m_scene->setLightsEnabled(!m_scene->areLightsEnabled());
+        std::cout << "Showroom lights: " << (m_scene->areLightsEnabled() ? "On" : "Off") << std::endl;
+    }
+    
+    // Ambient occlusion tier (the render thread picks it up with the next packet)
+    if (key == GLFW_KEY_Q) {
+        m_ambientOcclusion = AmbientOcclusion::getNextQuality(m_ambientOcclusion);
+        std::cout << "Ambient occlusion: " << AmbientOcclusion::getQualityName(m_ambientOcclusion)
+                  << std::endl;
+    }
+    
+    // Anti-aliasing mode (TAA history restarts when it is switched back on)
+    if (key == GLFW_KEY_M) {
+        m_antiAliasing = AntiAliasing::getNextMode(m_antiAliasing);
+        std::cout << "Anti-aliasing: " << AntiAliasing::getModeName(m_antiAliasing) << std::endl;
+    }
+    
+    // Statistics overlay
+    if (key == GLFW_KEY_F3) {
+        m_showStats = !m_showStats;
+    }
+    
     // Escape handling
     if (key == GLFW_KEY_ESCAPE) {
         if (m_input->isCursorCaptured()) {
             m_input->releaseCursor();
-            std::cout << "Cursor released (press mouse to recapture)" << std::endl;
+            std::cout << "Cursor released (left click to select, right click to recapture)" << std::endl;
         } else {
             quit();
         }
@@ -275,7 +589,18 @@ void Application::updateFPS() {
         m_frameCount = 0;
         m_fpsAccumulator = 0.0f;
         
-        // Update window title with FPS
-        // (Not implemented to keep code simple)
+        if (AllocationTracker::isEnabled()) {
+            AllocationTracker::printReport(std::cout, AllocationTracker::takeReport());
+        }
+        
+        // Show the last frame's numbers in the window title
+        RenderStats stats = m_renderThread->getStats();
+        std::ostringstream status;
+        status.precision(1);
+        status << std::fixed << m_fps << " FPS | "
+               << stats.drawCalls << " draws, " << stats.triangles / 1000 << "k tris | "
+               << "CPU " << stats.cpuMainMs << " + " << stats.cpuRenderMs << " ms | "
+               << "GPU " << stats.gpuMs << " ms";
+        m_window->setTitleStatus(status.str());
     }
 }
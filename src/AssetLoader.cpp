@@ -0,0 +1,125 @@
+/**
+ * =============================================================================
+ * AssetLoader.cpp - Background Asset Loading Implementation
+ * =============================================================================
+ */
+
+#include "AssetLoader.h"
+#include "Window.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Fence wait slice (nanoseconds); the wait is retried until the GPU is done
+constexpr GLuint64 UPLOAD_WAIT_SLICE = 100000000;  // 100 ms
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+AssetLoader::AssetLoader(Window& window)
+    : m_context(window.createSharedContext())
+    , m_runningCount(0)
+    , m_stop(false)
+{
+    if (!m_context) {
+        throw std::runtime_error("Failed to create shared OpenGL context for asset loading");
+    }
+    
+    m_thread = std::thread(&AssetLoader::threadLoop, this);
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+    
+    glfwDestroyWindow(m_context);
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+size_t AssetLoader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size() + m_runningCount;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void AssetLoader::enqueue(LoadJob job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_condition.notify_one();
+}
+
+void AssetLoader::threadLoop() {
+    glfwMakeContextCurrent(m_context);
+    
+    std::vector<LoadJob> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+    
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        if (m_stop) {
+            break;
+        }
+        
+        while (!m_jobs.empty() && batch.size() < MAX_BATCH_SIZE) {
+            batch.push_back(std::move(m_jobs.front()));
+            m_jobs.pop_front();
+        }
+        m_runningCount = batch.size();
+        lock.unlock();
+        
+        for (LoadJob& job : batch) {
+            job.run();
+        }
+        
+        // Results may only be handed out once their uploads have landed
+        waitForUploads();
+        for (LoadJob& job : batch) {
+            job.publish();
+        }
+        batch.clear();
+        
+        lock.lock();
+        m_runningCount = 0;
+    }
+    lock.unlock();
+    
+    glfwMakeContextCurrent(nullptr);
+}
+
+void AssetLoader::waitForUploads() {
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    
+    // Flush on the first wait only; after that the fence is on its way
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    GLenum status;
+    do {
+        status = glClientWaitSync(fence, flags, UPLOAD_WAIT_SLICE);
+        flags = 0;
+    } while (status == GL_TIMEOUT_EXPIRED);
+    
+    if (status == GL_WAIT_FAILED) {
+        std::cerr << "ERROR: Asset upload fence wait failed" << std::endl;
+    }
+    glDeleteSync(fence);
+}
@@ -25,6 +25,7 @@ Camera::Camera()
     , m_fov(45.0f)
     , m_nearPlane(0.1f)
     , m_farPlane(100.0f)
+    , m_projectionJitter(0.0f)
     , m_mode(CameraMode::FREE_ROAM)
     , m_orbitTarget(0.0f)
     , m_orbitRadius(5.0f)
@@ -47,6 +48,7 @@ Camera::Camera(const glm::vec3& position, const glm::vec3& up, float yaw, float
     , m_fov(45.0f)
     , m_nearPlane(0.1f)
     , m_farPlane(100.0f)
+    , m_projectionJitter(0.0f)
     , m_mode(CameraMode::FREE_ROAM)
     , m_orbitTarget(0.0f)
     , m_orbitRadius(5.0f)
@@ -75,7 +77,14 @@ glm::mat4 Camera::getProjectionMatrix(float aspectRatio) const {
     // - FOV: field of view angle (larger = wider view)
     // - Aspect ratio: width/height (prevents distortion)
     // - Near/Far: clipping planes (objects outside are not rendered)
-    return glm::perspective(glm::radians(m_fov), aspectRatio, m_nearPlane, m_farPlane);
+    glm::mat4 projection = glm::perspective(glm::radians(m_fov), aspectRatio, m_nearPlane, m_farPlane);
+    
+    // Jitter: a clip-space translation by offset * w moves every vertex
+    // by the same NDC offset after the perspective divide
+    if (m_projectionJitter != glm::vec2(0.0f)) {
+        projection = glm::translate(glm::mat4(1.0f), glm::vec3(m_projectionJitter, 0.0f)) * projection;
+    }
+    return projection;
 }
 
 // =============================================================================
@@ -223,6 +232,19 @@ void Camera::setPitch(float pitch) {
     updateCameraVectors();
 }
 
+void Camera::lookAt(const glm::vec3& target) {
+    glm::vec3 direction = target - m_position;
+    if (glm::dot(direction, direction) < 1e-8f) {
+        return;
+    }
+    direction = glm::normalize(direction);
+    
+    // Inverse of updateCameraVectors()
+    m_yaw = glm::degrees(std::atan2(direction.z, direction.x));
+    m_pitch = std::clamp(glm::degrees(std::asin(direction.y)), -89.0f, 89.0f);
+    updateCameraVectors();
+}
+
 void Camera::setFOV(float fov) {
     m_fov = std::clamp(fov, 1.0f, 120.0f);
 }
@@ -10,62 +10,63 @@
 
 #include <cmath>
 
+namespace {
+
+// Cars only need their geometry back for buildBVHs() and raycasts, so
+// they keep positions and indices (12 of 32 bytes per vertex)
+constexpr MeshRetention CAR_MESH_RETENTION = MeshRetention::COLLISION_ONLY;
+
+// Default dimensions, shared by the members and generateGeometry()
+constexpr float CAR_LENGTH = 4.0f;
+constexpr float CAR_WIDTH = 1.8f;
+constexpr float CAR_HEIGHT = 1.5f;
+constexpr float WHEEL_RADIUS = 0.4f;
+
+// Fixed shapes, built at compile time and uploaded straight from these tables
+constexpr auto BODY_MESH = StaticMesh::makeCarBody();
+constexpr auto WHEEL_MESH = StaticMesh::makeCylinder<24>(WHEEL_RADIUS, 0.2f);
+constexpr auto NARROW_WHEEL_MESH = StaticMesh::makeCylinder<24>(WHEEL_RADIUS, 0.15f);
+
+} // anonymous namespace
+
 // =============================================================================
 // Constructors / Destructor
 // =============================================================================
 
 CarModel::CarModel()
-    : Model("DetailedCar")
-    , m_bodyMeshIndex(0)
-    , m_windowMeshIndex(0)
-    , m_interiorMeshIndex(0)
-    , m_wheelRotation(0.0f)
-    , m_wheelSpeed(0.0f)
-    , m_doorAnimSpeed(90.0f)  // Degrees per second
-    , m_currentSpeed(0.0f)
-    , m_heading(0.0f)
-    , m_headlightsOn(false)
-    , m_hasInterior(true)
-    , m_length(4.0f)
-    , m_width(1.8f)
-    , m_height(1.5f)
-    , m_wheelRadius(0.4f)
+    : CarModel(generateGeometry(false))
 {
-    m_doorOpenAmount.fill(0.0f);
-    m_doorTargetOpen.fill(false);
-    m_wheelMeshIndices.fill(0);
-    m_doorMeshIndices.fill(0);
-    
-    createDetailedCar();
 }
 
 CarModel::CarModel(bool simplified)
-    : Model("SimplifiedCar")
+    : CarModel(generateGeometry(simplified))
+{
+}
+
+CarModel::CarModel(CarGeometry&& geometry)
+    : Model(geometry.simplified ? "SimplifiedCar" : "DetailedCar")
     , m_bodyMeshIndex(0)
     , m_windowMeshIndex(0)
     , m_interiorMeshIndex(0)
     , m_wheelRotation(0.0f)
     , m_wheelSpeed(0.0f)
-    , m_doorAnimSpeed(90.0f)
+    , m_doorAnimSpeed(90.0f)  // Degrees per second
     , m_currentSpeed(0.0f)
     , m_heading(0.0f)
     , m_headlightsOn(false)
-    , m_hasInterior(!simplified)
-    , m_length(4.0f)
-    , m_width(1.8f)
-    , m_height(1.5f)
-    , m_wheelRadius(0.4f)
+    , m_price(0)
+    , m_hasInterior(!geometry.simplified)
+    , m_length(CAR_LENGTH)
+    , m_width(CAR_WIDTH)
+    , m_height(CAR_HEIGHT)
+    , m_wheelRadius(WHEEL_RADIUS)
 {
     m_doorOpenAmount.fill(0.0f);
     m_doorTargetOpen.fill(false);
     m_wheelMeshIndices.fill(0);
     m_doorMeshIndices.fill(0);
     
-    if (simplified) {
-        createSimplifiedCar();
-    } else {
-        createDetailedCar();
-    }
+    createMeshes(std::move(geometry));
 }
 
 CarModel::~CarModel() = default;
@@ -148,17 +149,23 @@ void CarModel::turn(float angle, float deltaTime) {
 // =============================================================================
 
 glm::vec3 CarModel::getOrbitTarget() const {
-    // Target point is slightly above the car center
-    return m_position + glm::vec3(0.0f, m_height * 0.5f, 0.0f);
+    // Target point is slightly above the car center (where it is drawn,
+    // so the camera moves exactly with the interpolated car)
+    return getRenderPosition() + glm::vec3(0.0f, m_height * 0.5f, 0.0f);
+}
+
+glm::vec3 CarModel::getLabelPosition() const {
+    // Just over the roof, following the drawn position like the orbit target
+    return getRenderPosition() + glm::vec3(0.0f, m_height + 0.3f, 0.0f);
 }
 
 glm::vec3 CarModel::getDriverSeatPosition() const {
     // Driver seat is on the left side, forward of center
-    float headingRad = glm::radians(m_heading);
+    float headingRad = glm::radians(getRenderRotation().y);
     glm::vec3 forward(std::sin(headingRad), 0.0f, std::cos(headingRad));
     glm::vec3 right(std::cos(headingRad), 0.0f, -std::sin(headingRad));
     
-    return m_position 
+    return getRenderPosition()
            + glm::vec3(0.0f, 1.0f, 0.0f)  // Height
            + forward * 0.3f               // Slightly forward
            - right * 0.4f;                // Left side
@@ -176,7 +183,7 @@ void CarModel::draw(Shader& shader) const {
 void CarModel::drawOpaque(Shader& shader) const {
     if (!m_visible) return;
     
-    glm::mat4 modelMatrix = getModelMatrix();
+    glm::mat4 modelMatrix = getRenderMatrix();
     
     // Draw body
     if (m_bodyMeshIndex < m_meshes.size()) {
@@ -193,22 +200,7 @@ void CarModel::drawOpaque(Shader& shader) const {
     // Draw wheels with rotation
     for (size_t i = 0; i < 4; i++) {
         if (m_wheelMeshIndices[i] < m_meshes.size()) {
-            // Calculate wheel position
-            float xOffset = (i < 2) ? m_length * 0.35f : -m_length * 0.35f;  // Front/rear
-            float zOffset = (i % 2 == 0) ? -m_width * 0.5f : m_width * 0.5f;  // Left/right
-            
-            glm::mat4 wheelMatrix = modelMatrix;
-            wheelMatrix = glm::translate(wheelMatrix, glm::vec3(xOffset, m_wheelRadius, zOffset));
-            
-            // Rotate wheel on its axis
-            wheelMatrix = glm::rotate(wheelMatrix, glm::radians(m_wheelRotation), glm::vec3(0, 0, 1));
-            
-            // Rotate wheel to face sideways
-            if (i % 2 == 0) {
-                wheelMatrix = glm::rotate(wheelMatrix, glm::radians(90.0f), glm::vec3(0, 0, 1));
-            } else {
-                wheelMatrix = glm::rotate(wheelMatrix, glm::radians(-90.0f), glm::vec3(0, 0, 1));
-            }
+            glm::mat4 wheelMatrix = getWheelMatrix(i, modelMatrix);
             
             shader.setMat4("model", wheelMatrix);
             glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(wheelMatrix)));
@@ -239,7 +231,7 @@ void CarModel::drawTransparent(Shader& shader) const {
     
     // Draw windows (transparent)
     if (m_windowMeshIndex < m_meshes.size()) {
-        glm::mat4 modelMatrix = getModelMatrix();
+        glm::mat4 modelMatrix = getRenderMatrix();
         shader.setMat4("model", modelMatrix);
         glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMatrix)));
         shader.setMat3("normalMatrix", normalMatrix);
@@ -251,47 +243,89 @@ void CarModel::drawTransparent(Shader& shader) const {
     }
 }
 
+glm::mat4 CarModel::getMeshMatrix(size_t meshIndex) const {
+    for (size_t i = 0; i < 4; i++) {
+        if (m_wheelMeshIndices[i] == meshIndex) {
+            return getWheelMatrix(i, getRenderMatrix());
+        }
+    }
+    return getRenderMatrix();
+}
+
+const char* CarModel::getPartName(size_t meshIndex) const {
+    static const char* wheelNames[4] = {
+        "Front-left wheel", "Front-right wheel", "Rear-left wheel", "Rear-right wheel"
+    };
+    
+    if (meshIndex == m_bodyMeshIndex) return "Body";
+    for (size_t i = 0; i < 4; i++) {
+        if (m_wheelMeshIndices[i] == meshIndex) return wheelNames[i];
+    }
+    if (meshIndex == m_windowMeshIndex) return "Windows";
+    if (meshIndex == m_interiorMeshIndex) return "Interior";
+    return "Unknown";
+}
+
+glm::mat4 CarModel::getWheelMatrix(size_t wheel, const glm::mat4& modelMatrix) const {
+    // Calculate wheel position
+    float xOffset = (wheel < 2) ? m_length * 0.35f : -m_length * 0.35f;  // Front/rear
+    float zOffset = (wheel % 2 == 0) ? -m_width * 0.5f : m_width * 0.5f;  // Left/right
+    
+    glm::mat4 wheelMatrix = glm::translate(modelMatrix, glm::vec3(xOffset, m_wheelRadius, zOffset));
+    
+    // Rotate wheel on its axis
+    wheelMatrix = glm::rotate(wheelMatrix, glm::radians(m_wheelRotation), glm::vec3(0, 0, 1));
+    
+    // Rotate wheel to face sideways
+    if (wheel % 2 == 0) {
+        wheelMatrix = glm::rotate(wheelMatrix, glm::radians(90.0f), glm::vec3(0, 0, 1));
+    } else {
+        wheelMatrix = glm::rotate(wheelMatrix, glm::radians(-90.0f), glm::vec3(0, 0, 1));
+    }
+    
+    return wheelMatrix;
+}
+
 // =============================================================================
 // Collision
 // =============================================================================
 
 void CarModel::getBoundingBox(glm::vec3& min, glm::vec3& max) const {
+    AABB bounds = getOrientedBoundingBox().getEnclosingAABB();
+    min = bounds.min;
+    max = bounds.max;
+}
+
+OBB CarModel::getOrientedBoundingBox() const {
+    // Body in model space: length along X, width along Z, origin at ground
     glm::vec3 halfSize(m_length / 2.0f, m_height / 2.0f, m_width / 2.0f);
-    min = m_position - halfSize;
-    max = m_position + halfSize;
-    min.y = m_position.y;  // Bottom at ground level
-    max.y = m_position.y + m_height;
+    AABB localBox(glm::vec3(-halfSize.x, 0.0f, -halfSize.z),
+                  glm::vec3( halfSize.x, m_height, halfSize.z));
+    return OBB::fromTransform(getModelMatrix(), localBox);
 }
 
 // =============================================================================
-// Private Methods
+// Geometry Generation
 // =============================================================================
 
-void CarModel::createDetailedCar() {
-    // Create car body
-    m_bodyMeshIndex = m_meshes.size();
-    addMesh(std::make_unique<Mesh>(MeshGenerator::createCarBody()), Material::CarPaintRed());
-    
-    // Create wheels
-    for (size_t i = 0; i < 4; i++) {
-        m_wheelMeshIndices[i] = m_meshes.size();
-        addMesh(std::make_unique<Mesh>(MeshGenerator::createWheel(m_wheelRadius, 0.2f)), 
-                Material::Rubber());
+CarGeometry CarModel::generateGeometry(bool simplified) {
+    CarGeometry geometry;
+    geometry.simplified = simplified;
+    if (simplified) {
+        return geometry;  // No interior or detailed windows
     }
     
-    // Create windows (simplified - just the windshield area)
-    std::vector<Vertex> windowVerts;
-    std::vector<unsigned int> windowInds;
+    // Windows (simplified - just the windshield area)
+    std::vector<Vertex>& windowVerts = geometry.window.vertices;
+    windowVerts.reserve(4);
     
-    float hl = m_length / 2.0f;
-    float hw = m_width / 2.0f * 0.9f;
+    float hl = CAR_LENGTH / 2.0f;
+    float hw = CAR_WIDTH / 2.0f * 0.9f;
     float bodyHeight = 0.8f;
     float cabinHeight = 0.7f;
     float cabinTop = bodyHeight + cabinHeight;
     float hoodLength = 1.2f;
-    float trunkLength = 0.8f;
     float cabinFront = hl - hoodLength;
-    float cabinBack = -hl + trunkLength;
     
     // Windshield
     windowVerts.push_back({{cabinFront + 0.05f, bodyHeight + 0.05f, -hw + 0.05f}, {0.7f, 0.7f, 0}, {0, 0}});
@@ -299,14 +333,11 @@ void CarModel::createDetailedCar() {
     windowVerts.push_back({{cabinFront + 0.35f, cabinTop - 0.05f, hw - 0.05f}, {0.7f, 0.7f, 0}, {1, 1}});
     windowVerts.push_back({{cabinFront + 0.05f, bodyHeight + 0.05f, hw - 0.05f}, {0.7f, 0.7f, 0}, {0, 1}});
     
-    windowInds = {0, 1, 2, 2, 3, 0};
+    geometry.window.indices = {0, 1, 2, 2, 3, 0};
     
-    m_windowMeshIndex = m_meshes.size();
-    addMesh(std::make_unique<Mesh>(windowVerts, windowInds), Material::Glass());
-    
-    // Create simple interior
-    std::vector<Vertex> interiorVerts;
-    std::vector<unsigned int> interiorInds;
+    // Simple interior
+    std::vector<Vertex>& interiorVerts = geometry.interior.vertices;
+    interiorVerts.reserve(4);
     
     // Dashboard
     float dashY = bodyHeight + 0.1f;
@@ -315,23 +346,40 @@ void CarModel::createDetailedCar() {
     interiorVerts.push_back({{cabinFront + 0.2f, dashY + 0.3f, hw - 0.1f}, {0, 1, 0}, {1, 1}});
     interiorVerts.push_back({{cabinFront - 0.1f, dashY, hw - 0.1f}, {0, 1, 0}, {0, 1}});
     
-    interiorInds = {0, 1, 2, 2, 3, 0};
+    geometry.interior.indices = {0, 1, 2, 2, 3, 0};
     
-    m_interiorMeshIndex = m_meshes.size();
-    addMesh(std::make_unique<Mesh>(interiorVerts, interiorInds), Material::DashboardPlastic());
+    return geometry;
 }
 
-void CarModel::createSimplifiedCar() {
-    // Just the body and wheels, no interior or detailed windows
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void CarModel::createMeshes(CarGeometry&& geometry) {
+    // Create car body
     m_bodyMeshIndex = m_meshes.size();
-    addMesh(std::make_unique<Mesh>(MeshGenerator::createCarBody()), Material::CarPaintBlue());
+    addMesh(std::make_unique<Mesh>(BODY_MESH, CAR_MESH_RETENTION),
+            geometry.simplified ? Material::CarPaintBlue() : Material::CarPaintRed());
     
+    // Create wheels: the same table four times, each with its own buffers
     for (size_t i = 0; i < 4; i++) {
         m_wheelMeshIndices[i] = m_meshes.size();
-        addMesh(std::make_unique<Mesh>(MeshGenerator::createWheel(m_wheelRadius, 0.15f)), 
+        addMesh(std::make_unique<Mesh>(geometry.simplified ? NARROW_WHEEL_MESH : WHEEL_MESH,
+                                       CAR_MESH_RETENTION),
                 Material::Rubber());
     }
     
-    m_windowMeshIndex = m_meshes.size();  // No window mesh for simplified
-    m_interiorMeshIndex = m_meshes.size();  // No interior mesh
+    if (geometry.simplified) {
+        m_windowMeshIndex = m_meshes.size();  // No window mesh for simplified
+        m_interiorMeshIndex = m_meshes.size();  // No interior mesh
+        return;
+    }
+    
+    m_windowMeshIndex = m_meshes.size();
+    addMesh(std::make_unique<Mesh>(std::move(geometry.window), CAR_MESH_RETENTION),
+            Material::Glass());
+    
+    m_interiorMeshIndex = m_meshes.size();
+    addMesh(std::make_unique<Mesh>(std::move(geometry.interior), CAR_MESH_RETENTION),
+            Material::DashboardPlastic());
 }
@@ -5,6 +5,7 @@
  */
 
 #include "Collision.h"
+#include "ThreadPool.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -63,6 +64,102 @@ bool BoundingSphere::containsPoint(const glm::vec3& point) const {
     return glm::length(point - center) <= radius;
 }
 
+// =============================================================================
+// Frustum Methods
+// =============================================================================
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // A clip-space point is inside when -w <= x, y, z <= w, so each plane
+    // is the matrix's fourth row plus or minus one of the others
+    // (Gribb/Hartmann). glm is column-major: row i is m[0][i]..m[3][i].
+    glm::mat4 rows = glm::transpose(viewProjection);
+    Frustum frustum;
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = rows[3] + rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+    
+    // Unit normals, so plane distances are in world units
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+    for (const glm::vec4& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// OBB Methods
+// =============================================================================
+
+OBB::OBB()
+    : center(0.0f)
+    , halfExtents(0.0f)
+{
+    axes[0] = glm::vec3(1, 0, 0);
+    axes[1] = glm::vec3(0, 1, 0);
+    axes[2] = glm::vec3(0, 0, 1);
+}
+
+OBB OBB::fromAABB(const AABB& box) {
+    OBB result;
+    result.center = box.getCenter();
+    result.halfExtents = box.getHalfExtents();
+    return result;
+}
+
+OBB OBB::fromTransform(const glm::mat4& transform, const AABB& localBox) {
+    OBB result;
+    result.center = glm::vec3(transform * glm::vec4(localBox.getCenter(), 1.0f));
+    
+    glm::vec3 localHalf = localBox.getHalfExtents();
+    for (int i = 0; i < 3; i++) {
+        // Each matrix column is a local axis scaled by the model scale
+        glm::vec3 column = glm::vec3(transform[i]);
+        float scale = glm::length(column);
+        result.axes[i] = (scale > 0.0f) ? column / scale : result.axes[i];
+        result.halfExtents[i] = localHalf[i] * scale;
+    }
+    
+    return result;
+}
+
+AABB OBB::getEnclosingAABB() const {
+    // Extent along each world axis is the sum of the projected half-axes
+    glm::vec3 extent = glm::abs(axes[0]) * halfExtents.x +
+                       glm::abs(axes[1]) * halfExtents.y +
+                       glm::abs(axes[2]) * halfExtents.z;
+    return AABB(center - extent, center + extent);
+}
+
+glm::vec3 OBB::getSupportPoint(const glm::vec3& direction) const {
+    glm::vec3 point = center;
+    for (int i = 0; i < 3; i++) {
+        float sign = (glm::dot(direction, axes[i]) >= 0.0f) ? 1.0f : -1.0f;
+        point += axes[i] * (halfExtents[i] * sign);
+    }
+    return point;
+}
+
+bool OBB::containsPoint(const glm::vec3& point) const {
+    glm::vec3 d = point - center;
+    for (int i = 0; i < 3; i++) {
+        if (std::abs(glm::dot(d, axes[i])) > halfExtents[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // =============================================================================
 // Collision Functions
 // =============================================================================
@@ -198,14 +295,924 @@ glm::vec3 resolveAABBCollision(const AABB& a, const AABB& b) {
     return result.normal * result.penetration;
 }
 
+// -----------------------------------------------------------------------------
+// Separating Axis Test for two OBBs
+// -----------------------------------------------------------------------------
+// Two convex boxes are apart if and only if there is an axis where their
+// projections don't overlap. For boxes, only 15 axes need checking:
+// the 3 face normals of each box, plus the 9 cross products of an edge
+// from 'a' with an edge from 'b'.
+//
+// Instead of testing one axis at a time and exiting early, all 15 axes are
+// stored as arrays (x[], y[], z[]) and every step runs as a plain loop over
+// them. The loops have no branches, so the compiler can turn them into SIMD
+// code, and we need every overlap anyway to find the minimum for the response.
+
+namespace {
+
+constexpr int SAT_AXIS_COUNT = 15;
+constexpr int SAT_LANES = 16;  // Padded to a multiple of 4/8 SIMD lanes
+
+struct SATResult {
+    bool separated;
+    int minAxis;
+    float minOverlap;
+    glm::vec3 normal;
+};
+
+SATResult runSeparatingAxisTest(const OBB& a, const OBB& b) {
+    alignas(32) float ax[SAT_LANES], ay[SAT_LANES], az[SAT_LANES];
+    alignas(32) float overlap[SAT_LANES];
+    
+    // Build the candidate axes: 3 from 'a', 3 from 'b', 9 edge crosses
+    for (int i = 0; i < 3; i++) {
+        ax[i] = a.axes[i].x;     ay[i] = a.axes[i].y;     az[i] = a.axes[i].z;
+        ax[3 + i] = b.axes[i].x; ay[3 + i] = b.axes[i].y; az[3 + i] = b.axes[i].z;
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            glm::vec3 c = glm::cross(a.axes[i], b.axes[j]);
+            int k = 6 + i * 3 + j;
+            ax[k] = c.x; ay[k] = c.y; az[k] = c.z;
+        }
+    }
+    ax[15] = ay[15] = 0.0f; az[15] = 1.0f;  // Padding lane, ignored below
+    
+    // Normalize. Parallel edges give a zero cross product; those axes
+    // repeat a face axis, so give them a huge overlap and they never win.
+    alignas(32) float invLen[SAT_LANES], valid[SAT_LANES];
+    for (int k = 0; k < SAT_LANES; k++) {
+        float lenSq = ax[k] * ax[k] + ay[k] * ay[k] + az[k] * az[k];
+        valid[k] = (lenSq > 1e-6f) ? 1.0f : 0.0f;
+        invLen[k] = 1.0f / std::sqrt(std::max(lenSq, 1e-6f));
+    }
+    for (int k = 0; k < SAT_LANES; k++) {
+        ax[k] *= invLen[k];
+        ay[k] *= invLen[k];
+        az[k] *= invLen[k];
+    }
+    
+    // Project both boxes and the center offset onto every axis
+    glm::vec3 d = a.center - b.center;
+    glm::vec3 ea[3] = { a.axes[0] * a.halfExtents.x,
+                        a.axes[1] * a.halfExtents.y,
+                        a.axes[2] * a.halfExtents.z };
+    glm::vec3 eb[3] = { b.axes[0] * b.halfExtents.x,
+                        b.axes[1] * b.halfExtents.y,
+                        b.axes[2] * b.halfExtents.z };
+    
+    for (int k = 0; k < SAT_LANES; k++) {
+        float ra = std::abs(ax[k] * ea[0].x + ay[k] * ea[0].y + az[k] * ea[0].z) +
+                   std::abs(ax[k] * ea[1].x + ay[k] * ea[1].y + az[k] * ea[1].z) +
+                   std::abs(ax[k] * ea[2].x + ay[k] * ea[2].y + az[k] * ea[2].z);
+        float rb = std::abs(ax[k] * eb[0].x + ay[k] * eb[0].y + az[k] * eb[0].z) +
+                   std::abs(ax[k] * eb[1].x + ay[k] * eb[1].y + az[k] * eb[1].z) +
+                   std::abs(ax[k] * eb[2].x + ay[k] * eb[2].y + az[k] * eb[2].z);
+        float dist = std::abs(ax[k] * d.x + ay[k] * d.y + az[k] * d.z);
+        overlap[k] = (ra + rb - dist) * valid[k] +
+                     std::numeric_limits<float>::max() * (1.0f - valid[k]);
+    }
+    
+    // Pick the axis with the least overlap. Edge axes must beat face axes
+    // by a small margin, which keeps the normal stable when they almost tie.
+    SATResult result;
+    result.separated = false;
+    result.minAxis = 0;
+    result.minOverlap = overlap[0];
+    
+    for (int k = 0; k < SAT_AXIS_COUNT; k++) {
+        if (overlap[k] < 0.0f) {
+            result.separated = true;
+        }
+        float biased = (k >= 6) ? overlap[k] * 1.05f + 0.001f : overlap[k];
+        if (biased < result.minOverlap) {
+            result.minOverlap = overlap[k];
+            result.minAxis = k;
+        }
+    }
+    
+    int k = result.minAxis;
+    result.normal = glm::vec3(ax[k], ay[k], az[k]);
+    if (glm::dot(result.normal, d) < 0.0f) {
+        result.normal = -result.normal;  // Point from 'b' towards 'a'
+    }
+    
+    return result;
+}
+
+} // anonymous namespace
+
+bool testOBBvsOBB(const OBB& a, const OBB& b) {
+    return !runSeparatingAxisTest(a, b).separated;
+}
+
+CollisionResult testOBBvsOBBResponse(const OBB& a, const OBB& b) {
+    CollisionResult result;
+    
+    SATResult sat = runSeparatingAxisTest(a, b);
+    if (sat.separated) {
+        return result;
+    }
+    
+    result.hit = true;
+    result.normal = sat.normal;
+    result.penetration = sat.minOverlap;
+    
+    // Contact point: halfway between the deepest point of each box
+    glm::vec3 deepestA = a.getSupportPoint(-sat.normal);
+    glm::vec3 deepestB = b.getSupportPoint(sat.normal);
+    result.point = (deepestA + deepestB) * 0.5f;
+    
+    return result;
+}
+
+CollisionResult testOBBvsAABBResponse(const OBB& a, const AABB& b) {
+    return testOBBvsOBBResponse(a, OBB::fromAABB(b));
+}
+
 } // namespace Collision
 
+// =============================================================================
+// SweepAndPrune
+// =============================================================================
+
+SweepAndPrune::SweepAndPrune()
+    : m_sortAxis(0)
+{
+}
+
+size_t SweepAndPrune::addProxy(const AABB& box) {
+    size_t id;
+    if (!m_freeIds.empty()) {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_boxes[id] = box;
+        m_alive[id] = 1;
+    } else {
+        id = m_boxes.size();
+        m_boxes.push_back(box);
+        m_alive.push_back(1);
+        m_activeSlot.push_back(0);
+    }
+    
+    // New endpoints go at the end; the next sort moves them into place
+    uint32_t proxy = static_cast<uint32_t>(id);
+    m_endpoints.push_back({box.min[m_sortAxis], proxy, 0});
+    m_endpoints.push_back({box.max[m_sortAxis], proxy, 1});
+    
+    return id;
+}
+
+void SweepAndPrune::updateProxy(size_t proxyId, const AABB& box) {
+    m_boxes[proxyId] = box;
+}
+
+void SweepAndPrune::removeProxy(size_t proxyId) {
+    if (proxyId >= m_alive.size() || !m_alive[proxyId]) {
+        return;
+    }
+    
+    m_alive[proxyId] = 0;
+    m_freeIds.push_back(proxyId);
+    
+    // Removing keeps the remaining endpoints in sorted order
+    m_endpoints.erase(
+        std::remove_if(m_endpoints.begin(), m_endpoints.end(),
+            [proxyId](const Endpoint& e) { return e.proxy == proxyId; }),
+        m_endpoints.end());
+}
+
+const std::vector<BroadPhasePair>& SweepAndPrune::findOverlappingPairs() {
+    m_pairs.clear();
+    
+    chooseSortAxis();
+    sortEndpoints();
+    
+    // Sweep: an interval opens at its min endpoint and closes at its max.
+    // Every interval opened while another is still open overlaps it on the
+    // sort axis, so only those need the full 3-axis test.
+    m_active.clear();
+    
+    for (const Endpoint& endpoint : m_endpoints) {
+        uint32_t proxy = endpoint.proxy;
+        
+        if (endpoint.isMax) {
+            // Close the interval (swap-remove from the active set)
+            uint32_t slot = m_activeSlot[proxy];
+            uint32_t last = m_active.back();
+            m_active[slot] = last;
+            m_activeSlot[last] = slot;
+            m_active.pop_back();
+            continue;
+        }
+        
+        const AABB& box = m_boxes[proxy];
+        for (uint32_t other : m_active) {
+            if (Collision::testAABBvsAABB(box, m_boxes[other])) {
+                m_pairs.push_back({std::min<size_t>(proxy, other),
+                                   std::max<size_t>(proxy, other)});
+            }
+        }
+        
+        m_activeSlot[proxy] = static_cast<uint32_t>(m_active.size());
+        m_active.push_back(proxy);
+    }
+    
+    return m_pairs;
+}
+
+void SweepAndPrune::clear() {
+    m_boxes.clear();
+    m_alive.clear();
+    m_freeIds.clear();
+    m_endpoints.clear();
+    m_pairs.clear();
+    m_active.clear();
+    m_activeSlot.clear();
+}
+
+void SweepAndPrune::chooseSortAxis() {
+    size_t count = getProxyCount();
+    if (count < 2) {
+        return;
+    }
+    
+    // Variance of box centers along each axis
+    glm::vec3 sum(0.0f);
+    glm::vec3 sumSq(0.0f);
+    for (size_t i = 0; i < m_boxes.size(); i++) {
+        if (!m_alive[i]) continue;
+        glm::vec3 center = m_boxes[i].getCenter();
+        sum += center;
+        sumSq += center * center;
+    }
+    
+    float invCount = 1.0f / static_cast<float>(count);
+    glm::vec3 variance = sumSq * invCount - (sum * invCount) * (sum * invCount);
+    
+    int bestAxis = m_sortAxis;
+    for (int axis = 0; axis < 3; axis++) {
+        if (variance[axis] > variance[bestAxis]) {
+            bestAxis = axis;
+        }
+    }
+    
+    // Only switch when clearly better - switching costs a full sort
+    if (bestAxis != m_sortAxis && variance[bestAxis] > variance[m_sortAxis] * 1.5f) {
+        m_sortAxis = bestAxis;
+        
+        for (Endpoint& endpoint : m_endpoints) {
+            const AABB& box = m_boxes[endpoint.proxy];
+            endpoint.value = endpoint.isMax ? box.max[m_sortAxis] : box.min[m_sortAxis];
+        }
+        std::sort(m_endpoints.begin(), m_endpoints.end(),
+            [](const Endpoint& a, const Endpoint& b) {
+                return a.value < b.value || (a.value == b.value && a.isMax < b.isMax);
+            });
+    }
+}
+
+void SweepAndPrune::sortEndpoints() {
+    // Refresh cached values from the latest bounds
+    for (Endpoint& endpoint : m_endpoints) {
+        const AABB& box = m_boxes[endpoint.proxy];
+        endpoint.value = endpoint.isMax ? box.max[m_sortAxis] : box.min[m_sortAxis];
+    }
+    
+    // Insertion sort: O(n + swaps), and the list is nearly sorted already.
+    // Ties put min endpoints first so touching boxes are reported.
+    for (size_t i = 1; i < m_endpoints.size(); i++) {
+        Endpoint key = m_endpoints[i];
+        size_t j = i;
+        while (j > 0) {
+            const Endpoint& prev = m_endpoints[j - 1];
+            if (prev.value < key.value || (prev.value == key.value && prev.isMax <= key.isMax)) {
+                break;
+            }
+            m_endpoints[j] = prev;
+            j--;
+        }
+        m_endpoints[j] = key;
+    }
+}
+
+// =============================================================================
+// StaticAABBTree
+// =============================================================================
+
+struct StaticAABBTree::RayPacket {
+    alignas(16) float originX[RAY_PACKET_SIZE];
+    alignas(16) float originY[RAY_PACKET_SIZE];
+    alignas(16) float originZ[RAY_PACKET_SIZE];
+    alignas(16) float invDirX[RAY_PACKET_SIZE];
+    alignas(16) float invDirY[RAY_PACKET_SIZE];
+    alignas(16) float invDirZ[RAY_PACKET_SIZE];
+    alignas(16) float tMax[RAY_PACKET_SIZE];     // Closest hit so far
+    alignas(16) int32_t hit[RAY_PACKET_SIZE];    // Leaf-order box index, -1 = none
+};
+
+namespace {
+
+// Avoid infinities for axis-parallel rays: 0 * inf would give NaN
+inline float safeInverse(float d) {
+    return 1.0f / ((std::abs(d) > 1e-8f) ? d : std::copysign(1e-8f, d));
+}
+
+// Quantize a direction into 16 buckets per axis (12-bit key).
+// Rays with equal keys point nearly the same way.
+inline uint32_t directionKey(const glm::vec3& d) {
+    auto bucket = [](float c) {
+        int b = static_cast<int>((c + 1.0f) * 8.0f);
+        return static_cast<uint32_t>(std::min(std::max(b, 0), 15));
+    };
+    return (bucket(d.x) << 8) | (bucket(d.y) << 4) | bucket(d.z);
+}
+
+constexpr uint32_t DIRECTION_KEY_COUNT = 1 << 12;
+
+// Below this depth splits fall back to the median, which bounds the tree
+// depth (and the traversal stack) even for lopsided SAH splits. Median
+// splits add at most 32 more levels for any 32-bit box count.
+constexpr uint32_t MAX_SAH_DEPTH = 48;
+constexpr int TRAVERSAL_STACK_SIZE = 96;
+static_assert(TRAVERSAL_STACK_SIZE >= static_cast<int>(MAX_SAH_DEPTH) + 32 + 2,
+              "Traversal stack must hold a path of the deepest possible tree");
+
+} // anonymous namespace
+
+void StaticAABBTree::build(const std::vector<AABB>& boxes) {
+    clear();
+    if (boxes.empty()) {
+        return;
+    }
+    
+    uint32_t count = static_cast<uint32_t>(boxes.size());
+    m_boxes = boxes;
+    m_boxIndices.resize(count);
+    
+    std::vector<glm::vec3> centers(count);
+    for (uint32_t i = 0; i < count; i++) {
+        m_boxIndices[i] = static_cast<int32_t>(i);
+        centers[i] = boxes[i].getCenter();
+    }
+    
+    // A binary tree with leaves of at least one box has < 2N nodes
+    m_nodes.reserve(2 * count);
+    m_nodes.resize(1);
+    buildNode(0, 0, count, 0, centers);
+    
+    // Store boxes in leaf order so a leaf reads one contiguous run
+    for (uint32_t i = 0; i < count; i++) {
+        m_boxes[i] = boxes[m_boxIndices[i]];
+    }
+}
+
+void StaticAABBTree::buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count,
+                               uint32_t depth, std::vector<glm::vec3>& centers) {
+    // Bounds of the boxes, and of their centers (used to pick the split)
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    glm::vec3 centerMin = boundsMin;
+    glm::vec3 centerMax = boundsMax;
+    
+    for (uint32_t i = first; i < first + count; i++) {
+        int32_t box = m_boxIndices[i];
+        boundsMin = glm::min(boundsMin, m_boxes[box].min);
+        boundsMax = glm::max(boundsMax, m_boxes[box].max);
+        centerMin = glm::min(centerMin, centers[box]);
+        centerMax = glm::max(centerMax, centers[box]);
+    }
+    
+    m_nodes[nodeIndex].boundsMin = boundsMin;
+    m_nodes[nodeIndex].boundsMax = boundsMax;
+    
+    if (count <= static_cast<uint32_t>(MAX_LEAF_SIZE)) {
+        m_nodes[nodeIndex].leftOrFirst = first;
+        m_nodes[nodeIndex].count = count;
+        return;
+    }
+    
+    // Choose the split with the surface area heuristic (SAH): the chance a
+    // ray hits a child is roughly proportional to its surface area, so we
+    // minimize  area(left) * countLeft + area(right) * countRight.
+    // Centers are sorted into SAH_BINS buckets along the widest axis and
+    // only the bucket boundaries are evaluated.
+    glm::vec3 spread = centerMax - centerMin;
+    int axis = 0;
+    if (spread.y > spread[axis]) axis = 1;
+    if (spread.z > spread[axis]) axis = 2;
+    
+    uint32_t mid = first + count / 2;
+    
+    if (depth < MAX_SAH_DEPTH && spread[axis] > 1e-6f) {
+        constexpr int SAH_BINS = 12;
+        struct Bin {
+            glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+            uint32_t count = 0;
+        };
+        Bin bins[SAH_BINS];
+        
+        float binScale = SAH_BINS / spread[axis];
+        auto binOf = [&](int32_t box) {
+            int b = static_cast<int>((centers[box][axis] - centerMin[axis]) * binScale);
+            return std::min(b, SAH_BINS - 1);
+        };
+        
+        for (uint32_t i = first; i < first + count; i++) {
+            int32_t box = m_boxIndices[i];
+            Bin& bin = bins[binOf(box)];
+            bin.boundsMin = glm::min(bin.boundsMin, m_boxes[box].min);
+            bin.boundsMax = glm::max(bin.boundsMax, m_boxes[box].max);
+            bin.count++;
+        }
+        
+        auto halfArea = [](const glm::vec3& bmin, const glm::vec3& bmax) {
+            glm::vec3 e = glm::max(bmax - bmin, glm::vec3(0.0f));
+            return e.x * e.y + e.y * e.z + e.z * e.x;
+        };
+        
+        // Sweep from the right to get the cost of every right-hand side
+        float rightCost[SAH_BINS];
+        Bin accum;
+        for (int b = SAH_BINS - 1; b > 0; b--) {
+            accum.boundsMin = glm::min(accum.boundsMin, bins[b].boundsMin);
+            accum.boundsMax = glm::max(accum.boundsMax, bins[b].boundsMax);
+            accum.count += bins[b].count;
+            rightCost[b] = accum.count ? halfArea(accum.boundsMin, accum.boundsMax) * accum.count : 0.0f;
+        }
+        
+        // Then from the left, combining both sides
+        float bestCost = std::numeric_limits<float>::max();
+        int bestSplit = -1;
+        accum = Bin();
+        for (int b = 0; b < SAH_BINS - 1; b++) {
+            accum.boundsMin = glm::min(accum.boundsMin, bins[b].boundsMin);
+            accum.boundsMax = glm::max(accum.boundsMax, bins[b].boundsMax);
+            accum.count += bins[b].count;
+            if (accum.count == 0 || accum.count == count) {
+                continue;
+            }
+            float cost = halfArea(accum.boundsMin, accum.boundsMax) * accum.count +
+                         rightCost[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+        
+        if (bestSplit >= 0) {
+            auto firstRight = std::partition(
+                m_boxIndices.begin() + first, m_boxIndices.begin() + first + count,
+                [&](int32_t box) { return binOf(box) <= bestSplit; });
+            mid = static_cast<uint32_t>(firstRight - m_boxIndices.begin());
+        }
+    }
+    
+    if (mid == first + count / 2) {
+        // No useful SAH split (e.g. all centers equal) or too deep: split at the median
+        std::nth_element(m_boxIndices.begin() + first,
+                         m_boxIndices.begin() + mid,
+                         m_boxIndices.begin() + first + count,
+                         [&centers, axis](int32_t a, int32_t b) {
+                             return centers[a][axis] < centers[b][axis];
+                         });
+    }
+    
+    // Children are allocated as a pair (m_nodes may reallocate here)
+    uint32_t left = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.resize(m_nodes.size() + 2);
+    m_nodes[nodeIndex].leftOrFirst = left;
+    m_nodes[nodeIndex].count = 0;
+    
+    buildNode(left, first, mid - first, depth + 1, centers);
+    buildNode(left + 1, mid, first + count - mid, depth + 1, centers);
+}
+
+size_t StaticAABBTree::raycastBatch(const Ray* rays, size_t count, float maxDistance,
+                                    float* outHitT, int32_t* outHitIndex) const {
+    if (m_nodes.empty()) {
+        for (size_t i = 0; i < count; i++) {
+            outHitT[i] = maxDistance;
+            outHitIndex[i] = -1;
+        }
+        return 0;
+    }
+    
+    // Group rays by direction with a counting sort, so each packet holds
+    // rays that visit mostly the same nodes. Small batches skip this.
+    std::vector<uint32_t> order(count);
+    if (count > 4 * RAY_PACKET_SIZE) {
+        std::vector<uint16_t> keys(count);
+        std::vector<uint32_t> offsets(DIRECTION_KEY_COUNT + 1, 0);
+        for (size_t i = 0; i < count; i++) {
+            keys[i] = static_cast<uint16_t>(directionKey(rays[i].direction));
+            offsets[keys[i] + 1]++;
+        }
+        for (uint32_t k = 0; k < DIRECTION_KEY_COUNT; k++) {
+            offsets[k + 1] += offsets[k];
+        }
+        for (size_t i = 0; i < count; i++) {
+            order[offsets[keys[i]]++] = static_cast<uint32_t>(i);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            order[i] = static_cast<uint32_t>(i);
+        }
+    }
+    
+    size_t hitCount = 0;
+    
+    for (size_t start = 0; start < count; start += RAY_PACKET_SIZE) {
+        size_t lanes = std::min(count - start, static_cast<size_t>(RAY_PACKET_SIZE));
+        
+        RayPacket packet;
+        for (int l = 0; l < RAY_PACKET_SIZE; l++) {
+            // Unused lanes get a negative range and never hit anything
+            const Ray& ray = rays[order[start + std::min<size_t>(l, lanes - 1)]];
+            packet.originX[l] = ray.origin.x;
+            packet.originY[l] = ray.origin.y;
+            packet.originZ[l] = ray.origin.z;
+            packet.invDirX[l] = safeInverse(ray.direction.x);
+            packet.invDirY[l] = safeInverse(ray.direction.y);
+            packet.invDirZ[l] = safeInverse(ray.direction.z);
+            packet.tMax[l] = (static_cast<size_t>(l) < lanes) ? maxDistance : -1.0f;
+            packet.hit[l] = -1;
+        }
+        
+        tracePacket(packet);
+        
+        for (size_t l = 0; l < lanes; l++) {
+            uint32_t rayIndex = order[start + l];
+            bool hit = packet.hit[l] >= 0;
+            outHitT[rayIndex] = hit ? packet.tMax[l] : maxDistance;
+            outHitIndex[rayIndex] = hit ? m_boxIndices[packet.hit[l]] : -1;
+            hitCount += hit ? 1 : 0;
+        }
+    }
+    
+    return hitCount;
+}
+
+void StaticAABBTree::tracePacket(RayPacket& packet) const {
+    // Slab test of one box against every lane. Writes entry/exit distances
+    // and returns a bit mask of the lanes that hit before their tMax.
+    auto intersect = [&packet](const glm::vec3& bmin, const glm::vec3& bmax,
+                               float* tNear, float* tFar) {
+        int mask = 0;
+        for (int l = 0; l < RAY_PACKET_SIZE; l++) {
+            float tx1 = (bmin.x - packet.originX[l]) * packet.invDirX[l];
+            float tx2 = (bmax.x - packet.originX[l]) * packet.invDirX[l];
+            float ty1 = (bmin.y - packet.originY[l]) * packet.invDirY[l];
+            float ty2 = (bmax.y - packet.originY[l]) * packet.invDirY[l];
+            float tz1 = (bmin.z - packet.originZ[l]) * packet.invDirZ[l];
+            float tz2 = (bmax.z - packet.originZ[l]) * packet.invDirZ[l];
+            
+            float enter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)),
+                                   std::max(std::min(tz1, tz2), 0.0f));
+            float exit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)),
+                                  std::min(std::max(tz1, tz2), packet.tMax[l]));
+            tNear[l] = enter;
+            tFar[l] = exit;
+            mask |= (enter <= exit ? 1 : 0) << l;
+        }
+        return mask;
+    };
+    
+    // Near-to-far child order from the first lane's direction signs
+    glm::vec3 dirSign(packet.invDirX[0] >= 0.0f ? 1.0f : -1.0f,
+                      packet.invDirY[0] >= 0.0f ? 1.0f : -1.0f,
+                      packet.invDirZ[0] >= 0.0f ? 1.0f : -1.0f);
+    
+    alignas(16) float tNear[RAY_PACKET_SIZE];
+    alignas(16) float tFar[RAY_PACKET_SIZE];
+    
+    uint32_t stack[TRAVERSAL_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        
+        // Re-tested on pop: closer hits found since the push may cull it
+        if (!intersect(node.boundsMin, node.boundsMax, tNear, tFar)) {
+            continue;
+        }
+        
+        if (node.count > 0) {
+            for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; i++) {
+                intersect(m_boxes[i].min, m_boxes[i].max, tNear, tFar);
+                for (int l = 0; l < RAY_PACKET_SIZE; l++) {
+                    bool closer = tNear[l] <= tFar[l];
+                    packet.tMax[l] = closer ? tNear[l] : packet.tMax[l];
+                    packet.hit[l] = closer ? static_cast<int32_t>(i) : packet.hit[l];
+                }
+            }
+            continue;
+        }
+        
+        // Push the far child first so the near one is visited next
+        uint32_t left = node.leftOrFirst;
+        glm::vec3 toRight = (m_nodes[left + 1].boundsMin + m_nodes[left + 1].boundsMax) -
+                            (m_nodes[left].boundsMin + m_nodes[left].boundsMax);
+        bool leftFirst = glm::dot(toRight, dirSign) >= 0.0f;
+        stack[stackSize++] = leftFirst ? left + 1 : left;
+        stack[stackSize++] = leftFirst ? left : left + 1;
+    }
+}
+
+void StaticAABBTree::clear() {
+    m_nodes.clear();
+    m_boxes.clear();
+    m_boxIndices.clear();
+}
+
+// =============================================================================
+// SpatialHashGrid
+// =============================================================================
+
+SpatialHashGrid::SpatialHashGrid(float cellSize, uint32_t bucketCount)
+    : m_cellSize(std::max(cellSize, 1e-3f))
+    , m_inverseCellSize(1.0f / m_cellSize)
+    , m_bucketMask(0)
+    , m_maxRadius(0.0f)
+{
+    uint32_t buckets = 1;
+    while (buckets < bucketCount) {
+        buckets <<= 1;
+    }
+    m_bucketMask = buckets - 1;
+    m_bucketStart.assign(buckets + 1, 0);
+}
+
+void SpatialHashGrid::rebuild(const glm::vec3* positions, const float* radii, size_t count) {
+    const uint32_t bucketCount = m_bucketMask + 1;
+    
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+    m_radius.resize(count);
+    m_ids.resize(count);
+    m_keys.resize(count);
+    
+    // Counting sort by bucket. Each slice of the input gets its own
+    // histogram, so slices can be counted and scattered independently.
+    ThreadPool& pool = ThreadPool::getShared();
+    size_t sliceCount = 1;
+    if (count >= PARALLEL_REBUILD_THRESHOLD) {
+        sliceCount = std::min(pool.getWorkerCount() + 1, count / 1024);
+    }
+    size_t sliceSize = (count + sliceCount - 1) / std::max<size_t>(sliceCount, 1);
+    
+    m_sliceCounts.assign(sliceCount * bucketCount, 0);
+    std::vector<float> sliceMaxRadius(sliceCount, 0.0f);
+    
+    // Pass 1: bucket of every entry, and per-slice counts
+    pool.parallelFor(sliceCount, 1, [&](size_t sliceBegin, size_t sliceEnd) {
+        for (size_t slice = sliceBegin; slice < sliceEnd; slice++) {
+            uint32_t* counts = &m_sliceCounts[slice * bucketCount];
+            size_t end = std::min(count, (slice + 1) * sliceSize);
+            float maxRadius = 0.0f;
+            for (size_t i = slice * sliceSize; i < end; i++) {
+                uint32_t key = bucketOf(cellOf(positions[i].x), cellOf(positions[i].z));
+                m_keys[i] = key;
+                counts[key]++;
+                maxRadius = std::max(maxRadius, radii ? radii[i] : 0.0f);
+            }
+            sliceMaxRadius[slice] = maxRadius;
+        }
+    });
+    
+    // Prefix sum over (bucket, slice): turns counts into write offsets.
+    // Slice order within a bucket keeps the sort stable.
+    uint32_t running = 0;
+    for (uint32_t b = 0; b < bucketCount; b++) {
+        m_bucketStart[b] = running;
+        for (size_t slice = 0; slice < sliceCount; slice++) {
+            uint32_t& slot = m_sliceCounts[slice * bucketCount + b];
+            uint32_t sliceEntries = slot;
+            slot = running;
+            running += sliceEntries;
+        }
+    }
+    m_bucketStart[bucketCount] = running;
+    
+    m_maxRadius = 0.0f;
+    for (float r : sliceMaxRadius) {
+        m_maxRadius = std::max(m_maxRadius, r);
+    }
+    
+    // Pass 2: scatter every entry into its bucket's range
+    pool.parallelFor(sliceCount, 1, [&](size_t sliceBegin, size_t sliceEnd) {
+        for (size_t slice = sliceBegin; slice < sliceEnd; slice++) {
+            uint32_t* offsets = &m_sliceCounts[slice * bucketCount];
+            size_t end = std::min(count, (slice + 1) * sliceSize);
+            for (size_t i = slice * sliceSize; i < end; i++) {
+                uint32_t dst = offsets[m_keys[i]]++;
+                m_x[dst] = positions[i].x;
+                m_y[dst] = positions[i].y;
+                m_z[dst] = positions[i].z;
+                m_radius[dst] = radii ? radii[i] : 0.0f;
+                m_ids[dst] = static_cast<uint32_t>(i);
+            }
+        }
+    });
+}
+
+bool SpatialHashGrid::gatherBuckets(int32_t minX, int32_t minZ, int32_t maxX, int32_t maxZ,
+                                    std::vector<uint32_t>& outBuckets) const {
+    outBuckets.clear();
+    
+    int64_t cells = (static_cast<int64_t>(maxX) - minX + 1) * (static_cast<int64_t>(maxZ) - minZ + 1);
+    if (cells >= static_cast<int64_t>(m_bucketMask) + 1) {
+        return false;
+    }
+    
+    for (int32_t z = minZ; z <= maxZ; z++) {
+        for (int32_t x = minX; x <= maxX; x++) {
+            outBuckets.push_back(bucketOf(x, z));
+        }
+    }
+    
+    // Two cells can hash to the same bucket; visit it once. Small lists
+    // (the usual 2x2 or 3x3 cells) are cheaper to check pairwise.
+    if (outBuckets.size() <= 16) {
+        size_t unique = 0;
+        for (size_t i = 0; i < outBuckets.size(); i++) {
+            if (std::find(outBuckets.begin(), outBuckets.begin() + unique, outBuckets[i]) ==
+                outBuckets.begin() + unique) {
+                outBuckets[unique++] = outBuckets[i];
+            }
+        }
+        outBuckets.resize(unique);
+    } else {
+        std::sort(outBuckets.begin(), outBuckets.end());
+        outBuckets.erase(std::unique(outBuckets.begin(), outBuckets.end()), outBuckets.end());
+    }
+    return true;
+}
+
+size_t SpatialHashGrid::queryRadius(const glm::vec3& center, float radius,
+                                    std::vector<uint32_t>& outIds) const {
+    size_t found = 0;
+    if (m_ids.empty()) {
+        return 0;
+    }
+    
+    // Any overlapping entry's center lies within radius + maxRadius
+    float reach = radius + m_maxRadius;
+    std::vector<uint32_t> buckets;
+    bool local = gatherBuckets(cellOf(center.x - reach), cellOf(center.z - reach),
+                               cellOf(center.x + reach), cellOf(center.z + reach), buckets);
+    
+    auto scan = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            float dx = m_x[i] - center.x;
+            float dy = m_y[i] - center.y;
+            float dz = m_z[i] - center.z;
+            float r = radius + m_radius[i];
+            if (dx * dx + dy * dy + dz * dz <= r * r) {
+                outIds.push_back(m_ids[i]);
+                found++;
+            }
+        }
+    };
+    
+    if (local) {
+        for (uint32_t b : buckets) {
+            scan(m_bucketStart[b], m_bucketStart[b + 1]);
+        }
+    } else {
+        scan(0, static_cast<uint32_t>(m_ids.size()));
+    }
+    return found;
+}
+
+int32_t SpatialHashGrid::findNearest(const glm::vec3& point, float maxDistance,
+                                     float* outDistance) const {
+    int32_t best = -1;
+    float bestDistSq = maxDistance * maxDistance;
+    
+    auto scan = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            float dx = m_x[i] - point.x;
+            float dy = m_y[i] - point.y;
+            float dz = m_z[i] - point.z;
+            float distSq = dx * dx + dy * dy + dz * dz;
+            if (distSq <= bestDistSq) {
+                bestDistSq = distSq;
+                best = static_cast<int32_t>(m_ids[i]);
+            }
+        }
+    };
+    
+    // Search rings of cells around the point's cell, nearest first. Every
+    // cell of ring r + 1 is at least r cells away, so once the best hit is
+    // within that distance no further ring can beat it.
+    int32_t cx = cellOf(point.x);
+    int32_t cz = cellOf(point.z);
+    
+    // Rings past the first one that covers every bucket are never searched
+    // (that ring finishes with a plain scan). Clamp to it before converting,
+    // since a huge or infinite maxDistance would overflow int32_t.
+    int32_t allBucketsRing = static_cast<int32_t>(std::sqrt(static_cast<double>(m_bucketMask) + 1.0) * 0.5) + 1;
+    float rings = std::ceil(maxDistance * m_inverseCellSize);
+    int32_t maxRing = rings < static_cast<float>(allBucketsRing) ? static_cast<int32_t>(rings)
+                                                                 : allBucketsRing;
+    
+    for (int32_t ring = 0; ring <= maxRing && !m_ids.empty(); ring++) {
+        int64_t side = 2 * static_cast<int64_t>(ring) + 1;
+        if (side * side > static_cast<int64_t>(m_bucketMask) + 1) {
+            // Ring covers every bucket: finish with a plain scan
+            scan(0, static_cast<uint32_t>(m_ids.size()));
+            break;
+        }
+        
+        auto visitCell = [&](int32_t x, int32_t z) {
+            uint32_t b = bucketOf(x, z);
+            scan(m_bucketStart[b], m_bucketStart[b + 1]);
+        };
+        if (ring == 0) {
+            visitCell(cx, cz);
+        } else {
+            for (int32_t x = cx - ring; x <= cx + ring; x++) {
+                visitCell(x, cz - ring);
+                visitCell(x, cz + ring);
+            }
+            for (int32_t z = cz - ring + 1; z <= cz + ring - 1; z++) {
+                visitCell(cx - ring, z);
+                visitCell(cx + ring, z);
+            }
+        }
+        
+        float settled = static_cast<float>(ring) * m_cellSize;
+        if (best >= 0 && bestDistSq <= settled * settled) {
+            break;
+        }
+    }
+    
+    if (best >= 0 && outDistance) {
+        *outDistance = std::sqrt(bestDistSq);
+    }
+    return best;
+}
+
+void SpatialHashGrid::findPairs(std::vector<BroadPhasePair>& outPairs) const {
+    outPairs.clear();
+    
+    std::vector<uint32_t> buckets;
+    const uint32_t count = static_cast<uint32_t>(m_ids.size());
+    
+    for (uint32_t i = 0; i < count; i++) {
+        // Partners can be up to (own radius + largest radius) away
+        float reach = m_radius[i] + m_maxRadius;
+        bool local = gatherBuckets(cellOf(m_x[i] - reach), cellOf(m_z[i] - reach),
+                                   cellOf(m_x[i] + reach), cellOf(m_z[i] + reach), buckets);
+        
+        // Each pair is seen from both sides; keep it only from the
+        // entry that comes first in sorted order
+        auto scan = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t j = std::max(begin, i + 1); j < end; j++) {
+                float dx = m_x[j] - m_x[i];
+                float dy = m_y[j] - m_y[i];
+                float dz = m_z[j] - m_z[i];
+                float r = m_radius[i] + m_radius[j];
+                if (dx * dx + dy * dy + dz * dz <= r * r) {
+                    size_t a = m_ids[i];
+                    size_t b = m_ids[j];
+                    outPairs.push_back({std::min(a, b), std::max(a, b)});
+                }
+            }
+        };
+        
+        if (local) {
+            for (uint32_t b : buckets) {
+                scan(m_bucketStart[b], m_bucketStart[b + 1]);
+            }
+        } else {
+            scan(i + 1, count);
+        }
+    }
+}
+
+void SpatialHashGrid::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_radius.clear();
+    m_ids.clear();
+    m_keys.clear();
+    std::fill(m_bucketStart.begin(), m_bucketStart.end(), 0);
+    m_maxRadius = 0.0f;
+}
+
 // =============================================================================
 // CollisionWorld
 // =============================================================================
 
 size_t CollisionWorld::addStaticAABB(const AABB& box) {
     m_staticBoxes.push_back(box);
+    m_staticTreeDirty = true;
     return m_staticBoxes.size() - 1;
 }
 
@@ -248,6 +1255,46 @@ glm::vec3 CollisionWorld::resolveCollisions(const AABB& movingBox,
     return resolvedPos;
 }
 
+CollisionResult CollisionWorld::testAgainstStatic(const OBB& movingBox) const {
+    CollisionResult deepest;
+    deepest.penetration = 0;
+    
+    // Cheap AABB rejection first; only touching walls get the full SAT
+    AABB bounds = movingBox.getEnclosingAABB();
+    
+    for (const auto& staticBox : m_staticBoxes) {
+        if (!Collision::testAABBvsAABB(bounds, staticBox)) {
+            continue;
+        }
+        CollisionResult result = Collision::testOBBvsAABBResponse(movingBox, staticBox);
+        if (result.hit && result.penetration > deepest.penetration) {
+            deepest = result;
+        }
+    }
+    
+    return deepest;
+}
+
+glm::vec3 CollisionWorld::resolveCollisions(const OBB& movingBox, 
+                                            const glm::vec3& currentPos) const {
+    glm::vec3 resolvedPos = currentPos;
+    OBB testBox = movingBox;
+    
+    for (int iteration = 0; iteration < 4; iteration++) {
+        CollisionResult result = testAgainstStatic(testBox);
+        
+        if (!result.hit) {
+            break;
+        }
+        
+        glm::vec3 push = result.normal * (result.penetration + 0.001f);
+        resolvedPos += push;
+        testBox.center += push;
+    }
+    
+    return resolvedPos;
+}
+
 bool CollisionWorld::raycast(const Ray& ray, float maxDistance, 
                              float& hitT, size_t& hitIndex) const {
     hitT = maxDistance;
@@ -267,6 +1314,40 @@ bool CollisionWorld::raycast(const Ray& ray, float maxDistance,
     return anyHit;
 }
 
+size_t CollisionWorld::raycastBatch(const Ray* rays, size_t count, float maxDistance,
+                                    float* outHitT, int32_t* outHitIndex) const {
+    if (m_staticTreeDirty) {
+        StaticAABBTree tree;
+        tree.build(m_staticBoxes);
+        return tree.raycastBatch(rays, count, maxDistance, outHitT, outHitIndex);
+    }
+    return m_staticTree.raycastBatch(rays, count, maxDistance, outHitT, outHitIndex);
+}
+
+void CollisionWorld::buildStaticTree() {
+    m_staticTree.build(m_staticBoxes);
+    m_staticTreeDirty = false;
+}
+
+size_t CollisionWorld::addDynamicAABB(const AABB& box) {
+    return m_broadPhase.addProxy(box);
+}
+
+void CollisionWorld::updateDynamicAABB(size_t proxyId, const AABB& box) {
+    m_broadPhase.updateProxy(proxyId, box);
+}
+
+void CollisionWorld::removeDynamicAABB(size_t proxyId) {
+    m_broadPhase.removeProxy(proxyId);
+}
+
+const std::vector<BroadPhasePair>& CollisionWorld::findDynamicPairs() {
+    return m_broadPhase.findOverlappingPairs();
+}
+
 void CollisionWorld::clear() {
     m_staticBoxes.clear();
+    m_staticTree.clear();
+    m_staticTreeDirty = true;
+    m_broadPhase.clear();
 }
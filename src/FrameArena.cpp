@@ -0,0 +1,72 @@
+/**
+ * =============================================================================
+ * FrameArena.cpp - Per-Frame Linear Allocator Implementation
+ * =============================================================================
+ */
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// =============================================================================
+// Constructor
+// =============================================================================
+
+FrameArena::FrameArena(size_t capacity, std::pmr::memory_resource* upstream)
+    : m_buffer(std::make_unique<std::byte[]>(capacity))
+    , m_capacity(capacity)
+    , m_offset(0)
+    , m_peak(0)
+    , m_overflowCount(0)
+    , m_upstream(upstream)
+{
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void FrameArena::reset() {
+    m_offset = 0;
+}
+
+// =============================================================================
+// memory_resource Interface
+// =============================================================================
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    // Align the absolute address, so over-aligned requests work too
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer.get());
+    uintptr_t start = (base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    size_t end = static_cast<size_t>(start - base) + bytes;
+    
+    if (end <= m_capacity) {
+        m_offset = end;
+        m_peak = std::max(m_peak, m_offset);
+        return reinterpret_cast<void*>(start);
+    }
+    
+    m_overflowCount++;
+    return m_upstream->allocate(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+    // Block memory is reclaimed all at once by reset()
+    if (!owns(pointer)) {
+        m_upstream->deallocate(pointer, bytes, alignment);
+    }
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+bool FrameArena::owns(const void* pointer) const {
+    const std::byte* p = static_cast<const std::byte*>(pointer);
+    return p >= m_buffer.get() && p < m_buffer.get() + m_capacity;
+}
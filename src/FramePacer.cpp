@@ -0,0 +1,223 @@
+/**
+ * =============================================================================
+ * FramePacer.cpp - Frame Pacing Implementation
+ * =============================================================================
+ */
+
+#include "FramePacer.h"
+#include "Window.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+// Below this much remaining time the limiter spins instead of sleeping
+constexpr double SPIN_THRESHOLD = 0.002;
+
+// Longest a queue-throttle fence wait may block (nanoseconds)
+constexpr GLuint64 FENCE_TIMEOUT = 100000000;  // 100 ms
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+FramePacer::FramePacer(Window& window)
+    : m_window(window)
+    , m_mode(PacingMode::VSYNC)
+    , m_adaptiveSupported(false)
+    , m_targetPeriod(1.0 / DEFAULT_TARGET_RATE)
+    , m_nextDeadline(0.0)
+    , m_maxQueuedFrames(0)
+    , m_fenceIndex(0)
+    , m_frameTimeCount(0)
+    , m_frameTimeIndex(0)
+    , m_lastFrameEnd(Window::getTime())
+{
+    m_fences.fill(nullptr);
+    m_frameTimes.fill(0.0);
+    
+    // Swap control tear is a WGL/GLX extension, not a GL one
+    m_adaptiveSupported = glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+                          glfwExtensionSupported("GLX_EXT_swap_control_tear");
+    
+    setMode(PacingMode::VSYNC);
+}
+
+FramePacer::~FramePacer() {
+    clearFences();
+}
+
+// =============================================================================
+// Settings
+// =============================================================================
+
+void FramePacer::setMode(PacingMode mode) {
+    if (mode == PacingMode::ADAPTIVE_VSYNC && !m_adaptiveSupported) {
+        mode = PacingMode::VSYNC;
+    }
+    m_mode = mode;
+    
+    switch (mode) {
+        case PacingMode::VSYNC:
+            m_window.setSwapInterval(1);
+            break;
+        case PacingMode::ADAPTIVE_VSYNC:
+            m_window.setSwapInterval(-1);
+            break;
+        case PacingMode::UNCAPPED:
+        case PacingMode::LIMITED:
+            m_window.setSwapInterval(0);
+            break;
+    }
+    
+    // Start the limiter schedule fresh instead of catching up
+    m_nextDeadline = Window::getTime() + m_targetPeriod;
+}
+
+void FramePacer::cycleMode() {
+    setMode(getNextMode(m_mode));
+}
+
+PacingMode FramePacer::getNextMode(PacingMode mode) const {
+    switch (mode) {
+        case PacingMode::VSYNC:
+            return m_adaptiveSupported ? PacingMode::ADAPTIVE_VSYNC : PacingMode::UNCAPPED;
+        case PacingMode::ADAPTIVE_VSYNC:
+            return PacingMode::UNCAPPED;
+        case PacingMode::UNCAPPED:
+            return PacingMode::LIMITED;
+        case PacingMode::LIMITED:
+            return PacingMode::VSYNC;
+    }
+    return PacingMode::VSYNC;
+}
+
+void FramePacer::setTargetFrameRate(double framesPerSecond) {
+    if (framesPerSecond > 0.0) {
+        m_targetPeriod = 1.0 / framesPerSecond;
+        m_nextDeadline = Window::getTime() + m_targetPeriod;
+    }
+}
+
+void FramePacer::setMaxQueuedFrames(size_t frames) {
+    clearFences();
+    m_maxQueuedFrames = std::min(frames, MAX_QUEUED_FRAMES);
+}
+
+// =============================================================================
+// Per-Frame
+// =============================================================================
+
+void FramePacer::endFrame() {
+    if (m_maxQueuedFrames > 0) {
+        throttleGpuQueue();
+    }
+    
+    if (m_mode == PacingMode::LIMITED) {
+        waitForDeadline();
+    }
+    
+    // Record the full frame time, waits included
+    double now = Window::getTime();
+    m_frameTimes[m_frameTimeIndex] = now - m_lastFrameEnd;
+    m_frameTimeIndex = (m_frameTimeIndex + 1) % HISTORY_SIZE;
+    m_frameTimeCount = std::min(m_frameTimeCount + 1, HISTORY_SIZE);
+    m_lastFrameEnd = now;
+}
+
+FrameTimeStats FramePacer::getStats() const {
+    FrameTimeStats stats;
+    stats.frameCount = m_frameTimeCount;
+    if (m_frameTimeCount == 0) {
+        return stats;
+    }
+    
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    double minimum = m_frameTimes[0];
+    double maximum = m_frameTimes[0];
+    for (size_t i = 0; i < m_frameTimeCount; i++) {
+        double t = m_frameTimes[i];
+        sum += t;
+        sumSquares += t * t;
+        minimum = std::min(minimum, t);
+        maximum = std::max(maximum, t);
+    }
+    
+    double count = static_cast<double>(m_frameTimeCount);
+    double mean = sum / count;
+    double variance = std::max(sumSquares / count - mean * mean, 0.0);
+    
+    stats.average = mean * 1000.0;
+    stats.standardDeviation = std::sqrt(variance) * 1000.0;
+    stats.minimum = minimum * 1000.0;
+    stats.maximum = maximum * 1000.0;
+    return stats;
+}
+
+const char* FramePacer::getModeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSYNC:          return "VSync";
+        case PacingMode::ADAPTIVE_VSYNC: return "Adaptive VSync";
+        case PacingMode::UNCAPPED:       return "Uncapped";
+        case PacingMode::LIMITED:        return "Frame limiter";
+    }
+    return "Unknown";
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void FramePacer::throttleGpuQueue() {
+    // The slot about to be reused holds the fence from m_maxQueuedFrames
+    // frames ago; once it has signaled, the GPU is at most that far behind
+    GLsync oldest = static_cast<GLsync>(m_fences[m_fenceIndex]);
+    if (oldest) {
+        glClientWaitSync(oldest, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+        glDeleteSync(oldest);
+    }
+    
+    m_fences[m_fenceIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_fenceIndex = (m_fenceIndex + 1) % m_maxQueuedFrames;
+}
+
+void FramePacer::waitForDeadline() {
+    double now = Window::getTime();
+    
+    // Far behind (a hitch, or the mode was just enabled): restart the
+    // schedule rather than rushing several frames out to catch up
+    if (now - m_nextDeadline > m_targetPeriod) {
+        m_nextDeadline = now;
+    }
+    
+    // Coarse sleep while the deadline is well away
+    double remaining = m_nextDeadline - now;
+    if (remaining > SPIN_THRESHOLD) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(remaining - SPIN_THRESHOLD));
+    }
+    
+    // Fine spin for the rest
+    while (Window::getTime() < m_nextDeadline) {
+        std::this_thread::yield();
+    }
+    
+    m_nextDeadline += m_targetPeriod;
+}
+
+void FramePacer::clearFences() {
+    for (void*& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+    m_fenceIndex = 0;
+}
@@ -0,0 +1,200 @@
+/**
+ * =============================================================================
+ * FramePacket.cpp - Frame Packet and Queue Implementation
+ * =============================================================================
+ */
+
+#include "FramePacket.h"
+#include "Collision.h"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+// =============================================================================
+// RenderView
+// =============================================================================
+
+glm::mat4 RenderView::getScreenProjection(int framebufferWidth, int framebufferHeight) const {
+    // Scale the view's NDC square down to the viewport and move it there
+    glm::vec2 scale(static_cast<float>(width) / static_cast<float>(framebufferWidth),
+                    static_cast<float>(height) / static_cast<float>(framebufferHeight));
+    glm::vec2 offset(static_cast<float>(2 * x + width) / static_cast<float>(framebufferWidth) - 1.0f,
+                     static_cast<float>(2 * y + height) / static_cast<float>(framebufferHeight) - 1.0f);
+    return glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f)) *
+           glm::scale(glm::mat4(1.0f), glm::vec3(scale, 1.0f)) * projection;
+}
+
+// =============================================================================
+// FramePacket
+// =============================================================================
+
+void FramePacket::cullItems() {
+    // One frustum per view; without views the camera is view 0
+    std::array<Frustum, MAX_VIEWS> frusta;
+    size_t viewCount = std::min(views.size(), MAX_VIEWS);
+    if (viewCount == 0) {
+        frusta[0] = Frustum::fromMatrix(projection * view);
+        viewCount = 1;
+    }
+    for (size_t i = 0; i < std::min(views.size(), MAX_VIEWS); i++) {
+        frusta[i] = Frustum::fromMatrix(views[i].projection * views[i].view);
+    }
+    
+    // Each item's bounds are tested once per view, here, instead of in
+    // every pass that draws it
+    for (auto* items : {&opaqueItems, &transparentItems}) {
+        for (DrawItem& item : *items) {
+            glm::vec3 center(item.bounds);
+            item.viewMask = 0;
+            for (size_t i = 0; i < viewCount; i++) {
+                if (frusta[i].intersectsSphere(center, item.bounds.w)) {
+                    item.viewMask |= 1u << i;
+                }
+            }
+            if (item.viewMask == 0) {
+                itemsCulled++;
+            }
+        }
+    }
+}
+
+void FramePacket::assignLights() {
+    static_assert(Renderer::MAX_POINT_LIGHTS <= 8 && Renderer::MAX_SPOT_LIGHTS <= 8,
+                  "Light masks hold 8 lights");
+    
+    // The renderer uploads only the first few lights of each kind
+    size_t pointCount = std::min(pointLights.size(), static_cast<size_t>(Renderer::MAX_POINT_LIGHTS));
+    size_t spotCount = std::min(spotLights.size(), static_cast<size_t>(Renderer::MAX_SPOT_LIGHTS));
+    
+    for (auto* items : {&opaqueItems, &transparentItems}) {
+        for (DrawItem& item : *items) {
+            item.pointLightMask = 0;
+            item.spotLightMask = 0;
+            if (item.material.lightMap != 0) {
+                continue;
+            }
+            
+            glm::vec3 center(item.bounds);
+            for (size_t i = 0; i < pointCount; i++) {
+                if (pointLights[i].reaches(center, item.bounds.w)) {
+                    item.pointLightMask |= static_cast<uint8_t>(1u << i);
+                }
+            }
+            for (size_t i = 0; i < spotCount; i++) {
+                if (spotLights[i].reaches(center, item.bounds.w)) {
+                    item.spotLightMask |= static_cast<uint8_t>(1u << i);
+                }
+            }
+        }
+    }
+}
+
+void FramePacket::clear() {
+    views.clear();
+    pointLights.clear();
+    spotLights.clear();
+    opaqueItems.clear();
+    transparentItems.clear();
+    labels.clear();
+    objectsTotal = 0;
+    objectsHidden = 0;
+    itemsCulled = 0;
+    pickRequested = false;
+}
+
+// =============================================================================
+// FrameQueue - Settings
+// =============================================================================
+
+void FrameQueue::setMaxQueuedFrames(size_t frames) {
+    m_maxQueued.store(std::clamp<size_t>(frames, 1, SLOT_COUNT - 1));
+    
+    // A larger limit may unblock the producer
+    if (m_producerWaiting.load()) {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_producerCondition.notify_one();
+    }
+}
+
+// =============================================================================
+// FrameQueue - Producer
+// =============================================================================
+
+FramePacket* FrameQueue::beginWrite() {
+    if (!canWrite()) {
+        // Announce the wait before re-checking, so endRead() either sees
+        // the flag or we see its new release count (both are seq_cst)
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        m_producerWaiting.store(true);
+        m_producerCondition.wait(lock, [this] { return canWrite() || m_closed.load(); });
+        m_producerWaiting.store(false);
+    }
+    
+    if (m_closed.load()) {
+        return nullptr;
+    }
+    return &m_slots[m_published.load(std::memory_order_relaxed) % SLOT_COUNT];
+}
+
+void FrameQueue::publish() {
+    m_published.fetch_add(1);
+    
+    if (m_consumerWaiting.load()) {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_consumerCondition.notify_one();
+    }
+}
+
+// =============================================================================
+// FrameQueue - Consumer
+// =============================================================================
+
+FramePacket* FrameQueue::beginRead() {
+    if (!canRead()) {
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        m_consumerWaiting.store(true);
+        m_consumerCondition.wait(lock, [this] { return canRead() || m_closed.load(); });
+        m_consumerWaiting.store(false);
+    }
+    
+    if (!canRead()) {
+        return nullptr;  // Closed with nothing left to draw
+    }
+    return &m_slots[m_released.load(std::memory_order_relaxed) % SLOT_COUNT];
+}
+
+void FrameQueue::endRead() {
+    m_released.fetch_add(1);
+    
+    if (m_producerWaiting.load()) {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_producerCondition.notify_one();
+    }
+}
+
+// =============================================================================
+// FrameQueue - Shutdown
+// =============================================================================
+
+void FrameQueue::close() {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    m_closed.store(true);
+    m_producerCondition.notify_all();
+    m_consumerCondition.notify_all();
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+bool FrameQueue::canWrite() const {
+    // Packets published but not yet fully drawn (the one being drawn
+    // included). The slot about to be written is always a free one.
+    uint64_t inFlight = m_published.load() - m_released.load();
+    return inFlight <= m_maxQueued.load();
+}
+
+bool FrameQueue::canRead() const {
+    return m_released.load() < m_published.load();
+}
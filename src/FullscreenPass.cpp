@@ -0,0 +1,46 @@
+/**
+ * =============================================================================
+ * FullscreenPass.cpp - Shared Fullscreen Triangle Implementation
+ * =============================================================================
+ */
+
+#include "FullscreenPass.h"
+
+#include <glad/glad.h>
+
+const char* const FullscreenPass::VERTEX_SHADER_SOURCE = R"(
+#version 330 core
+
+void main() {
+    // (-1,-1), (3,-1), (-1,3): one triangle covering the viewport
+    vec2 position = vec2(gl_VertexID == 1 ? 3.0 : -1.0, gl_VertexID == 2 ? 3.0 : -1.0);
+    gl_Position = vec4(position, 0.0, 1.0);
+}
+)";
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+FullscreenPass::FullscreenPass()
+    : m_emptyVAO(0)
+{
+    // Core profile draws need a VAO even without attributes
+    glGenVertexArrays(1, &m_emptyVAO);
+}
+
+FullscreenPass::~FullscreenPass() {
+    glDeleteVertexArrays(1, &m_emptyVAO);
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void FullscreenPass::bind() const {
+    glBindVertexArray(m_emptyVAO);
+}
+
+void FullscreenPass::draw() {
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+}
@@ -0,0 +1,72 @@
+/**
+ * =============================================================================
+ * GpuDeletionQueue.cpp - Deferred Deletion Implementation
+ * =============================================================================
+ */
+
+#include "GpuDeletionQueue.h"
+
+#include <glad/glad.h>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+std::mutex g_mutex;
+std::vector<GLuint> g_vertexArrays;
+std::vector<GLuint> g_buffers;
+std::vector<GLuint> g_textures;
+
+void enqueue(std::vector<GLuint>& list, unsigned int id) {
+    if (id == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_mutex);
+    list.push_back(id);
+}
+
+} // anonymous namespace
+
+namespace GpuDeletionQueue {
+
+void deleteVertexArray(unsigned int id) {
+    enqueue(g_vertexArrays, id);
+}
+
+void deleteBuffer(unsigned int id) {
+    enqueue(g_buffers, id);
+}
+
+void deleteTexture(unsigned int id) {
+    enqueue(g_textures, id);
+}
+
+void flush() {
+    // Swap the lists out so the GL calls run without holding the lock
+    std::vector<GLuint> vertexArrays;
+    std::vector<GLuint> buffers;
+    std::vector<GLuint> textures;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        vertexArrays.swap(g_vertexArrays);
+        buffers.swap(g_buffers);
+        textures.swap(g_textures);
+    }
+    
+    if (!vertexArrays.empty()) {
+        glDeleteVertexArrays(static_cast<GLsizei>(vertexArrays.size()), vertexArrays.data());
+    }
+    if (!buffers.empty()) {
+        glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+    }
+    if (!textures.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(textures.size()), textures.data());
+    }
+}
+
+size_t getPendingCount() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return g_vertexArrays.size() + g_buffers.size() + g_textures.size();
+}
+
+} // namespace GpuDeletionQueue
@@ -0,0 +1,82 @@
+/**
+ * =============================================================================
+ * GpuTimer.cpp - GPU Frame Timing Implementation
+ * =============================================================================
+ */
+
+#include "GpuTimer.h"
+
+#include <glad/glad.h>
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+GpuTimer::GpuTimer()
+    : m_index(0)
+    , m_measuring(false)
+    , m_lastTimeMs(0.0)
+{
+    glGenQueries(static_cast<GLsizei>(SLOT_COUNT), m_beginQueries.data());
+    glGenQueries(static_cast<GLsizei>(SLOT_COUNT), m_endQueries.data());
+    m_pending.fill(false);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(static_cast<GLsizei>(SLOT_COUNT), m_beginQueries.data());
+    glDeleteQueries(static_cast<GLsizei>(SLOT_COUNT), m_endQueries.data());
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void GpuTimer::beginFrame() {
+    collectResults();
+    
+    // A slot still in flight after SLOT_COUNT frames: skip this frame
+    // rather than wait for it
+    m_measuring = !m_pending[m_index];
+    if (m_measuring) {
+        glQueryCounter(m_beginQueries[m_index], GL_TIMESTAMP);
+    }
+}
+
+void GpuTimer::endFrame() {
+    if (!m_measuring) {
+        return;
+    }
+    
+    glQueryCounter(m_endQueries[m_index], GL_TIMESTAMP);
+    m_pending[m_index] = true;
+    m_index = (m_index + 1) % SLOT_COUNT;
+    m_measuring = false;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void GpuTimer::collectResults() {
+    // The current slot is the oldest one; go round from there
+    for (size_t n = 0; n < SLOT_COUNT; n++) {
+        size_t slot = (m_index + n) % SLOT_COUNT;
+        if (!m_pending[slot]) {
+            continue;
+        }
+        
+        // The end timestamp finishes last, so its result implies the start's
+        GLint available = 0;
+        glGetQueryObjectiv(m_endQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;  // Later slots can't be done either
+        }
+        
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(m_beginQueries[slot], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(m_endQueries[slot], GL_QUERY_RESULT, &end);
+        m_lastTimeMs = static_cast<double>(end - begin) / 1.0e6;
+        m_pending[slot] = false;
+    }
+}
@@ -26,6 +26,7 @@ Input::Input(Window& window)
     , m_cursorCaptured(false)
 {
     setupDefaultBindings();
+    m_frameEvents.reserve(InputEventQueue::CAPACITY);
     
     // Set up window callbacks to forward to this input handler
     window.setKeyCallback([this](int key, int scancode, int action, int mods) {
@@ -50,16 +51,23 @@ Input::Input(Window& window)
 // =============================================================================
 
 void Input::update() {
-    // Update previous key states
-    m_previousKeyStates = m_keyStates;
-    m_previousMouseButtonStates = m_mouseButtonStates;
+    // Save last frame's state, then apply everything received since
+    m_previousKeysDown = m_keysDown;
+    m_previousButtonsDown = m_buttonsDown;
+    
+    m_frameEvents.clear();
+    InputEvent event;
+    while (m_events.pop(event)) {
+        m_frameEvents.push_back(event);
+        applyEvent(event);
+    }
     
     // Reset per-frame values
     m_mouseDelta = glm::vec2(0.0f);
     m_scrollOffset = m_accumulatedScroll;
     m_accumulatedScroll = 0.0f;
     
-    // Calculate mouse delta
+    // Calculate mouse delta (motion already applied by lateLatch is excluded)
     double x, y;
     m_window.getMousePosition(x, y);
     glm::vec2 currentPos(static_cast<float>(x), static_cast<float>(y));
@@ -79,43 +87,28 @@ void Input::update() {
 // =============================================================================
 
 bool Input::isKeyHeld(int key) const {
-    auto it = m_keyStates.find(key);
-    if (it != m_keyStates.end()) {
-        return it->second == KeyState::PRESSED || it->second == KeyState::HELD;
-    }
-    return false;
+    return key >= 0 && key < MAX_KEYS && m_keysDown[key];
 }
 
 bool Input::isKeyPressed(int key) const {
-    auto it = m_keyStates.find(key);
-    auto prevIt = m_previousKeyStates.find(key);
-    
-    bool currentlyHeld = (it != m_keyStates.end() && 
-                          (it->second == KeyState::PRESSED || it->second == KeyState::HELD));
-    bool previouslyHeld = (prevIt != m_previousKeyStates.end() && 
-                           (prevIt->second == KeyState::PRESSED || prevIt->second == KeyState::HELD));
-    
-    return currentlyHeld && !previouslyHeld;
+    return isKeyHeld(key) && !m_previousKeysDown[key];
 }
 
 bool Input::isKeyReleased(int key) const {
-    auto it = m_keyStates.find(key);
-    auto prevIt = m_previousKeyStates.find(key);
-    
-    bool currentlyHeld = (it != m_keyStates.end() && 
-                          (it->second == KeyState::PRESSED || it->second == KeyState::HELD));
-    bool previouslyHeld = (prevIt != m_previousKeyStates.end() && 
-                           (prevIt->second == KeyState::PRESSED || prevIt->second == KeyState::HELD));
-    
-    return !currentlyHeld && previouslyHeld;
+    return key >= 0 && key < MAX_KEYS && !m_keysDown[key] && m_previousKeysDown[key];
 }
 
 KeyState Input::getKeyState(int key) const {
-    auto it = m_keyStates.find(key);
-    if (it != m_keyStates.end()) {
-        return it->second;
+    if (key < 0 || key >= MAX_KEYS) {
+        return KeyState::RELEASED;
     }
-    return KeyState::RELEASED;
+    
+    bool down = m_keysDown[key];
+    bool wasDown = m_previousKeysDown[key];
+    if (down) {
+        return wasDown ? KeyState::HELD : KeyState::PRESSED;
+    }
+    return wasDown ? KeyState::RELEASED_THIS_FRAME : KeyState::RELEASED;
 }
 
 void Input::onKeyPress(KeyPressCallback callback) {
@@ -127,23 +120,11 @@ void Input::onKeyPress(KeyPressCallback callback) {
 // =============================================================================
 
 bool Input::isMouseButtonHeld(int button) const {
-    auto it = m_mouseButtonStates.find(button);
-    if (it != m_mouseButtonStates.end()) {
-        return it->second == KeyState::PRESSED || it->second == KeyState::HELD;
-    }
-    return false;
+    return button >= 0 && button < MAX_MOUSE_BUTTONS && m_buttonsDown[button];
 }
 
 bool Input::isMouseButtonPressed(int button) const {
-    auto it = m_mouseButtonStates.find(button);
-    auto prevIt = m_previousMouseButtonStates.find(button);
-    
-    bool currentlyHeld = (it != m_mouseButtonStates.end() && 
-                          (it->second == KeyState::PRESSED || it->second == KeyState::HELD));
-    bool previouslyHeld = (prevIt != m_previousMouseButtonStates.end() && 
-                           (prevIt->second == KeyState::PRESSED || prevIt->second == KeyState::HELD));
-    
-    return currentlyHeld && !previouslyHeld;
+    return isMouseButtonHeld(button) && !m_previousButtonsDown[button];
 }
 
 void Input::onMouseMove(MouseMoveCallback callback) {
@@ -239,6 +220,27 @@ void Input::processCamera(Camera& camera, float deltaTime) {
     }
 }
 
+void Input::lateLatch(Camera& camera) {
+    if (!m_cursorCaptured || m_firstMouse) {
+        return;
+    }
+    
+    // Fetch motion the OS delivered while this frame was simulated.
+    // Other events only land in the ring and wait for the next update().
+    m_window.pollEvents();
+    
+    double x, y;
+    m_window.getMousePosition(x, y);
+    glm::vec2 currentPos(static_cast<float>(x), static_cast<float>(y));
+    
+    glm::vec2 delta = currentPos - m_lastMousePosition;
+    if (delta.x != 0.0f || delta.y != 0.0f) {
+        camera.processMouseMovement(delta.x, -delta.y);
+        m_lastMousePosition = currentPos;
+        m_mousePosition = currentPos;
+    }
+}
+
 void Input::processCar(CarModel& car, float deltaTime) {
     float move = 0.0f;
     float turn = 0.0f;
@@ -275,39 +277,58 @@ void Input::setupDefaultBindings() {
     bindAction("quit", GLFW_KEY_ESCAPE);
 }
 
-void Input::handleKey(int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods) {
-    if (action == GLFW_PRESS) {
-        m_keyStates[key] = KeyState::PRESSED;
-        
-        // Notify callbacks
-        for (auto& callback : m_keyPressCallbacks) {
-            callback(key);
-        }
-    } else if (action == GLFW_RELEASE) {
-        m_keyStates[key] = KeyState::RELEASED;
-    } else if (action == GLFW_REPEAT) {
-        m_keyStates[key] = KeyState::HELD;
+void Input::applyEvent(const InputEvent& event) {
+    switch (event.type) {
+        case InputEvent::Type::KEY:
+            if (event.code < 0 || event.code >= MAX_KEYS) {
+                break;  // GLFW_KEY_UNKNOWN
+            }
+            if (event.action == GLFW_PRESS) {
+                m_keysDown[event.code] = true;
+                
+                // Notify callbacks
+                for (auto& callback : m_keyPressCallbacks) {
+                    callback(event.code);
+                }
+            } else if (event.action == GLFW_RELEASE) {
+                m_keysDown[event.code] = false;
+            }
+            break;
+            
+        case InputEvent::Type::MOUSE_BUTTON:
+            if (event.code >= 0 && event.code < MAX_MOUSE_BUTTONS) {
+                m_buttonsDown[event.code] = (event.action == GLFW_PRESS);
+            }
+            break;
+            
+        case InputEvent::Type::CURSOR:
+            for (auto& callback : m_mouseMoveCallbacks) {
+                callback(event.x, event.y);
+            }
+            break;
+            
+        case InputEvent::Type::SCROLL:
+            m_accumulatedScroll += static_cast<float>(event.y);
+            
+            for (auto& callback : m_scrollCallbacks) {
+                callback(event.y);
+            }
+            break;
     }
 }
 
+void Input::handleKey(int key, [[maybe_unused]] int scancode, int action, int mods) {
+    m_events.push({InputEvent::Type::KEY, key, action, mods, 0.0, 0.0, Window::getTime()});
+}
+
 void Input::handleMouseMove(double xpos, double ypos) {
-    for (auto& callback : m_mouseMoveCallbacks) {
-        callback(xpos, ypos);
-    }
+    m_events.push({InputEvent::Type::CURSOR, 0, 0, 0, xpos, ypos, Window::getTime()});
 }
 
-void Input::handleMouseButton(int button, int action, [[maybe_unused]] int mods) {
-    if (action == GLFW_PRESS) {
-        m_mouseButtonStates[button] = KeyState::PRESSED;
-    } else if (action == GLFW_RELEASE) {
-        m_mouseButtonStates[button] = KeyState::RELEASED;
-    }
+void Input::handleMouseButton(int button, int action, int mods) {
+    m_events.push({InputEvent::Type::MOUSE_BUTTON, button, action, mods, 0.0, 0.0, Window::getTime()});
 }
 
-void Input::handleScroll([[maybe_unused]] double xoffset, double yoffset) {
-    m_accumulatedScroll += static_cast<float>(yoffset);
-    
-    for (auto& callback : m_scrollCallbacks) {
-        callback(yoffset);
-    }
+void Input::handleScroll(double xoffset, double yoffset) {
+    m_events.push({InputEvent::Type::SCROLL, 0, 0, 0, xoffset, yoffset, Window::getTime()});
 }
@@ -8,6 +8,47 @@
 #include "Shader.h"
 
 #include <cmath>
+#include <limits>
+
+namespace {
+
+/**
+ * Solve 1 / (constant + linear * d + quadratic * d^2) = RANGE_ATTENUATION for d.
+ */
+float getAttenuationRange(float constant, float linear, float quadratic) {
+    float c = constant - 1.0f / Light::RANGE_ATTENUATION;
+    if (c >= 0.0f) {
+        return 0.0f;    // Dimmer than the cutoff even at the light
+    }
+    if (quadratic > 0.0f) {
+        return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * c)) / (2.0f * quadratic);
+    }
+    if (linear > 0.0f) {
+        return -c / linear;
+    }
+    return std::numeric_limits<float>::infinity();
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Uniform Names
+// =============================================================================
+
+LightUniformNames::LightUniformNames(const std::string& prefix)
+    : enabled(prefix + ".enabled")
+    , position(prefix + ".position")
+    , direction(prefix + ".direction")
+    , ambient(prefix + ".ambient")
+    , diffuse(prefix + ".diffuse")
+    , specular(prefix + ".specular")
+    , cutOff(prefix + ".cutOff")
+    , outerCutOff(prefix + ".outerCutOff")
+    , constant(prefix + ".constant")
+    , linear(prefix + ".linear")
+    , quadratic(prefix + ".quadratic")
+{
+}
 
 // =============================================================================
 // Base Light
@@ -21,6 +62,10 @@ Light::Light()
 {
 }
 
+void Light::applyToShader(Shader& shader, const std::string& uniformName) const {
+    applyToShader(shader, LightUniformNames(uniformName));
+}
+
 // =============================================================================
 // Directional Light
 // =============================================================================
@@ -43,12 +88,12 @@ DirectionalLight::DirectionalLight(const glm::vec3& dir,
     specular = spec;
 }
 
-void DirectionalLight::applyToShader(Shader& shader, const std::string& uniformName) const {
-    shader.setBool(uniformName + ".enabled", enabled);
-    shader.setVec3(uniformName + ".direction", direction);
-    shader.setVec3(uniformName + ".ambient", ambient);
-    shader.setVec3(uniformName + ".diffuse", diffuse);
-    shader.setVec3(uniformName + ".specular", specular);
+void DirectionalLight::applyToShader(Shader& shader, const LightUniformNames& names) const {
+    shader.setBool(names.enabled, enabled);
+    shader.setVec3(names.direction, direction);
+    shader.setVec3(names.ambient, ambient);
+    shader.setVec3(names.diffuse, diffuse);
+    shader.setVec3(names.specular, specular);
 }
 
 // =============================================================================
@@ -80,15 +125,15 @@ PointLight::PointLight(const glm::vec3& pos,
     specular = spec;
 }
 
-void PointLight::applyToShader(Shader& shader, const std::string& uniformName) const {
-    shader.setBool(uniformName + ".enabled", enabled);
-    shader.setVec3(uniformName + ".position", position);
-    shader.setVec3(uniformName + ".ambient", ambient);
-    shader.setVec3(uniformName + ".diffuse", diffuse);
-    shader.setVec3(uniformName + ".specular", specular);
-    shader.setFloat(uniformName + ".constant", constant);
-    shader.setFloat(uniformName + ".linear", linear);
-    shader.setFloat(uniformName + ".quadratic", quadratic);
+void PointLight::applyToShader(Shader& shader, const LightUniformNames& names) const {
+    shader.setBool(names.enabled, enabled);
+    shader.setVec3(names.position, position);
+    shader.setVec3(names.ambient, ambient);
+    shader.setVec3(names.diffuse, diffuse);
+    shader.setVec3(names.specular, specular);
+    shader.setFloat(names.constant, constant);
+    shader.setFloat(names.linear, linear);
+    shader.setFloat(names.quadratic, quadratic);
 }
 
 void PointLight::setRange(float range) {
@@ -99,6 +144,19 @@ void PointLight::setRange(float range) {
     quadratic = 75.0f / (range * range);
 }
 
+float PointLight::getRange() const {
+    return getAttenuationRange(constant, linear, quadratic);
+}
+
+bool PointLight::reaches(const glm::vec3& center, float radius) const {
+    if (!enabled) {
+        return false;
+    }
+    float reach = getRange() + radius;
+    glm::vec3 offset = center - position;
+    return glm::dot(offset, offset) <= reach * reach;
+}
+
 // =============================================================================
 // Spot Light
 // =============================================================================
@@ -135,24 +193,54 @@ SpotLight::SpotLight(const glm::vec3& pos,
     specular = spec;
 }
 
-void SpotLight::applyToShader(Shader& shader, const std::string& uniformName) const {
-    shader.setBool(uniformName + ".enabled", enabled);
-    shader.setVec3(uniformName + ".position", position);
-    shader.setVec3(uniformName + ".direction", direction);
-    shader.setVec3(uniformName + ".ambient", ambient);
-    shader.setVec3(uniformName + ".diffuse", diffuse);
-    shader.setVec3(uniformName + ".specular", specular);
+void SpotLight::applyToShader(Shader& shader, const LightUniformNames& names) const {
+    shader.setBool(names.enabled, enabled);
+    shader.setVec3(names.position, position);
+    shader.setVec3(names.direction, direction);
+    shader.setVec3(names.ambient, ambient);
+    shader.setVec3(names.diffuse, diffuse);
+    shader.setVec3(names.specular, specular);
     
     // Store cutoff as cosine for efficient comparison in shader
-    shader.setFloat(uniformName + ".cutOff", std::cos(glm::radians(innerCutoff)));
-    shader.setFloat(uniformName + ".outerCutOff", std::cos(glm::radians(outerCutoff)));
+    shader.setFloat(names.cutOff, std::cos(glm::radians(innerCutoff)));
+    shader.setFloat(names.outerCutOff, std::cos(glm::radians(outerCutoff)));
     
-    shader.setFloat(uniformName + ".constant", constant);
-    shader.setFloat(uniformName + ".linear", linear);
-    shader.setFloat(uniformName + ".quadratic", quadratic);
+    shader.setFloat(names.constant, constant);
+    shader.setFloat(names.linear, linear);
+    shader.setFloat(names.quadratic, quadratic);
 }
 
 void SpotLight::setCutoff(float innerDegrees, float outerDegrees) {
     innerCutoff = innerDegrees;
     outerCutoff = outerDegrees;
 }
+
+float SpotLight::getRange() const {
+    return getAttenuationRange(constant, linear, quadratic);
+}
+
+bool SpotLight::reaches(const glm::vec3& center, float radius) const {
+    if (!enabled) {
+        return false;
+    }
+    glm::vec3 offset = center - position;
+    float reach = getRange() + radius;
+    if (glm::dot(offset, offset) > reach * reach) {
+        return false;
+    }
+    
+    // The shader adds the ambient term outside the cone too
+    if (ambient != glm::vec3(0.0f)) {
+        return true;
+    }
+    
+    // Signed distance from the sphere's center to the outer cone's surface
+    glm::vec3 axis = glm::normalize(direction);
+    float along = glm::dot(offset, axis);
+    if (along < -radius) {
+        return false;   // Behind the light
+    }
+    float across = glm::length(offset - axis * along);
+    float angle = glm::radians(outerCutoff);
+    return std::cos(angle) * across - std::sin(angle) * along <= radius;
+}
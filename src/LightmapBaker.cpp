@@ -0,0 +1,752 @@
+/**
+ * =============================================================================
+ * LightmapBaker.cpp - CPU Lightmap Baking Implementation
+ * =============================================================================
+ */
+
+#include "LightmapBaker.h"
+#include "RenderStats.h"
+#include "ThreadPool.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <fstream>
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+// Rays start this far off the surface so they don't hit it again
+constexpr float RAY_OFFSET = 0.01f;
+constexpr float MAX_RAY_DISTANCE = 1.0e6f;
+
+// Lights attenuated below this add nothing visible
+constexpr float LIGHT_CUTOFF = 1.0f / 256.0f;
+
+// Two triangles share a chart if their normals are at least this close
+constexpr float COPLANAR_COSINE = 0.999f;
+
+// Texels handed to a worker at a time
+constexpr size_t TEXEL_GRAIN = 64;
+
+// Cache file header
+constexpr uint32_t CACHE_MAGIC = 0x50414D4C;    // "LMAP"
+constexpr uint32_t CACHE_VERSION = 1;
+
+/**
+ * Chart - Up to two triangles laid flat together in a lightmap.
+ */
+struct Chart {
+    uint32_t triangles[2];
+    uint32_t triangleCount;
+    glm::vec3 origin;           // World-space frame the chart is flattened into
+    glm::vec3 axisU;
+    glm::vec3 axisV;
+    glm::vec2 min;              // Flattened bounds, in meters
+    glm::vec2 max;
+    glm::ivec2 size;            // Texels, padding included
+    glm::ivec2 offset;          // Lower-left texel in the lightmap
+};
+
+glm::vec2 flatten(const Chart& chart, const glm::vec3& point) {
+    glm::vec3 local = point - chart.origin;
+    return glm::vec2(glm::dot(local, chart.axisU), glm::dot(local, chart.axisV));
+}
+
+/**
+ * Size the charts at a texel density and shelf-pack them, tallest first.
+ * @param width Output: lightmap width
+ * @param height Output: lightmap height
+ */
+void packCharts(std::vector<Chart>& charts, float density, int& width, int& height) {
+    const int padding = 2 * LightmapBaker::CHART_PADDING;
+    
+    size_t area = 0;
+    int widest = 0;
+    for (Chart& chart : charts) {
+        glm::vec2 extent = (chart.max - chart.min) * density;
+        chart.size.x = std::max(1, static_cast<int>(std::ceil(extent.x))) + padding;
+        chart.size.y = std::max(1, static_cast<int>(std::ceil(extent.y))) + padding;
+        area += static_cast<size_t>(chart.size.x) * chart.size.y;
+        widest = std::max(widest, chart.size.x);
+    }
+    
+    // Aim for a square lightmap
+    width = std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))));
+    
+    std::vector<size_t> order(charts.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return charts[a].size.y > charts[b].size.y;
+    });
+    
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (size_t index : order) {
+        Chart& chart = charts[index];
+        if (x + chart.size.x > width) {
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+        chart.offset = glm::ivec2(x, y);
+        x += chart.size.x;
+        shelfHeight = std::max(shelfHeight, chart.size.y);
+    }
+    height = y + shelfHeight;
+}
+
+/**
+ * Barycentric weights of the point of triangle abc closest to p (2D).
+ * Texels just outside a chart's triangles take the lighting of its edge,
+ * which fills the padding.
+ */
+glm::vec3 closestBarycentric(const glm::vec2& p, const glm::vec2& a,
+                             const glm::vec2& b, const glm::vec2& c) {
+    glm::vec2 ab = b - a;
+    glm::vec2 ac = c - a;
+    glm::vec2 ap = p - a;
+    float d00 = glm::dot(ab, ab);
+    float d01 = glm::dot(ab, ac);
+    float d11 = glm::dot(ac, ac);
+    float d20 = glm::dot(ap, ab);
+    float d21 = glm::dot(ap, ac);
+    float denominator = d00 * d11 - d01 * d01;
+    if (std::abs(denominator) > 1e-12f) {
+        float v = (d11 * d20 - d01 * d21) / denominator;
+        float w = (d00 * d21 - d01 * d20) / denominator;
+        float u = 1.0f - v - w;
+        if (u >= 0.0f && v >= 0.0f && w >= 0.0f) {
+            return glm::vec3(u, v, w);
+        }
+    }
+    
+    // Outside: nearest point on one of the edges
+    const glm::vec2 corners[3] = {a, b, c};
+    glm::vec3 best(1.0f, 0.0f, 0.0f);
+    float bestDistance = FLT_MAX;
+    for (int edge = 0; edge < 3; edge++) {
+        int next = (edge + 1) % 3;
+        glm::vec2 direction = corners[next] - corners[edge];
+        float lengthSquared = glm::dot(direction, direction);
+        float t = lengthSquared > 0.0f
+            ? glm::clamp(glm::dot(p - corners[edge], direction) / lengthSquared, 0.0f, 1.0f)
+            : 0.0f;
+        glm::vec2 offset = p - (corners[edge] + direction * t);
+        float distance = glm::dot(offset, offset);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = glm::vec3(0.0f);
+            best[edge] = 1.0f - t;
+            best[next] = t;
+        }
+    }
+    return best;
+}
+
+/**
+ * Van der Corput radical inverse in base 2 (second Hammersley coordinate).
+ */
+float radicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return static_cast<float>(bits) * 2.3283064365386963e-10f;
+}
+
+/**
+ * Integer hash (for a fixed per-texel offset of the sample pattern).
+ */
+uint32_t hashIndex(uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7FEB352Du;
+    value ^= value >> 15;
+    value *= 0x846CA68Bu;
+    value ^= value >> 16;
+    return value;
+}
+
+/**
+ * Direction around a normal, distributed like cos(theta): rays near the
+ * normal, where light counts most, are sampled most.
+ */
+glm::vec3 cosineDirection(const glm::vec3& normal, float u1, float u2) {
+    float radius = std::sqrt(u1);
+    float phi = 2.0f * PI * u2;
+    
+    glm::vec3 up = std::abs(normal.y) < 0.999f ? glm::vec3(0.0f, 1.0f, 0.0f)
+                                               : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 tangent = glm::normalize(glm::cross(up, normal));
+    glm::vec3 bitangent = glm::cross(normal, tangent);
+    return tangent * (radius * std::cos(phi)) + bitangent * (radius * std::sin(phi)) +
+           normal * std::sqrt(std::max(0.0f, 1.0f - u1));
+}
+
+/**
+ * FNV-1a over raw bytes.
+ */
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+}
+
+template <typename T>
+void hashValue(uint64_t& hash, const T& value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Setup
+// =============================================================================
+
+size_t LightmapBaker::addSurface(MeshData& mesh, const glm::mat4& model, const Material& material) {
+    Surface surface;
+    surface.ambient = material.ambient;
+    surface.diffuse = material.diffuse;
+    
+    const std::vector<Vertex>& vertices = mesh.vertices;
+    const std::vector<unsigned int>& indices = mesh.indices;
+    uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    
+    std::vector<glm::vec3> world(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        world[i] = glm::vec3(model * glm::vec4(vertices[i].Position, 1.0f));
+    }
+    
+    auto corner = [&](uint32_t triangle, int k) {
+        return world[indices[3 * triangle + k]];
+    };
+    auto faceNormal = [&](uint32_t triangle) {
+        glm::vec3 normal = glm::cross(corner(triangle, 1) - corner(triangle, 0),
+                                      corner(triangle, 2) - corner(triangle, 0));
+        float length = glm::length(normal);
+        return length > 1e-8f ? normal / length : glm::vec3(0.0f);
+    };
+    
+    // Quads (two coplanar triangles sharing an edge) become one chart;
+    // every generator emits its quads as consecutive triangles
+    auto sharesChart = [&](uint32_t a, uint32_t b) {
+        int shared = 0;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                shared += indices[3 * a + i] == indices[3 * b + j];
+            }
+        }
+        return shared == 2 && glm::dot(faceNormal(a), faceNormal(b)) > COPLANAR_COSINE;
+    };
+    
+    std::vector<Chart> charts;
+    for (uint32_t triangle = 0; triangle < triangleCount;) {
+        Chart chart{};
+        chart.triangles[0] = triangle;
+        chart.triangleCount = 1;
+        if (triangle + 1 < triangleCount && sharesChart(triangle, triangle + 1)) {
+            chart.triangles[1] = triangle + 1;
+            chart.triangleCount = 2;
+        }
+        triangle += chart.triangleCount;
+        
+        // Lay the chart flat along its first edge
+        glm::vec3 normal = faceNormal(chart.triangles[0]);
+        glm::vec3 edge = corner(chart.triangles[0], 1) - corner(chart.triangles[0], 0);
+        chart.origin = corner(chart.triangles[0], 0);
+        if (normal == glm::vec3(0.0f)) {
+            chart.axisU = glm::vec3(1.0f, 0.0f, 0.0f);     // Degenerate: any frame will do
+            chart.axisV = glm::vec3(0.0f, 1.0f, 0.0f);
+        } else {
+            chart.axisU = glm::normalize(edge);
+            chart.axisV = glm::cross(normal, chart.axisU);
+        }
+        
+        chart.min = glm::vec2(FLT_MAX);
+        chart.max = glm::vec2(-FLT_MAX);
+        for (uint32_t t = 0; t < chart.triangleCount; t++) {
+            for (int k = 0; k < 3; k++) {
+                glm::vec2 flat = flatten(chart, corner(chart.triangles[t], k));
+                chart.min = glm::min(chart.min, flat);
+                chart.max = glm::max(chart.max, flat);
+            }
+        }
+        charts.push_back(chart);
+    }
+    
+    // Big surfaces get fewer texels per meter rather than a huge lightmap
+    float density = TEXELS_PER_METER;
+    int width = 0;
+    int height = 0;
+    for (int attempt = 0; attempt < 32; attempt++) {
+        packCharts(charts, density, width, height);
+        if (width <= MAX_SIZE && height <= MAX_SIZE) {
+            break;
+        }
+        density *= 0.8f;
+    }
+    surface.lightmap.width = width;
+    surface.lightmap.height = height;
+    surface.lightmap.texels.assign(static_cast<size_t>(width) * height, glm::vec3(0.0f));
+    
+    // New vertices: one per chart corner, with its lightmap UV
+    MeshData charted;
+    charted.vertices.reserve(vertices.size());
+    charted.indices.reserve(indices.size());
+    std::vector<glm::vec3> normals;
+    const glm::vec2 lightmapSize(static_cast<float>(width), static_cast<float>(height));
+    
+    for (const Chart& chart : charts) {
+        unsigned int originals[6];
+        unsigned int remapped[6];
+        int cornerCount = 0;
+        
+        for (uint32_t t = 0; t < chart.triangleCount; t++) {
+            for (int k = 0; k < 3; k++) {
+                unsigned int original = indices[3 * chart.triangles[t] + k];
+                int found = 0;
+                while (found < cornerCount && originals[found] != original) {
+                    found++;
+                }
+                if (found == cornerCount) {
+                    glm::vec2 texel = glm::vec2(chart.offset + glm::ivec2(CHART_PADDING)) +
+                                      (flatten(chart, world[original]) - chart.min) * density;
+                    Vertex vertex = vertices[original];
+                    vertex.TexCoords = texel / lightmapSize;
+                    
+                    originals[cornerCount] = original;
+                    remapped[cornerCount] = static_cast<unsigned int>(charted.vertices.size());
+                    cornerCount++;
+                    
+                    charted.vertices.push_back(vertex);
+                    surface.positions.push_back(world[original]);
+                    surface.uvs.push_back(vertex.TexCoords);
+                    normals.push_back(glm::normalize(normalMatrix * vertex.Normal));
+                }
+                charted.indices.push_back(remapped[found]);
+            }
+        }
+    }
+    surface.indices = charted.indices;
+    
+    // Find the surface point under every texel of every chart
+    surface.samples.resize(static_cast<size_t>(width) * height);
+    uint32_t chartTriangle = 0;
+    for (const Chart& chart : charts) {
+        for (int y = chart.offset.y; y < chart.offset.y + chart.size.y; y++) {
+            for (int x = chart.offset.x; x < chart.offset.x + chart.size.x; x++) {
+                glm::vec2 center(x + 0.5f, y + 0.5f);
+                TexelSample& sample = surface.samples[static_cast<size_t>(y) * width + x];
+                float bestDistance = FLT_MAX;
+                
+                for (uint32_t t = 0; t < chart.triangleCount; t++) {
+                    const unsigned int* corners = &surface.indices[3 * (chartTriangle + t)];
+                    glm::vec2 a = surface.uvs[corners[0]] * lightmapSize;
+                    glm::vec2 b = surface.uvs[corners[1]] * lightmapSize;
+                    glm::vec2 c = surface.uvs[corners[2]] * lightmapSize;
+                    glm::vec3 weights = closestBarycentric(center, a, b, c);
+                    
+                    glm::vec2 closest = a * weights.x + b * weights.y + c * weights.z;
+                    float distance = glm::dot(center - closest, center - closest);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        sample.position = surface.positions[corners[0]] * weights.x +
+                                          surface.positions[corners[1]] * weights.y +
+                                          surface.positions[corners[2]] * weights.z;
+                        glm::vec3 normal = normals[corners[0]] * weights.x +
+                                           normals[corners[1]] * weights.y +
+                                           normals[corners[2]] * weights.z;
+                        sample.normal = glm::length(normal) > 0.0f ? glm::normalize(normal)
+                                                                   : glm::vec3(0.0f, 1.0f, 0.0f);
+                        sample.used = true;
+                    }
+                }
+            }
+        }
+        chartTriangle += chart.triangleCount;
+    }
+    
+    mesh = std::move(charted);
+    m_surfaces.push_back(std::move(surface));
+    return m_surfaces.size() - 1;
+}
+
+void LightmapBaker::setLights(const DirectionalLight& sun, const std::vector<PointLight>& pointLights,
+                              const std::vector<SpotLight>& spotLights) {
+    m_sun = sun;
+    m_pointLights.clear();
+    for (const PointLight& light : pointLights) {
+        if (light.enabled) {
+            m_pointLights.push_back(light);
+        }
+    }
+    m_spotLights.clear();
+    for (const SpotLight& light : spotLights) {
+        if (light.enabled) {
+            m_spotLights.push_back(light);
+        }
+    }
+}
+
+// =============================================================================
+// Baking
+// =============================================================================
+
+void LightmapBaker::bake() {
+    // One hierarchy over every surface, in world space
+    std::vector<glm::vec3> positions;
+    std::vector<unsigned int> indices;
+    m_triangleSurfaces.clear();
+    for (size_t s = 0; s < m_surfaces.size(); s++) {
+        Surface& surface = m_surfaces[s];
+        surface.firstTriangle = static_cast<uint32_t>(indices.size() / 3);
+        unsigned int base = static_cast<unsigned int>(positions.size());
+        positions.insert(positions.end(), surface.positions.begin(), surface.positions.end());
+        for (unsigned int index : surface.indices) {
+            indices.push_back(base + index);
+        }
+        m_triangleSurfaces.insert(m_triangleSurfaces.end(), surface.indices.size() / 3,
+                                  static_cast<uint32_t>(s));
+    }
+    m_bvh.build(positions, indices);
+    
+    // Every texel that lies on (or pads) a chart
+    struct TexelRef {
+        uint32_t surface;
+        uint32_t texel;
+    };
+    std::vector<TexelRef> texels;
+    texels.reserve(getTexelCount());
+    for (size_t s = 0; s < m_surfaces.size(); s++) {
+        const std::vector<TexelSample>& samples = m_surfaces[s].samples;
+        for (size_t t = 0; t < samples.size(); t++) {
+            if (samples[t].used) {
+                texels.push_back({static_cast<uint32_t>(s), static_cast<uint32_t>(t)});
+            }
+        }
+    }
+    
+    // Per-texel light, laid out like the lightmaps
+    auto makeBuffer = [&]() {
+        std::vector<std::vector<glm::vec3>> buffer(m_surfaces.size());
+        for (size_t s = 0; s < m_surfaces.size(); s++) {
+            buffer[s].assign(m_surfaces[s].samples.size(), glm::vec3(0.0f));
+        }
+        return buffer;
+    };
+    std::vector<std::vector<glm::vec3>> direct = makeBuffer();
+    std::vector<std::vector<glm::vec3>> ambient = makeBuffer();
+    std::vector<std::vector<glm::vec3>> indirect = makeBuffer();
+    
+    ThreadPool& pool = ThreadPool::getShared();
+    pool.parallelFor(texels.size(), TEXEL_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const TexelRef& ref = texels[i];
+            const Surface& surface = m_surfaces[ref.surface];
+            const TexelSample& sample = surface.samples[ref.texel];
+            computeDirect(sample.position, sample.normal, surface,
+                          direct[ref.surface][ref.texel], ambient[ref.surface][ref.texel]);
+        }
+    });
+    
+    // Each pass gathers the light the previous pass left on the surfaces
+    std::vector<std::vector<glm::vec3>> previous = direct;
+    std::vector<std::vector<glm::vec3>> bounce = makeBuffer();
+    for (int pass = 0; pass < BOUNCES; pass++) {
+        bool measureOcclusion = (pass == 0);
+        
+        pool.parallelFor(texels.size(), TEXEL_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const TexelRef& ref = texels[i];
+                const Surface& surface = m_surfaces[ref.surface];
+                const TexelSample& sample = surface.samples[ref.texel];
+                glm::vec3 origin = sample.position + sample.normal * RAY_OFFSET;
+                
+                // Shift the shared Hammersley pattern per texel, so
+                // neighbours don't repeat the same error
+                uint32_t seed = hashIndex(static_cast<uint32_t>(i));
+                float shiftU = static_cast<float>(seed & 0xFFFFu) / 65536.0f;
+                float shiftV = static_cast<float>(seed >> 16) / 65536.0f;
+                
+                glm::vec3 incoming(0.0f);
+                int open = 0;
+                for (int k = 0; k < SAMPLES_PER_TEXEL; k++) {
+                    float u1 = (k + 0.5f) / SAMPLES_PER_TEXEL + shiftU;
+                    float u2 = radicalInverse(static_cast<uint32_t>(k)) + shiftV;
+                    u1 -= std::floor(u1);
+                    u2 -= std::floor(u2);
+                    
+                    float distance = 0.0f;
+                    Ray ray(origin, cosineDirection(sample.normal, u1, u2));
+                    incoming += gather(ray, previous, distance);
+                    if (distance < 0.0f || distance > OCCLUSION_DISTANCE) {
+                        open++;
+                    }
+                }
+                
+                // Cosine-weighted samples: the average is the diffuse bounce
+                bounce[ref.surface][ref.texel] = surface.diffuse * incoming /
+                                                 static_cast<float>(SAMPLES_PER_TEXEL);
+                if (measureOcclusion) {
+                    ambient[ref.surface][ref.texel] *= static_cast<float>(open) / SAMPLES_PER_TEXEL;
+                }
+            }
+        });
+        
+        for (size_t s = 0; s < m_surfaces.size(); s++) {
+            for (size_t t = 0; t < indirect[s].size(); t++) {
+                indirect[s][t] += bounce[s][t];
+            }
+        }
+        std::swap(previous, bounce);
+    }
+    
+    for (size_t s = 0; s < m_surfaces.size(); s++) {
+        std::vector<glm::vec3>& result = m_surfaces[s].lightmap.texels;
+        for (size_t t = 0; t < result.size(); t++) {
+            result[t] = ambient[s][t] + direct[s][t] + indirect[s][t];
+        }
+    }
+}
+
+void LightmapBaker::computeDirect(const glm::vec3& position, const glm::vec3& normal,
+                                  const Surface& surface, glm::vec3& direct,
+                                  glm::vec3& ambient) const {
+    // Same terms as the main shader, minus specular
+    direct = glm::vec3(0.0f);
+    ambient = glm::vec3(0.0f);
+    glm::vec3 origin = position + normal * RAY_OFFSET;
+    
+    // The sun stands in for skylight: the showroom box is closed, so it
+    // casts no shadows here, just as in the dynamic path
+    if (m_sun.enabled) {
+        float diff = std::max(glm::dot(normal, glm::normalize(-m_sun.direction)), 0.0f);
+        ambient += m_sun.ambient * surface.ambient;
+        direct += m_sun.diffuse * diff * surface.diffuse;
+    }
+    
+    for (const PointLight& light : m_pointLights) {
+        glm::vec3 toLight = light.position - position;
+        float distance = glm::length(toLight);
+        float attenuation = 1.0f / (light.constant + light.linear * distance +
+                                    light.quadratic * distance * distance);
+        if (attenuation < LIGHT_CUTOFF) {
+            continue;
+        }
+        
+        ambient += light.ambient * surface.ambient * attenuation;
+        float diff = distance > 0.0f ? std::max(glm::dot(normal, toLight / distance), 0.0f) : 0.0f;
+        if (diff > 0.0f && !isOccluded(origin, light.position)) {
+            direct += light.diffuse * diff * surface.diffuse * attenuation;
+        }
+    }
+    
+    for (const SpotLight& light : m_spotLights) {
+        glm::vec3 toLight = light.position - position;
+        float distance = glm::length(toLight);
+        float attenuation = 1.0f / (light.constant + light.linear * distance +
+                                    light.quadratic * distance * distance);
+        if (attenuation < LIGHT_CUTOFF || distance <= 0.0f) {
+            continue;
+        }
+        
+        glm::vec3 lightDir = toLight / distance;
+        float cosInner = std::cos(glm::radians(light.innerCutoff));
+        float cosOuter = std::cos(glm::radians(light.outerCutoff));
+        float theta = glm::dot(lightDir, glm::normalize(-light.direction));
+        float intensity = glm::clamp((theta - cosOuter) / (cosInner - cosOuter), 0.0f, 1.0f);
+        
+        ambient += light.ambient * surface.ambient * attenuation;
+        float diff = std::max(glm::dot(normal, lightDir), 0.0f);
+        if (diff > 0.0f && intensity > 0.0f && !isOccluded(origin, light.position)) {
+            direct += light.diffuse * diff * surface.diffuse * intensity * attenuation;
+        }
+    }
+}
+
+bool LightmapBaker::isOccluded(const glm::vec3& origin, const glm::vec3& target) const {
+    glm::vec3 toTarget = target - origin;
+    float distance = glm::length(toTarget);
+    if (distance <= RAY_OFFSET) {
+        return false;
+    }
+    TriangleHit hit;
+    return m_bvh.raycast(Ray(origin, toTarget), distance - RAY_OFFSET, hit);
+}
+
+glm::vec3 LightmapBaker::gather(const Ray& ray, const std::vector<std::vector<glm::vec3>>& source,
+                                float& hitDistance) const {
+    TriangleHit hit;
+    if (!m_bvh.raycast(ray, MAX_RAY_DISTANCE, hit)) {
+        hitDistance = -1.0f;
+        return glm::vec3(0.0f);
+    }
+    hitDistance = hit.distance;
+    
+    uint32_t s = m_triangleSurfaces[hit.triangle];
+    const Surface& surface = m_surfaces[s];
+    const unsigned int* corners = &surface.indices[3 * (hit.triangle - surface.firstTriangle)];
+    
+    // Back faces are the inside of a closed shape: no light there
+    const glm::vec3& p0 = surface.positions[corners[0]];
+    glm::vec3 faceNormal = glm::cross(surface.positions[corners[1]] - p0,
+                                      surface.positions[corners[2]] - p0);
+    if (glm::dot(faceNormal, ray.direction) >= 0.0f) {
+        return glm::vec3(0.0f);
+    }
+    
+    glm::vec2 uv = surface.uvs[corners[0]] * hit.barycentric.x +
+                   surface.uvs[corners[1]] * hit.barycentric.y +
+                   surface.uvs[corners[2]] * hit.barycentric.z;
+    int width = surface.lightmap.width;
+    int height = surface.lightmap.height;
+    int x = glm::clamp(static_cast<int>(uv.x * width), 0, width - 1);
+    int y = glm::clamp(static_cast<int>(uv.y * height), 0, height - 1);
+    return source[s][static_cast<size_t>(y) * width + x];
+}
+
+// =============================================================================
+// Cache
+// =============================================================================
+
+uint64_t LightmapBaker::computeKey() const {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    
+    hashValue(hash, CACHE_VERSION);
+    hashValue(hash, TEXELS_PER_METER);
+    hashValue(hash, MAX_SIZE);
+    hashValue(hash, CHART_PADDING);
+    hashValue(hash, SAMPLES_PER_TEXEL);
+    hashValue(hash, BOUNCES);
+    hashValue(hash, OCCLUSION_DISTANCE);
+    
+    for (const Surface& surface : m_surfaces) {
+        hashValue(hash, surface.ambient);
+        hashValue(hash, surface.diffuse);
+        hashValue(hash, surface.lightmap.width);
+        hashValue(hash, surface.lightmap.height);
+        hashBytes(hash, surface.positions.data(), surface.positions.size() * sizeof(glm::vec3));
+        hashBytes(hash, surface.uvs.data(), surface.uvs.size() * sizeof(glm::vec2));
+        hashBytes(hash, surface.indices.data(), surface.indices.size() * sizeof(unsigned int));
+    }
+    
+    hashValue(hash, m_sun.enabled);
+    hashValue(hash, m_sun.direction);
+    hashValue(hash, m_sun.ambient);
+    hashValue(hash, m_sun.diffuse);
+    for (const PointLight& light : m_pointLights) {
+        hashValue(hash, light.position);
+        hashValue(hash, light.ambient);
+        hashValue(hash, light.diffuse);
+        hashValue(hash, light.constant);
+        hashValue(hash, light.linear);
+        hashValue(hash, light.quadratic);
+    }
+    for (const SpotLight& light : m_spotLights) {
+        hashValue(hash, light.position);
+        hashValue(hash, light.direction);
+        hashValue(hash, light.ambient);
+        hashValue(hash, light.diffuse);
+        hashValue(hash, light.innerCutoff);
+        hashValue(hash, light.outerCutoff);
+        hashValue(hash, light.constant);
+        hashValue(hash, light.linear);
+        hashValue(hash, light.quadratic);
+    }
+    return hash;
+}
+
+bool LightmapBaker::loadCache(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t key = 0;
+    uint32_t count = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&key), sizeof(key));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || magic != CACHE_MAGIC || version != CACHE_VERSION ||
+        key != computeKey() || count != m_surfaces.size()) {
+        return false;
+    }
+    
+    // The key covers every lightmap size, so the texel counts match
+    for (Surface& surface : m_surfaces) {
+        std::vector<glm::vec3>& texels = surface.lightmap.texels;
+        file.read(reinterpret_cast<char*>(texels.data()),
+                  static_cast<std::streamsize>(texels.size() * sizeof(glm::vec3)));
+    }
+    if (!file) {
+        for (Surface& surface : m_surfaces) {
+            std::fill(surface.lightmap.texels.begin(), surface.lightmap.texels.end(), glm::vec3(0.0f));
+        }
+        return false;
+    }
+    return true;
+}
+
+bool LightmapBaker::saveCache(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    
+    uint64_t key = computeKey();
+    uint32_t count = static_cast<uint32_t>(m_surfaces.size());
+    file.write(reinterpret_cast<const char*>(&CACHE_MAGIC), sizeof(CACHE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const Surface& surface : m_surfaces) {
+        const std::vector<glm::vec3>& texels = surface.lightmap.texels;
+        file.write(reinterpret_cast<const char*>(texels.data()),
+                   static_cast<std::streamsize>(texels.size() * sizeof(glm::vec3)));
+    }
+    return static_cast<bool>(file);
+}
+
+// =============================================================================
+// Results
+// =============================================================================
+
+unsigned int LightmapBaker::createTexture(size_t surface) const {
+    const Lightmap& lightmap = m_surfaces[surface].lightmap;
+    
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, lightmap.width, lightmap.height, 0,
+                 GL_RGB, GL_FLOAT, lightmap.texels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    RenderStats::addUploadedBytes(lightmap.texels.size() * sizeof(glm::vec3));
+    return texture;
+}
+
+size_t LightmapBaker::getTexelCount() const {
+    size_t count = 0;
+    for (const Surface& surface : m_surfaces) {
+        for (const TexelSample& sample : surface.samples) {
+            count += sample.used ? 1 : 0;
+        }
+    }
+    return count;
+}
@@ -17,9 +17,12 @@ Material::Material()
     , specular(0.5f)
     , shininess(32.0f)
     , opacity(1.0f)
+    , reflectivity(0.0f)
+    , roughness(0.0f)
     , diffuseMap(0)
     , specularMap(0)
     , normalMap(0)
+    , lightMap(0)
 {
 }
 
@@ -32,9 +35,12 @@ Material::Material(const glm::vec3& amb,
     , specular(spec)
     , shininess(shine)
     , opacity(1.0f)
+    , reflectivity(0.0f)
+    , roughness(0.0f)
     , diffuseMap(0)
     , specularMap(0)
     , normalMap(0)
+    , lightMap(0)
 {
 }
 
@@ -43,11 +49,49 @@ Material::Material(const glm::vec3& amb,
 // =============================================================================
 
 void Material::applyToShader(Shader& shader, const std::string& uniformName) const {
-    shader.setVec3(uniformName + ".ambient", ambient);
-    shader.setVec3(uniformName + ".diffuse", diffuse);
-    shader.setVec3(uniformName + ".specular", specular);
-    shader.setFloat(uniformName + ".shininess", shininess);
-    shader.setFloat(uniformName + ".opacity", opacity);
+    // Applied for every draw, almost always as "material": build those
+    // names once instead of eight heap-allocated concatenations per draw
+    struct UniformNames {
+        std::string ambient;
+        std::string diffuse;
+        std::string specular;
+        std::string shininess;
+        std::string opacity;
+        std::string reflectivity;
+        std::string roughness;
+        std::string hasLightMap;
+        
+        explicit UniformNames(const std::string& prefix)
+            : ambient(prefix + ".ambient")
+            , diffuse(prefix + ".diffuse")
+            , specular(prefix + ".specular")
+            , shininess(prefix + ".shininess")
+            , opacity(prefix + ".opacity")
+            , reflectivity(prefix + ".reflectivity")
+            , roughness(prefix + ".roughness")
+            , hasLightMap(prefix + ".hasLightMap")
+        {
+        }
+    };
+    
+    static const UniformNames defaultNames("material");
+    
+    auto apply = [&](const UniformNames& names) {
+        shader.setVec3(names.ambient, ambient);
+        shader.setVec3(names.diffuse, diffuse);
+        shader.setVec3(names.specular, specular);
+        shader.setFloat(names.shininess, shininess);
+        shader.setFloat(names.opacity, opacity);
+        shader.setFloat(names.reflectivity, reflectivity);
+        shader.setFloat(names.roughness, roughness);
+        shader.setBool(names.hasLightMap, lightMap != 0);
+    };
+    
+    if (uniformName == "material") {
+        apply(defaultNames);
+    } else {
+        apply(UniformNames(uniformName));
+    }
 }
 
 // =============================================================================
@@ -70,6 +114,8 @@ Material Material::Chrome() {
         glm::vec3(0.774597f, 0.774597f, 0.774597f),
         76.8f
     );
+    mat.reflectivity = 0.8f;
+    mat.roughness = 0.05f;
     return mat;
 }
 
@@ -183,48 +229,63 @@ Material Material::Jade() {
 // =============================================================================
 
 Material Material::CarPaintRed() {
-    return Material(
+    Material mat(
         glm::vec3(0.15f, 0.02f, 0.02f),
         glm::vec3(0.8f, 0.1f, 0.1f),
         glm::vec3(0.9f, 0.9f, 0.9f),
         64.0f
     );
+    mat.reflectivity = 0.12f;
+    mat.roughness = 0.1f;
+    return mat;
 }
 
 Material Material::CarPaintBlue() {
-    return Material(
+    Material mat(
         glm::vec3(0.02f, 0.02f, 0.15f),
         glm::vec3(0.1f, 0.2f, 0.8f),
         glm::vec3(0.9f, 0.9f, 0.9f),
         64.0f
     );
+    mat.reflectivity = 0.12f;
+    mat.roughness = 0.1f;
+    return mat;
 }
 
 Material Material::CarPaintBlack() {
-    return Material(
+    Material mat(
         glm::vec3(0.02f, 0.02f, 0.02f),
         glm::vec3(0.1f, 0.1f, 0.1f),
         glm::vec3(0.9f, 0.9f, 0.9f),
         128.0f
     );
+    mat.reflectivity = 0.15f;
+    mat.roughness = 0.05f;
+    return mat;
 }
 
 Material Material::CarPaintWhite() {
-    return Material(
+    Material mat(
         glm::vec3(0.2f, 0.2f, 0.2f),
         glm::vec3(0.95f, 0.95f, 0.95f),
         glm::vec3(0.9f, 0.9f, 0.9f),
         64.0f
     );
+    mat.reflectivity = 0.12f;
+    mat.roughness = 0.1f;
+    return mat;
 }
 
 Material Material::CarPaintSilver() {
-    return Material(
+    Material mat(
         glm::vec3(0.15f, 0.15f, 0.15f),
         glm::vec3(0.6f, 0.6f, 0.65f),
         glm::vec3(0.95f, 0.95f, 0.95f),
         96.0f
     );
+    mat.reflectivity = 0.2f;
+    mat.roughness = 0.2f;
+    return mat;
 }
 
 Material Material::Glass() {
@@ -235,6 +296,8 @@ Material Material::Glass() {
         128.0f
     );
     mat.opacity = 0.3f;
+    mat.reflectivity = 0.1f;
+    mat.roughness = 0.0f;
     return mat;
 }
 
@@ -246,6 +309,8 @@ Material Material::GlassTinted() {
         128.0f
     );
     mat.opacity = 0.4f;
+    mat.reflectivity = 0.12f;
+    mat.roughness = 0.0f;
     return mat;
 }
 
@@ -284,6 +349,8 @@ Material Material::HeadlightGlass() {
         256.0f
     );
     mat.opacity = 0.2f;
+    mat.reflectivity = 0.1f;
+    mat.roughness = 0.0f;
     return mat;
 }
 
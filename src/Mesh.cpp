@@ -5,71 +5,223 @@
  */
 
 #include "Mesh.h"
+#include "MeshBVH.h"
 #include "Shader.h"
+#include "GpuDeletionQueue.h"
+#include "RenderStats.h"
 
 #include <glad/glad.h>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <iostream>
+
+// Static tables are uploaded as they are, so they must match Vertex byte for byte
+static_assert(sizeof(StaticVertex) == sizeof(Vertex) &&
+              offsetof(StaticVertex, normal) == offsetof(Vertex, Normal) &&
+              offsetof(StaticVertex, texCoords) == offsetof(Vertex, TexCoords),
+              "StaticVertex must have the same layout as Vertex");
+
+namespace {
+
+constexpr float PI = 3.14159265359f;
+
+/**
+ * UnitCircle - Cosines and sines of sectors + 1 evenly spaced angles.
+ * The last entry repeats the first, for the texture seam.
+ */
+struct UnitCircle {
+    std::vector<float> cosines;
+    std::vector<float> sines;
+};
+
+/**
+ * Compute the ring table once per mesh. Every ring of a sphere or
+ * cylinder is a scaled copy of it, so sin/cos run once per sector instead
+ * of once per vertex.
+ */
+UnitCircle computeUnitCircle(int sectors) {
+    UnitCircle circle;
+    size_t count = static_cast<size_t>(sectors) + 1;
+    circle.cosines.resize(count);
+    circle.sines.resize(count);
+    
+    // Separate arrays and a branch-free body: the loop vectorizes where
+    // the compiler has a vector math library (e.g. glibc with -ffast-math)
+    float* cosines = circle.cosines.data();
+    float* sines = circle.sines.data();
+    float step = 2.0f * PI / static_cast<float>(sectors);
+    for (size_t j = 0; j < count; j++) {
+        float angle = static_cast<float>(j) * step;
+        cosines[j] = std::cos(angle);
+        sines[j] = std::sin(angle);
+    }
+    return circle;
+}
+
+Vertex toVertex(const Vertex& vertex) {
+    return vertex;
+}
+
+Vertex toVertex(const StaticVertex& vertex) {
+    return Vertex(glm::vec3(vertex.position[0], vertex.position[1], vertex.position[2]),
+                  glm::vec3(vertex.normal[0], vertex.normal[1], vertex.normal[2]),
+                  glm::vec2(vertex.texCoords[0], vertex.texCoords[1]));
+}
+
+/**
+ * Copy what a retention policy keeps from data owned elsewhere.
+ */
+template <typename SourceVertex>
+void copyRetained(const SourceVertex* vertices, size_t vertexCount,
+                  const unsigned int* indices, size_t indexCount,
+                  MeshRetention retention,
+                  std::vector<Vertex>& outVertices,
+                  std::vector<glm::vec3>& outPositions,
+                  std::vector<unsigned int>& outIndices) {
+    switch (retention) {
+        case MeshRetention::KEEP_ALL:
+            outVertices.reserve(vertexCount);
+            for (size_t i = 0; i < vertexCount; i++) {
+                outVertices.push_back(toVertex(vertices[i]));
+            }
+            outIndices.assign(indices, indices + indexCount);
+            break;
+            
+        case MeshRetention::COLLISION_ONLY:
+            outPositions.reserve(vertexCount);
+            for (size_t i = 0; i < vertexCount; i++) {
+                outPositions.push_back(toVertex(vertices[i]).Position);
+            }
+            outIndices.assign(indices, indices + indexCount);
+            break;
+            
+        case MeshRetention::DROP:
+            break;
+    }
+}
+
+} // anonymous namespace
 
 // =============================================================================
 // Constructor / Destructor
 // =============================================================================
 
-Mesh::Mesh(const std::vector<Vertex>& verts,
-           const std::vector<unsigned int>& inds,
-           const std::vector<Texture>& texs)
-    : vertices(verts)
-    , indices(inds)
-    , textures(texs)
+Mesh::Mesh(std::vector<Vertex>&& verts,
+           std::vector<unsigned int>&& inds,
+           MeshRetention retention,
+           std::vector<Texture> texs)
+    : textures(std::move(texs))
     , m_VAO(0)
     , m_VBO(0)
     , m_EBO(0)
+    , m_retention(MeshRetention::KEEP_ALL)
+    , m_vertices(std::move(verts))
+    , m_indices(std::move(inds))
+    , m_vertexCount(m_vertices.size())
+    , m_indexCount(m_indices.size())
+    , m_boundsCenter(0.0f)
+    , m_boundsRadius(0.0f)
 {
-    setupMesh();
+    setupMesh(m_vertices.data(), m_indices.data());
+    releaseCpuData(retention);
+}
+
+Mesh::Mesh(MeshData&& data, MeshRetention retention)
+    : Mesh(std::move(data.vertices), std::move(data.indices), retention)
+{
+}
+
+Mesh::Mesh(const Vertex* verts, size_t vertexCount,
+           const unsigned int* inds, size_t indexCount,
+           MeshRetention retention)
+    : m_VAO(0)
+    , m_VBO(0)
+    , m_EBO(0)
+    , m_retention(retention)
+    , m_vertexCount(vertexCount)
+    , m_indexCount(indexCount)
+    , m_boundsCenter(0.0f)
+    , m_boundsRadius(0.0f)
+{
+    setupMesh(verts, inds);
+    
+    // Copy only what the policy keeps
+    copyRetained(verts, vertexCount, inds, indexCount, retention,
+                 m_vertices, m_positions, m_indices);
+}
+            
+Mesh::Mesh(const StaticVertex* verts, size_t vertexCount,
+           const unsigned int* inds, size_t indexCount,
+           MeshRetention retention)
+    : m_VAO(0)
+    , m_VBO(0)
+    , m_EBO(0)
+    , m_retention(retention)
+    , m_vertexCount(vertexCount)
+    , m_indexCount(indexCount)
+    , m_boundsCenter(0.0f)
+    , m_boundsRadius(0.0f)
+{
+    // Same layout as Vertex (see the static_assert above)
+    setupMesh(verts, inds);
+    copyRetained(verts, vertexCount, inds, indexCount, retention,
+                 m_vertices, m_positions, m_indices);
 }
 
 Mesh::~Mesh() {
-    if (m_VAO != 0) {
-        glDeleteVertexArrays(1, &m_VAO);
-        glDeleteBuffers(1, &m_VBO);
-        glDeleteBuffers(1, &m_EBO);
-    }
+    releaseGpuResources();
 }
 
 // Move constructor
 Mesh::Mesh(Mesh&& other) noexcept
-    : vertices(std::move(other.vertices))
-    , indices(std::move(other.indices))
-    , textures(std::move(other.textures))
+    : textures(std::move(other.textures))
     , m_VAO(other.m_VAO)
     , m_VBO(other.m_VBO)
     , m_EBO(other.m_EBO)
+    , m_retention(other.m_retention)
+    , m_vertices(std::move(other.m_vertices))
+    , m_positions(std::move(other.m_positions))
+    , m_indices(std::move(other.m_indices))
+    , m_vertexCount(other.m_vertexCount)
+    , m_indexCount(other.m_indexCount)
+    , m_boundsCenter(other.m_boundsCenter)
+    , m_boundsRadius(other.m_boundsRadius)
+    , m_bvh(std::move(other.m_bvh))
 {
     other.m_VAO = 0;
     other.m_VBO = 0;
     other.m_EBO = 0;
+    other.m_vertexCount = 0;
+    other.m_indexCount = 0;
 }
 
 // Move assignment
 Mesh& Mesh::operator=(Mesh&& other) noexcept {
     if (this != &other) {
         // Clean up existing resources
-        if (m_VAO != 0) {
-            glDeleteVertexArrays(1, &m_VAO);
-            glDeleteBuffers(1, &m_VBO);
-            glDeleteBuffers(1, &m_EBO);
-        }
+        releaseGpuResources();
         
         // Move data
-        vertices = std::move(other.vertices);
-        indices = std::move(other.indices);
         textures = std::move(other.textures);
         m_VAO = other.m_VAO;
         m_VBO = other.m_VBO;
         m_EBO = other.m_EBO;
+        m_retention = other.m_retention;
+        m_vertices = std::move(other.m_vertices);
+        m_positions = std::move(other.m_positions);
+        m_indices = std::move(other.m_indices);
+        m_vertexCount = other.m_vertexCount;
+        m_indexCount = other.m_indexCount;
+        m_boundsCenter = other.m_boundsCenter;
+        m_boundsRadius = other.m_boundsRadius;
+        m_bvh = std::move(other.m_bvh);
         
         other.m_VAO = 0;
         other.m_VBO = 0;
         other.m_EBO = 0;
+        other.m_vertexCount = 0;
+        other.m_indexCount = 0;
     }
     return *this;
 }
@@ -79,59 +231,178 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
 // =============================================================================
 
 void Mesh::draw([[maybe_unused]] const Shader& shader) const {
-    // Bind textures if any are available
-    unsigned int diffuseNr = 0;
-    unsigned int specularNr = 0;
-    
+    // Bind textures if any are available, one unit each in order.
+    // The main shader only samples the environment map and lightmaps,
+    // which the Renderer binds, so no sampler names are built.
     for (size_t i = 0; i < textures.size(); i++) {
         glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
-        
-        std::string name;
-        if (textures[i].type == "diffuse") {
-            name = "texture_diffuse" + std::to_string(diffuseNr++);
-        } else if (textures[i].type == "specular") {
-            name = "texture_specular" + std::to_string(specularNr++);
-        }
-        
         glBindTexture(GL_TEXTURE_2D, textures[i].id);
     }
     
+    // The VAO is made on first draw, in the context that draws
+    if (m_VAO == 0) {
+        createVertexArray();
+    }
+    
     // Draw mesh
     glBindVertexArray(m_VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_indexCount), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
     
+    // Every draw path ends here, so this is where draws are counted
+    RenderStats& stats = RenderStats::current();
+    stats.drawCalls++;
+    stats.instances++;
+    stats.triangles += m_indexCount / 3;
+    stats.vertices += m_indexCount;
+    stats.vertexArrayChanges++;
+    stats.textureChanges += static_cast<uint32_t>(textures.size());
+    
     // Reset texture unit
     glActiveTexture(GL_TEXTURE0);
 }
 
+// =============================================================================
+// CPU-Side Data
+// =============================================================================
+
+void Mesh::releaseCpuData(MeshRetention retention) {
+    // Policies are ordered from most to least data
+    if (retention <= m_retention) {
+        return;
+    }
+    
+    if (retention == MeshRetention::COLLISION_ONLY) {
+        m_positions.reserve(m_vertices.size());
+        for (const Vertex& vertex : m_vertices) {
+            m_positions.push_back(vertex.Position);
+        }
+    }
+    
+    // Swap with empty vectors: clear() would keep the capacity
+    std::vector<Vertex>().swap(m_vertices);
+    if (retention == MeshRetention::DROP) {
+        std::vector<glm::vec3>().swap(m_positions);
+        std::vector<unsigned int>().swap(m_indices);
+    }
+    m_retention = retention;
+}
+
+size_t Mesh::getCpuMemoryUsage() const {
+    return m_vertices.capacity() * sizeof(Vertex) +
+           m_positions.capacity() * sizeof(glm::vec3) +
+           m_indices.capacity() * sizeof(unsigned int);
+}
+
+// =============================================================================
+// Ray Queries
+// =============================================================================
+
+void Mesh::buildBVH() {
+    if (m_retention == MeshRetention::DROP) {
+        std::cerr << "ERROR: Cannot build a BVH for a mesh whose data was dropped after upload"
+                  << std::endl;
+        return;
+    }
+    
+    if (!m_bvh) {
+        m_bvh = std::make_unique<TriangleBVH>();
+    }
+    if (m_retention == MeshRetention::KEEP_ALL) {
+        m_bvh->build(m_vertices, m_indices);
+    } else {
+        m_bvh->build(m_positions, m_indices);
+    }
+}
+
+bool Mesh::raycast(const Ray& ray, float maxDistance, TriangleHit& hit) const {
+    if (!m_bvh || !m_bvh->raycast(ray, maxDistance, hit)) {
+        hit.hit = false;
+        return false;
+    }
+    
+    hit.point = ray.getPoint(hit.distance);
+    
+    size_t base = 3 * static_cast<size_t>(hit.triangle);
+    if (base + 2 >= m_indices.size()) {
+        return true;
+    }
+    
+    if (!m_vertices.empty()) {
+        // Interpolate per-vertex attributes with the barycentric weights
+        const Vertex& a = m_vertices[m_indices[base + 0]];
+        const Vertex& b = m_vertices[m_indices[base + 1]];
+        const Vertex& c = m_vertices[m_indices[base + 2]];
+        const glm::vec3& w = hit.barycentric;
+        hit.uv = a.TexCoords * w.x + b.TexCoords * w.y + c.TexCoords * w.z;
+        hit.normal = glm::normalize(a.Normal * w.x + b.Normal * w.y + c.Normal * w.z);
+    } else {
+        // Positions only: the flat normal of the counter-clockwise triangle
+        const glm::vec3& a = m_positions[m_indices[base + 0]];
+        const glm::vec3& b = m_positions[m_indices[base + 1]];
+        const glm::vec3& c = m_positions[m_indices[base + 2]];
+        hit.uv = glm::vec2(0.0f);
+        hit.normal = glm::normalize(glm::cross(b - a, c - a));
+    }
+    return true;
+}
+
 // =============================================================================
 // Private Methods
 // =============================================================================
 
-void Mesh::setupMesh() {
-    // Generate buffers
-    glGenVertexArrays(1, &m_VAO);
+void Mesh::setupMesh(const void* vertices, const unsigned int* indices) {
+    // Only the buffers are made here: they are shared between contexts,
+    // so this works on the asset loader thread too
     glGenBuffers(1, &m_VBO);
     glGenBuffers(1, &m_EBO);
     
-    // Bind VAO first
-    glBindVertexArray(m_VAO);
-    
     // Upload vertex data to VBO
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
     glBufferData(GL_ARRAY_BUFFER, 
-                 vertices.size() * sizeof(Vertex),
-                 vertices.data(),
+                 m_vertexCount * sizeof(Vertex),
+                 vertices,
                  GL_STATIC_DRAW);
     
-    // Upload index data to EBO
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 indices.size() * sizeof(unsigned int),
-                 indices.data(),
+    // Upload index data to EBO. The element binding belongs to a VAO and
+    // there is none yet; any target will do for the upload itself.
+    glBindBuffer(GL_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 m_indexCount * sizeof(unsigned int),
+                 indices,
                  GL_STATIC_DRAW);
     
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    RenderStats::addUploadedBytes(m_vertexCount * sizeof(Vertex) +
+                                  m_indexCount * sizeof(unsigned int));
+    
+    // Bounds while every vertex is at hand, whatever is retained later
+    const Vertex* first = static_cast<const Vertex*>(vertices);
+    if (m_vertexCount > 0) {
+        glm::vec3 minimum = first[0].Position;
+        glm::vec3 maximum = first[0].Position;
+        for (size_t i = 1; i < m_vertexCount; i++) {
+            minimum = glm::min(minimum, first[i].Position);
+            maximum = glm::max(maximum, first[i].Position);
+        }
+        m_boundsCenter = (minimum + maximum) * 0.5f;
+        float radiusSquared = 0.0f;
+        for (size_t i = 0; i < m_vertexCount; i++) {
+            glm::vec3 offset = first[i].Position - m_boundsCenter;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        m_boundsRadius = std::sqrt(radiusSquared);
+    }
+}
+
+void Mesh::createVertexArray() const {
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    
     // Configure vertex attributes
     // Attribute 0: Position (vec3)
     glEnableVertexAttribArray(0);
@@ -152,101 +423,55 @@ void Mesh::setupMesh() {
     glBindVertexArray(0);
 }
 
+void Mesh::releaseGpuResources() {
+    // Never delete directly: this may run on a thread without a context
+    GpuDeletionQueue::deleteVertexArray(m_VAO);
+    GpuDeletionQueue::deleteBuffer(m_VBO);
+    GpuDeletionQueue::deleteBuffer(m_EBO);
+    m_VAO = 0;
+    m_VBO = 0;
+    m_EBO = 0;
+}
+
 // =============================================================================
 // Primitive Mesh Generators
 // =============================================================================
 
 namespace MeshGenerator {
 
-Mesh createCube(float size) {
-    float h = size / 2.0f;
-    
-    std::vector<Vertex> vertices = {
-        // Front face
-        {{-h, -h,  h}, { 0,  0,  1}, {0, 0}},
-        {{ h, -h,  h}, { 0,  0,  1}, {1, 0}},
-        {{ h,  h,  h}, { 0,  0,  1}, {1, 1}},
-        {{-h,  h,  h}, { 0,  0,  1}, {0, 1}},
-        // Back face
-        {{ h, -h, -h}, { 0,  0, -1}, {0, 0}},
-        {{-h, -h, -h}, { 0,  0, -1}, {1, 0}},
-        {{-h,  h, -h}, { 0,  0, -1}, {1, 1}},
-        {{ h,  h, -h}, { 0,  0, -1}, {0, 1}},
-        // Top face
-        {{-h,  h,  h}, { 0,  1,  0}, {0, 0}},
-        {{ h,  h,  h}, { 0,  1,  0}, {1, 0}},
-        {{ h,  h, -h}, { 0,  1,  0}, {1, 1}},
-        {{-h,  h, -h}, { 0,  1,  0}, {0, 1}},
-        // Bottom face
-        {{-h, -h, -h}, { 0, -1,  0}, {0, 0}},
-        {{ h, -h, -h}, { 0, -1,  0}, {1, 0}},
-        {{ h, -h,  h}, { 0, -1,  0}, {1, 1}},
-        {{-h, -h,  h}, { 0, -1,  0}, {0, 1}},
-        // Right face
-        {{ h, -h,  h}, { 1,  0,  0}, {0, 0}},
-        {{ h, -h, -h}, { 1,  0,  0}, {1, 0}},
-        {{ h,  h, -h}, { 1,  0,  0}, {1, 1}},
-        {{ h,  h,  h}, { 1,  0,  0}, {0, 1}},
-        // Left face
-        {{-h, -h, -h}, {-1,  0,  0}, {0, 0}},
-        {{-h, -h,  h}, {-1,  0,  0}, {1, 0}},
-        {{-h,  h,  h}, {-1,  0,  0}, {1, 1}},
-        {{-h,  h, -h}, {-1,  0,  0}, {0, 1}},
-    };
-    
-    std::vector<unsigned int> indices = {
-        0, 1, 2, 2, 3, 0,       // Front
-        4, 5, 6, 6, 7, 4,       // Back
-        8, 9, 10, 10, 11, 8,    // Top
-        12, 13, 14, 14, 15, 12, // Bottom
-        16, 17, 18, 18, 19, 16, // Right
-        20, 21, 22, 22, 23, 20  // Left
-    };
-    
-    return Mesh(vertices, indices);
-}
-
-Mesh createPlane(float width, float depth, float uScale, float vScale) {
-    float hw = width / 2.0f;
-    float hd = depth / 2.0f;
-    
-    std::vector<Vertex> vertices = {
-        {{-hw, 0, -hd}, {0, 1, 0}, {0, 0}},
-        {{ hw, 0, -hd}, {0, 1, 0}, {uScale, 0}},
-        {{ hw, 0,  hd}, {0, 1, 0}, {uScale, vScale}},
-        {{-hw, 0,  hd}, {0, 1, 0}, {0, vScale}},
-    };
-    
-    std::vector<unsigned int> indices = {0, 1, 2, 2, 3, 0};
-    
-    return Mesh(vertices, indices);
-}
-
-Mesh createSphere(float radius, int sectors, int stacks) {
+MeshData generateCube(float size) {
+    return copyTable(StaticMesh::makeCube(size));
+}
+
+MeshData generatePlane(float width, float depth, float uScale, float vScale) {
+    return copyTable(StaticMesh::makePlane(width, depth, uScale, vScale));
+}
+
+MeshData generateSphere(float radius, int sectors, int stacks) {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
     
-    float sectorStep = 2 * 3.14159265359f / sectors;
-    float stackStep = 3.14159265359f / stacks;
+    // One ring per stack boundary; the pole stacks have one triangle per
+    // sector, the others two
+    vertices.reserve(static_cast<size_t>(stacks + 1) * (sectors + 1));
+    indices.reserve(6 * static_cast<size_t>(sectors) * std::max(stacks - 1, 0));
+    
+    UnitCircle ring = computeUnitCircle(sectors);
+    float stackStep = PI / stacks;
     
     // Generate vertices
     for (int i = 0; i <= stacks; ++i) {
-        float stackAngle = 3.14159265359f / 2 - i * stackStep;
-        float xy = radius * cosf(stackAngle);
-        float z = radius * sinf(stackAngle);
+        float stackAngle = PI / 2 - i * stackStep;
+        float ringScale = cosf(stackAngle);
+        float height = sinf(stackAngle);
         
         for (int j = 0; j <= sectors; ++j) {
-            float sectorAngle = j * sectorStep;
-            
-            float x = xy * cosf(sectorAngle);
-            float y = xy * sinf(sectorAngle);
-            
-            glm::vec3 pos(x, z, y);
-            glm::vec3 normal = glm::normalize(pos);
+            // On a sphere the unit normal is the position over the radius
+            glm::vec3 normal(ringScale * ring.cosines[j], height, ringScale * ring.sines[j]);
             glm::vec2 tex(static_cast<float>(j) / sectors,
                          static_cast<float>(i) / stacks);
             
-            vertices.push_back({pos, normal, tex});
+            vertices.push_back({normal * radius, normal, tex});
         }
     }
     
@@ -270,15 +495,20 @@ Mesh createSphere(float radius, int sectors, int stacks) {
         }
     }
     
-    return Mesh(vertices, indices);
+    return {std::move(vertices), std::move(indices)};
 }
 
-Mesh createCylinder(float radius, float height, int sectors) {
+MeshData generateCylinder(float radius, float height, int sectors) {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
     
+    // Two side rings, then a center and a ring per cap; two triangles
+    // per sector on the side and one per cap
+    vertices.reserve(2 * static_cast<size_t>(sectors + 1) + 2 * static_cast<size_t>(sectors + 2));
+    indices.reserve(12 * static_cast<size_t>(sectors));
+    
     float halfHeight = height / 2.0f;
-    float sectorStep = 2 * 3.14159265359f / sectors;
+    UnitCircle ring = computeUnitCircle(sectors);
     
     // Side vertices
     for (int i = 0; i <= 1; ++i) {
@@ -286,12 +516,8 @@ Mesh createCylinder(float radius, float height, int sectors) {
         float v = static_cast<float>(i);
         
         for (int j = 0; j <= sectors; ++j) {
-            float sectorAngle = j * sectorStep;
-            float x = radius * cosf(sectorAngle);
-            float z = radius * sinf(sectorAngle);
-            
-            glm::vec3 pos(x, y, z);
-            glm::vec3 normal = glm::normalize(glm::vec3(x, 0, z));
+            glm::vec3 normal(ring.cosines[j], 0.0f, ring.sines[j]);
+            glm::vec3 pos(radius * normal.x, y, radius * normal.z);
             glm::vec2 tex(static_cast<float>(j) / sectors, v);
             
             vertices.push_back({pos, normal, tex});
@@ -316,13 +542,9 @@ Mesh createCylinder(float radius, float height, int sectors) {
     int baseIndex = static_cast<int>(vertices.size());
     vertices.push_back({{0, halfHeight, 0}, {0, 1, 0}, {0.5f, 0.5f}});
     for (int j = 0; j <= sectors; ++j) {
-        float sectorAngle = j * sectorStep;
-        float x = radius * cosf(sectorAngle);
-        float z = radius * sinf(sectorAngle);
-        
-        glm::vec3 pos(x, halfHeight, z);
-        glm::vec2 tex(0.5f + 0.5f * cosf(sectorAngle),
-                     0.5f + 0.5f * sinf(sectorAngle));
+        glm::vec3 pos(radius * ring.cosines[j], halfHeight, radius * ring.sines[j]);
+        glm::vec2 tex(0.5f + 0.5f * ring.cosines[j],
+                     0.5f + 0.5f * ring.sines[j]);
         
         vertices.push_back({pos, {0, 1, 0}, tex});
     }
@@ -337,13 +559,9 @@ Mesh createCylinder(float radius, float height, int sectors) {
     baseIndex = static_cast<int>(vertices.size());
     vertices.push_back({{0, -halfHeight, 0}, {0, -1, 0}, {0.5f, 0.5f}});
     for (int j = 0; j <= sectors; ++j) {
-        float sectorAngle = j * sectorStep;
-        float x = radius * cosf(sectorAngle);
-        float z = radius * sinf(sectorAngle);
-        
-        glm::vec3 pos(x, -halfHeight, z);
-        glm::vec2 tex(0.5f + 0.5f * cosf(sectorAngle),
-                     0.5f + 0.5f * sinf(sectorAngle));
+        glm::vec3 pos(radius * ring.cosines[j], -halfHeight, radius * ring.sines[j]);
+        glm::vec2 tex(0.5f + 0.5f * ring.cosines[j],
+                     0.5f + 0.5f * ring.sines[j]);
         
         vertices.push_back({pos, {0, -1, 0}, tex});
     }
@@ -354,109 +572,57 @@ Mesh createCylinder(float radius, float height, int sectors) {
         indices.push_back(baseIndex + j + 2);
     }
     
-    return Mesh(vertices, indices);
+    return {std::move(vertices), std::move(indices)};
 }
 
-Mesh createCarBody() {
-    // Create a simplified car body shape
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    
-    // Car dimensions
-    float length = 4.0f;
-    float width = 1.8f;
-    float bodyHeight = 0.8f;
-    float cabinHeight = 0.7f;
-    float hoodLength = 1.2f;
-    float trunkLength = 0.8f;
-    
-    float hl = length / 2.0f;
-    float hw = width / 2.0f;
-    
-    // Lower body (box shape)
-    // Front
-    vertices.push_back({{-hl, 0, -hw}, {0, 0, -1}, {0, 0}});
-    vertices.push_back({{ hl, 0, -hw}, {0, 0, -1}, {1, 0}});
-    vertices.push_back({{ hl, bodyHeight, -hw}, {0, 0, -1}, {1, 1}});
-    vertices.push_back({{-hl, bodyHeight, -hw}, {0, 0, -1}, {0, 1}});
-    
-    // Back
-    vertices.push_back({{ hl, 0, hw}, {0, 0, 1}, {0, 0}});
-    vertices.push_back({{-hl, 0, hw}, {0, 0, 1}, {1, 0}});
-    vertices.push_back({{-hl, bodyHeight, hw}, {0, 0, 1}, {1, 1}});
-    vertices.push_back({{ hl, bodyHeight, hw}, {0, 0, 1}, {0, 1}});
-    
-    // Left side
-    vertices.push_back({{-hl, 0, hw}, {-1, 0, 0}, {0, 0}});
-    vertices.push_back({{-hl, 0, -hw}, {-1, 0, 0}, {1, 0}});
-    vertices.push_back({{-hl, bodyHeight, -hw}, {-1, 0, 0}, {1, 1}});
-    vertices.push_back({{-hl, bodyHeight, hw}, {-1, 0, 0}, {0, 1}});
-    
-    // Right side
-    vertices.push_back({{ hl, 0, -hw}, {1, 0, 0}, {0, 0}});
-    vertices.push_back({{ hl, 0, hw}, {1, 0, 0}, {1, 0}});
-    vertices.push_back({{ hl, bodyHeight, hw}, {1, 0, 0}, {1, 1}});
-    vertices.push_back({{ hl, bodyHeight, -hw}, {1, 0, 0}, {0, 1}});
-    
-    // Bottom
-    vertices.push_back({{-hl, 0, hw}, {0, -1, 0}, {0, 0}});
-    vertices.push_back({{ hl, 0, hw}, {0, -1, 0}, {1, 0}});
-    vertices.push_back({{ hl, 0, -hw}, {0, -1, 0}, {1, 1}});
-    vertices.push_back({{-hl, 0, -hw}, {0, -1, 0}, {0, 1}});
-    
-    // Hood (top of front section)
-    float hoodStart = hl - hoodLength;
-    vertices.push_back({{hoodStart, bodyHeight, -hw}, {0, 1, 0}, {0, 0}});
-    vertices.push_back({{hl, bodyHeight, -hw}, {0, 1, 0}, {1, 0}});
-    vertices.push_back({{hl, bodyHeight, hw}, {0, 1, 0}, {1, 1}});
-    vertices.push_back({{hoodStart, bodyHeight, hw}, {0, 1, 0}, {0, 1}});
-    
-    // Trunk (top of rear section)
-    float trunkEnd = -hl + trunkLength;
-    vertices.push_back({{-hl, bodyHeight, -hw}, {0, 1, 0}, {0, 0}});
-    vertices.push_back({{trunkEnd, bodyHeight, -hw}, {0, 1, 0}, {1, 0}});
-    vertices.push_back({{trunkEnd, bodyHeight, hw}, {0, 1, 0}, {1, 1}});
-    vertices.push_back({{-hl, bodyHeight, hw}, {0, 1, 0}, {0, 1}});
-    
-    // Cabin (raised middle section)
-    float cabinFront = hoodStart;
-    float cabinBack = trunkEnd;
-    float cabinTop = bodyHeight + cabinHeight;
-    float cabinWidth = hw * 0.9f;
-    
-    // Cabin front (windshield area)
-    vertices.push_back({{cabinFront, bodyHeight, -cabinWidth}, {0.7f, 0.7f, 0}, {0, 0}});
-    vertices.push_back({{cabinFront + 0.3f, cabinTop, -cabinWidth}, {0.7f, 0.7f, 0}, {1, 0}});
-    vertices.push_back({{cabinFront + 0.3f, cabinTop, cabinWidth}, {0.7f, 0.7f, 0}, {1, 1}});
-    vertices.push_back({{cabinFront, bodyHeight, cabinWidth}, {0.7f, 0.7f, 0}, {0, 1}});
-    
-    // Cabin back (rear window area)
-    vertices.push_back({{cabinBack, bodyHeight, cabinWidth}, {-0.7f, 0.7f, 0}, {0, 0}});
-    vertices.push_back({{cabinBack - 0.3f, cabinTop, cabinWidth}, {-0.7f, 0.7f, 0}, {1, 0}});
-    vertices.push_back({{cabinBack - 0.3f, cabinTop, -cabinWidth}, {-0.7f, 0.7f, 0}, {1, 1}});
-    vertices.push_back({{cabinBack, bodyHeight, -cabinWidth}, {-0.7f, 0.7f, 0}, {0, 1}});
-    
-    // Cabin roof
-    vertices.push_back({{cabinFront + 0.3f, cabinTop, -cabinWidth}, {0, 1, 0}, {0, 0}});
-    vertices.push_back({{cabinBack - 0.3f, cabinTop, -cabinWidth}, {0, 1, 0}, {1, 0}});
-    vertices.push_back({{cabinBack - 0.3f, cabinTop, cabinWidth}, {0, 1, 0}, {1, 1}});
-    vertices.push_back({{cabinFront + 0.3f, cabinTop, cabinWidth}, {0, 1, 0}, {0, 1}});
-    
-    // Generate indices for all quads
-    for (unsigned int i = 0; i < vertices.size(); i += 4) {
-        indices.push_back(i);
-        indices.push_back(i + 1);
-        indices.push_back(i + 2);
-        indices.push_back(i + 2);
-        indices.push_back(i + 3);
-        indices.push_back(i);
+MeshData generateCarBody() {
+    // Fixed shape: the table is built once, at compile time
+    static constexpr auto CAR_BODY = StaticMesh::makeCarBody();
+    return copyTable(CAR_BODY);
+}
+
+MeshData generateWheel(float radius, float width) {
+    return generateCylinder(radius, width, 24);
+}
+
+MeshData copyTable(const StaticVertex* vertices, size_t vertexCount,
+                   const unsigned int* indices, size_t indexCount) {
+    MeshData data;
+    data.vertices.reserve(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++) {
+        data.vertices.push_back(toVertex(vertices[i]));
     }
-    
-    return Mesh(vertices, indices);
+    data.indices.assign(indices, indices + indexCount);
+    return data;
+}
+
+// =============================================================================
+// Generate and Upload
+// =============================================================================
+
+Mesh createCube(float size, MeshRetention retention) {
+    return Mesh(generateCube(size), retention);
+}
+
+Mesh createPlane(float width, float depth, float uScale, float vScale,
+                 MeshRetention retention) {
+    return Mesh(generatePlane(width, depth, uScale, vScale), retention);
+}
+
+Mesh createSphere(float radius, int sectors, int stacks, MeshRetention retention) {
+    return Mesh(generateSphere(radius, sectors, stacks), retention);
+}
+
+Mesh createCylinder(float radius, float height, int sectors, MeshRetention retention) {
+    return Mesh(generateCylinder(radius, height, sectors), retention);
+}
+
+Mesh createCarBody(MeshRetention retention) {
+    return Mesh(generateCarBody(), retention);
 }
 
-Mesh createWheel(float radius, float width) {
-    return createCylinder(radius, width, 24);
+Mesh createWheel(float radius, float width, MeshRetention retention) {
+    return Mesh(generateWheel(radius, width), retention);
 }
 
 } // namespace MeshGenerator
@@ -0,0 +1,475 @@
+/**
+ * =============================================================================
+ * MeshBVH.cpp - Triangle Bounding Volume Hierarchy Implementation
+ * =============================================================================
+ */
+
+#include "MeshBVH.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace {
+
+// Determinants below this mean the ray runs parallel to the triangle
+constexpr float DETERMINANT_EPSILON = 1e-12f;
+
+// Below this depth splits fall back to the median, which bounds the
+// tree depth (and the traversal stack) even for degenerate input
+constexpr uint32_t MAX_SAH_DEPTH = 48;
+constexpr int TRAVERSAL_STACK_SIZE = 96;
+
+// Subtrees smaller than this are not worth a separate thread task
+constexpr uint32_t MIN_PARALLEL_SUBTREE = 1024;
+
+// Avoid infinities for axis-parallel rays: 0 * inf would give NaN
+inline float safeInverse(float d) {
+    return 1.0f / ((std::abs(d) > 1e-8f) ? d : std::copysign(1e-8f, d));
+}
+
+} // anonymous namespace
+
+struct TriangleBVH::BuildInput {
+    std::vector<glm::vec3> corners;     // 3 per triangle
+    std::vector<glm::vec3> boundsMin;   // Per-triangle bounds
+    std::vector<glm::vec3> boundsMax;
+    std::vector<glm::vec3> centers;
+    std::vector<uint32_t> order;        // Triangle indices, partitioned in place
+};
+
+// =============================================================================
+// Building
+// =============================================================================
+
+void TriangleBVH::build(const std::vector<Vertex>& vertices,
+                        const std::vector<unsigned int>& indices) {
+    buildFromPositions(reinterpret_cast<const unsigned char*>(vertices.data()) +
+                       offsetof(Vertex, Position), sizeof(Vertex), indices);
+}
+
+void TriangleBVH::build(const std::vector<glm::vec3>& positions,
+                        const std::vector<unsigned int>& indices) {
+    buildFromPositions(reinterpret_cast<const unsigned char*>(positions.data()),
+                       sizeof(glm::vec3), indices);
+}
+
+void TriangleBVH::buildFromPositions(const unsigned char* positions, size_t stride,
+                                     const std::vector<unsigned int>& indices) {
+    clear();
+    
+    uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triangleCount == 0) {
+        return;
+    }
+    m_triangleCount = triangleCount;
+    
+    ThreadPool& pool = ThreadPool::getShared();
+    bool parallel = triangleCount >= PARALLEL_BUILD_THRESHOLD && pool.getWorkerCount() > 0;
+    
+    BuildInput input;
+    input.corners.resize(3 * static_cast<size_t>(triangleCount));
+    input.boundsMin.resize(triangleCount);
+    input.boundsMax.resize(triangleCount);
+    input.centers.resize(triangleCount);
+    input.order.resize(triangleCount);
+    
+    auto position = [&](unsigned int index) {
+        return *reinterpret_cast<const glm::vec3*>(positions + stride * index);
+    };
+    
+    auto prepare = [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            glm::vec3 a = position(indices[3 * t + 0]);
+            glm::vec3 b = position(indices[3 * t + 1]);
+            glm::vec3 c = position(indices[3 * t + 2]);
+            input.corners[3 * t + 0] = a;
+            input.corners[3 * t + 1] = b;
+            input.corners[3 * t + 2] = c;
+            input.boundsMin[t] = glm::min(a, glm::min(b, c));
+            input.boundsMax[t] = glm::max(a, glm::max(b, c));
+            input.centers[t] = (input.boundsMin[t] + input.boundsMax[t]) * 0.5f;
+            input.order[t] = static_cast<uint32_t>(t);
+        }
+    };
+    
+    if (parallel) {
+        pool.parallelFor(triangleCount, 4096, prepare);
+    } else {
+        prepare(0, triangleCount);
+    }
+    
+    // A binary tree with leaves of at least one triangle has < 2N nodes
+    m_nodes.reserve(2 * static_cast<size_t>(triangleCount));
+    m_nodes.resize(1);
+    
+    if (!parallel) {
+        buildNode(m_nodes, 0, 0, triangleCount, 0, input, 0, nullptr);
+    } else {
+        // Split the top of the tree here until the pieces are small enough
+        // to give every thread a few, then build the pieces in parallel.
+        // Each piece partitions its own range of input.order, so they
+        // never touch the same data.
+        uint32_t threads = static_cast<uint32_t>(pool.getWorkerCount()) + 1;
+        uint32_t deferBelow = std::max(triangleCount / (threads * 4), MIN_PARALLEL_SUBTREE);
+        
+        std::vector<DeferredSubtree> deferred;
+        buildNode(m_nodes, 0, 0, triangleCount, 0, input, deferBelow, &deferred);
+        
+        std::vector<std::vector<Node>> subtrees(deferred.size());
+        pool.parallelFor(deferred.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const DeferredSubtree& task = deferred[i];
+                subtrees[i].reserve(2 * static_cast<size_t>(task.count));
+                subtrees[i].resize(1);
+                buildNode(subtrees[i], 0, task.first, task.count, task.depth, input, 0, nullptr);
+            }
+        });
+        
+        // Join: each subtree root replaces its placeholder node, the rest
+        // are appended. Local index i > 0 lands at base + i - 1.
+        for (size_t i = 0; i < deferred.size(); i++) {
+            const std::vector<Node>& local = subtrees[i];
+            uint32_t base = static_cast<uint32_t>(m_nodes.size());
+            auto relocate = [base](Node node) {
+                if (node.count == 0) {
+                    node.leftOrFirst = base + node.leftOrFirst - 1;
+                }
+                return node;
+            };
+            
+            m_nodes[deferred[i].nodeIndex] = relocate(local[0]);
+            for (size_t j = 1; j < local.size(); j++) {
+                m_nodes.push_back(relocate(local[j]));
+            }
+        }
+    }
+    
+    fillBlocks(input);
+}
+
+void TriangleBVH::buildNode(std::vector<Node>& nodes, uint32_t nodeIndex,
+                            uint32_t first, uint32_t count, uint32_t depth,
+                            BuildInput& input, uint32_t deferBelow,
+                            std::vector<DeferredSubtree>* deferred) {
+    if (deferred && count <= deferBelow) {
+        deferred->push_back({nodeIndex, first, count, depth});
+        return;
+    }
+    
+    // Bounds of the triangles, and of their centers (used to pick the split)
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    glm::vec3 centerMin = boundsMin;
+    glm::vec3 centerMax = boundsMax;
+    
+    for (uint32_t i = first; i < first + count; i++) {
+        uint32_t tri = input.order[i];
+        boundsMin = glm::min(boundsMin, input.boundsMin[tri]);
+        boundsMax = glm::max(boundsMax, input.boundsMax[tri]);
+        centerMin = glm::min(centerMin, input.centers[tri]);
+        centerMax = glm::max(centerMax, input.centers[tri]);
+    }
+    
+    nodes[nodeIndex].boundsMin = boundsMin;
+    nodes[nodeIndex].boundsMax = boundsMax;
+    
+    if (count <= static_cast<uint32_t>(LEAF_WIDTH)) {
+        // Leaf: leftOrFirst points into input.order until fillBlocks
+        nodes[nodeIndex].leftOrFirst = first;
+        nodes[nodeIndex].count = count;
+        return;
+    }
+    
+    uint32_t mid = first + count / 2;
+    if (depth < MAX_SAH_DEPTH) {
+        mid = partition(first, count, centerMin, centerMax, input);
+    } else {
+        glm::vec3 spread = centerMax - centerMin;
+        int axis = 0;
+        if (spread.y > spread[axis]) axis = 1;
+        if (spread.z > spread[axis]) axis = 2;
+        std::nth_element(input.order.begin() + first,
+                         input.order.begin() + mid,
+                         input.order.begin() + first + count,
+                         [&input, axis](uint32_t a, uint32_t b) {
+                             return input.centers[a][axis] < input.centers[b][axis];
+                         });
+    }
+    
+    // Children are allocated as a pair (nodes may reallocate here)
+    uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes.resize(nodes.size() + 2);
+    nodes[nodeIndex].leftOrFirst = left;
+    nodes[nodeIndex].count = 0;
+    
+    buildNode(nodes, left, first, mid - first, depth + 1, input, deferBelow, deferred);
+    buildNode(nodes, left + 1, mid, first + count - mid, depth + 1, input, deferBelow, deferred);
+}
+
+uint32_t TriangleBVH::partition(uint32_t first, uint32_t count,
+                                const glm::vec3& centerMin, const glm::vec3& centerMax,
+                                BuildInput& input) {
+    glm::vec3 spread = centerMax - centerMin;
+    int axis = 0;
+    if (spread.y > spread[axis]) axis = 1;
+    if (spread.z > spread[axis]) axis = 2;
+    
+    uint32_t mid = first + count / 2;
+    
+    // Binned surface area heuristic, as in StaticAABBTree::buildNode
+    if (spread[axis] > 1e-6f) {
+        constexpr int SAH_BINS = 12;
+        struct Bin {
+            glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+            uint32_t count = 0;
+        };
+        Bin bins[SAH_BINS];
+        
+        float binScale = SAH_BINS / spread[axis];
+        auto binOf = [&](uint32_t tri) {
+            int b = static_cast<int>((input.centers[tri][axis] - centerMin[axis]) * binScale);
+            return std::min(b, SAH_BINS - 1);
+        };
+        
+        for (uint32_t i = first; i < first + count; i++) {
+            uint32_t tri = input.order[i];
+            Bin& bin = bins[binOf(tri)];
+            bin.boundsMin = glm::min(bin.boundsMin, input.boundsMin[tri]);
+            bin.boundsMax = glm::max(bin.boundsMax, input.boundsMax[tri]);
+            bin.count++;
+        }
+        
+        auto halfArea = [](const glm::vec3& bmin, const glm::vec3& bmax) {
+            glm::vec3 e = glm::max(bmax - bmin, glm::vec3(0.0f));
+            return e.x * e.y + e.y * e.z + e.z * e.x;
+        };
+        
+        float rightCost[SAH_BINS];
+        Bin accum;
+        for (int b = SAH_BINS - 1; b > 0; b--) {
+            accum.boundsMin = glm::min(accum.boundsMin, bins[b].boundsMin);
+            accum.boundsMax = glm::max(accum.boundsMax, bins[b].boundsMax);
+            accum.count += bins[b].count;
+            rightCost[b] = accum.count ? halfArea(accum.boundsMin, accum.boundsMax) * accum.count : 0.0f;
+        }
+        
+        float bestCost = std::numeric_limits<float>::max();
+        int bestSplit = -1;
+        accum = Bin();
+        for (int b = 0; b < SAH_BINS - 1; b++) {
+            accum.boundsMin = glm::min(accum.boundsMin, bins[b].boundsMin);
+            accum.boundsMax = glm::max(accum.boundsMax, bins[b].boundsMax);
+            accum.count += bins[b].count;
+            if (accum.count == 0 || accum.count == count) {
+                continue;
+            }
+            float cost = halfArea(accum.boundsMin, accum.boundsMax) * accum.count +
+                         rightCost[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+        
+        if (bestSplit >= 0) {
+            auto firstRight = std::partition(
+                input.order.begin() + first, input.order.begin() + first + count,
+                [&](uint32_t tri) { return binOf(tri) <= bestSplit; });
+            return static_cast<uint32_t>(firstRight - input.order.begin());
+        }
+    }
+    
+    // No useful SAH split (e.g. all centers equal): split at the median
+    std::nth_element(input.order.begin() + first,
+                     input.order.begin() + mid,
+                     input.order.begin() + first + count,
+                     [&input, axis](uint32_t a, uint32_t b) {
+                         return input.centers[a][axis] < input.centers[b][axis];
+                     });
+    return mid;
+}
+
+void TriangleBVH::fillBlocks(const BuildInput& input) {
+    size_t leafCount = (m_nodes.size() + 1) / 2;
+    m_blocks.reserve(leafCount);
+    m_blockTriangles.reserve(leafCount * LEAF_WIDTH);
+    
+    for (Node& node : m_nodes) {
+        if (node.count == 0) {
+            continue;
+        }
+        
+        TriangleBlock block = {};
+        for (uint32_t l = 0; l < node.count; l++) {
+            uint32_t tri = input.order[node.leftOrFirst + l];
+            const glm::vec3& a = input.corners[3 * static_cast<size_t>(tri) + 0];
+            glm::vec3 e1 = input.corners[3 * static_cast<size_t>(tri) + 1] - a;
+            glm::vec3 e2 = input.corners[3 * static_cast<size_t>(tri) + 2] - a;
+            for (int axis = 0; axis < 3; axis++) {
+                block.v0[axis][l] = a[axis];
+                block.e1[axis][l] = e1[axis];
+                block.e2[axis][l] = e2[axis];
+            }
+            m_blockTriangles.push_back(tri);
+        }
+        for (uint32_t l = node.count; l < static_cast<uint32_t>(LEAF_WIDTH); l++) {
+            m_blockTriangles.push_back(0);
+        }
+        
+        node.leftOrFirst = static_cast<uint32_t>(m_blocks.size());
+        m_blocks.push_back(block);
+    }
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+bool TriangleBVH::raycast(const Ray& ray, float maxDistance, TriangleHit& hit) const {
+    hit.hit = false;
+    if (m_nodes.empty()) {
+        return false;
+    }
+    
+    const glm::vec3 origin = ray.origin;
+    const glm::vec3 dir = ray.direction;
+    const glm::vec3 invDir(safeInverse(dir.x), safeInverse(dir.y), safeInverse(dir.z));
+    
+    // Entry distance of a node, or infinity if the ray misses it
+    const float miss = std::numeric_limits<float>::infinity();
+    float closest = maxDistance;
+    auto enterNode = [&](const Node& node) {
+        glm::vec3 t1 = (node.boundsMin - origin) * invDir;
+        glm::vec3 t2 = (node.boundsMax - origin) * invDir;
+        glm::vec3 tSmall = glm::min(t1, t2);
+        glm::vec3 tLarge = glm::max(t1, t2);
+        float enter = std::max(std::max(tSmall.x, tSmall.y), std::max(tSmall.z, 0.0f));
+        float exit = std::min(std::min(tLarge.x, tLarge.y), std::min(tLarge.z, closest));
+        return enter <= exit ? enter : miss;
+    };
+    
+    uint32_t bestBlock = 0;
+    int bestLane = -1;
+    float bestU = 0.0f;
+    float bestV = 0.0f;
+    
+    struct StackEntry {
+        uint32_t node;
+        float enter;
+    };
+    StackEntry stack[TRAVERSAL_STACK_SIZE];
+    int stackSize = 0;
+    
+    float rootEnter = enterNode(m_nodes[0]);
+    if (rootEnter != miss) {
+        stack[stackSize++] = {0, rootEnter};
+    }
+    
+    alignas(16) float laneT[LEAF_WIDTH];
+    alignas(16) float laneU[LEAF_WIDTH];
+    alignas(16) float laneV[LEAF_WIDTH];
+    
+    while (stackSize > 0) {
+        StackEntry entry = stack[--stackSize];
+        
+        // A closer triangle may have been found since this was pushed
+        if (entry.enter > closest) {
+            continue;
+        }
+        const Node& node = m_nodes[entry.node];
+        
+        if (node.count > 0) {
+            // Moller-Trumbore against all lanes of the block at once:
+            // solve origin + t * dir = v0 + u * e1 + v * e2 with Cramer's rule
+            const TriangleBlock& block = m_blocks[node.leftOrFirst];
+            for (int l = 0; l < LEAF_WIDTH; l++) {
+                float e1x = block.e1[0][l], e1y = block.e1[1][l], e1z = block.e1[2][l];
+                float e2x = block.e2[0][l], e2y = block.e2[1][l], e2z = block.e2[2][l];
+                
+                // p = dir x e2
+                float px = dir.y * e2z - dir.z * e2y;
+                float py = dir.z * e2x - dir.x * e2z;
+                float pz = dir.x * e2y - dir.y * e2x;
+                float det = e1x * px + e1y * py + e1z * pz;
+                bool facing = std::abs(det) > DETERMINANT_EPSILON;
+                float invDet = 1.0f / (facing ? det : 1.0f);
+                
+                // s = origin - v0, q = s x e1
+                float sx = origin.x - block.v0[0][l];
+                float sy = origin.y - block.v0[1][l];
+                float sz = origin.z - block.v0[2][l];
+                float u = (sx * px + sy * py + sz * pz) * invDet;
+                float qx = sy * e1z - sz * e1y;
+                float qy = sz * e1x - sx * e1z;
+                float qz = sx * e1y - sy * e1x;
+                float v = (dir.x * qx + dir.y * qy + dir.z * qz) * invDet;
+                float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+                
+                bool inside = facing && u >= 0.0f && v >= 0.0f && u + v <= 1.0f &&
+                              t >= 0.0f && t <= closest;
+                laneT[l] = inside ? t : miss;
+                laneU[l] = u;
+                laneV[l] = v;
+            }
+            
+            for (int l = 0; l < LEAF_WIDTH; l++) {
+                if (laneT[l] <= closest) {
+                    closest = laneT[l];
+                    bestBlock = node.leftOrFirst;
+                    bestLane = l;
+                    bestU = laneU[l];
+                    bestV = laneV[l];
+                }
+            }
+            continue;
+        }
+        
+        // Visit the nearer child first: push it last
+        uint32_t left = node.leftOrFirst;
+        float enterLeft = enterNode(m_nodes[left]);
+        float enterRight = enterNode(m_nodes[left + 1]);
+        bool leftFirst = enterLeft <= enterRight;
+        uint32_t nearChild = leftFirst ? left : left + 1;
+        uint32_t farChild = leftFirst ? left + 1 : left;
+        float nearEnter = leftFirst ? enterLeft : enterRight;
+        float farEnter = leftFirst ? enterRight : enterLeft;
+        
+        if (farEnter != miss) {
+            stack[stackSize++] = {farChild, farEnter};
+        }
+        if (nearEnter != miss) {
+            stack[stackSize++] = {nearChild, nearEnter};
+        }
+    }
+    
+    if (bestLane < 0) {
+        return false;
+    }
+    
+    hit.hit = true;
+    hit.distance = closest;
+    hit.triangle = m_blockTriangles[bestBlock * LEAF_WIDTH + bestLane];
+    hit.barycentric = glm::vec3(1.0f - bestU - bestV, bestU, bestV);
+    return true;
+}
+
+// =============================================================================
+// Utility
+// =============================================================================
+
+size_t TriangleBVH::getMemoryUsage() const {
+    return m_nodes.capacity() * sizeof(Node) +
+           m_blocks.capacity() * sizeof(TriangleBlock) +
+           m_blockTriangles.capacity() * sizeof(uint32_t);
+}
+
+void TriangleBVH::clear() {
+    m_nodes.clear();
+    m_blocks.clear();
+    m_blockTriangles.clear();
+    m_triangleCount = 0;
+}
@@ -6,8 +6,13 @@
 
 #include "Model.h"
 #include "Shader.h"
+#include "ObjectPicker.h"
+#include "MeshBVH.h"
+#include "FramePacket.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
 
 // =============================================================================
 // Constructors / Destructor
@@ -21,6 +26,11 @@ Model::Model()
     , m_visible(true)
     , m_modelMatrix(1.0f)
     , m_modelMatrixDirty(true)
+    , m_previousPosition(0.0f)
+    , m_previousRotation(0.0f)
+    , m_previousScale(1.0f)
+    , m_hasPreviousTransform(false)
+    , m_renderAlpha(1.0f)
 {
 }
 
@@ -32,6 +42,11 @@ Model::Model(const std::string& name)
     , m_visible(true)
     , m_modelMatrix(1.0f)
     , m_modelMatrixDirty(true)
+    , m_previousPosition(0.0f)
+    , m_previousRotation(0.0f)
+    , m_previousScale(1.0f)
+    , m_hasPreviousTransform(false)
+    , m_renderAlpha(1.0f)
 {
 }
 
@@ -49,6 +64,12 @@ Model::Model(Model&& other) noexcept
     , m_visible(other.m_visible)
     , m_modelMatrix(other.m_modelMatrix)
     , m_modelMatrixDirty(other.m_modelMatrixDirty)
+    , m_previousPosition(other.m_previousPosition)
+    , m_previousRotation(other.m_previousRotation)
+    , m_previousScale(other.m_previousScale)
+    , m_hasPreviousTransform(other.m_hasPreviousTransform)
+    , m_renderAlpha(other.m_renderAlpha)
+    , m_drawnMatrices(std::move(other.m_drawnMatrices))
 {
 }
 
@@ -65,6 +86,12 @@ Model& Model::operator=(Model&& other) noexcept {
         m_visible = other.m_visible;
         m_modelMatrix = other.m_modelMatrix;
         m_modelMatrixDirty = other.m_modelMatrixDirty;
+        m_previousPosition = other.m_previousPosition;
+        m_previousRotation = other.m_previousRotation;
+        m_previousScale = other.m_previousScale;
+        m_hasPreviousTransform = other.m_hasPreviousTransform;
+        m_renderAlpha = other.m_renderAlpha;
+        m_drawnMatrices = std::move(other.m_drawnMatrices);
     }
     return *this;
 }
@@ -97,6 +124,20 @@ const Mesh* Model::getMesh(size_t index) const {
     return nullptr;
 }
 
+Material* Model::getMeshMaterial(size_t index) {
+    if (index < m_meshMaterials.size()) {
+        return &m_meshMaterials[index];
+    }
+    return nullptr;
+}
+
+const Material* Model::getMeshMaterial(size_t index) const {
+    if (index < m_meshMaterials.size()) {
+        return &m_meshMaterials[index];
+    }
+    return nullptr;
+}
+
 // =============================================================================
 // Transform Operations
 // =============================================================================
@@ -129,23 +170,82 @@ glm::mat4 Model::getModelMatrix() const {
 }
 
 void Model::updateModelMatrix() const {
+    m_modelMatrix = composeMatrix(m_position, m_rotation, m_scale);
+    m_modelMatrixDirty = false;
+}
+
+glm::mat4 Model::composeMatrix(const glm::vec3& position, const glm::vec3& rotation,
+                               const glm::vec3& scale) {
     // Build model matrix: Translation * RotationZ * RotationY * RotationX * Scale
     // Order matters! Transformations are applied right to left.
     
-    m_modelMatrix = glm::mat4(1.0f);
+    glm::mat4 matrix(1.0f);
     
     // Translation
-    m_modelMatrix = glm::translate(m_modelMatrix, m_position);
+    matrix = glm::translate(matrix, position);
     
     // Rotation (ZYX order for typical Euler angles)
-    m_modelMatrix = glm::rotate(m_modelMatrix, glm::radians(m_rotation.z), glm::vec3(0, 0, 1));
-    m_modelMatrix = glm::rotate(m_modelMatrix, glm::radians(m_rotation.y), glm::vec3(0, 1, 0));
-    m_modelMatrix = glm::rotate(m_modelMatrix, glm::radians(m_rotation.x), glm::vec3(1, 0, 0));
+    matrix = glm::rotate(matrix, glm::radians(rotation.z), glm::vec3(0, 0, 1));
+    matrix = glm::rotate(matrix, glm::radians(rotation.y), glm::vec3(0, 1, 0));
+    matrix = glm::rotate(matrix, glm::radians(rotation.x), glm::vec3(1, 0, 0));
     
     // Scale
-    m_modelMatrix = glm::scale(m_modelMatrix, m_scale);
+    matrix = glm::scale(matrix, scale);
     
-    m_modelMatrixDirty = false;
+    return matrix;
+}
+
+// =============================================================================
+// Render Interpolation
+// =============================================================================
+
+namespace {
+
+// Blend two angles in degrees along the shorter way around the circle
+float lerpAngle(float from, float to, float alpha) {
+    float delta = std::fmod(to - from, 360.0f);
+    if (delta > 180.0f) delta -= 360.0f;
+    if (delta < -180.0f) delta += 360.0f;
+    return from + delta * alpha;
+}
+
+} // anonymous namespace
+
+void Model::storePreviousTransform() {
+    m_previousPosition = m_position;
+    m_previousRotation = m_rotation;
+    m_previousScale = m_scale;
+    m_hasPreviousTransform = true;
+}
+
+void Model::setRenderAlpha(float alpha) {
+    m_renderAlpha = glm::clamp(alpha, 0.0f, 1.0f);
+}
+
+glm::vec3 Model::getRenderPosition() const {
+    if (!m_hasPreviousTransform) {
+        return m_position;
+    }
+    return glm::mix(m_previousPosition, m_position, m_renderAlpha);
+}
+
+glm::vec3 Model::getRenderRotation() const {
+    if (!m_hasPreviousTransform) {
+        return m_rotation;
+    }
+    return glm::vec3(lerpAngle(m_previousRotation.x, m_rotation.x, m_renderAlpha),
+                     lerpAngle(m_previousRotation.y, m_rotation.y, m_renderAlpha),
+                     lerpAngle(m_previousRotation.z, m_rotation.z, m_renderAlpha));
+}
+
+glm::mat4 Model::getRenderMatrix() const {
+    // Objects that never moved in a fixed step, or are exactly on the
+    // latest step, can use the cached matrix
+    if (!m_hasPreviousTransform || m_renderAlpha >= 1.0f) {
+        return getModelMatrix();
+    }
+    return composeMatrix(getRenderPosition(), getRenderRotation(),
+                         glm::mix(m_previousScale, m_scale, m_renderAlpha));
 }
 
 // =============================================================================
@@ -161,7 +261,7 @@ void Model::draw(Shader& shader) const {
 void Model::draw(Shader& shader, const glm::mat4& parentTransform) const {
     if (!m_visible) return;
     
-    glm::mat4 modelMatrix = parentTransform * getModelMatrix();
+    glm::mat4 modelMatrix = parentTransform * getRenderMatrix();
     shader.setMat4("model", modelMatrix);
     
     // Calculate normal matrix for lighting
@@ -183,6 +283,106 @@ void Model::draw(Shader& shader, const glm::mat4& parentTransform) const {
     }
 }
 
+glm::mat4 Model::getMeshMatrix([[maybe_unused]] size_t meshIndex) const {
+    return getRenderMatrix();
+}
+
+void Model::drawIds(Shader& idShader, uint32_t objectId) const {
+    if (!m_visible) return;
+    
+    for (size_t i = 0; i < m_meshes.size(); i++) {
+        idShader.setUInt("objectId", ObjectPicker::encodeId(objectId, static_cast<uint32_t>(i)));
+        idShader.setMat4("model", getMeshMatrix(i));
+        m_meshes[i]->draw(idShader);
+    }
+}
+
+bool Model::collectDrawItems(std::vector<DrawItem>& opaque, std::vector<DrawItem>& transparent,
+                             uint32_t objectId, const glm::vec3& cameraPosition) const {
+    if (!m_visible) {
+        // Reappearing is a cut, not motion
+        m_drawnMatrices.clear();
+        return false;
+    }
+    
+    // First frame (or meshes added since): no motion
+    bool hasPrevious = m_drawnMatrices.size() == m_meshes.size();
+    m_drawnMatrices.resize(m_meshes.size());
+    
+    for (size_t i = 0; i < m_meshes.size(); i++) {
+        DrawItem item;
+        item.mesh = m_meshes[i].get();
+        item.model = getMeshMatrix(i);
+        item.previousModel = hasPrevious ? m_drawnMatrices[i] : item.model;
+        m_drawnMatrices[i] = item.model;
+        item.material = (i < m_meshMaterials.size()) ? m_meshMaterials[i] : m_material;
+        item.pickId = ObjectPicker::encodeId(objectId, static_cast<uint32_t>(i));
+        
+        glm::vec3 offset = glm::vec3(item.model[3]) - cameraPosition;
+        item.sortDepth = glm::dot(offset, offset);
+        
+        // World bounds for culling: the largest axis scale covers any rotation
+        const Mesh& mesh = *m_meshes[i];
+        float scale = std::max({glm::length(glm::vec3(item.model[0])),
+                                glm::length(glm::vec3(item.model[1])),
+                                glm::length(glm::vec3(item.model[2]))});
+        glm::vec3 center = glm::vec3(item.model * glm::vec4(mesh.getBoundsCenter(), 1.0f));
+        item.bounds = glm::vec4(center, mesh.getBoundsRadius() * scale);
+        item.viewMask = ~0u;
+        item.pointLightMask = 0xFF;
+        item.spotLightMask = 0xFF;
+        
+        if (item.material.isTransparent()) {
+            transparent.push_back(item);
+        } else {
+            opaque.push_back(item);
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// Ray Queries
+// =============================================================================
+
+void Model::buildBVHs() {
+    for (auto& mesh : m_meshes) {
+        mesh->buildBVH();
+    }
+}
+
+bool Model::raycast(const Ray& ray, float maxDistance, TriangleHit& hit) const {
+    hit.hit = false;
+    if (!m_visible) return false;
+    
+    float closest = maxDistance;
+    
+    for (size_t i = 0; i < m_meshes.size(); i++) {
+        if (!m_meshes[i]->hasBVH()) {
+            continue;
+        }
+        
+        // Transform the ray instead of the triangles. The direction is not
+        // re-normalized, so the hit distance stays in world units.
+        glm::mat4 meshMatrix = getMeshMatrix(i);
+        glm::mat4 toLocal = glm::inverse(meshMatrix);
+        Ray localRay;
+        localRay.origin = glm::vec3(toLocal * glm::vec4(ray.origin, 1.0f));
+        localRay.direction = glm::vec3(toLocal * glm::vec4(ray.direction, 0.0f));
+        
+        TriangleHit meshHit;
+        if (m_meshes[i]->raycast(localRay, closest, meshHit)) {
+            closest = meshHit.distance;
+            hit = meshHit;
+            hit.meshIndex = i;
+            hit.point = ray.getPoint(meshHit.distance);
+            hit.normal = glm::normalize(glm::mat3(glm::transpose(toLocal)) * meshHit.normal);
+        }
+    }
+    
+    return hit.hit;
+}
+
 // =============================================================================
 // Material
 // =============================================================================
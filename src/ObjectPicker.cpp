@@ -0,0 +1,232 @@
+/**
+ * =============================================================================
+ * ObjectPicker.cpp - GPU Object-ID Picking Implementation
+ * =============================================================================
+ */
+
+#include "ObjectPicker.h"
+#include "Shader.h"
+
+#include <glad/glad.h>
+#include <iostream>
+
+// ID-only shader: same vertex transform as the main shader, but the
+// fragment output is an unsigned integer instead of a lit color
+static const char* ID_VERTEX_SHADER_SOURCE = R"(
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    gl_Position = projection * view * model * vec4(aPos, 1.0);
+}
+)";
+
+static const char* ID_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+uniform uint objectId;
+
+out uint FragId;
+
+void main() {
+    FragId = objectId;
+}
+)";
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+ObjectPicker::ObjectPicker(int width, int height)
+    : m_width(width)
+    , m_height(height)
+    , m_valid(false)
+    , m_framebuffer(0)
+    , m_idTexture(0)
+    , m_depthBuffer(0)
+    , m_writeSlot(0)
+    , m_readSlot(0)
+{
+    m_shader = std::make_unique<Shader>(ID_VERTEX_SHADER_SOURCE, ID_FRAGMENT_SHADER_SOURCE, false);
+    
+    // One 4-byte PBO per slot; STREAM_READ tells the driver the CPU reads it
+    for (auto& slot : m_slots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(uint32_t), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    createTargets();
+}
+
+ObjectPicker::~ObjectPicker() {
+    for (auto& slot : m_slots) {
+        if (slot.fence) {
+            glDeleteSync(static_cast<GLsync>(slot.fence));
+        }
+        glDeleteBuffers(1, &slot.pbo);
+    }
+    destroyTargets();
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void ObjectPicker::resize(int width, int height) {
+    if (width == m_width && height == m_height) {
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    
+    // Pending readbacks already copied their pixel, so they stay valid
+    destroyTargets();
+    createTargets();
+}
+
+bool ObjectPicker::beginPick(int x, int y, const glm::mat4& view, const glm::mat4& projection) {
+    if (!m_valid || x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return false;
+    }
+    
+    // Every slot still waiting on the GPU: skip this pick rather than stall
+    ReadbackSlot& slot = m_slots[m_writeSlot];
+    if (slot.pending) {
+        return false;
+    }
+    slot.x = x;
+    slot.y = y;
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+    
+    // Clears and draws only touch the scissor rectangle
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, y, 1, 1);
+    
+    const GLuint noObject[4] = {0, 0, 0, 0};
+    glClearBufferuiv(GL_COLOR, 0, noObject);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+    
+    m_shader->use();
+    m_shader->setMat4("view", view);
+    m_shader->setMat4("projection", projection);
+    
+    return true;
+}
+
+void ObjectPicker::endPick() {
+    ReadbackSlot& slot = m_slots[m_writeSlot];
+    
+    // Copy the pixel into the PBO. With a pack buffer bound, the last
+    // argument is an offset into it, and the call returns immediately.
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glReadPixels(slot.x, slot.y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.pending = true;
+    m_writeSlot = (m_writeSlot + 1) % READBACK_SLOTS;
+    
+    // Restore the default framebuffer for the next frame
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_width, m_height);
+}
+
+bool ObjectPicker::pollResult(PickResult& result) {
+    bool gotResult = false;
+    
+    // Slots finish in order, so stop at the first one that isn't ready
+    while (m_slots[m_readSlot].pending) {
+        ReadbackSlot& slot = m_slots[m_readSlot];
+        GLsync fence = static_cast<GLsync>(slot.fence);
+        
+        // Zero timeout: just ask, never wait
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        
+        glDeleteSync(fence);
+        slot.fence = nullptr;
+        slot.pending = false;
+        
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(uint32_t), GL_MAP_READ_BIT);
+        if (data) {
+            uint32_t id = *static_cast<const uint32_t*>(data);
+            result.objectId = id >> 8;
+            result.partId = id & 0xFFu;
+            result.x = slot.x;
+            result.y = slot.y;
+            gotResult = true;
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        
+        m_readSlot = (m_readSlot + 1) % READBACK_SLOTS;
+    }
+    
+    return gotResult;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void ObjectPicker::createTargets() {
+    // Integer color target: one 32-bit ID per pixel, never filtered
+    glGenTextures(1, &m_idTexture);
+    glBindTexture(GL_TEXTURE_2D, m_idTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, m_width, m_height, 0,
+                 GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    // Depth buffer so the nearest surface wins, exactly like the color pass
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_idTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    
+    m_valid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!m_valid) {
+        std::cerr << "ERROR: Picking framebuffer is incomplete" << std::endl;
+    }
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ObjectPicker::destroyTargets() {
+    if (m_framebuffer) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    if (m_idTexture) {
+        glDeleteTextures(1, &m_idTexture);
+        m_idTexture = 0;
+    }
+    if (m_depthBuffer) {
+        glDeleteRenderbuffers(1, &m_depthBuffer);
+        m_depthBuffer = 0;
+    }
+    m_valid = false;
+}
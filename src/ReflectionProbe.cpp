@@ -0,0 +1,345 @@
+/**
+ * =============================================================================
+ * ReflectionProbe.cpp - Cached Environment Cubemap Implementation
+ * =============================================================================
+ */
+
+#include "ReflectionProbe.h"
+#include "Renderer.h"
+#include "Shader.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+
+// Prefilter shader: one fullscreen triangle per face and mip. Each pixel
+// turns into its cubemap direction and averages the capture over the GGX
+// lobe around it (split-sum prefilter, with view = normal).
+static const char* FILTER_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+out vec4 FragColor;
+
+uniform samplerCube sourceMap;
+uniform int face;
+uniform float faceSize;         // Target mip size in pixels
+uniform float sourceSize;       // Capture mip 0 size in pixels
+uniform float roughness;
+
+const float PI = 3.14159265359;
+const uint SAMPLE_COUNT = 32u;
+
+// Cubemap direction of a face pixel (u, v in -1..1, GL face orientation)
+vec3 faceDirection(vec2 uv) {
+    if (face == 0) return vec3(1.0, -uv.y, -uv.x);
+    if (face == 1) return vec3(-1.0, -uv.y, uv.x);
+    if (face == 2) return vec3(uv.x, 1.0, uv.y);
+    if (face == 3) return vec3(uv.x, -1.0, -uv.y);
+    if (face == 4) return vec3(uv.x, -uv.y, 1.0);
+    return vec3(-uv.x, -uv.y, -1.0);
+}
+
+// Low-discrepancy sample points (Hammersley set)
+float radicalInverse(uint bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return float(bits) * 2.3283064365386963e-10;
+}
+
+// Half vector distributed like the GGX lobe around n
+vec3 sampleGGX(vec2 xi, vec3 n, float alpha) {
+    float phi = 2.0 * PI * xi.x;
+    float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (alpha * alpha - 1.0) * xi.y));
+    float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+    
+    vec3 up = abs(n.z) < 0.999 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0);
+    vec3 tangent = normalize(cross(up, n));
+    vec3 bitangent = cross(n, tangent);
+    return normalize(tangent * (cos(phi) * sinTheta) +
+                     bitangent * (sin(phi) * sinTheta) + n * cosTheta);
+}
+
+void main() {
+    vec2 uv = gl_FragCoord.xy / faceSize * 2.0 - 1.0;
+    vec3 n = normalize(faceDirection(uv));
+    
+    // Mirror level: a straight copy
+    if (roughness == 0.0) {
+        FragColor = vec4(textureLod(sourceMap, n, 0.0).rgb, 1.0);
+        return;
+    }
+    
+    float alpha = roughness * roughness;
+    float texelSolidAngle = 4.0 * PI / (6.0 * sourceSize * sourceSize);
+    
+    vec3 color = vec3(0.0);
+    float totalWeight = 0.0;
+    for (uint i = 0u; i < SAMPLE_COUNT; i++) {
+        vec2 xi = vec2(float(i) / float(SAMPLE_COUNT), radicalInverse(i));
+        vec3 h = sampleGGX(xi, n, alpha);
+        vec3 l = normalize(2.0 * dot(n, h) * h - n);
+        
+        float nDotL = dot(n, l);
+        if (nDotL > 0.0) {
+            // Read the capture mip whose texels cover this sample's
+            // share of the lobe (view = normal, so the pdf is D / 4)
+            float nDotH = max(dot(n, h), 0.0);
+            float denom = nDotH * nDotH * (alpha * alpha - 1.0) + 1.0;
+            float d = alpha * alpha / (PI * denom * denom);
+            float pdf = d / 4.0 + 0.0001;
+            float sampleSolidAngle = 1.0 / (float(SAMPLE_COUNT) * pdf);
+            float lod = 0.5 * log2(sampleSolidAngle / texelSolidAngle) + 1.0;
+            
+            color += textureLod(sourceMap, l, max(lod, 0.0)).rgb * nDotL;
+            totalWeight += nDotL;
+        }
+    }
+    
+    FragColor = vec4(color / max(totalWeight, 0.0001), 1.0);
+}
+)";
+
+namespace {
+
+// Capture camera: 90 degrees covers exactly one face
+constexpr float CAPTURE_NEAR = 0.1f;
+constexpr float CAPTURE_FAR = 100.0f;
+
+/**
+ * View direction and up vector of each cube face, in GL face order
+ * (+X, -X, +Y, -Y, +Z, -Z). The up vectors match the cubemap's texture
+ * orientation, so a capture needs no flipping.
+ */
+struct FaceView {
+    glm::vec3 direction;
+    glm::vec3 up;
+};
+
+const FaceView FACE_VIEWS[ReflectionProbe::FACE_COUNT] = {
+    { glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f) },
+    { glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f) },
+    { glm::vec3( 0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f) },
+    { glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f) },
+    { glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f) },
+    { glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f) },
+};
+
+/**
+ * Create a half-float RGBA cubemap with storage for every mip level.
+ */
+unsigned int createCubemap(int size, int mipLevels) {
+    unsigned int texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    for (int level = 0; level < mipLevels; level++) {
+        int levelSize = size >> level;
+        for (int face = 0; face < ReflectionProbe::FACE_COUNT; face++) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGBA16F,
+                         levelSize, levelSize, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+        }
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipLevels - 1);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    return texture;
+}
+
+/**
+ * Number of mip levels down to 1x1.
+ */
+int fullMipCount(int size) {
+    int levels = 1;
+    while (size > 1) {
+        size /= 2;
+        levels++;
+    }
+    return levels;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+ReflectionProbe::ReflectionProbe()
+    : m_valid(false)
+    , m_ready(false)
+    , m_captureMap(0)
+    , m_captureFramebuffer(0)
+    , m_depthBuffer(0)
+    , m_filteredMap(0)
+    , m_filterFramebuffer(0)
+    , m_hasVersion(false)
+    , m_version(0)
+    , m_nextFace(FACE_COUNT)
+    , m_position(0.0f)
+{
+    m_filterShader = std::make_unique<Shader>(FullscreenPass::VERTEX_SHADER_SOURCE,
+                                              FILTER_FRAGMENT_SHADER_SOURCE, false);
+    m_filterShader->use();
+    m_filterShader->setInt("sourceMap", 0);
+    m_filterShader->setFloat("sourceSize", static_cast<float>(FACE_SIZE));
+    
+    // Filtering across face edges, so rough mips have no visible seams
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+    
+    // The capture keeps its full mip chain: the filter reads from all of it
+    m_captureMap = createCubemap(FACE_SIZE, fullMipCount(FACE_SIZE));
+    m_filteredMap = createCubemap(FACE_SIZE, MIP_COUNT);
+    
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, FACE_SIZE, FACE_SIZE);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    // Capture: a face as color, plus depth. The filter needs no depth.
+    glGenFramebuffers(1, &m_captureFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_captureFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_CUBE_MAP_POSITIVE_X, m_captureMap, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    m_valid = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    
+    glGenFramebuffers(1, &m_filterFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_filterFramebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_CUBE_MAP_POSITIVE_X, m_filteredMap, 0);
+    m_valid = m_valid && glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (!m_valid) {
+        std::cerr << "ERROR: Reflection probe framebuffer is incomplete" << std::endl;
+    }
+}
+
+ReflectionProbe::~ReflectionProbe() {
+    glDeleteFramebuffers(1, &m_captureFramebuffer);
+    glDeleteFramebuffers(1, &m_filterFramebuffer);
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+    glDeleteTextures(1, &m_captureMap);
+    glDeleteTextures(1, &m_filteredMap);
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void ReflectionProbe::update(Renderer& renderer, const FramePacket& packet, int width, int height) {
+    if (!m_valid) {
+        return;
+    }
+    
+    // New static content: start over, even in the middle of a recapture
+    bool changed = !m_hasVersion || packet.staticVersion != m_version ||
+                   packet.probePosition != m_position;
+    if (changed) {
+        m_hasVersion = true;
+        m_version = packet.staticVersion;
+        m_position = packet.probePosition;
+        m_nextFace = 0;
+        collectStaticItems(packet);
+    }
+    if (m_nextFace >= FACE_COUNT) {
+        return;
+    }
+    
+    // Nothing to show yet: capture everything now. Otherwise the old
+    // result stays valid, so spread the work at one face per frame.
+    int lastFace = m_ready ? m_nextFace + 1 : FACE_COUNT;
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, m_captureFramebuffer);
+    glViewport(0, 0, FACE_SIZE, FACE_SIZE);
+    const glm::vec3& clearColor = renderer.getClearColor();
+    glClearColor(clearColor.r, clearColor.g, clearColor.b, 1.0f);
+    
+    for (; m_nextFace < lastFace; m_nextFace++) {
+        captureFace(renderer, m_nextFace);
+    }
+    
+    if (m_nextFace == FACE_COUNT) {
+        prefilter();
+        m_ready = true;
+    }
+    
+    // Back to the frame being drawn
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+    renderer.setCamera(packet.view, packet.projection, packet.cameraPosition);
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void ReflectionProbe::collectStaticItems(const FramePacket& packet) {
+    // clear() keeps capacity, so only the first capture allocates
+    m_opaqueItems.clear();
+    m_transparentItems.clear();
+    
+    // The probe looks in every direction, so the views' culling doesn't apply
+    for (const DrawItem& item : packet.opaqueItems) {
+        if ((item.pickId >> 8) == 0) {
+            m_opaqueItems.push_back(item);
+            m_opaqueItems.back().viewMask = ~0u;
+        }
+    }
+    for (const DrawItem& item : packet.transparentItems) {
+        if ((item.pickId >> 8) == 0) {
+            m_transparentItems.push_back(item);
+            m_transparentItems.back().viewMask = ~0u;
+        }
+    }
+}
+
+void ReflectionProbe::captureFace(Renderer& renderer, int face) {
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, m_captureMap, 0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    
+    const FaceView& faceView = FACE_VIEWS[face];
+    glm::mat4 view = glm::lookAt(m_position, m_position + faceView.direction, faceView.up);
+    glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, CAPTURE_NEAR, CAPTURE_FAR);
+    
+    renderer.setCamera(view, projection, m_position);
+    renderer.drawItems(m_opaqueItems, m_transparentItems);
+}
+
+void ReflectionProbe::prefilter() {
+    // Lower capture mips are what rough samples read
+    glBindTexture(GL_TEXTURE_CUBE_MAP, m_captureMap);
+    glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, m_filterFramebuffer);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    
+    m_filterShader->use();
+    m_fullscreen.bind();
+    
+    for (int level = 0; level < MIP_COUNT; level++) {
+        int levelSize = FACE_SIZE >> level;
+        glViewport(0, 0, levelSize, levelSize);
+        m_filterShader->setFloat("faceSize", static_cast<float>(levelSize));
+        m_filterShader->setFloat("roughness", static_cast<float>(level) / (MIP_COUNT - 1));
+        
+        for (int face = 0; face < FACE_COUNT; face++) {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                   GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, m_filteredMap, level);
+            m_filterShader->setInt("face", face);
+            FullscreenPass::draw();
+        }
+    }
+    
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    glEnable(GL_DEPTH_TEST);
+}
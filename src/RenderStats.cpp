@@ -0,0 +1,28 @@
+/**
+ * =============================================================================
+ * RenderStats.cpp - Per-Frame Rendering Counters Implementation
+ * =============================================================================
+ */
+
+#include "RenderStats.h"
+
+#include <atomic>
+
+namespace {
+
+thread_local RenderStats t_current;
+std::atomic<uint64_t> g_uploadedBytes{0};
+
+} // anonymous namespace
+
+RenderStats& RenderStats::current() {
+    return t_current;
+}
+
+void RenderStats::addUploadedBytes(size_t bytes) {
+    g_uploadedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+uint64_t RenderStats::takeUploadedBytes() {
+    return g_uploadedBytes.exchange(0, std::memory_order_relaxed);
+}
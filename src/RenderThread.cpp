@@ -0,0 +1,392 @@
+/**
+ * =============================================================================
+ * RenderThread.cpp - Dedicated OpenGL Render Thread Implementation
+ * =============================================================================
+ */
+
+#include "RenderThread.h"
+#include "Window.h"
+#include "Renderer.h"
+#include "FramePacer.h"
+#include "Mesh.h"
+#include "Shader.h"
+#include "GpuDeletionQueue.h"
+#include "AllocationTracker.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+// Label text size: 2 screen pixels per font pixel
+constexpr float LABEL_SCALE = 2.0f;
+
+/**
+ * Get a packet's projection without the TAA jitter, so labels and the
+ * pick pixel don't shake.
+ */
+glm::mat4 getSteadyProjection(const FramePacket& packet) {
+    return glm::translate(glm::mat4(1.0f), glm::vec3(-packet.jitter, 0.0f)) * packet.projection;
+}
+
+/**
+ * Check if a world point projects inside a view's own rectangle.
+ */
+bool isInsideView(const RenderView& view, const glm::vec3& position) {
+    glm::vec4 clip = view.projection * view.view * glm::vec4(position, 1.0f);
+    return clip.w > 0.0f && std::abs(clip.x) <= clip.w && std::abs(clip.y) <= clip.w;
+}
+
+/**
+ * Find the view whose viewport holds a pixel.
+ * @return Index into packet.views, or -1
+ */
+int findViewAt(const FramePacket& packet, int x, int y) {
+    size_t viewCount = std::min(packet.views.size(), FramePacket::MAX_VIEWS);
+    for (size_t i = 0; i < viewCount; i++) {
+        const RenderView& view = packet.views[i];
+        if (x >= view.x && x < view.x + view.width && y >= view.y && y < view.y + view.height) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+RenderThread::RenderThread(Window& window, Renderer& renderer, ObjectPicker& picker,
+                           FramePacer& pacer, bool threaded)
+    : m_window(window)
+    , m_renderer(renderer)
+    , m_picker(picker)
+    , m_pacer(pacer)
+    , m_threaded(threaded)
+    , m_running(false)
+    , m_frameNumber(0)
+    , m_width(window.getWidth())
+    , m_height(window.getHeight())
+    , m_hasPickResult(false)
+    , m_occlusion(m_width, m_height)
+    , m_antiAliasing(m_width, m_height)
+{
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+// =============================================================================
+// Start / Stop
+// =============================================================================
+
+void RenderThread::start() {
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    
+    if (m_threaded) {
+        // A GL context can only be current on one thread at a time
+        Window::detachContext();
+        m_thread = std::thread(&RenderThread::threadLoop, this);
+    }
+}
+
+void RenderThread::stop() {
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    
+    if (m_threaded) {
+        m_queue.close();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_window.makeContextCurrent();
+    }
+}
+
+// =============================================================================
+// Main Thread Interface
+// =============================================================================
+
+FramePacket* RenderThread::beginFrame() {
+    FramePacket* packet = m_queue.beginWrite();
+    if (!packet) {
+        return nullptr;
+    }
+    
+    packet->clear();
+    packet->frameNumber = ++m_frameNumber;
+    return packet;
+}
+
+void RenderThread::submitFrame() {
+    m_queue.publish();
+    
+    // Without a thread, draw it right here through the same path
+    if (!m_threaded) {
+        FramePacket* packet = m_queue.beginRead();
+        if (packet) {
+            renderPacket(*packet);
+            m_queue.endRead();
+        }
+    }
+}
+
+RenderStats RenderThread::getStats() const {
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    return m_stats;
+}
+
+bool RenderThread::pollPickResult(PickResult& result) {
+    std::lock_guard<std::mutex> lock(m_pickMutex);
+    if (!m_hasPickResult) {
+        return false;
+    }
+    result = m_pickResult;
+    m_hasPickResult = false;
+    return true;
+}
+
+// =============================================================================
+// Render Thread
+// =============================================================================
+
+void RenderThread::threadLoop() {
+    m_window.makeContextCurrent();
+    
+    try {
+        while (FramePacket* packet = m_queue.beginRead()) {
+            renderPacket(*packet);
+            m_queue.endRead();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: Render thread stopped: " << e.what() << std::endl;
+        m_queue.close();  // Makes beginFrame() return nullptr on the main thread
+    }
+    
+    Window::detachContext();
+}
+
+void RenderThread::renderPacket(const FramePacket& packet) {
+    // Steady-state frames must not allocate (checked in instrumented builds)
+    ALLOCATION_ZONE(AllocSubsystem::RENDERER);
+    ALLOCATION_FREE_SCOPE(packet.frameNumber > AllocationTracker::WARMUP_FRAMES);
+    
+    double frameStart = Window::getTime();
+    
+    // GL objects released since the last frame (see GpuDeletionQueue)
+    GpuDeletionQueue::flush();
+    
+    // Follow window resizes (skipped while minimized)
+    if ((packet.width != m_width || packet.height != m_height) &&
+        packet.width > 0 && packet.height > 0) {
+        m_width = packet.width;
+        m_height = packet.height;
+        m_renderer.resize(m_width, m_height);
+        m_picker.resize(m_width, m_height);
+        m_occlusion.resize(m_width, m_height);
+        m_antiAliasing.resize(m_width, m_height);
+    }
+    
+    // Swap interval must be set by the thread that owns the context
+    if (packet.pacingMode != m_pacer.getMode()) {
+        FrameTimeStats stats = m_pacer.getStats();
+        std::cout << FramePacer::getModeName(m_pacer.getMode()) << ": "
+                  << stats.average << " ms avg, " << stats.standardDeviation << " ms std dev, "
+                  << stats.minimum << "-" << stats.maximum << " ms" << std::endl;
+        
+        m_pacer.setMode(packet.pacingMode);
+        std::cout << "Frame pacing: " << FramePacer::getModeName(m_pacer.getMode());
+        if (m_pacer.getMode() == PacingMode::LIMITED) {
+            std::cout << " (" << m_pacer.getTargetFrameRate() << " FPS)";
+        }
+        std::cout << std::endl;
+    }
+    
+    m_gpuTimer.beginFrame();
+    m_renderer.beginFrame();
+    m_renderer.setCamera(packet.view, packet.projection, packet.cameraPosition);
+    
+    m_renderer.setDirectionalLight(packet.sunLight);
+    for (const auto& light : packet.pointLights) {
+        m_renderer.addPointLight(light);
+    }
+    for (const auto& light : packet.spotLights) {
+        m_renderer.addSpotLight(light);
+    }
+    
+    // Reflections: the probe draws with the main shader, so it must not
+    // sample itself (or this view's occlusion) while it captures
+    m_renderer.setEnvironmentMap(0, 0.0f);
+    m_renderer.setAmbientOcclusion(0, 0);
+    m_probe.update(m_renderer, packet, m_width, m_height);
+    m_renderer.setEnvironmentMap(m_probe.getTexture(), m_probe.getMaxLod());
+    
+    m_occlusion.render(packet, m_width, m_height);
+    m_renderer.setAmbientOcclusion(m_occlusion.getTexture(), m_occlusion.getDepthTexture());
+    
+    // Main pass into the anti-aliasing target, then resolved to the screen
+    m_antiAliasing.beginScene(packet, m_renderer);
+    if (packet.views.empty()) {
+        m_renderer.drawItems(packet.opaqueItems, packet.transparentItems, 0, 1u);
+    } else {
+        renderViews(packet);
+    }
+    m_antiAliasing.resolve();
+    
+    // ID pass under the cursor (after the visible frame, before the swap)
+    renderPicking(packet);
+    
+    // Text and graphs over the finished image
+    renderHud(packet);
+    
+    m_gpuTimer.endFrame();
+    publishStats(packet, frameStart);
+    
+    m_window.swapBuffers();
+    m_pacer.endFrame();
+}
+
+void RenderThread::renderViews(const FramePacket& packet) {
+    // Every view's camera in one upload, then the same lists per viewport
+    size_t viewCount = std::min(packet.views.size(), FramePacket::MAX_VIEWS);
+    m_renderer.setViews(packet.views.data(), viewCount);
+    
+    // One view's glass, sorted for that view's camera (frame memory)
+    std::pmr::vector<DrawItem> viewTransparentItems(&m_renderer.getFrameArena());
+    
+    for (size_t i = 0; i < viewCount; i++) {
+        const RenderView& view = packet.views[i];
+        uint32_t viewBit = 1u << i;
+        glViewport(view.x, view.y, view.width, view.height);
+        
+        // The packet's glass is sorted for the main camera; re-sort the
+        // few pieces this view sees for its own (capacity is reused)
+        viewTransparentItems.clear();
+        for (const DrawItem& item : packet.transparentItems) {
+            if (item.viewMask & viewBit) {
+                viewTransparentItems.push_back(item);
+                glm::vec3 offset = glm::vec3(item.model[3]) - view.cameraPosition;
+                viewTransparentItems.back().sortDepth = glm::dot(offset, offset);
+            }
+        }
+        std::sort(viewTransparentItems.begin(), viewTransparentItems.end(),
+                  [](const DrawItem& a, const DrawItem& b) { return a.sortDepth > b.sortDepth; });
+        
+        m_renderer.drawItems(packet.opaqueItems.data(), packet.opaqueItems.size(),
+                             viewTransparentItems.data(), viewTransparentItems.size(), i, viewBit);
+    }
+    
+    glViewport(0, 0, m_width, m_height);
+}
+
+void RenderThread::renderHud(const FramePacket& packet) {
+    m_text.begin(m_width, m_height);
+    
+    if (!packet.labels.empty() && packet.views.empty()) {
+        glm::mat4 viewProjection = getSteadyProjection(packet) * packet.view;
+        for (const TextLabel& label : packet.labels) {
+            m_text.addLabel(label.text, label.position, viewProjection, LABEL_SCALE,
+                            label.color, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+        }
+    }
+    
+    // Labels of each view, kept to the view's own rectangle
+    size_t viewCount = std::min(packet.views.size(), FramePacket::MAX_VIEWS);
+    for (size_t i = 0; i < viewCount && !packet.labels.empty(); i++) {
+        const RenderView& view = packet.views[i];
+        glm::mat4 viewProjection = view.getScreenProjection(m_width, m_height) * view.view;
+        for (const TextLabel& label : packet.labels) {
+            if (isInsideView(view, label.position)) {
+                m_text.addLabel(label.text, label.position, viewProjection, LABEL_SCALE,
+                                label.color, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+            }
+        }
+    }
+    
+    if (packet.showStats) {
+        m_overlay.draw(m_text);
+    }
+    
+    // Every label and number in a single draw
+    m_text.flush();
+}
+
+void RenderThread::renderPicking(const FramePacket& packet) {
+    // Results of picks issued one or two frames ago
+    PickResult result;
+    if (m_picker.pollResult(result)) {
+        std::lock_guard<std::mutex> lock(m_pickMutex);
+        m_pickResult = result;
+        m_hasPickResult = true;
+    }
+    
+    if (!packet.pickRequested) {
+        return;
+    }
+    
+    // With several views, the pick goes through the one under the cursor
+    glm::mat4 view = packet.view;
+    glm::mat4 projection = getSteadyProjection(packet);
+    uint32_t viewBit = 1u;
+    if (!packet.views.empty()) {
+        int viewIndex = findViewAt(packet, packet.pickX, packet.pickY);
+        if (viewIndex < 0) {
+            return;
+        }
+        const RenderView& pickView = packet.views[static_cast<size_t>(viewIndex)];
+        view = pickView.view;
+        projection = pickView.getScreenProjection(m_width, m_height);
+        viewBit = 1u << viewIndex;
+    }
+    
+    if (!m_picker.beginPick(packet.pickX, packet.pickY, view, projection)) {
+        return;
+    }
+    
+    // Everything in the view is drawn, including ID 0 items, so
+    // unpickable geometry still hides what is behind it
+    Shader& idShader = m_picker.getShader();
+    for (const auto* items : {&packet.opaqueItems, &packet.transparentItems}) {
+        for (const DrawItem& item : *items) {
+            if ((item.viewMask & viewBit) == 0) {
+                continue;
+            }
+            idShader.setUInt("objectId", item.pickId);
+            idShader.setMat4("model", item.model);
+            item.mesh->draw(idShader);
+        }
+    }
+    
+    m_picker.endPick();
+}
+
+void RenderThread::publishStats(const FramePacket& packet, double frameStart) {
+    // Draw and state counters were filled in while drawing
+    RenderStats& stats = RenderStats::current();
+    stats.frameNumber = packet.frameNumber;
+    stats.bytesUploaded = RenderStats::takeUploadedBytes();
+    stats.objectsTotal = packet.objectsTotal;
+    stats.objectsHidden = packet.objectsHidden;
+    stats.itemsTotal = static_cast<uint32_t>(packet.opaqueItems.size() + packet.transparentItems.size());
+    stats.itemsCulled = packet.itemsCulled;
+    stats.cpuMainMs = packet.cpuMainMs;
+    stats.cpuRenderMs = (Window::getTime() - frameStart) * 1000.0;
+    stats.gpuMs = m_gpuTimer.getLastTimeMs();
+    
+    m_overlay.addFrame(stats);
+    
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_stats = stats;
+}
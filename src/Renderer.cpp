@@ -9,9 +9,13 @@
 #include "Camera.h"
 #include "Model.h"
 #include "Light.h"
+#include "FramePacket.h"
+#include "Mesh.h"
 
 #include <glad/glad.h>
 #include <algorithm>
+#include <cstring>
+#include <iostream>
 
 // Embedded shader sources for the main rendering shader
 static const char* VERTEX_SHADER_SOURCE = R"(
@@ -24,12 +28,24 @@ layout (location = 2) in vec2 aTexCoords;
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
+out vec4 CurrentClip;
+out vec4 PreviousClip;
+
+// Camera of the view being drawn (one buffer slot per view)
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    mat4 prevViewProj;      // Previous frame's, for motion vectors
+    vec4 viewPos;           // xyz
+    vec4 jitterDelta;       // xy
+};
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 uniform mat3 normalMatrix;
 
+// Where this vertex was drawn last frame (motion vectors)
+uniform mat4 previousModel;
+
 void main() {
     // Transform position to world space for lighting calculations
     FragPos = vec3(model * vec4(aPos, 1.0));
@@ -43,17 +59,32 @@ void main() {
     
     // Final clip-space position
     gl_Position = projection * view * vec4(FragPos, 1.0);
+    
+    CurrentClip = gl_Position;
+    PreviousClip = prevViewProj * previousModel * vec4(aPos, 1.0);
 }
 )";
 
 static const char* FRAGMENT_SHADER_SOURCE = R"(
 #version 330 core
 
-out vec4 FragColor;
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec2 Velocity;    // Screen UV offset back to the previous frame
 
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoords;
+in vec4 CurrentClip;
+in vec4 PreviousClip;
+
+// Same block as the vertex shader's
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    mat4 prevViewProj;
+    vec4 viewPos;           // Camera position in xyz
+    vec4 jitterDelta;       // This frame's projection jitter minus the previous one, NDC in xy
+};
 
 // Material properties
 struct Material {
@@ -62,6 +93,9 @@ struct Material {
     vec3 specular;
     float shininess;
     float opacity;
+    float reflectivity;
+    float roughness;
+    bool hasLightMap;
 };
 
 // Directional light (like the sun)
@@ -107,43 +141,98 @@ uniform Material material;
 uniform DirLight dirLight;
 uniform PointLight pointLights[MAX_POINT_LIGHTS];
 uniform SpotLight spotLights[MAX_SPOT_LIGHTS];
+
+// Lights reaching this draw: the first numPointLights entries of
+// pointLightList index pointLights (likewise for spot lights)
 uniform int numPointLights;
 uniform int numSpotLights;
-uniform vec3 viewPos;
+uniform ivec4 pointLightList;
+uniform ivec2 spotLightList;
+
+// Baked ambient and diffuse light of static surfaces (UVs in TexCoords)
+uniform sampler2D lightMap;
+
+// Half-resolution ambient occlusion and the depth it was computed from
+uniform sampler2D aoMap;
+uniform sampler2D aoDepth;
+uniform bool hasAO;
+
+// Ambient light reaching this fragment (1 = all of it), set in main()
+float occlusion = 1.0;
+
+// Prefiltered reflection probe (mip = roughness)
+uniform samplerCube environmentMap;
+uniform bool hasEnvMap;
+uniform float envMaxLod;
 
 // Function declarations
 vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+float SampleOcclusion();
 
 void main() {
     // Normalize interpolated normal
     vec3 norm = normalize(Normal);
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
     
     // Start with no light contribution
     vec3 result = vec3(0.0);
     
-    // Directional light
-    if (dirLight.enabled) {
-        result += CalcDirLight(dirLight, norm, viewDir);
+    // Glass is not in the occlusion depth, so it would take on the
+    // occlusion of whatever is behind it
+    if (hasAO && material.opacity >= 1.0) {
+        occlusion = SampleOcclusion();
     }
     
-    // Point lights
-    for (int i = 0; i < numPointLights && i < MAX_POINT_LIGHTS; i++) {
-        if (pointLights[i].enabled) {
-            result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);
+    if (material.hasLightMap) {
+        // Static surface: every light was baked in, shadows and bounces
+        // too, but not the cars standing on it
+        result = texture(lightMap, TexCoords).rgb * occlusion;
+    } else {
+        // Directional light
+        if (dirLight.enabled) {
+            result += CalcDirLight(dirLight, norm, viewDir);
+        }
+    
+        // Point lights
+        for (int i = 0; i < numPointLights && i < MAX_POINT_LIGHTS; i++) {
+            int light = pointLightList[i];
+            if (pointLights[light].enabled) {
+                result += CalcPointLight(pointLights[light], norm, FragPos, viewDir);
+            }
         }
-    }
     
-    // Spot lights
-    for (int i = 0; i < numSpotLights && i < MAX_SPOT_LIGHTS; i++) {
-        if (spotLights[i].enabled) {
-            result += CalcSpotLight(spotLights[i], norm, FragPos, viewDir);
+        // Spot lights
+        for (int i = 0; i < numSpotLights && i < MAX_SPOT_LIGHTS; i++) {
+            int light = spotLightList[i];
+            if (spotLights[light].enabled) {
+                result += CalcSpotLight(spotLights[light], norm, FragPos, viewDir);
+            }
         }
     }
     
-    FragColor = vec4(result, material.opacity);
+    // Environment reflection with Schlick's Fresnel: surfaces turn into
+    // mirrors at grazing angles, and glass stops being see-through there
+    float alpha = material.opacity;
+    if (hasEnvMap && material.reflectivity > 0.0) {
+        vec3 reflectDir = reflect(-viewDir, norm);
+        vec3 reflection = textureLod(environmentMap, reflectDir,
+                                     material.roughness * envMaxLod).rgb;
+        float cosTheta = max(dot(norm, viewDir), 0.0);
+        float fresnel = material.reflectivity +
+                        (1.0 - material.reflectivity) * pow(1.0 - cosTheta, 5.0);
+        result = mix(result, reflection, fresnel);
+        alpha = mix(alpha, 1.0, fresnel);
+    }
+    
+    FragColor = vec4(result, alpha);
+    
+    // Jitter is not motion: without removing it, still pixels would
+    // reproject to a different spot every frame
+    vec2 current = CurrentClip.xy / CurrentClip.w;
+    vec2 previous = PreviousClip.xy / PreviousClip.w;
+    Velocity = (current - previous - jitterDelta.xy) * 0.5;
 }
 
 // =============================================================================
@@ -153,7 +242,7 @@ vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir) {
     vec3 lightDir = normalize(-light.direction);
     
     // Ambient
-    vec3 ambient = light.ambient * material.ambient;
+    vec3 ambient = light.ambient * material.ambient * occlusion;
     
     // Diffuse (Lambertian)
     float diff = max(dot(normal, lightDir), 0.0);
@@ -174,7 +263,7 @@ vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     vec3 lightDir = normalize(light.position - fragPos);
     
     // Ambient
-    vec3 ambient = light.ambient * material.ambient;
+    vec3 ambient = light.ambient * material.ambient * occlusion;
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
@@ -200,7 +289,7 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     vec3 lightDir = normalize(light.position - fragPos);
     
     // Ambient
-    vec3 ambient = light.ambient * material.ambient;
+    vec3 ambient = light.ambient * material.ambient * occlusion;
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
@@ -223,8 +312,54 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir) {
     
     return (ambient + (diffuse + specular) * intensity) * attenuation;
 }
+
+// =============================================================================
+// Ambient Occlusion (depth-aware bilateral upsample)
+// =============================================================================
+float LinearDepth(float depth) {
+    return projection[3][2] / (depth * 2.0 - 1.0 + projection[2][2]);
+}
+
+float SampleOcclusion() {
+    // The four half-resolution texels around this pixel, weighted
+    // bilinearly and by how close their depth is to this fragment's
+    vec2 position = gl_FragCoord.xy * 0.5 - 0.5;
+    ivec2 base = ivec2(floor(position));
+    vec2 f = fract(position);
+    ivec2 maxTexel = textureSize(aoMap, 0) - 1;
+    float depth = LinearDepth(gl_FragCoord.z);
+    
+    float total = 0.0;
+    float totalWeight = 0.0;
+    for (int i = 0; i < 4; i++) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(base + offset, ivec2(0), maxTexel);
+        vec2 bilinear = mix(1.0 - f, f, vec2(offset));
+        float sampleDepth = LinearDepth(texelFetch(aoDepth, texel, 0).r);
+        float weight = bilinear.x * bilinear.y / (0.001 + abs(sampleDepth - depth) / depth);
+        total += texelFetch(aoMap, texel, 0).r * weight;
+        totalWeight += weight;
+    }
+    return totalWeight > 0.0 ? total / totalWeight : 1.0;
+}
 )";
 
+namespace {
+
+/**
+ * One slot of the Frame uniform block. std140 lays mat4 and vec4 out
+ * exactly as glm does, so a slot is copied as is.
+ */
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 prevViewProj;
+    glm::vec4 viewPos;
+    glm::vec4 jitterDelta;
+};
+
+} // anonymous namespace
+
 // =============================================================================
 // Constructor / Destructor
 // =============================================================================
@@ -233,77 +368,66 @@ Renderer::Renderer(int width, int height)
     : m_width(width)
     , m_height(height)
     , m_directionalLight(nullptr)
+    , m_pointLights(&m_frameArena)
+    , m_spotLights(&m_frameArena)
+    , m_dirLightNames(std::make_unique<LightUniformNames>("dirLight"))
+    , m_environmentMap(0)
+    , m_environmentMaxLod(0.0f)
+    , m_occlusionMap(0)
+    , m_occlusionDepthMap(0)
+    , m_previousViewProjection(1.0f)
+    , m_jitterDelta(0.0f)
+    , m_frameUniformBuffer(0)
+    , m_frameUniformStride(sizeof(FrameUniforms))
+    , m_frameUniformsDirty(true)
+    , m_boundLightMap(0)
+    , m_boundLightMasks(ALL_LIGHTS)
     , m_clearColor(0.1f, 0.1f, 0.15f)
     , m_wireframeMode(false)
     , m_cullingEnabled(true)
-    , m_drawCallCount(0)
-    , m_triangleCount(0)
 {
+    m_pointLightNames.reserve(MAX_POINT_LIGHTS);
+    for (int i = 0; i < MAX_POINT_LIGHTS; i++) {
+        m_pointLightNames.emplace_back("pointLights[" + std::to_string(i) + "]");
+    }
+    m_spotLightNames.reserve(MAX_SPOT_LIGHTS);
+    for (int i = 0; i < MAX_SPOT_LIGHTS; i++) {
+        m_spotLightNames.emplace_back("spotLights[" + std::to_string(i) + "]");
+    }
+    
     createShaders();
     setupRenderState();
 }
 
-Renderer::~Renderer() = default;
+Renderer::~Renderer() {
+    if (m_frameUniformBuffer) glDeleteBuffers(1, &m_frameUniformBuffer);
+}
 
 // =============================================================================
 // Frame Management
 // =============================================================================
 
 void Renderer::beginFrame() {
-    // Reset statistics
-    m_drawCallCount = 0;
-    m_triangleCount = 0;
-    
-    // Clear render queues
-    m_opaqueCommands.clear();
-    m_transparentCommands.clear();
-    
-    // Clear lights (they get re-added each frame)
-    m_pointLights.clear();
-    m_spotLights.clear();
+    // Reset statistics (Mesh::draw and Shader count into them)
+    RenderStats::current() = RenderStats();
+    
+    // Drop last frame's lights, then rewind the arena.
+    // clear() would keep capacity that points into memory reset() hands
+    // out again, so the containers are replaced with empty ones first.
+    m_pointLights = std::pmr::vector<PointLight>(&m_frameArena);
+    m_spotLights = std::pmr::vector<SpotLight>(&m_frameArena);
     m_directionalLight = nullptr;
+    m_frameArena.reset();
+    
+    // Lights are added one by one; reserve so the arena holds one block each
+    m_pointLights.reserve(MAX_POINT_LIGHTS);
+    m_spotLights.reserve(MAX_SPOT_LIGHTS);
     
     // Clear the screen
     glClearColor(m_clearColor.r, m_clearColor.g, m_clearColor.b, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void Renderer::endFrame() {
-    // Activate shader
-    m_shader->use();
-    
-    // Set camera matrices
-    m_shader->setMat4("view", m_viewMatrix);
-    m_shader->setMat4("projection", m_projectionMatrix);
-    m_shader->setVec3("viewPos", m_cameraPosition);
-    
-    // Apply lighting
-    applyLighting();
-    
-    // Render opaque objects first (any order, depth test handles visibility)
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-    
-    for (const auto& cmd : m_opaqueCommands) {
-        executeCommand(cmd);
-    }
-    
-    // Sort and render transparent objects (back to front)
-    sortTransparentCommands();
-    
-    glDepthMask(GL_FALSE);  // Don't write to depth buffer
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    for (const auto& cmd : m_transparentCommands) {
-        executeCommand(cmd);
-    }
-    
-    // Restore state
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-}
-
 void Renderer::resize(int width, int height) {
     m_width = width;
     m_height = height;
@@ -319,6 +443,41 @@ void Renderer::setCamera(const Camera& camera) {
     m_projectionMatrix = camera.getProjectionMatrix(
         static_cast<float>(m_width) / static_cast<float>(m_height));
     m_cameraPosition = camera.getPosition();
+    m_frameUniformsDirty = true;
+}
+
+void Renderer::setCamera(const glm::mat4& view, const glm::mat4& projection,
+                         const glm::vec3& position) {
+    m_viewMatrix = view;
+    m_projectionMatrix = projection;
+    m_cameraPosition = position;
+    m_frameUniformsDirty = true;
+}
+
+void Renderer::setViews(const RenderView* views, size_t count) {
+    count = std::min(count, FramePacket::MAX_VIEWS);
+    std::pmr::vector<unsigned char> staging(m_frameUniformStride * count, &m_frameArena);
+    
+    // The views are drawn without temporal anti-aliasing, so their
+    // previous camera is their current one: no camera motion, no jitter
+    for (size_t i = 0; i < count; i++) {
+        FrameUniforms uniforms;
+        uniforms.view = views[i].view;
+        uniforms.projection = views[i].projection;
+        uniforms.prevViewProj = views[i].projection * views[i].view;
+        uniforms.viewPos = glm::vec4(views[i].cameraPosition, 1.0f);
+        uniforms.jitterDelta = glm::vec4(0.0f);
+        std::memcpy(staging.data() + i * m_frameUniformStride,
+                    &uniforms, sizeof(uniforms));
+    }
+    
+    // One upload for every view
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameUniformBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, static_cast<GLsizeiptr>(staging.size()), staging.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    
+    // Slot 0 now holds view 0 until the next setCamera()
+    m_frameUniformsDirty = false;
 }
 
 // =============================================================================
@@ -351,26 +510,71 @@ void Renderer::clearLights() {
 // Rendering
 // =============================================================================
 
-void Renderer::submit(const Model& model, const glm::mat4& transform) {
-    RenderCommand cmd;
-    cmd.model = &model;
-    cmd.transform = transform;
-    cmd.transparent = model.getMaterial().isTransparent();
-    
-    if (cmd.transparent) {
-        // Calculate distance to camera for sorting
-        glm::vec3 modelPos = glm::vec3(transform[3]);
-        cmd.distanceToCamera = glm::length(m_cameraPosition - modelPos);
-        m_transparentCommands.push_back(cmd);
-    } else {
-        m_opaqueCommands.push_back(cmd);
-    }
-}
-
 void Renderer::drawImmediate(const Model& model, Shader& shader) {
     shader.use();
     model.draw(shader);
-    m_drawCallCount++;
+}
+
+void Renderer::drawItems(const DrawItem* opaque, size_t opaqueCount,
+                         const DrawItem* transparent, size_t transparentCount,
+                         size_t viewIndex, uint32_t viewMask) {
+    m_shader->use();
+    
+    bindView(viewIndex);
+    
+    applyLighting();
+    
+    // One cubemap for every item; materials without reflectivity skip it
+    m_shader->setBool("hasEnvMap", m_environmentMap != 0);
+    if (m_environmentMap != 0) {
+        glActiveTexture(GL_TEXTURE0 + ENVIRONMENT_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_environmentMap);
+        glActiveTexture(GL_TEXTURE0);
+        m_shader->setFloat("envMaxLod", m_environmentMaxLod);
+        RenderStats::current().textureChanges++;
+    }
+    
+    // Occlusion of this view, for every opaque fragment
+    m_shader->setBool("hasAO", m_occlusionMap != 0);
+    if (m_occlusionMap != 0) {
+        glActiveTexture(GL_TEXTURE0 + OCCLUSION_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, m_occlusionMap);
+        glActiveTexture(GL_TEXTURE0 + OCCLUSION_DEPTH_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, m_occlusionDepthMap);
+        glActiveTexture(GL_TEXTURE0);
+        RenderStats::current().textureChanges += 2;
+    }
+    
+    // Lightmaps are bound as items need them; applyLighting() listed every light
+    m_boundLightMap = 0;
+    m_boundLightMasks = ALL_LIGHTS;
+    
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    
+    for (size_t i = 0; i < opaqueCount; i++) {
+        if (opaque[i].viewMask & viewMask) {
+            executeItem(opaque[i]);
+        }
+    }
+    
+    // Already sorted back to front when the packet was built. Glass keeps
+    // the motion of what is behind it (it has no alpha to blend with).
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColorMaski(1, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    
+    for (size_t i = 0; i < transparentCount; i++) {
+        if (transparent[i].viewMask & viewMask) {
+            executeItem(transparent[i]);
+        }
+    }
+    
+    // Restore state
+    glColorMaski(1, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
 }
 
 // =============================================================================
@@ -381,6 +585,22 @@ void Renderer::setClearColor(const glm::vec3& color) {
     m_clearColor = color;
 }
 
+void Renderer::setEnvironmentMap(unsigned int cubemap, float maxLod) {
+    m_environmentMap = cubemap;
+    m_environmentMaxLod = maxLod;
+}
+
+void Renderer::setAmbientOcclusion(unsigned int occlusionMap, unsigned int depthMap) {
+    m_occlusionMap = occlusionMap;
+    m_occlusionDepthMap = depthMap;
+}
+
+void Renderer::setPreviousCamera(const glm::mat4& viewProjection, const glm::vec2& jitterDelta) {
+    m_previousViewProjection = viewProjection;
+    m_jitterDelta = jitterDelta;
+    m_frameUniformsDirty = true;
+}
+
 void Renderer::setWireframe(bool enabled) {
     m_wireframeMode = enabled;
     glPolygonMode(GL_FRONT_AND_BACK, enabled ? GL_LINE : GL_FILL);
@@ -416,53 +636,133 @@ void Renderer::setupRenderState() {
 void Renderer::applyLighting() {
     // Apply directional light
     if (m_directionalLight) {
-        m_directionalLight->applyToShader(*m_shader, "dirLight");
+        m_directionalLight->applyToShader(*m_shader, *m_dirLightNames);
     } else {
-        m_shader->setBool("dirLight.enabled", false);
+        m_shader->setBool(m_dirLightNames->enabled, false);
     }
     
     // Apply point lights
-    m_shader->setInt("numPointLights", static_cast<int>(m_pointLights.size()));
     for (size_t i = 0; i < m_pointLights.size(); i++) {
-        std::string name = "pointLights[" + std::to_string(i) + "]";
-        m_pointLights[i].applyToShader(*m_shader, name);
+        m_pointLights[i].applyToShader(*m_shader, m_pointLightNames[i]);
     }
     
     // Disable unused point lights
     for (size_t i = m_pointLights.size(); i < MAX_POINT_LIGHTS; i++) {
-        std::string name = "pointLights[" + std::to_string(i) + "].enabled";
-        m_shader->setBool(name, false);
+        m_shader->setBool(m_pointLightNames[i].enabled, false);
     }
     
     // Apply spot lights
-    m_shader->setInt("numSpotLights", static_cast<int>(m_spotLights.size()));
     for (size_t i = 0; i < m_spotLights.size(); i++) {
-        std::string name = "spotLights[" + std::to_string(i) + "]";
-        m_spotLights[i].applyToShader(*m_shader, name);
+        m_spotLights[i].applyToShader(*m_shader, m_spotLightNames[i]);
     }
     
     // Disable unused spot lights
     for (size_t i = m_spotLights.size(); i < MAX_SPOT_LIGHTS; i++) {
-        std::string name = "spotLights[" + std::to_string(i) + "].enabled";
-        m_shader->setBool(name, false);
+        m_shader->setBool(m_spotLightNames[i].enabled, false);
     }
+    
+    // Until an item narrows them down, every light applies
+    applyLightLists(0xFF, 0xFF);
 }
 
-void Renderer::sortTransparentCommands() {
-    // Sort back to front (furthest first)
-    std::sort(m_transparentCommands.begin(), m_transparentCommands.end(),
-        [](const RenderCommand& a, const RenderCommand& b) {
-            return a.distanceToCamera > b.distanceToCamera;
-        });
+void Renderer::applyLightLists(uint8_t pointMask, uint8_t spotMask) {
+    glm::ivec4 pointList(0);
+    int pointCount = 0;
+    for (size_t i = 0; i < m_pointLights.size(); i++) {
+        if (pointMask & (1u << i)) {
+            pointList[pointCount++] = static_cast<int>(i);
+        }
+    }
+    
+    glm::ivec2 spotList(0);
+    int spotCount = 0;
+    for (size_t i = 0; i < m_spotLights.size(); i++) {
+        if (spotMask & (1u << i)) {
+            spotList[spotCount++] = static_cast<int>(i);
+        }
+    }
+    
+    m_shader->setInt("numPointLights", pointCount);
+    m_shader->setIVec4("pointLightList", pointList);
+    m_shader->setInt("numSpotLights", spotCount);
+    m_shader->setIVec2("spotLightList", spotList);
 }
 
-void Renderer::executeCommand(const RenderCommand& cmd) {
-    if (cmd.model && cmd.model->isVisible()) {
-        cmd.model->draw(*m_shader, cmd.transform);
-        m_drawCallCount++;
+void Renderer::bindView(size_t viewIndex) {
+    // Slot 0 follows setCamera()/setPreviousCamera() unless setViews() filled it
+    if (viewIndex == 0 && m_frameUniformsDirty) {
+        FrameUniforms uniforms;
+        uniforms.view = m_viewMatrix;
+        uniforms.projection = m_projectionMatrix;
+        uniforms.prevViewProj = m_previousViewProjection;
+        uniforms.viewPos = glm::vec4(m_cameraPosition, 1.0f);
+        uniforms.jitterDelta = glm::vec4(m_jitterDelta.x, m_jitterDelta.y, 0.0f, 0.0f);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_frameUniformBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniforms), &uniforms);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        m_frameUniformsDirty = false;
     }
+    
+    glBindBufferRange(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, m_frameUniformBuffer,
+                      static_cast<GLintptr>(viewIndex * m_frameUniformStride),
+                      sizeof(FrameUniforms));
+}
+
+void Renderer::executeItem(const DrawItem& item) {
+    m_shader->setMat4("model", item.model);
+    m_shader->setMat4("previousModel", item.previousModel);
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(item.model)));
+    m_shader->setMat3("normalMatrix", normalMatrix);
+    
+    item.material.applyToShader(*m_shader);
+    
+    // Only the lights that reach the item; neighbours mostly share them
+    uint16_t lightMasks = static_cast<uint16_t>(item.pointLightMask | (item.spotLightMask << 8));
+    if (lightMasks != m_boundLightMasks) {
+        applyLightLists(item.pointLightMask, item.spotLightMask);
+        m_boundLightMasks = lightMasks;
+    }
+    
+    // Static surfaces mostly have a lightmap each; skip rebinding the same one
+    unsigned int lightMap = item.material.lightMap;
+    if (lightMap != 0 && lightMap != m_boundLightMap) {
+        glActiveTexture(GL_TEXTURE0 + LIGHTMAP_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, lightMap);
+        glActiveTexture(GL_TEXTURE0);
+        m_boundLightMap = lightMap;
+        RenderStats::current().textureChanges++;
+    }
+    
+    item.mesh->draw(*m_shader);
 }
 
 void Renderer::createShaders() {
     m_shader = std::make_unique<Shader>(VERTEX_SHADER_SOURCE, FRAGMENT_SHADER_SOURCE, false);
+    
+    // The sampler units never change, so they are set once
+    m_shader->use();
+    m_shader->setInt("environmentMap", ENVIRONMENT_TEXTURE_UNIT);
+    m_shader->setInt("lightMap", LIGHTMAP_TEXTURE_UNIT);
+    m_shader->setInt("aoMap", OCCLUSION_TEXTURE_UNIT);
+    m_shader->setInt("aoDepth", OCCLUSION_DEPTH_TEXTURE_UNIT);
+    
+    unsigned int frameBlock = glGetUniformBlockIndex(m_shader->getID(), "Frame");
+    if (frameBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_shader->getID(), frameBlock, FRAME_UNIFORM_BINDING);
+    } else {
+        std::cerr << "ERROR: Main shader has no Frame uniform block" << std::endl;
+    }
+    
+    // One slot per view; slot offsets must respect the driver's alignment
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0) {
+        size_t align = static_cast<size_t>(alignment);
+        m_frameUniformStride = (sizeof(FrameUniforms) + align - 1) / align * align;
+    }
+    glGenBuffers(1, &m_frameUniformBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameUniformBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(m_frameUniformStride * FramePacket::MAX_VIEWS),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
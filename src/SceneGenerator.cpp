@@ -0,0 +1,273 @@
+/**
+ * =============================================================================
+ * SceneGenerator.cpp - Procedural Scene Layout Implementation
+ * =============================================================================
+ */
+
+#include "SceneGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+// Parking grid: one slot per car, length along X like the car body
+constexpr float SLOT_LENGTH = 6.0f;         // Car length 4 m + 2 m gap
+constexpr float SLOT_WIDTH = 3.5f;          // Car width 1.8 m + gap
+constexpr float FILL_RATIO = 0.85f;         // Share of slots that get a car
+constexpr float HERO_CLEARANCE = 6.0f;      // Free radius around the hero platform
+constexpr float LOT_HEIGHT = 10.0f;
+constexpr float PILLAR_SIZE = 0.8f;
+
+/**
+ * Largest value each command-line option accepts. Values are checked as
+ * doubles before conversion, since converting an out-of-range double to
+ * an integer (or float) is undefined.
+ */
+struct OptionLimit {
+    const char* name;
+    double maximum;
+};
+
+constexpr OptionLimit OPTION_LIMITS[] = {
+    {"--cars", 1000000.0},
+    {"--detailed", 1.0},
+    {"--lights", 4096.0},
+    {"--pillars", 1000.0},
+    {"--seed", 4294967295.0},    // UINT32_MAX
+};
+
+/**
+ * Random numbers that come out the same on every compiler and standard
+ * library. std::uniform_real_distribution and std::shuffle are allowed to
+ * differ between implementations, which would break seeded comparisons.
+ */
+class LayoutRandom {
+public:
+    explicit LayoutRandom(uint32_t seed) : m_engine(seed) {}
+    
+    // Uniform float in [0, 1)
+    float next() { return static_cast<float>(m_engine() >> 8) * (1.0f / 16777216.0f); }
+    
+    // Uniform float in [lo, hi)
+    float range(float lo, float hi) { return lo + (hi - lo) * next(); }
+    
+    // Uniform integer in [0, n)
+    uint32_t index(uint32_t n) { return static_cast<uint32_t>(m_engine() % n); }
+
+private:
+    std::mt19937 m_engine;
+};
+
+/**
+ * Parse a whole argument as a number, rejecting trailing garbage.
+ */
+bool parseNumber(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0' && std::isfinite(value);
+}
+
+} // anonymous namespace
+
+namespace SceneGenerator {
+
+// =============================================================================
+// Layouts
+// =============================================================================
+
+SceneLayout createLayout(const SceneConfig& config) {
+    return config.isGenerated() ? createLotLayout(config) : createShowroomLayout();
+}
+
+SceneLayout createShowroomLayout() {
+    SceneLayout layout;
+    layout.size = glm::vec3(30.0f, 10.0f, 20.0f);
+    
+    // Placeholder cars around the showroom (paint: see PAINT_COUNT order
+    // in ShowroomScene: red, blue, black, white, silver)
+    layout.cars = {
+        {{-8.0f, 0.0f, -5.0f}, 30.0f, false, 1, 32500},
+        {{8.0f, 0.0f, -5.0f}, -30.0f, false, 3, 41900},
+        {{-8.0f, 0.0f, 5.0f}, -45.0f, false, 4, 27800},
+        {{8.0f, 0.0f, 5.0f}, 45.0f, false, 2, 36400}
+    };
+    
+    // Ceiling lights
+    const glm::vec3 ceilingColor(0.8f, 0.8f, 0.75f);
+    layout.lights = {
+        {{-5.0f, 8.0f, -5.0f}, ceilingColor, 15.0f},
+        {{5.0f, 8.0f, -5.0f}, ceilingColor, 15.0f},
+        {{-5.0f, 8.0f, 5.0f}, ceilingColor, 15.0f},
+        {{5.0f, 8.0f, 5.0f}, ceilingColor, 15.0f}
+    };
+    
+    return layout;
+}
+
+SceneLayout createLotLayout(const SceneConfig& config) {
+    SceneLayout layout;
+    LayoutRandom random(config.seed);
+    
+    // The hero car is created by the scene; everything else goes in slots
+    size_t carsToPlace = config.carCount > 0 ? config.carCount - 1 : 0;
+    
+    // Grow a roughly square grid until enough slots are free
+    auto slotCenter = [](uint32_t col, uint32_t row, uint32_t cols, uint32_t rows) {
+        return glm::vec3((col + 0.5f) * SLOT_LENGTH - cols * SLOT_LENGTH * 0.5f,
+                         0.0f,
+                         (row + 0.5f) * SLOT_WIDTH - rows * SLOT_WIDTH * 0.5f);
+    };
+    auto isReserved = [](const glm::vec3& center) {
+        return center.x * center.x + center.z * center.z < HERO_CLEARANCE * HERO_CLEARANCE;
+    };
+    
+    double neededSlots = static_cast<double>(carsToPlace) / FILL_RATIO;
+    uint32_t cols = std::max(4u, static_cast<uint32_t>(
+        std::ceil(std::sqrt(neededSlots * SLOT_WIDTH / SLOT_LENGTH))));
+    uint32_t rows = 0;
+    std::vector<uint32_t> freeSlots;
+    
+    while (true) {
+        rows = static_cast<uint32_t>(std::ceil(cols * SLOT_LENGTH / SLOT_WIDTH));
+        freeSlots.clear();
+        for (uint32_t row = 0; row < rows; row++) {
+            for (uint32_t col = 0; col < cols; col++) {
+                if (!isReserved(slotCenter(col, row, cols, rows))) {
+                    freeSlots.push_back(row * cols + col);
+                }
+            }
+        }
+        if (freeSlots.size() * FILL_RATIO >= carsToPlace) {
+            break;
+        }
+        cols++;
+    }
+    
+    layout.size = glm::vec3(cols * SLOT_LENGTH, LOT_HEIGHT, rows * SLOT_WIDTH);
+    
+    // Pick random slots (partial Fisher-Yates shuffle), then restore grid
+    // order so neighbouring cars are also neighbours in memory
+    for (size_t i = 0; i < carsToPlace; i++) {
+        size_t j = i + random.index(static_cast<uint32_t>(freeSlots.size() - i));
+        std::swap(freeSlots[i], freeSlots[j]);
+    }
+    freeSlots.resize(carsToPlace);
+    std::sort(freeSlots.begin(), freeSlots.end());
+    
+    layout.cars.reserve(carsToPlace);
+    for (uint32_t slot : freeSlots) {
+        CarPlacement car;
+        car.position = slotCenter(slot % cols, slot / cols, cols, rows);
+        car.position.x += random.range(-0.3f, 0.3f);
+        car.position.z += random.range(-0.2f, 0.2f);
+        
+        // Parked nose-in or nose-out, never perfectly straight
+        car.heading = (random.next() < 0.5f ? 0.0f : 180.0f) + random.range(-8.0f, 8.0f);
+        car.detailed = random.next() < config.detailedFraction;
+        car.paint = random.index(PAINT_COUNT);
+        car.price = 15000 + 100 * random.index(550);   // $15,000 - $69,900
+        layout.cars.push_back(car);
+    }
+    
+    // Lights hang at random spots over the lot
+    layout.lights.reserve(config.lightCount);
+    for (size_t i = 0; i < config.lightCount; i++) {
+        LightPlacement light;
+        light.position = glm::vec3(random.range(-0.5f, 0.5f) * layout.size.x,
+                                   random.range(7.0f, 9.0f),
+                                   random.range(-0.5f, 0.5f) * layout.size.z);
+        float warmth = random.next();
+        light.color = glm::vec3(0.8f, 0.75f + 0.05f * warmth, 0.7f + 0.1f * (1.0f - warmth));
+        light.range = random.range(20.0f, 35.0f);
+        layout.lights.push_back(light);
+    }
+    
+    // Pillars sit on slot corners, where they never overlap a parked car
+    if (config.pillarSpacing > 0.0f) {
+        uint32_t stepX = std::max(1u, static_cast<uint32_t>(std::lround(config.pillarSpacing / SLOT_LENGTH)));
+        uint32_t stepZ = std::max(1u, static_cast<uint32_t>(std::lround(config.pillarSpacing / SLOT_WIDTH)));
+        glm::vec3 half(PILLAR_SIZE * 0.5f, 0.0f, PILLAR_SIZE * 0.5f);
+        
+        for (uint32_t row = stepZ; row < rows; row += stepZ) {
+            for (uint32_t col = stepX; col < cols; col += stepX) {
+                glm::vec3 corner(col * SLOT_LENGTH - layout.size.x * 0.5f, 0.0f,
+                                 row * SLOT_WIDTH - layout.size.z * 0.5f);
+                if (isReserved(corner)) {
+                    continue;
+                }
+                layout.pillars.push_back(AABB(corner - half,
+                                              corner + half + glm::vec3(0.0f, LOT_HEIGHT, 0.0f)));
+            }
+        }
+    }
+    
+    return layout;
+}
+
+// =============================================================================
+// Command Line
+// =============================================================================
+
+CommandLineResult parseCommandLine(int argc, char* argv[], SceneConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        const char* option = argv[i];
+        
+        if (std::strcmp(option, "--help") == 0 || std::strcmp(option, "-h") == 0) {
+            printUsage(argv[0]);
+            return CommandLineResult::EXIT_OK;
+        }
+        
+        const OptionLimit* limit = std::find_if(std::begin(OPTION_LIMITS), std::end(OPTION_LIMITS),
+            [option](const OptionLimit& entry) { return std::strcmp(option, entry.name) == 0; });
+        if (limit == std::end(OPTION_LIMITS)) {
+            std::cerr << "ERROR: Unknown option " << option << std::endl;
+            printUsage(argv[0]);
+            return CommandLineResult::EXIT_ERROR;
+        }
+        
+        if (i + 1 >= argc) {
+            std::cerr << "ERROR: Missing value for option " << option << std::endl;
+            printUsage(argv[0]);
+            return CommandLineResult::EXIT_ERROR;
+        }
+        
+        double value = 0.0;
+        if (!parseNumber(argv[i + 1], value) || value < 0.0 || value > limit->maximum) {
+            std::cerr << "ERROR: Invalid value for " << option << ": " << argv[i + 1]
+                      << " (0 to " << static_cast<unsigned long long>(limit->maximum) << ")" << std::endl;
+            return CommandLineResult::EXIT_ERROR;
+        }
+        i++;
+        
+        if (std::strcmp(option, "--cars") == 0) {
+            config.carCount = static_cast<size_t>(value);
+        } else if (std::strcmp(option, "--detailed") == 0) {
+            config.detailedFraction = static_cast<float>(value);
+        } else if (std::strcmp(option, "--lights") == 0) {
+            config.lightCount = static_cast<size_t>(value);
+        } else if (std::strcmp(option, "--pillars") == 0) {
+            config.pillarSpacing = static_cast<float>(value);
+        } else {
+            config.seed = static_cast<uint32_t>(value);
+        }
+    }
+    return CommandLineResult::RUN;
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n"
+              << "  --cars N        Generate a car lot with N cars (0 = standard showroom)\n"
+              << "  --detailed F    Share of detailed car models, 0..1 (default 0.1)\n"
+              << "  --lights M      Point lights in the lot (default 16)\n"
+              << "  --pillars S     Pillar spacing in meters, 0 = none (default 24)\n"
+              << "  --seed S        Random seed (default 1)\n"
+              << "  --help          Show this message" << std::endl;
+}
+
+} // namespace SceneGenerator
@@ -5,6 +5,8 @@
  */
 
 #include "Shader.h"
+#include "AllocationTracker.h"
+#include "RenderStats.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
@@ -12,6 +14,13 @@
 #include <sstream>
 #include <iostream>
 
+namespace {
+
+// Program bound by Shader::use() on this thread (0 = unknown or none)
+thread_local unsigned int t_boundProgram = 0;
+
+} // anonymous namespace
+
 // =============================================================================
 // Constructors / Destructor
 // =============================================================================
@@ -21,6 +30,8 @@ Shader::Shader() : m_programID(0) {}
 Shader::Shader(const std::string& vertexSource, const std::string& fragmentSource, bool fromFile)
     : m_programID(0)
 {
+    ALLOCATION_ZONE(AllocSubsystem::SHADER);
+    
     std::string vertCode, fragCode;
     
     if (fromFile) {
@@ -56,23 +67,35 @@ Shader::Shader(const std::string& vertexSource, const std::string& fragmentSourc
 
 Shader::~Shader() {
     if (m_programID != 0) {
+        if (m_programID == t_boundProgram) {
+            t_boundProgram = 0;
+        }
         glDeleteProgram(m_programID);
     }
 }
 
 // Move constructor
-Shader::Shader(Shader&& other) noexcept : m_programID(other.m_programID) {
+Shader::Shader(Shader&& other) noexcept
+    : m_programID(other.m_programID)
+    , m_uniformLocations(std::move(other.m_uniformLocations))
+{
     other.m_programID = 0;
+    other.m_uniformLocations.clear();
 }
 
 // Move assignment
 Shader& Shader::operator=(Shader&& other) noexcept {
     if (this != &other) {
         if (m_programID != 0) {
+            if (m_programID == t_boundProgram) {
+                t_boundProgram = 0;
+            }
             glDeleteProgram(m_programID);
         }
         m_programID = other.m_programID;
+        m_uniformLocations = std::move(other.m_uniformLocations);
         other.m_programID = 0;
+        other.m_uniformLocations.clear();
     }
     return *this;
 }
@@ -82,7 +105,14 @@ Shader& Shader::operator=(Shader&& other) noexcept {
 // =============================================================================
 
 void Shader::use() const {
+    // Skip binding the program that is already bound. One context per
+    // thread, so the thread's last program is the context's.
+    if (m_programID == t_boundProgram) {
+        return;
+    }
     glUseProgram(m_programID);
+    t_boundProgram = m_programID;
+    RenderStats::current().programChanges++;
 }
 
 // =============================================================================
@@ -97,6 +127,10 @@ void Shader::setInt(const std::string& name, int value) const {
     glUniform1i(getUniformLocation(name), value);
 }
 
+void Shader::setUInt(const std::string& name, unsigned int value) const {
+    glUniform1ui(getUniformLocation(name), value);
+}
+
 void Shader::setFloat(const std::string& name, float value) const {
     glUniform1f(getUniformLocation(name), value);
 }
@@ -125,6 +159,14 @@ void Shader::setVec4(const std::string& name, float x, float y, float z, float w
     glUniform4f(getUniformLocation(name), x, y, z, w);
 }
 
+void Shader::setIVec2(const std::string& name, const glm::ivec2& value) const {
+    glUniform2i(getUniformLocation(name), value.x, value.y);
+}
+
+void Shader::setIVec4(const std::string& name, const glm::ivec4& value) const {
+    glUniform4i(getUniformLocation(name), value.x, value.y, value.z, value.w);
+}
+
 void Shader::setMat3(const std::string& name, const glm::mat3& value) const {
     glUniformMatrix3fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
@@ -192,7 +234,18 @@ unsigned int Shader::linkProgram(unsigned int vertexShader, unsigned int fragmen
 }
 
 int Shader::getUniformLocation(const std::string& name) const {
-    // In a production implementation, this would cache uniform locations
-    // in a std::unordered_map to avoid repeated lookups
-    return glGetUniformLocation(m_programID, name.c_str());
+    ALLOCATION_ZONE(AllocSubsystem::SHADER);
+    
+    // Every setter looks up its location once, so uniform uploads are
+    // counted here
+    RenderStats::current().uniformChanges++;
+    
+    auto it = m_uniformLocations.find(name);
+    if (it != m_uniformLocations.end()) {
+        return it->second;
+    }
+    
+    int location = glGetUniformLocation(m_programID, name.c_str());
+    m_uniformLocations.emplace(name, location);
+    return location;
 }
@@ -8,31 +8,102 @@
 #include "Model.h"
 #include "CarModel.h"
 #include "Mesh.h"
+#include "MeshBVH.h"
 #include "Shader.h"
-#include "Renderer.h"
 #include "Material.h"
+#include "FramePacket.h"
+#include "GpuDeletionQueue.h"
+#include "LightmapBaker.h"
+#include "AssetLoader.h"
+#include "AllocationTracker.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+
+namespace {
+
+/**
+ * Write a price with thousands separators, e.g. "$48,900".
+ */
+void formatPrice(uint32_t dollars, char* buffer, size_t size) {
+    unsigned int millions = dollars / 1000000;
+    unsigned int thousands = dollars / 1000 % 1000;
+    unsigned int ones = dollars % 1000;
+    if (millions > 0) {
+        std::snprintf(buffer, size, "$%u,%03u,%03u", millions, thousands, ones);
+    } else if (thousands > 0) {
+        std::snprintf(buffer, size, "$%u,%03u", thousands, ones);
+    } else {
+        std::snprintf(buffer, size, "$%u", ones);
+    }
+}
+
+// Fixed shapes, built at compile time and uploaded straight from these tables
+constexpr auto PLATFORM_MESH = StaticMesh::makeCylinder<48>(3.0f, 0.2f);
+constexpr auto PILLAR_MESH = StaticMesh::makeCube(1.0f);    // Unit cube, scaled per pillar
+
+// Reflection probe above the platform, about where the car body's sides are
+constexpr float PROBE_HEIGHT = 1.0f;
+
+// Baked environment lighting, reused while the room and lights are unchanged
+const char* const LIGHTMAP_CACHE_PATH = "lightmaps.cache";
+
+} // anonymous namespace
+
+/**
+ * SceneGeometry - Startup meshes, filled in by generateGeometry().
+ */
+struct ShowroomScene::SceneGeometry {
+    MeshData floor;
+    MeshData ceiling;
+    MeshData wall;                      // Back and front walls
+    MeshData sideWall;                  // Left and right walls
+    CarGeometry mainCar;
+    std::vector<CarGeometry> backgroundCars;    // One per placement, or none
+};
 
 // =============================================================================
 // Constructor / Destructor
 // =============================================================================
 
-ShowroomScene::ShowroomScene()
-    : m_showroomSize(30.0f, 10.0f, 20.0f)
-{
-    createEnvironment();
-    createMainCar();
-    createBackgroundCars();
-    setupLighting();
+ShowroomScene::ShowroomScene(const SceneConfig& config, AssetLoader* loader) {
+    SceneLayout layout = SceneGenerator::createLayout(config);
+    m_showroomSize = layout.size;
+    m_pillars = std::move(layout.pillars);
+    
+    // Generate on all cores, then upload here in one pass: GL calls stay
+    // on this thread, the arithmetic doesn't
+    SceneGeometry geometry = generateGeometry(layout.cars, loader == nullptr);
+    setupLighting(layout.lights);       // The environment's lightmaps are baked from these
+    createEnvironment(geometry);
+    createMainCar(std::move(geometry.mainCar));
+    if (loader) {
+        streamBackgroundCars(layout.cars, *loader);
+    } else {
+        createBackgroundCars(layout.cars, std::move(geometry.backgroundCars));
+    }
+    buildCarBVHs();
     setupCollision();
 }
 
-ShowroomScene::~ShowroomScene() = default;
+ShowroomScene::~ShowroomScene() {
+    for (unsigned int texture : m_environmentLightmaps) {
+        GpuDeletionQueue::deleteTexture(texture);
+    }
+}
 
 // =============================================================================
 // Update
 // =============================================================================
 
 void ShowroomScene::update(float deltaTime) {
+    ALLOCATION_ZONE(AllocSubsystem::ANIMATION);
+    
     // Update main car animations
     if (m_mainCar) {
         m_mainCar->update(deltaTime);
@@ -44,27 +115,53 @@ void ShowroomScene::update(float deltaTime) {
     }
 }
 
-// =============================================================================
-// Rendering
-// =============================================================================
+void ShowroomScene::storePreviousTransforms() {
+    // Only cars move; the environment stays on its cached matrix
+    if (m_mainCar) {
+        m_mainCar->storePreviousTransform();
+    }
+    for (auto& car : m_backgroundCars) {
+        car->storePreviousTransform();
+    }
+}
 
-void ShowroomScene::render(Renderer& renderer) const {
-    // Submit environment
-    for (const auto& env : m_environment) {
-        renderer.submit(*env);
+void ShowroomScene::setRenderAlpha(float alpha) {
+    if (m_mainCar) {
+        m_mainCar->setRenderAlpha(alpha);
+    }
+    for (auto& car : m_backgroundCars) {
+        car->setRenderAlpha(alpha);
     }
+}
+
+size_t ShowroomScene::updateStreaming() {
+    size_t added = 0;
     
-    // Submit main car
-    if (m_mainCar) {
-        renderer.submit(*m_mainCar);
+    // Strictly in order: a car that finished early waits for those before it
+    while (m_nextPendingCar < m_pendingCars.size() &&
+           AssetLoader::isReady(m_pendingCars[m_nextPendingCar])) {
+        try {
+            std::unique_ptr<CarModel> car = m_pendingCars[m_nextPendingCar].get();
+            addDynamicCar(car.get());
+            m_backgroundCars.push_back(std::move(car));
+            added++;
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR: Failed to load background car: " << e.what() << std::endl;
+        }
+        m_nextPendingCar++;
     }
     
-    // Submit background cars
-    for (const auto& car : m_backgroundCars) {
-        renderer.submit(*car);
+    if (m_nextPendingCar == m_pendingCars.size()) {
+        m_pendingCars.clear();
+        m_nextPendingCar = 0;
     }
+    return added;
 }
 
+// =============================================================================
+// Rendering
+// =============================================================================
+
 void ShowroomScene::draw(Shader& shader) const {
     // Draw environment (opaque)
     for (const auto& env : m_environment) {
@@ -91,6 +188,107 @@ void ShowroomScene::draw(Shader& shader) const {
     }
 }
 
+void ShowroomScene::drawIds(Shader& idShader) const {
+    for (const auto& env : m_environment) {
+        env->drawIds(idShader, 0);
+    }
+    
+    if (m_mainCar) {
+        m_mainCar->drawIds(idShader, 1);
+    }
+    
+    for (size_t i = 0; i < m_backgroundCars.size(); i++) {
+        m_backgroundCars[i]->drawIds(idShader, static_cast<uint32_t>(i + 2));
+    }
+}
+
+void ShowroomScene::collectDrawItems(FramePacket& packet) const {
+    const glm::vec3& eye = packet.cameraPosition;
+    
+    // Count what each model contributes for the culling statistics
+    auto collect = [&](const Model& model, uint32_t objectId) {
+        packet.objectsTotal++;
+        if (!model.collectDrawItems(packet.opaqueItems, packet.transparentItems, objectId, eye)) {
+            packet.objectsHidden++;
+        }
+    };
+    
+    for (const auto& env : m_environment) {
+        collect(*env, 0);
+    }
+    
+    if (m_mainCar) {
+        collect(*m_mainCar, 1);
+    }
+    
+    for (size_t i = 0; i < m_backgroundCars.size(); i++) {
+        collect(*m_backgroundCars[i], static_cast<uint32_t>(i + 2));
+    }
+    
+    // Back to front (furthest first)
+    std::sort(packet.transparentItems.begin(), packet.transparentItems.end(),
+        [](const DrawItem& a, const DrawItem& b) {
+            return a.sortDepth > b.sortDepth;
+        });
+}
+
+void ShowroomScene::collectPriceTags(FramePacket& packet) const {
+    auto addTag = [&](const CarModel& car, const glm::vec4& color) {
+        if (!car.isVisible() || car.getPrice() == 0) {
+            return;
+        }
+        TextLabel label;
+        label.position = car.getLabelPosition();
+        label.color = color;
+        formatPrice(car.getPrice(), label.text, sizeof(label.text));
+        packet.labels.push_back(label);
+    };
+    
+    // The featured car's tag stands out in gold
+    if (m_mainCar) {
+        addTag(*m_mainCar, glm::vec4(1.0f, 0.85f, 0.3f, 1.0f));
+    }
+    for (const auto& car : m_backgroundCars) {
+        addTag(*car, glm::vec4(1.0f));
+    }
+}
+
+CarModel* ShowroomScene::getCarByPickId(uint32_t objectId) {
+    if (objectId == 1) {
+        return m_mainCar.get();
+    }
+    if (objectId >= 2 && objectId - 2 < m_backgroundCars.size()) {
+        return m_backgroundCars[objectId - 2].get();
+    }
+    return nullptr;
+}
+
+CarModel* ShowroomScene::raycastCars(const Ray& ray, float maxDistance, TriangleHit& hit) const {
+    CarModel* closestCar = nullptr;
+    float closest = maxDistance;
+    hit.hit = false;
+    
+    auto testCar = [&](CarModel* car) {
+        // No bounding box pre-test: wheels stick out of the body box, and
+        // each mesh BVH rejects a missing ray at its root node anyway
+        TriangleHit carHit;
+        if (car->raycast(ray, closest, carHit)) {
+            closest = carHit.distance;
+            hit = carHit;
+            closestCar = car;
+        }
+    };
+    
+    if (m_mainCar) {
+        testCar(m_mainCar.get());
+    }
+    for (const auto& car : m_backgroundCars) {
+        testCar(car.get());
+    }
+    
+    return closestCar;
+}
+
 // =============================================================================
 // Lighting
 // =============================================================================
@@ -112,9 +310,27 @@ void ShowroomScene::applyLighting(Shader& shader) const {
         std::string name = "spotLights[" + std::to_string(i) + "]";
         m_spotLights[i].applyToShader(shader, name);
     }
+    
+    // Every light applies to everything drawn with this setup
+    shader.setIVec4("pointLightList", glm::ivec4(0, 1, 2, 3));
+    shader.setIVec2("spotLightList", glm::ivec2(0, 1));
+}
+
+void ShowroomScene::collectLights(FramePacket& packet) const {
+    packet.sunLight = m_sunLight;
+    packet.pointLights.assign(m_pointLights.begin(), m_pointLights.end());
+    packet.spotLights.assign(m_spotLights.begin(), m_spotLights.end());
+}
+
+void ShowroomScene::collectReflectionProbe(FramePacket& packet) const {
+    packet.probePosition = getShowroomCenter() + glm::vec3(0.0f, PROBE_HEIGHT, 0.0f);
+    packet.staticVersion = m_staticVersion;
 }
 
 void ShowroomScene::setLightsEnabled(bool enabled) {
+    // The reflection probe saw the old lighting
+    m_staticVersion++;
+    
     m_sunLight.enabled = enabled;
     for (auto& light : m_pointLights) {
         light.enabled = enabled;
@@ -122,6 +338,15 @@ void ShowroomScene::setLightsEnabled(bool enabled) {
     for (auto& light : m_spotLights) {
         light.enabled = enabled;
     }
+    
+    // The lightmaps hold the lights-on result; with them off, the
+    // environment goes back to the (now dark) dynamic lighting
+    for (size_t i = 0; i < m_environment.size(); i++) {
+        Material* material = m_environment[i]->getMeshMaterial(0);
+        if (material) {
+            material->lightMap = enabled ? m_environmentLightmaps[i] : 0;
+        }
+    }
 }
 
 // =============================================================================
@@ -146,27 +371,150 @@ glm::vec3 ShowroomScene::constrainPosition(const glm::vec3& position,
     return m_collisionWorld.resolveCollisions(testBox, position);
 }
 
+glm::vec3 ShowroomScene::constrainPosition(const glm::vec3& position, 
+                                            const OBB& box) const {
+    return m_collisionWorld.resolveCollisions(box, position);
+}
+
+void ShowroomScene::resolveCarCollisions() {
+    // Refresh broadphase bounds from the cars' current positions
+    for (size_t proxy = 0; proxy < m_dynamicCars.size(); proxy++) {
+        if (m_dynamicCars[proxy]) {
+            m_collisionWorld.updateDynamicAABB(proxy, getCarBounds(*m_dynamicCars[proxy]));
+        }
+    }
+    
+    // Narrowphase on the candidate pairs only. The broadphase boxes are
+    // loose for turned cars, so the oriented test decides the real contact.
+    for (const BroadPhasePair& pair : m_collisionWorld.findDynamicPairs()) {
+        CarModel* carA = m_dynamicCars[pair.a];
+        CarModel* carB = m_dynamicCars[pair.b];
+        
+        CollisionResult result = Collision::testOBBvsOBBResponse(
+            carA->getOrientedBoundingBox(), carB->getOrientedBoundingBox());
+        if (!result.hit) {
+            continue;
+        }
+        
+        // Push each car out by half the penetration, staying on the floor
+        glm::vec3 push = result.normal * (result.penetration * 0.5f + 0.001f);
+        push.y = 0.0f;
+        
+        carA->setPosition(carA->getPosition() + push);
+        carB->setPosition(carB->getPosition() - push);
+        
+        // Don't let the push shove either car through a wall
+        carA->setPosition(m_collisionWorld.resolveCollisions(
+            carA->getOrientedBoundingBox(), carA->getPosition()));
+        carB->setPosition(m_collisionWorld.resolveCollisions(
+            carB->getOrientedBoundingBox(), carB->getPosition()));
+    }
+}
+
+void ShowroomScene::updateSpatialGrid() {
+    m_gridCars.clear();
+    m_gridPositions.clear();
+    m_gridRadii.clear();
+    
+    for (CarModel* car : m_dynamicCars) {
+        if (!car) {
+            continue;
+        }
+        // Radius of the footprint circle, whatever way the car is turned
+        glm::vec3 halfExtents = car->getOrientedBoundingBox().halfExtents;
+        m_gridCars.push_back(car);
+        m_gridPositions.push_back(car->getPosition());
+        m_gridRadii.push_back(std::sqrt(halfExtents.x * halfExtents.x +
+                                        halfExtents.z * halfExtents.z));
+    }
+    
+    m_carGrid.rebuild(m_gridPositions.data(), m_gridRadii.data(), m_gridPositions.size());
+}
+
+CarModel* ShowroomScene::findNearestCar(const glm::vec3& point, float maxDistance) const {
+    int32_t id = m_carGrid.findNearest(point, maxDistance);
+    return (id >= 0) ? m_gridCars[id] : nullptr;
+}
+
+void ShowroomScene::findCarsInRadius(const glm::vec3& center, float radius,
+                                     std::vector<CarModel*>& outCars) const {
+    outCars.clear();
+    
+    std::vector<uint32_t> ids;
+    m_carGrid.queryRadius(center, radius, ids);
+    for (uint32_t id : ids) {
+        outCars.push_back(m_gridCars[id]);
+    }
+}
+
+// =============================================================================
+// Private: Generate Geometry
+// =============================================================================
+
+ShowroomScene::SceneGeometry ShowroomScene::generateGeometry(
+    const std::vector<CarPlacement>& placements, bool withBackgroundCars) const {
+    SceneGeometry geometry;
+    if (withBackgroundCars) {
+        geometry.backgroundCars.resize(placements.size());
+    }
+    
+    // Task 0 is the environment, task 1 the main car, the rest one
+    // background car each. Every task writes only its own fields.
+    constexpr size_t FIRST_CAR_TASK = 2;
+    const glm::vec3 size = m_showroomSize;
+    ThreadPool::getShared().parallelFor(FIRST_CAR_TASK + geometry.backgroundCars.size(), 1,
+        [&](size_t begin, size_t end) {
+            for (size_t task = begin; task < end; task++) {
+                if (task == 0) {
+                    // Floor tiles keep the standard showroom's 6 x 4 m size at any room size
+                    geometry.floor = MeshGenerator::generatePlane(size.x, size.z,
+                                                                  size.x / 6.0f, size.z / 4.0f);
+                    geometry.ceiling = MeshGenerator::generatePlane(size.x, size.z, 3.0f, 3.0f);
+                    geometry.wall = MeshGenerator::generatePlane(size.x, size.y, 2.0f, 1.0f);
+                    geometry.sideWall = MeshGenerator::generatePlane(size.z, size.y, 2.0f, 1.0f);
+                } else if (task == 1) {
+                    geometry.mainCar = CarModel::generateGeometry(false);
+                } else {
+                    size_t car = task - FIRST_CAR_TASK;
+                    geometry.backgroundCars[car] =
+                        CarModel::generateGeometry(!placements[car].detailed);
+                }
+            }
+        });
+    return geometry;
+}
+
 // =============================================================================
 // Private: Create Environment
 // =============================================================================
 
-void ShowroomScene::createEnvironment() {
+void ShowroomScene::createEnvironment(SceneGeometry& geometry) {
+    // The environment is never raycast or edited, so its geometry lives
+    // only on the GPU
+    const MeshRetention retention = MeshRetention::DROP;
+    
+    // Models are placed first and their meshes uploaded last: baking
+    // needs the world transforms and gives every mesh lightmap UVs.
+    // Each surface has its own lightmap, so shapes used several times
+    // (walls, pillars) are copied, not shared.
+    std::vector<MeshData> meshes;
+    std::vector<Material> materials;
+    auto addSurface = [&](std::unique_ptr<Model> model, MeshData&& data, const Material& material) {
+        m_environment.push_back(std::move(model));
+        meshes.push_back(std::move(data));
+        materials.push_back(material);
+    };
+    
     // Floor
     auto floor = std::make_unique<Model>("Floor");
-    floor->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createPlane(m_showroomSize.x, m_showroomSize.z, 5.0f, 5.0f)),
-        Material::Tile());
     floor->setPosition(glm::vec3(0.0f, 0.0f, 0.0f));
-    m_environment.push_back(std::move(floor));
+    addSurface(std::move(floor), std::move(geometry.floor), Material::Tile());
     
     // Ceiling
     auto ceiling = std::make_unique<Model>("Ceiling");
-    ceiling->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createPlane(m_showroomSize.x, m_showroomSize.z, 3.0f, 3.0f)),
-        Material::Concrete());
     ceiling->setPosition(glm::vec3(0.0f, m_showroomSize.y, 0.0f));
     ceiling->setRotation(glm::vec3(180.0f, 0.0f, 0.0f));  // Flip upside down
-    m_environment.push_back(std::move(ceiling));
+    addSurface(std::move(ceiling), std::move(geometry.ceiling), Material::Concrete());
     
     // Walls
     float wallHeight = m_showroomSize.y;
@@ -175,87 +523,157 @@ void ShowroomScene::createEnvironment() {
     
     // Back wall
     auto backWall = std::make_unique<Model>("BackWall");
-    backWall->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createPlane(m_showroomSize.x, wallHeight, 2.0f, 1.0f)),
-        Material::Concrete());
     backWall->setPosition(glm::vec3(0.0f, wallHeight / 2.0f, -halfDepth));
     backWall->setRotation(glm::vec3(-90.0f, 0.0f, 0.0f));
-    m_environment.push_back(std::move(backWall));
+    addSurface(std::move(backWall), MeshData(geometry.wall), Material::Concrete());
     
     // Front wall (with opening simulation)
     auto frontWall = std::make_unique<Model>("FrontWall");
-    frontWall->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createPlane(m_showroomSize.x, wallHeight, 2.0f, 1.0f)),
-        Material::Concrete());
     frontWall->setPosition(glm::vec3(0.0f, wallHeight / 2.0f, halfDepth));
     frontWall->setRotation(glm::vec3(90.0f, 0.0f, 0.0f));
-    m_environment.push_back(std::move(frontWall));
+    addSurface(std::move(frontWall), std::move(geometry.wall), Material::Concrete());
     
     // Left wall
     auto leftWall = std::make_unique<Model>("LeftWall");
-    leftWall->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createPlane(m_showroomSize.z, wallHeight, 2.0f, 1.0f)),
-        Material::Concrete());
     leftWall->setPosition(glm::vec3(-halfWidth, wallHeight / 2.0f, 0.0f));
     leftWall->setRotation(glm::vec3(-90.0f, 0.0f, 90.0f));
-    m_environment.push_back(std::move(leftWall));
+    addSurface(std::move(leftWall), MeshData(geometry.sideWall), Material::Concrete());
     
     // Right wall
     auto rightWall = std::make_unique<Model>("RightWall");
-    rightWall->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createPlane(m_showroomSize.z, wallHeight, 2.0f, 1.0f)),
-        Material::Concrete());
     rightWall->setPosition(glm::vec3(halfWidth, wallHeight / 2.0f, 0.0f));
     rightWall->setRotation(glm::vec3(-90.0f, 0.0f, -90.0f));
-    m_environment.push_back(std::move(rightWall));
+    addSurface(std::move(rightWall), std::move(geometry.sideWall), Material::Concrete());
     
     // Display platform for main car
     auto platform = std::make_unique<Model>("Platform");
-    platform->addMesh(std::make_unique<Mesh>(
-        MeshGenerator::createCylinder(3.0f, 0.2f, 48)),
-        Material::Metal());
     platform->setPosition(glm::vec3(0.0f, 0.1f, 0.0f));
-    m_environment.push_back(std::move(platform));
+    addSurface(std::move(platform), MeshGenerator::copyTable(PLATFORM_MESH), Material::Metal());
+    
+    // Pillars (generated lots only): the unit cube, scaled per pillar
+    for (size_t i = 0; i < m_pillars.size(); i++) {
+        const AABB& box = m_pillars[i];
+        auto pillar = std::make_unique<Model>("Pillar " + std::to_string(i + 1));
+        pillar->setPosition(box.getCenter());
+        pillar->setScale(box.getSize());
+        addSurface(std::move(pillar), MeshGenerator::copyTable(PILLAR_MESH), Material::Concrete());
+    }
+    
+    bakeLightmaps(meshes, materials);
+    
+    for (size_t i = 0; i < m_environment.size(); i++) {
+        m_environment[i]->addMesh(std::make_unique<Mesh>(std::move(meshes[i]), retention),
+                                  materials[i]);
+    }
+}
+
+void ShowroomScene::bakeLightmaps(std::vector<MeshData>& meshes, std::vector<Material>& materials) {
+    LightmapBaker baker;
+    for (size_t i = 0; i < meshes.size(); i++) {
+        baker.addSurface(meshes[i], m_environment[i]->getModelMatrix(), materials[i]);
+    }
+    baker.setLights(m_sunLight, m_pointLights, m_spotLights);
+    
+    // Same room and lights as last run: nothing to bake
+    if (!baker.loadCache(LIGHTMAP_CACHE_PATH)) {
+        auto start = std::chrono::steady_clock::now();
+        baker.bake();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Baked " << baker.getTexelCount() << " lightmap texels in "
+                  << static_cast<int>(elapsed.count()) << " ms" << std::endl;
+        
+        if (!baker.saveCache(LIGHTMAP_CACHE_PATH)) {
+            std::cerr << "ERROR: Failed to write lightmap cache: " << LIGHTMAP_CACHE_PATH << std::endl;
+        }
+    }
+    
+    m_environmentLightmaps.reserve(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
+        unsigned int texture = baker.createTexture(i);
+        materials[i].lightMap = texture;
+        m_environmentLightmaps.push_back(texture);
+    }
 }
 
 // =============================================================================
 // Private: Create Cars
 // =============================================================================
 
-void ShowroomScene::createMainCar() {
-    m_mainCar = std::make_unique<CarModel>();
+void ShowroomScene::createMainCar(CarGeometry&& geometry) {
+    m_mainCar = std::make_unique<CarModel>(std::move(geometry));
     m_mainCar->setPosition(glm::vec3(0.0f, 0.2f, 0.0f));  // On platform
+    m_mainCar->setPrice(48900);
 }
 
-void ShowroomScene::createBackgroundCars() {
-    // Create some placeholder cars around the showroom
-    struct CarPlacement {
-        glm::vec3 position;
-        float rotation;
-        Material paint;
-    };
+void ShowroomScene::createBackgroundCars(const std::vector<CarPlacement>& placements,
+                                         std::vector<CarGeometry>&& geometry) {
+    m_backgroundCars.reserve(placements.size());
+    for (size_t i = 0; i < placements.size(); i++) {
+        m_backgroundCars.push_back(createBackgroundCar(placements[i], i + 1,
+                                                       std::move(geometry[i])));
+    }
+}
+
+void ShowroomScene::streamBackgroundCars(const std::vector<CarPlacement>& placements,
+                                         AssetLoader& loader) {
+    m_backgroundCars.reserve(placements.size());
+    m_pendingCars.reserve(placements.size());
+    for (size_t i = 0; i < placements.size(); i++) {
+        CarPlacement placement = placements[i];
+        m_pendingCars.push_back(loader.load([placement, i] {
+            auto car = createBackgroundCar(placement, i + 1,
+                                           CarModel::generateGeometry(!placement.detailed));
+            car->buildBVHs();
+            return car;
+        }));
+    }
+}
+
+void ShowroomScene::buildCarBVHs() {
+    // Exact raycasts against the bodies. Cars share nothing, so each task
+    // builds one car's BVHs.
+    std::vector<CarModel*> cars;
+    cars.reserve(m_backgroundCars.size() + 1);
+    if (m_mainCar) {
+        cars.push_back(m_mainCar.get());
+    }
+    for (auto& car : m_backgroundCars) {
+        cars.push_back(car.get());
+    }
     
-    std::vector<CarPlacement> placements = {
-        {{-8.0f, 0.0f, -5.0f}, 30.0f, Material::CarPaintBlue()},
-        {{8.0f, 0.0f, -5.0f}, -30.0f, Material::CarPaintWhite()},
-        {{-8.0f, 0.0f, 5.0f}, -45.0f, Material::CarPaintSilver()},
-        {{8.0f, 0.0f, 5.0f}, 45.0f, Material::CarPaintBlack()}
+    ThreadPool::getShared().parallelFor(cars.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            cars[i]->buildBVHs();
+        }
+    });
+}
+
+std::unique_ptr<CarModel> ShowroomScene::createBackgroundCar(const CarPlacement& placement,
+                                                             size_t number,
+                                                             CarGeometry&& geometry) {
+    // Paint presets, indexed by CarPlacement::paint
+    const Material paints[SceneGenerator::PAINT_COUNT] = {
+        Material::CarPaintRed(),
+        Material::CarPaintBlue(),
+        Material::CarPaintBlack(),
+        Material::CarPaintWhite(),
+        Material::CarPaintSilver()
     };
     
-    for (const auto& placement : placements) {
-        auto car = std::make_unique<CarModel>(true);  // Simplified version
-        car->setPosition(placement.position);
-        car->setRotation(glm::vec3(0.0f, placement.rotation, 0.0f));
-        car->setMaterial(placement.paint);
-        m_backgroundCars.push_back(std::move(car));
-    }
+    auto car = std::make_unique<CarModel>(std::move(geometry));
+    car->setName("Car " + std::to_string(number));
+    car->setPosition(placement.position);
+    car->setRotation(glm::vec3(0.0f, placement.heading, 0.0f));
+    car->setMaterial(paints[placement.paint % SceneGenerator::PAINT_COUNT]);
+    car->setPrice(placement.price);
+    return car;
 }
 
 // =============================================================================
 // Private: Setup Lighting
 // =============================================================================
 
-void ShowroomScene::setupLighting() {
+void ShowroomScene::setupLighting(const std::vector<LightPlacement>& lights) {
     // Main directional light (simulated skylight)
     m_sunLight = DirectionalLight(
         glm::vec3(-0.3f, -1.0f, -0.2f),  // Direction
@@ -265,21 +683,14 @@ void ShowroomScene::setupLighting() {
     );
     
     // Ceiling lights (point lights)
-    std::vector<glm::vec3> lightPositions = {
-        {-5.0f, 8.0f, -5.0f},
-        {5.0f, 8.0f, -5.0f},
-        {-5.0f, 8.0f, 5.0f},
-        {5.0f, 8.0f, 5.0f}
-    };
-    
-    for (const auto& pos : lightPositions) {
+    for (const auto& placement : lights) {
         PointLight light(
-            pos,
+            placement.position,
             glm::vec3(0.1f),              // Ambient
-            glm::vec3(0.8f, 0.8f, 0.75f), // Diffuse
+            placement.color,              // Diffuse
             glm::vec3(1.0f)               // Specular
         );
-        light.setRange(15.0f);
+        light.setRange(placement.range);
         m_pointLights.push_back(light);
     }
     
@@ -301,6 +712,14 @@ void ShowroomScene::setupLighting() {
 // =============================================================================
 
 void ShowroomScene::setupCollision() {
+    // Cars are moving bodies handled by the broadphase
+    if (m_mainCar) {
+        addDynamicCar(m_mainCar.get());
+    }
+    for (auto& car : m_backgroundCars) {
+        addDynamicCar(car.get());
+    }
+    
     float halfWidth = m_showroomSize.x / 2.0f;
     float halfDepth = m_showroomSize.z / 2.0f;
     float wallThickness = 0.5f;
@@ -328,4 +747,26 @@ void ShowroomScene::setupCollision() {
         glm::vec3(halfWidth, 0.0f, -halfDepth),
         glm::vec3(halfWidth + wallThickness, m_showroomSize.y, halfDepth)
     ));
+    
+    // Pillars
+    for (const AABB& pillar : m_pillars) {
+        m_collisionWorld.addStaticAABB(pillar);
+    }
+    
+    m_collisionWorld.buildStaticTree();
+    updateSpatialGrid();
+}
+
+void ShowroomScene::addDynamicCar(CarModel* car) {
+    size_t proxy = m_collisionWorld.addDynamicAABB(getCarBounds(*car));
+    if (proxy >= m_dynamicCars.size()) {
+        m_dynamicCars.resize(proxy + 1, nullptr);
+    }
+    m_dynamicCars[proxy] = car;
+}
+
+AABB ShowroomScene::getCarBounds(const CarModel& car) {
+    AABB bounds;
+    car.getBoundingBox(bounds.min, bounds.max);
+    return bounds;
 }
@@ -0,0 +1,152 @@
+/**
+ * =============================================================================
+ * StatsOverlay.cpp - On-Screen Frame Statistics Implementation
+ * =============================================================================
+ */
+
+#include "StatsOverlay.h"
+#include "RenderStats.h"
+#include "TextRenderer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Layout in pixels
+constexpr float MARGIN = 10.0f;
+constexpr float BAR_WIDTH = 2.0f;
+constexpr float STRIP_HEIGHT = 40.0f;
+constexpr float STRIP_GAP = 4.0f;
+
+// Numbers: 16 pixel text beside the strips, 12 pixel summary below
+constexpr float TEXT_GAP = 6.0f;
+constexpr float VALUE_SCALE = 2.0f;
+constexpr float SUMMARY_SCALE = 1.5f;
+constexpr float VALUE_WIDTH = 18.0f * TextRenderer::GLYPH_SIZE * VALUE_SCALE;  // 18 characters
+
+// Time strips show 0..33 ms with a line at the 60 FPS budget
+constexpr float TIME_SCALE_MS = 1000.0f / 30.0f;
+constexpr float BUDGET_MS = 1000.0f / 60.0f;
+
+// Each strip is a background, a line and one quad per bar; the whole
+// overlay must leave the text batch room for labels
+constexpr size_t QUADS_PER_STRIP = 2 + StatsOverlay::HISTORY_SIZE;
+static_assert(4 * QUADS_PER_STRIP < TextRenderer::MAX_GLYPHS / 4,
+              "Overlay graphs would crowd the text batch");
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor
+// =============================================================================
+
+StatsOverlay::StatsOverlay()
+    : m_historyCount(0)
+    , m_historyIndex(0)
+{
+    static_assert(METRIC_COUNT == 4, "The text batch budget assumes four strips");
+    
+    for (auto& metric : m_history) {
+        metric.fill(0.0f);
+    }
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void StatsOverlay::addFrame(const RenderStats& stats) {
+    m_history[CPU_MAIN][m_historyIndex] = static_cast<float>(stats.cpuMainMs);
+    m_history[CPU_RENDER][m_historyIndex] = static_cast<float>(stats.cpuRenderMs);
+    m_history[GPU][m_historyIndex] = static_cast<float>(stats.gpuMs);
+    m_history[DRAW_CALLS][m_historyIndex] = static_cast<float>(stats.drawCalls);
+    m_lastFrame = stats;
+    
+    m_historyIndex = (m_historyIndex + 1) % HISTORY_SIZE;
+    m_historyCount = std::min(m_historyCount + 1, HISTORY_SIZE);
+}
+
+void StatsOverlay::draw(TextRenderer& text) const {
+    // Draw calls scale to their own recent maximum (at least 1)
+    const auto& drawCalls = m_history[DRAW_CALLS];
+    float drawCallScale = std::max(1.0f, *std::max_element(drawCalls.begin(), drawCalls.end()));
+    
+    float top = MARGIN;
+    addStrip(text, CPU_MAIN, top, TIME_SCALE_MS, BUDGET_MS, glm::vec4(0.3f, 0.6f, 1.0f, 0.9f));
+    top += STRIP_HEIGHT + STRIP_GAP;
+    addStrip(text, CPU_RENDER, top, TIME_SCALE_MS, BUDGET_MS, glm::vec4(0.3f, 0.9f, 0.4f, 0.9f));
+    top += STRIP_HEIGHT + STRIP_GAP;
+    addStrip(text, GPU, top, TIME_SCALE_MS, BUDGET_MS, glm::vec4(1.0f, 0.6f, 0.2f, 0.9f));
+    top += STRIP_HEIGHT + STRIP_GAP;
+    addStrip(text, DRAW_CALLS, top, drawCallScale, 0.0f, glm::vec4(0.7f, 0.4f, 1.0f, 0.9f));
+    
+    addNumbers(text, MARGIN);
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void StatsOverlay::addStrip(TextRenderer& text, Metric metric, float top, float scale, float line,
+                            const glm::vec4& color) const {
+    float stripWidth = HISTORY_SIZE * BAR_WIDTH;
+    text.addRect(MARGIN, top, stripWidth, STRIP_HEIGHT, glm::vec4(0.0f, 0.0f, 0.0f, 0.5f));
+    
+    // Oldest frame on the left, newest on the right
+    const auto& values = m_history[metric];
+    size_t first = (m_historyIndex + HISTORY_SIZE - m_historyCount) % HISTORY_SIZE;
+    for (size_t i = 0; i < m_historyCount; i++) {
+        float value = std::min(values[(first + i) % HISTORY_SIZE] / scale, 1.0f);
+        float barHeight = value * STRIP_HEIGHT;
+        float x = MARGIN + (HISTORY_SIZE - m_historyCount + i) * BAR_WIDTH;
+        text.addRect(x, top + STRIP_HEIGHT - barHeight, BAR_WIDTH, barHeight, color);
+    }
+    
+    if (line > 0.0f) {
+        float y = top + STRIP_HEIGHT - std::min(line / scale, 1.0f) * STRIP_HEIGHT;
+        text.addRect(MARGIN, y, stripWidth, 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.6f));
+    }
+}
+
+void StatsOverlay::addNumbers(TextRenderer& text, float top) const {
+    const glm::vec4 background(0.0f, 0.0f, 0.0f, 0.5f);
+    const glm::vec4 white(1.0f);
+    char line[96];
+    
+    // Latest value beside each strip, vertically centered
+    float x = MARGIN + HISTORY_SIZE * BAR_WIDTH + TEXT_GAP;
+    float valueHeight = TextRenderer::GLYPH_SIZE * VALUE_SCALE;
+    float y = top + 0.5f * (STRIP_HEIGHT - valueHeight);
+    float stripStep = STRIP_HEIGHT + STRIP_GAP;
+    
+    text.addRect(x - TEXT_GAP * 0.5f, top, VALUE_WIDTH + TEXT_GAP,
+                 METRIC_COUNT * stripStep - STRIP_GAP, background);
+    
+    std::snprintf(line, sizeof(line), "CPU main   %5.2f ms", m_lastFrame.cpuMainMs);
+    text.addText(line, x, y, VALUE_SCALE, white);
+    std::snprintf(line, sizeof(line), "CPU render %5.2f ms", m_lastFrame.cpuRenderMs);
+    text.addText(line, x, y + stripStep, VALUE_SCALE, white);
+    std::snprintf(line, sizeof(line), "GPU        %5.2f ms", m_lastFrame.gpuMs);
+    text.addText(line, x, y + 2.0f * stripStep, VALUE_SCALE, white);
+    std::snprintf(line, sizeof(line), "Draws      %u", m_lastFrame.drawCalls);
+    text.addText(line, x, y + 3.0f * stripStep, VALUE_SCALE, white);
+    
+    // Summary of the other counters below the strips
+    char counts[96];
+    std::snprintf(line, sizeof(line), "Triangles %llu  Objects %u (%u hidden)  Items %u (%u culled)",
+                  static_cast<unsigned long long>(m_lastFrame.triangles),
+                  m_lastFrame.objectsTotal, m_lastFrame.objectsHidden,
+                  m_lastFrame.itemsTotal, m_lastFrame.itemsCulled);
+    std::snprintf(counts, sizeof(counts), "Programs %u  VAOs %u  Textures %u  Upload %.1f KB",
+                  m_lastFrame.programChanges, m_lastFrame.vertexArrayChanges,
+                  m_lastFrame.textureChanges, m_lastFrame.bytesUploaded / 1024.0);
+    
+    float summaryTop = top + METRIC_COUNT * stripStep;
+    float lineHeight = TextRenderer::GLYPH_SIZE * SUMMARY_SCALE + 2.0f;
+    float summaryWidth = std::max(TextRenderer::measure(line, SUMMARY_SCALE),
+                                  TextRenderer::measure(counts, SUMMARY_SCALE));
+    text.addRect(MARGIN, summaryTop, summaryWidth + 4.0f, 2.0f * lineHeight + 2.0f, background);
+    text.addText(line, MARGIN + 2.0f, summaryTop + 2.0f, SUMMARY_SCALE, white);
+    text.addText(counts, MARGIN + 2.0f, summaryTop + 2.0f + lineHeight, SUMMARY_SCALE, white);
+}
@@ -0,0 +1,416 @@
+/**
+ * =============================================================================
+ * TextRenderer.cpp - Batched Screen-Space Text Implementation
+ * =============================================================================
+ */
+
+#include "TextRenderer.h"
+#include "RenderStats.h"
+#include "Shader.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+static const char* TEXT_VERTEX_SHADER_SOURCE = R"(
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aColor;
+
+uniform vec2 screenSize;
+
+out vec2 TexCoord;
+out vec4 Color;
+
+void main() {
+    TexCoord = aTexCoord;
+    Color = aColor;
+    
+    // Pixels from the top-left corner to normalized device coordinates
+    vec2 ndc = aPos / screenSize * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+}
+)";
+
+static const char* TEXT_FRAGMENT_SHADER_SOURCE = R"(
+#version 330 core
+
+in vec2 TexCoord;
+in vec4 Color;
+
+uniform sampler2D fontAtlas;
+
+out vec4 FragColor;
+
+void main() {
+    FragColor = vec4(Color.rgb, Color.a * texture(fontAtlas, TexCoord).r);
+}
+)";
+
+namespace {
+
+// Printable ASCII from ' ' to '~', plus a solid block in the DEL slot
+// that rectangles sample from
+constexpr int FIRST_CHAR = 32;
+constexpr int CHAR_COUNT = 96;
+constexpr int SOLID_CHAR = 127;
+constexpr int FALLBACK_CHAR = '?';
+
+// Atlas layout: 16 x 6 cells of GLYPH_SIZE pixels
+constexpr int ATLAS_COLUMNS = 16;
+constexpr int ATLAS_ROWS = CHAR_COUNT / ATLAS_COLUMNS;
+constexpr int ATLAS_WIDTH = ATLAS_COLUMNS * TextRenderer::GLYPH_SIZE;
+constexpr int ATLAS_HEIGHT = ATLAS_ROWS * TextRenderer::GLYPH_SIZE;
+
+// Space around label text, in font pixels
+constexpr float LABEL_PADDING = 2.0f;
+
+/**
+ * 8x8 bitmap font (public domain font8x8 "basic" set). One byte per row,
+ * top row first; the lowest bit is the leftmost pixel.
+ */
+constexpr unsigned char FONT_8X8[CHAR_COUNT][8] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // ' '
+    {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00},   // '!'
+    {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // '"'
+    {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00},   // '#'
+    {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00},   // '$'
+    {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00},   // '%'
+    {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00},   // '&'
+    {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00},   // '''
+    {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00},   // '('
+    {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00},   // ')'
+    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},   // '*'
+    {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00},   // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06},   // ','
+    {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00},   // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00},   // '.'
+    {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00},   // '/'
+    {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00},   // '0'
+    {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00},   // '1'
+    {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00},   // '2'
+    {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00},   // '3'
+    {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00},   // '4'
+    {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00},   // '5'
+    {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00},   // '6'
+    {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00},   // '7'
+    {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00},   // '8'
+    {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00},   // '9'
+    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00},   // ':'
+    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06},   // ';'
+    {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00},   // '<'
+    {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00},   // '='
+    {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00},   // '>'
+    {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00},   // '?'
+    {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00},   // '@'
+    {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00},   // 'A'
+    {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00},   // 'B'
+    {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00},   // 'C'
+    {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00},   // 'D'
+    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00},   // 'E'
+    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00},   // 'F'
+    {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00},   // 'G'
+    {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00},   // 'H'
+    {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // 'I'
+    {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00},   // 'J'
+    {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00},   // 'K'
+    {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00},   // 'L'
+    {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00},   // 'M'
+    {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00},   // 'N'
+    {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00},   // 'O'
+    {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00},   // 'P'
+    {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00},   // 'Q'
+    {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00},   // 'R'
+    {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00},   // 'S'
+    {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // 'T'
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00},   // 'U'
+    {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},   // 'V'
+    {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00},   // 'W'
+    {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00},   // 'X'
+    {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00},   // 'Y'
+    {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00},   // 'Z'
+    {0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00},   // '['
+    {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00},   // '\'
+    {0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00},   // ']'
+    {0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00},   // '^'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF},   // '_'
+    {0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},   // '`'
+    {0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00},   // 'a'
+    {0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00},   // 'b'
+    {0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00},   // 'c'
+    {0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00},   // 'd'
+    {0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00},   // 'e'
+    {0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00},   // 'f'
+    {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F},   // 'g'
+    {0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00},   // 'h'
+    {0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // 'i'
+    {0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E},   // 'j'
+    {0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00},   // 'k'
+    {0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},   // 'l'
+    {0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00},   // 'm'
+    {0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00},   // 'n'
+    {0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00},   // 'o'
+    {0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F},   // 'p'
+    {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78},   // 'q'
+    {0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00},   // 'r'
+    {0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00},   // 's'
+    {0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00},   // 't'
+    {0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00},   // 'u'
+    {0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},   // 'v'
+    {0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00},   // 'w'
+    {0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00},   // 'x'
+    {0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F},   // 'y'
+    {0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00},   // 'z'
+    {0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00},   // '{'
+    {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00},   // '|'
+    {0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00},   // '}'
+    {0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},   // '~'
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}    // Solid (rectangles)
+};
+
+/**
+ * Get the atlas cell of a character as its top-left texture coordinate.
+ */
+glm::vec2 glyphOrigin(int c) {
+    if (c < FIRST_CHAR || c > SOLID_CHAR) {
+        c = FALLBACK_CHAR;
+    }
+    int index = c - FIRST_CHAR;
+    return glm::vec2(static_cast<float>(index % ATLAS_COLUMNS * TextRenderer::GLYPH_SIZE) / ATLAS_WIDTH,
+                     static_cast<float>(index / ATLAS_COLUMNS * TextRenderer::GLYPH_SIZE) / ATLAS_HEIGHT);
+}
+
+/**
+ * Pack a color into the RGBA8 vertex format (byte order R, G, B, A).
+ */
+uint32_t packColor(const glm::vec4& color) {
+    glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    return static_cast<uint32_t>(c.r) |
+           (static_cast<uint32_t>(c.g) << 8) |
+           (static_cast<uint32_t>(c.b) << 16) |
+           (static_cast<uint32_t>(c.a) << 24);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+TextRenderer::TextRenderer()
+    : m_atlas(0)
+    , m_VAO(0)
+    , m_VBO(0)
+    , m_EBO(0)
+    , m_pixelWidth(1.0f)
+    , m_pixelHeight(1.0f)
+{
+    m_shader = std::make_unique<Shader>(TEXT_VERTEX_SHADER_SOURCE,
+                                        TEXT_FRAGMENT_SHADER_SOURCE, false);
+    m_shader->use();
+    m_shader->setInt("fontAtlas", 0);
+    
+    createAtlas();
+    m_vertices.reserve(MAX_GLYPHS * 4);
+    
+    // Every quad uses the same two triangles, so the indices never change
+    std::vector<unsigned int> indices;
+    indices.reserve(MAX_GLYPHS * 6);
+    for (unsigned int quad = 0; quad < MAX_GLYPHS; quad++) {
+        unsigned int first = quad * 4;
+        indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+    
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+    
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_GLYPHS * 4 * sizeof(TextVertex), nullptr, GL_STREAM_DRAW);
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
+                 indices.data(), GL_STATIC_DRAW);
+    RenderStats::addUploadedBytes(indices.size() * sizeof(unsigned int));
+    
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex),
+                          (void*)offsetof(TextVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex),
+                          (void*)offsetof(TextVertex, texCoord));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextVertex),
+                          (void*)offsetof(TextVertex, color));
+    
+    // The element buffer binding is part of the VAO, so unbind that first
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+TextRenderer::~TextRenderer() {
+    glDeleteTextures(1, &m_atlas);
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_VBO);
+    glDeleteBuffers(1, &m_EBO);
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void TextRenderer::begin(int width, int height) {
+    m_vertices.clear();
+    m_pixelWidth = static_cast<float>(std::max(width, 1));
+    m_pixelHeight = static_cast<float>(std::max(height, 1));
+}
+
+void TextRenderer::addText(std::string_view text, float x, float y, float scale,
+                           const glm::vec4& color) {
+    uint32_t packed = packColor(color);
+    float size = GLYPH_SIZE * scale;
+    glm::vec2 cellSize(static_cast<float>(GLYPH_SIZE) / ATLAS_WIDTH,
+                       static_cast<float>(GLYPH_SIZE) / ATLAS_HEIGHT);
+    
+    for (char c : text) {
+        // Spaces only advance
+        if (c != ' ') {
+            glm::vec2 uv = glyphOrigin(static_cast<unsigned char>(c));
+            addQuad(x, y, size, size, uv, uv + cellSize, packed);
+        }
+        x += size;
+    }
+}
+
+void TextRenderer::addRect(float x, float y, float width, float height, const glm::vec4& color) {
+    // Sample the middle of the solid glyph so every pixel reads 1
+    glm::vec2 uv = glyphOrigin(SOLID_CHAR) +
+                   glm::vec2(0.5f * GLYPH_SIZE / ATLAS_WIDTH, 0.5f * GLYPH_SIZE / ATLAS_HEIGHT);
+    addQuad(x, y, width, height, uv, uv, packColor(color));
+}
+
+bool TextRenderer::addLabel(std::string_view text, const glm::vec3& worldPosition,
+                            const glm::mat4& viewProjection, float scale,
+                            const glm::vec4& textColor, const glm::vec4& backgroundColor) {
+    glm::vec4 clip = viewProjection * glm::vec4(worldPosition, 1.0f);
+    if (clip.w <= 0.0f) {
+        return false;  // Behind the camera
+    }
+    glm::vec2 ndc = glm::vec2(clip.x, clip.y) / clip.w;
+    
+    float padding = LABEL_PADDING * scale;
+    float width = measure(text, scale) + 2.0f * padding;
+    float height = GLYPH_SIZE * scale + 2.0f * padding;
+    
+    // Centered on the point horizontally, sitting on it vertically; snapped
+    // to whole pixels so the glyphs stay crisp
+    float x = std::round((ndc.x * 0.5f + 0.5f) * m_pixelWidth - 0.5f * width);
+    float y = std::round((0.5f - ndc.y * 0.5f) * m_pixelHeight - height);
+    if (x + width < 0.0f || x > m_pixelWidth || y + height < 0.0f || y > m_pixelHeight) {
+        return false;
+    }
+    
+    addRect(x, y, width, height, backgroundColor);
+    addText(text, x + padding, y + padding, scale, textColor);
+    return true;
+}
+
+void TextRenderer::flush() {
+    if (m_vertices.empty()) {
+        return;
+    }
+    
+    // Upload: orphan the old storage so the driver needn't wait for the
+    // previous frame's draw to finish reading it
+    size_t bytes = m_vertices.size() * sizeof(TextVertex);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, MAX_GLYPHS * 4 * sizeof(TextVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), m_vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    RenderStats::addUploadedBytes(bytes);
+    
+    // Drawn on top of everything, alpha blended
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    m_shader->use();
+    m_shader->setVec2("screenSize", m_pixelWidth, m_pixelHeight);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    
+    size_t indexCount = getQuadCount() * 6;
+    glBindVertexArray(m_VAO);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+    
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    
+    RenderStats& stats = RenderStats::current();
+    stats.drawCalls++;
+    stats.instances++;
+    stats.triangles += indexCount / 3;
+    stats.vertices += indexCount;
+    stats.vertexArrayChanges++;
+    stats.textureChanges++;
+}
+
+float TextRenderer::measure(std::string_view text, float scale) {
+    return static_cast<float>(text.size()) * GLYPH_SIZE * scale;
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void TextRenderer::createAtlas() {
+    // Expand the 1-bit rows to one byte per pixel (0 or 255)
+    std::vector<unsigned char> pixels(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+    for (int index = 0; index < CHAR_COUNT; index++) {
+        int left = index % ATLAS_COLUMNS * GLYPH_SIZE;
+        int top = index / ATLAS_COLUMNS * GLYPH_SIZE;
+        for (int row = 0; row < GLYPH_SIZE; row++) {
+            for (int column = 0; column < GLYPH_SIZE; column++) {
+                if (FONT_8X8[index][row] & (1 << column)) {
+                    pixels[(top + row) * ATLAS_WIDTH + left + column] = 255;
+                }
+            }
+        }
+    }
+    
+    glGenTextures(1, &m_atlas);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    
+    // Rows of one-byte pixels aren't 4-byte aligned in general
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, ATLAS_HEIGHT, 0,
+                 GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    RenderStats::addUploadedBytes(pixels.size());
+    
+    // Nearest filtering keeps the bitmap glyphs sharp at whole-number scales
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void TextRenderer::addQuad(float x, float y, float width, float height,
+                           const glm::vec2& uvMin, const glm::vec2& uvMax, uint32_t color) {
+    if (m_vertices.size() >= MAX_GLYPHS * 4) {
+        return;
+    }
+    
+    // Counter-clockwise on screen (y points down here, up in NDC), so
+    // back-face culling keeps the quads
+    m_vertices.push_back({glm::vec2(x, y + height), glm::vec2(uvMin.x, uvMax.y), color});
+    m_vertices.push_back({glm::vec2(x + width, y + height), uvMax, color});
+    m_vertices.push_back({glm::vec2(x + width, y), glm::vec2(uvMax.x, uvMin.y), color});
+    m_vertices.push_back({glm::vec2(x, y), uvMin, color});
+}
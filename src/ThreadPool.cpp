@@ -0,0 +1,158 @@
+/**
+ * =============================================================================
+ * ThreadPool.cpp - Worker Thread Pool Implementation
+ * =============================================================================
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+
+// Set while this thread runs loop chunks. A parallelFor from inside a
+// loop body checks it rather than the job mutex, which the thread that
+// started the outer loop already holds.
+thread_local bool t_insideLoop = false;
+
+} // anonymous namespace
+
+// =============================================================================
+// Constructor / Destructor
+// =============================================================================
+
+ThreadPool::ThreadPool(unsigned int workerCount) {
+    if (workerCount == 0) {
+        // The calling thread works too, so leave one hardware thread for it
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+    
+    m_workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_all();
+    
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::getShared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// =============================================================================
+// Public Methods
+// =============================================================================
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize, const RangeFunction& body) {
+    if (count == 0) {
+        return;
+    }
+    
+    Job job;
+    job.body = &body;
+    job.count = count;
+    job.grainSize = std::max<size_t>(grainSize, 1);
+    job.chunkCount = (count + job.grainSize - 1) / job.grainSize;
+    
+    // Single chunk, no workers, or called from a loop body (nested): do it
+    // all here instead of waiting on threads that are busy
+    if (job.chunkCount == 1 || m_workers.empty() || t_insideLoop) {
+        body(0, count);
+        return;
+    }
+    
+    // Another thread's loop is running: same, rather than queueing behind it
+    std::unique_lock<std::mutex> jobLock(m_jobMutex, std::try_to_lock);
+    if (!jobLock.owns_lock()) {
+        body(0, count);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_jobGeneration++;
+    }
+    m_wakeCondition.notify_all();
+    
+    // runChunks() catches what the body throws, so this always gets to
+    // unpublish the job before it leaves the stack
+    t_insideLoop = true;
+    runChunks(job);
+    t_insideLoop = false;
+    
+    // All chunks are taken; wait for workers still finishing theirs.
+    // Workers that wake after m_job is cleared never touch this job.
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_job = nullptr;
+        m_doneCondition.wait(lock, [this] { return m_busyWorkers == 0; });
+    }
+    
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+// =============================================================================
+// Private Methods
+// =============================================================================
+
+void ThreadPool::workerLoop() {
+    unsigned int seenGeneration = 0;
+    
+    // Workers only ever run loop bodies
+    t_insideLoop = true;
+    
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeCondition.wait(lock, [&] {
+            return m_stop || (m_job && m_jobGeneration != seenGeneration);
+        });
+        if (m_stop) {
+            return;
+        }
+        
+        seenGeneration = m_jobGeneration;
+        Job* job = m_job;
+        m_busyWorkers++;
+        
+        lock.unlock();
+        runChunks(*job);
+        lock.lock();
+        
+        if (--m_busyWorkers == 0) {
+            m_doneCondition.notify_all();
+        }
+    }
+}
+
+void ThreadPool::runChunks(Job& job) {
+    try {
+        size_t chunk;
+        while ((chunk = job.nextChunk.fetch_add(1)) < job.chunkCount) {
+            size_t begin = chunk * job.grainSize;
+            size_t end = std::min(begin + job.grainSize, job.count);
+            (*job.body)(begin, end);
+        }
+    } catch (...) {
+        // Hand out no more chunks; the caller rethrows the first error
+        job.nextChunk.store(job.chunkCount);
+        std::lock_guard<std::mutex> lock(job.errorMutex);
+        if (!job.error) {
+            job.error = std::current_exception();
+        }
+    }
+}
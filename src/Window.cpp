@@ -37,8 +37,9 @@ Window::Window(int width, int height, const std::string& title)
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
     
-    // Enable MSAA (Multi-Sample Anti-Aliasing) for smoother edges
-    glfwWindowHint(GLFW_SAMPLES, 4);
+    // Single-sampled default framebuffer: edges are smoothed offscreen
+    // (see AntiAliasing), where MSAA is one option among cheaper ones
+    glfwWindowHint(GLFW_SAMPLES, 0);
     
     // Create the window
     m_window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
@@ -130,6 +131,22 @@ void Window::pollEvents() {
     glfwPollEvents();
 }
 
+void Window::makeContextCurrent() {
+    glfwMakeContextCurrent(m_window);
+}
+
+void Window::detachContext() {
+    glfwMakeContextCurrent(nullptr);
+}
+
+GLFWwindow* Window::createSharedContext() const {
+    // Version/profile hints from the constructor still apply
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* shared = glfwCreateWindow(1, 1, "", nullptr, m_window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    return shared;
+}
+
 void Window::close() {
     glfwSetWindowShouldClose(m_window, GLFW_TRUE);
 }
@@ -138,6 +155,14 @@ double Window::getTime() {
     return glfwGetTime();
 }
 
+void Window::setTitleStatus(const std::string& status) {
+    if (status.empty()) {
+        glfwSetWindowTitle(m_window, m_title.c_str());
+    } else {
+        glfwSetWindowTitle(m_window, (m_title + " - " + status).c_str());
+    }
+}
+
 // =============================================================================
 // Cursor Control
 // =============================================================================
@@ -158,6 +183,10 @@ void Window::getMousePosition(double& x, double& y) const {
     glfwGetCursorPos(m_window, &x, &y);
 }
 
+void Window::setSwapInterval(int interval) {
+    glfwSwapInterval(interval);
+}
+
 // =============================================================================
 // Callback Setters
 // =============================================================================
@@ -191,7 +220,8 @@ void Window::framebufferSizeCallbackStatic(GLFWwindow* window, int width, int he
     if (self) {
         self->m_width = width;
         self->m_height = height;
-        glViewport(0, 0, width, height);
+        // No GL calls here: events arrive on the main thread, which may not
+        // hold the context (the renderer updates the viewport)
         if (self->m_framebufferSizeCallback) {
             self->m_framebufferSizeCallback(width, height);
         }
@@ -38,6 +38,13 @@ PFNGLFRONTFACEPROC glFrontFace = NULL;
 PFNGLDEPTHMASKPROC glDepthMask = NULL;
 PFNGLGETERRORPROC glGetError = NULL;
 PFNGLGETSTRINGPROC glGetString = NULL;
+PFNGLGETINTEGERVPROC glGetIntegerv = NULL;
+PFNGLSCISSORPROC glScissor = NULL;
+PFNGLREADPIXELSPROC glReadPixels = NULL;
+PFNGLREADBUFFERPROC glReadBuffer = NULL;
+PFNGLDRAWBUFFERPROC glDrawBuffer = NULL;
+PFNGLDRAWBUFFERSPROC glDrawBuffers = NULL;
+PFNGLCOLORMASKIPROC glColorMaski = NULL;
 
 // Shader functions
 PFNGLCREATESHADERPROC glCreateShader = NULL;
@@ -54,9 +61,14 @@ PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = NULL;
 PFNGLUSEPROGRAMPROC glUseProgram = NULL;
 PFNGLDELETEPROGRAMPROC glDeleteProgram = NULL;
 PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = NULL;
+PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex = NULL;
+PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding = NULL;
 
 // Uniform functions
 PFNGLUNIFORM1IPROC glUniform1i = NULL;
+PFNGLUNIFORM2IPROC glUniform2i = NULL;
+PFNGLUNIFORM4IPROC glUniform4i = NULL;
+PFNGLUNIFORM1UIPROC glUniform1ui = NULL;
 PFNGLUNIFORM1FPROC glUniform1f = NULL;
 PFNGLUNIFORM2FPROC glUniform2f = NULL;
 PFNGLUNIFORM3FPROC glUniform3f = NULL;
@@ -74,10 +86,43 @@ PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = NULL;
 // Buffer functions
 PFNGLGENBUFFERSPROC glGenBuffers = NULL;
 PFNGLBINDBUFFERPROC glBindBuffer = NULL;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange = NULL;
 PFNGLBUFFERDATAPROC glBufferData = NULL;
 PFNGLBUFFERSUBDATAPROC glBufferSubData = NULL;
 PFNGLDELETEBUFFERSPROC glDeleteBuffers = NULL;
 
+// Buffer mapping
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = NULL;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = NULL;
+
+// Framebuffer functions
+PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers = NULL;
+PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer = NULL;
+PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D = NULL;
+PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer = NULL;
+PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus = NULL;
+PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers = NULL;
+PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers = NULL;
+PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer = NULL;
+PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage = NULL;
+PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers = NULL;
+PFNGLCLEARBUFFERUIVPROC glClearBufferuiv = NULL;
+PFNGLCLEARBUFFERFVPROC glClearBufferfv = NULL;
+PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample = NULL;
+PFNGLBLITFRAMEBUFFERPROC glBlitFramebuffer = NULL;
+
+// Sync functions
+PFNGLFENCESYNCPROC glFenceSync = NULL;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync = NULL;
+PFNGLDELETESYNCPROC glDeleteSync = NULL;
+
+// Query functions
+PFNGLGENQUERIESPROC glGenQueries = NULL;
+PFNGLDELETEQUERIESPROC glDeleteQueries = NULL;
+PFNGLQUERYCOUNTERPROC glQueryCounter = NULL;
+PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv = NULL;
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v = NULL;
+
 // Vertex attribute functions
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = NULL;
 PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray = NULL;
@@ -95,6 +140,7 @@ PFNGLTEXPARAMETERIPROC glTexParameteri = NULL;
 PFNGLGENERATEMIPMAPPROC glGenerateMipmap = NULL;
 PFNGLACTIVETEXTUREPROC glActiveTexture = NULL;
 PFNGLDELETETEXTURESPROC glDeleteTextures = NULL;
+PFNGLPIXELSTOREIPROC glPixelStorei = NULL;
 
 // Polygon mode
 PFNGLPOLYGONMODEPROC glPolygonMode = NULL;
@@ -134,6 +180,13 @@ int gladLoadGLLoader(GLADloadproc load) {
     glDepthMask = (PFNGLDEPTHMASKPROC)load_gl_func(load, "glDepthMask");
     glGetError = (PFNGLGETERRORPROC)load_gl_func(load, "glGetError");
     glGetString = (PFNGLGETSTRINGPROC)load_gl_func(load, "glGetString");
+    glGetIntegerv = (PFNGLGETINTEGERVPROC)load_gl_func(load, "glGetIntegerv");
+    glScissor = (PFNGLSCISSORPROC)load_gl_func(load, "glScissor");
+    glReadPixels = (PFNGLREADPIXELSPROC)load_gl_func(load, "glReadPixels");
+    glReadBuffer = (PFNGLREADBUFFERPROC)load_gl_func(load, "glReadBuffer");
+    glDrawBuffer = (PFNGLDRAWBUFFERPROC)load_gl_func(load, "glDrawBuffer");
+    glDrawBuffers = (PFNGLDRAWBUFFERSPROC)load_gl_func(load, "glDrawBuffers");
+    glColorMaski = (PFNGLCOLORMASKIPROC)load_gl_func(load, "glColorMaski");
     
     // Load shader functions
     glCreateShader = (PFNGLCREATESHADERPROC)load_gl_func(load, "glCreateShader");
@@ -150,9 +203,14 @@ int gladLoadGLLoader(GLADloadproc load) {
     glUseProgram = (PFNGLUSEPROGRAMPROC)load_gl_func(load, "glUseProgram");
     glDeleteProgram = (PFNGLDELETEPROGRAMPROC)load_gl_func(load, "glDeleteProgram");
     glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)load_gl_func(load, "glGetUniformLocation");
+    glGetUniformBlockIndex = (PFNGLGETUNIFORMBLOCKINDEXPROC)load_gl_func(load, "glGetUniformBlockIndex");
+    glUniformBlockBinding = (PFNGLUNIFORMBLOCKBINDINGPROC)load_gl_func(load, "glUniformBlockBinding");
     
     // Load uniform functions
     glUniform1i = (PFNGLUNIFORM1IPROC)load_gl_func(load, "glUniform1i");
+    glUniform2i = (PFNGLUNIFORM2IPROC)load_gl_func(load, "glUniform2i");
+    glUniform4i = (PFNGLUNIFORM4IPROC)load_gl_func(load, "glUniform4i");
+    glUniform1ui = (PFNGLUNIFORM1UIPROC)load_gl_func(load, "glUniform1ui");
     glUniform1f = (PFNGLUNIFORM1FPROC)load_gl_func(load, "glUniform1f");
     glUniform2f = (PFNGLUNIFORM2FPROC)load_gl_func(load, "glUniform2f");
     glUniform3f = (PFNGLUNIFORM3FPROC)load_gl_func(load, "glUniform3f");
@@ -170,10 +228,43 @@ int gladLoadGLLoader(GLADloadproc load) {
     // Load buffer functions
     glGenBuffers = (PFNGLGENBUFFERSPROC)load_gl_func(load, "glGenBuffers");
     glBindBuffer = (PFNGLBINDBUFFERPROC)load_gl_func(load, "glBindBuffer");
+    glBindBufferRange = (PFNGLBINDBUFFERRANGEPROC)load_gl_func(load, "glBindBufferRange");
     glBufferData = (PFNGLBUFFERDATAPROC)load_gl_func(load, "glBufferData");
     glBufferSubData = (PFNGLBUFFERSUBDATAPROC)load_gl_func(load, "glBufferSubData");
     glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)load_gl_func(load, "glDeleteBuffers");
     
+    // Load buffer mapping functions
+    glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)load_gl_func(load, "glMapBufferRange");
+    glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)load_gl_func(load, "glUnmapBuffer");
+    
+    // Load framebuffer functions
+    glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)load_gl_func(load, "glGenFramebuffers");
+    glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)load_gl_func(load, "glBindFramebuffer");
+    glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)load_gl_func(load, "glFramebufferTexture2D");
+    glFramebufferRenderbuffer = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)load_gl_func(load, "glFramebufferRenderbuffer");
+    glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)load_gl_func(load, "glCheckFramebufferStatus");
+    glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)load_gl_func(load, "glDeleteFramebuffers");
+    glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)load_gl_func(load, "glGenRenderbuffers");
+    glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)load_gl_func(load, "glBindRenderbuffer");
+    glRenderbufferStorage = (PFNGLRENDERBUFFERSTORAGEPROC)load_gl_func(load, "glRenderbufferStorage");
+    glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)load_gl_func(load, "glDeleteRenderbuffers");
+    glClearBufferuiv = (PFNGLCLEARBUFFERUIVPROC)load_gl_func(load, "glClearBufferuiv");
+    glClearBufferfv = (PFNGLCLEARBUFFERFVPROC)load_gl_func(load, "glClearBufferfv");
+    glRenderbufferStorageMultisample = (PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC)load_gl_func(load, "glRenderbufferStorageMultisample");
+    glBlitFramebuffer = (PFNGLBLITFRAMEBUFFERPROC)load_gl_func(load, "glBlitFramebuffer");
+    
+    // Load sync functions
+    glFenceSync = (PFNGLFENCESYNCPROC)load_gl_func(load, "glFenceSync");
+    glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)load_gl_func(load, "glClientWaitSync");
+    glDeleteSync = (PFNGLDELETESYNCPROC)load_gl_func(load, "glDeleteSync");
+    
+    // Load query functions
+    glGenQueries = (PFNGLGENQUERIESPROC)load_gl_func(load, "glGenQueries");
+    glDeleteQueries = (PFNGLDELETEQUERIESPROC)load_gl_func(load, "glDeleteQueries");
+    glQueryCounter = (PFNGLQUERYCOUNTERPROC)load_gl_func(load, "glQueryCounter");
+    glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)load_gl_func(load, "glGetQueryObjectiv");
+    glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)load_gl_func(load, "glGetQueryObjectui64v");
+    
     // Load vertex attribute functions
     glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)load_gl_func(load, "glVertexAttribPointer");
     glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)load_gl_func(load, "glEnableVertexAttribArray");
@@ -191,6 +282,7 @@ int gladLoadGLLoader(GLADloadproc load) {
     glGenerateMipmap = (PFNGLGENERATEMIPMAPPROC)load_gl_func(load, "glGenerateMipmap");
     glActiveTexture = (PFNGLACTIVETEXTUREPROC)load_gl_func(load, "glActiveTexture");
     glDeleteTextures = (PFNGLDELETETEXTURESPROC)load_gl_func(load, "glDeleteTextures");
+    glPixelStorei = (PFNGLPIXELSTOREIPROC)load_gl_func(load, "glPixelStorei");
     
     // Load polygon mode
     glPolygonMode = (PFNGLPOLYGONMODEPROC)load_gl_func(load, "glPolygonMode");
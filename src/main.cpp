@@ -122,10 +122,10 @@
  *    - Each level handles its own transforms
  *    - Hierarchical transforms allow parent-child relationships
  * 
- * 3. RENDER QUEUE SYSTEM
- *    - Collects render commands during frame
+ * 3. FRAME PACKETS
+ *    - Collects draw items for the frame on the main thread
  *    - Sorts transparent objects for correct blending
- *    - Could be extended for batching similar objects
+ *    - The render thread draws them without touching the scene
  * 
  * 4. EMBEDDED SHADERS
  *    - Shaders are embedded in C++ for simplicity
@@ -141,6 +141,7 @@
  */
 
 #include "Application.h"
+#include "SceneGenerator.h"
 #include <iostream>
 #include <exception>
 
@@ -149,14 +150,25 @@
  * 
  * Creates and runs the car showroom application.
  * Catches and reports any exceptions that escape.
+ * Command-line options select a generated stress scene (see --help).
  */
-int main() {
+int main(int argc, char* argv[]) {
+    SceneConfig sceneConfig;
+    switch (SceneGenerator::parseCommandLine(argc, argv, sceneConfig)) {
+        case SceneGenerator::CommandLineResult::RUN:
+            break;
+        case SceneGenerator::CommandLineResult::EXIT_OK:
+            return 0;  // Help printed
+        case SceneGenerator::CommandLineResult::EXIT_ERROR:
+            return 1;  // Error already printed
+    }
+    
     try {
         std::cout << "=== OpenGL 3D Car Showroom ===" << std::endl;
         std::cout << "Educational Example Project" << std::endl;
         std::cout << "=============================" << std::endl;
         
-        Application app(1280, 720, "3D Car Showroom - OpenGL Example");
+        Application app(1280, 720, "3D Car Showroom - OpenGL Example", sceneConfig);
         return app.run();
         
     } catch (const std::exception& e) {